@@ -44,6 +44,8 @@ set(_libevent_components core extra)
 if(NOT WIN32)
   list(APPEND _libevent_components pthreads)
 endif()
+# Further components asked for, such as openssl.
+list(APPEND _libevent_components ${Libevent_FIND_COMPONENTS})
 
 find_package(Libevent ${Libevent_FIND_VERSION} QUIET
   NO_MODULE
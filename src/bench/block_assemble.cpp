@@ -12,6 +12,7 @@
 #include <test/util/mining.h>
 #include <test/util/script.h>
 #include <test/util/setup_common.h>
+#include <txmempool.h>
 #include <validation.h>
 
 #include <array>
@@ -64,6 +65,22 @@ static void BlockAssemblerAddPackageTxns(benchmark::Bench& bench)
     assembler_options.test_block_validity = false;
     assembler_options.coinbase_output_script = P2WSH_OP_TRUE;
 
+    bench.run([&] {
+        // Make every run walk the chunks instead of reusing the last selection.
+        testing_setup->m_node.mempool->AddTransactionsUpdated(1);
+        PrepareBlock(testing_setup->m_node, assembler_options);
+    });
+}
+static void BlockAssemblerSteadyState(benchmark::Bench& bench)
+{
+    FastRandomContext det_rand{true};
+    auto testing_setup{MakeNoLogFileContext<TestChain100Setup>()};
+    testing_setup->PopulateMempool(det_rand, /*num_transactions=*/1000, /*submit=*/true);
+    BlockAssembler::Options assembler_options;
+    assembler_options.test_block_validity = false;
+    assembler_options.coinbase_output_script = P2WSH_OP_TRUE;
+
+    // A miner polling for templates while neither the tip nor the mempool changes.
     bench.run([&] {
         PrepareBlock(testing_setup->m_node, assembler_options);
     });
@@ -71,3 +88,4 @@ static void BlockAssemblerAddPackageTxns(benchmark::Bench& bench)
 
 BENCHMARK(AssembleBlock, benchmark::PriorityLevel::HIGH);
 BENCHMARK(BlockAssemblerAddPackageTxns, benchmark::PriorityLevel::LOW);
+BENCHMARK(BlockAssemblerSteadyState, benchmark::PriorityLevel::LOW);
@@ -9,10 +9,15 @@
 #include <policy/policy.h>
 #include <primitives/transaction.h>
 #include <script/script.h>
+#include <random.h>
 #include <script/signingprovider.h>
+#include <support/allocators/pool.h>
 #include <test/util/transaction_utils.h>
+#include <util/hasher.h>
 
 #include <cassert>
+#include <functional>
+#include <unordered_map>
 #include <vector>
 
 // Microbenchmark for simple accesses to a CCoinsViewCache database. Note from
@@ -54,4 +59,66 @@ static void CCoinsCaching(benchmark::Bench& bench)
     });
 }
 
+//! The node-based coins cache map used before CCoinsMap became a FlatNodeMap, for comparison
+using UnorderedCoinsMap = std::unordered_map<COutPoint,
+                                             CCoinsCacheEntry,
+                                             SaltedOutpointHasher,
+                                             std::equal_to<COutPoint>,
+                                             PoolAllocator<CoinsCachePair,
+                                                           sizeof(CoinsCachePair) + sizeof(void*) * 4>>;
+
+static constexpr size_t COINS_MAP_BENCH_SIZE{100'000};
+
+static std::vector<COutPoint> RandomOutPoints(FastRandomContext& rng, size_t count)
+{
+    std::vector<COutPoint> outpoints;
+    outpoints.reserve(count);
+    for (size_t i{0}; i < count; ++i) outpoints.emplace_back(Txid::FromUint256(rng.rand256()), rng.randrange(4));
+    return outpoints;
+}
+
+/** Fill a coins map, as a cache does while connecting blocks. */
+template <typename Map>
+static void CoinsMapInsert(benchmark::Bench& bench)
+{
+    FastRandomContext rng{/*fDeterministic=*/true};
+    const auto outpoints{RandomOutPoints(rng, COINS_MAP_BENCH_SIZE)};
+    bench.batch(outpoints.size()).unit("coin").run([&] {
+        typename Map::allocator_type::ResourceType resource;
+        Map map{0, SaltedOutpointHasher{/*deterministic=*/true}, std::equal_to<COutPoint>{}, &resource};
+        for (const COutPoint& outpoint : outpoints) map.try_emplace(outpoint);
+        assert(map.size() == outpoints.size());
+    });
+}
+
+/** Look up coins in a full map, half of them missing, as a cache does before reading its backing view. */
+template <typename Map>
+static void CoinsMapFind(benchmark::Bench& bench)
+{
+    FastRandomContext rng{/*fDeterministic=*/true};
+    const auto outpoints{RandomOutPoints(rng, COINS_MAP_BENCH_SIZE)};
+    const auto missing{RandomOutPoints(rng, COINS_MAP_BENCH_SIZE)};
+    typename Map::allocator_type::ResourceType resource;
+    Map map{0, SaltedOutpointHasher{/*deterministic=*/true}, std::equal_to<COutPoint>{}, &resource};
+    for (const COutPoint& outpoint : outpoints) map.try_emplace(outpoint);
+
+    bench.batch(outpoints.size() + missing.size()).unit("lookup").run([&] {
+        size_t found{0};
+        for (size_t i{0}; i < outpoints.size(); ++i) {
+            found += map.find(outpoints[i]) != map.end();
+            found += map.find(missing[i]) != map.end();
+        }
+        assert(found == outpoints.size());
+    });
+}
+
+static void CoinsMapInsertFlat(benchmark::Bench& bench) { CoinsMapInsert<CCoinsMap>(bench); }
+static void CoinsMapInsertUnordered(benchmark::Bench& bench) { CoinsMapInsert<UnorderedCoinsMap>(bench); }
+static void CoinsMapFindFlat(benchmark::Bench& bench) { CoinsMapFind<CCoinsMap>(bench); }
+static void CoinsMapFindUnordered(benchmark::Bench& bench) { CoinsMapFind<UnorderedCoinsMap>(bench); }
+
 BENCHMARK(CCoinsCaching, benchmark::PriorityLevel::HIGH);
+BENCHMARK(CoinsMapInsertFlat, benchmark::PriorityLevel::HIGH);
+BENCHMARK(CoinsMapInsertUnordered, benchmark::PriorityLevel::HIGH);
+BENCHMARK(CoinsMapFindFlat, benchmark::PriorityLevel::HIGH);
+BENCHMARK(CoinsMapFindUnordered, benchmark::PriorityLevel::HIGH);
@@ -0,0 +1,61 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <net_processing.h>
+#include <pow.h>
+#include <primitives/block.h>
+#include <test/util/setup_common.h>
+#include <validation.h>
+
+#include <cassert>
+#include <vector>
+
+namespace {
+/** A full headers message of valid regtest headers. */
+std::vector<CBlockHeader> CreateHeaders(const ChainstateManager& chainman)
+{
+    const auto& params{chainman.GetConsensus()};
+    std::vector<CBlockHeader> headers(MAX_HEADERS_RESULTS);
+    uint256 prev_hash{params.hashGenesisBlock};
+    for (auto& header : headers) {
+        header.nVersion = 4;
+        header.hashPrevBlock = prev_hash;
+        header.nTime = 1700000000;
+        header.nBits = 0x207fffff;
+        while (!CheckProofOfWork(header.GetHash(), header.nBits, params)) ++header.nNonce;
+        prev_hash = header.GetHash();
+    }
+    return headers;
+}
+} // namespace
+
+/** Headers per second checked on the calling thread alone. */
+static void CheckHeadersPoW(benchmark::Bench& bench)
+{
+    const auto testing_setup{MakeNoLogFileContext<const TestingSetup>()};
+    const auto& chainman{*testing_setup->m_node.chainman};
+    const auto headers{CreateHeaders(chainman)};
+
+    bench.batch(headers.size()).unit("header").run([&] {
+        const bool valid{HasValidProofOfWork(headers, chainman.GetConsensus())};
+        assert(valid);
+    });
+}
+
+/** Headers per second checked with the header check queue, as for a headers message. */
+static void CheckHeadersPoWParallel(benchmark::Bench& bench)
+{
+    const auto testing_setup{MakeNoLogFileContext<const TestingSetup>()};
+    auto& chainman{*testing_setup->m_node.chainman};
+    const auto headers{CreateHeaders(chainman)};
+
+    bench.batch(headers.size()).unit("header").run([&] {
+        const bool valid{chainman.HasValidProofOfWork(headers)};
+        assert(valid);
+    });
+}
+
+BENCHMARK(CheckHeadersPoW, benchmark::PriorityLevel::HIGH);
+BENCHMARK(CheckHeadersPoWParallel, benchmark::PriorityLevel::HIGH);
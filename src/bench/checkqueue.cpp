@@ -22,10 +22,12 @@ static const unsigned int QUEUE_BATCH_SIZE = 128;
 // This Benchmark tests the CheckQueue with a slightly realistic workload,
 // where checks all contain a prevector that is indirect 50% of the time
 // and there is a little bit of work done between calls to Add.
-static void CCheckQueueSpeedPrevectorJob(benchmark::Bench& bench)
+// threads_num counts the main thread too.
+static void CheckQueueBench(benchmark::Bench& bench, int threads_num)
 {
-    // We shouldn't ever be running with the checkqueue on a single core machine.
-    if (GetNumCores() <= 1) return;
+    // We shouldn't ever be running with the checkqueue on a single core machine,
+    // nor with more threads than cores.
+    if (threads_num <= 1 || threads_num > GetNumCores()) return;
 
     ECC_Context ecc_context{};
 
@@ -40,10 +42,7 @@ static void CCheckQueueSpeedPrevectorJob(benchmark::Bench& bench)
         }
     };
 
-    // The main thread should be counted to prevent thread oversubscription, and
-    // to decrease the variance of benchmark results.
-    int worker_threads_num{GetNumCores() - 1};
-    CCheckQueue<PrevectorJob> queue{QUEUE_BATCH_SIZE, worker_threads_num};
+    CCheckQueue<PrevectorJob> queue{QUEUE_BATCH_SIZE, threads_num - 1};
 
     // create all the data once, then submit copies in the benchmark.
     FastRandomContext insecure_rand(true);
@@ -65,4 +64,27 @@ static void CCheckQueueSpeedPrevectorJob(benchmark::Bench& bench)
         control.Complete();
     });
 }
+
+static void CCheckQueueSpeedPrevectorJob(benchmark::Bench& bench)
+{
+    // The main thread should be counted to prevent thread oversubscription, and
+    // to decrease the variance of benchmark results.
+    CheckQueueBench(bench, GetNumCores());
+}
+
+// Scaling of the queue with the number of threads. Counts above the number of
+// cores are skipped.
+static void CCheckQueueSpeedPrevectorJob2Threads(benchmark::Bench& bench) { CheckQueueBench(bench, 2); }
+static void CCheckQueueSpeedPrevectorJob4Threads(benchmark::Bench& bench) { CheckQueueBench(bench, 4); }
+static void CCheckQueueSpeedPrevectorJob8Threads(benchmark::Bench& bench) { CheckQueueBench(bench, 8); }
+static void CCheckQueueSpeedPrevectorJob16Threads(benchmark::Bench& bench) { CheckQueueBench(bench, 16); }
+static void CCheckQueueSpeedPrevectorJob32Threads(benchmark::Bench& bench) { CheckQueueBench(bench, 32); }
+static void CCheckQueueSpeedPrevectorJob64Threads(benchmark::Bench& bench) { CheckQueueBench(bench, 64); }
+
 BENCHMARK(CCheckQueueSpeedPrevectorJob, benchmark::PriorityLevel::HIGH);
+BENCHMARK(CCheckQueueSpeedPrevectorJob2Threads, benchmark::PriorityLevel::LOW);
+BENCHMARK(CCheckQueueSpeedPrevectorJob4Threads, benchmark::PriorityLevel::LOW);
+BENCHMARK(CCheckQueueSpeedPrevectorJob8Threads, benchmark::PriorityLevel::LOW);
+BENCHMARK(CCheckQueueSpeedPrevectorJob16Threads, benchmark::PriorityLevel::LOW);
+BENCHMARK(CCheckQueueSpeedPrevectorJob32Threads, benchmark::PriorityLevel::LOW);
+BENCHMARK(CCheckQueueSpeedPrevectorJob64Threads, benchmark::PriorityLevel::LOW);
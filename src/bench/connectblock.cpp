@@ -111,6 +111,13 @@ static void ConnectBlockAllSchnorr(benchmark::Bench& bench)
     BenchmarkConnectBlock(bench, keys, outputs, *test_setup);
 }
 
+static void ConnectBlockAllSchnorrBatch(benchmark::Bench& bench)
+{
+    const auto test_setup{MakeNoLogFileContext<TestChain100Setup>(ChainType::REGTEST, {.extra_args = {"-batchschnorr=1"}})};
+    auto [keys, outputs]{CreateKeysAndOutputs(test_setup->coinbaseKey, /*num_schnorr=*/5, /*num_ecdsa=*/0)};
+    BenchmarkConnectBlock(bench, keys, outputs, *test_setup);
+}
+
 static void ConnectBlockMixedEcdsaSchnorr(benchmark::Bench& bench)
 {
     const auto test_setup{MakeNoLogFileContext<TestChain100Setup>()};
@@ -126,6 +133,72 @@ static void ConnectBlockAllEcdsa(benchmark::Bench& bench)
     BenchmarkConnectBlock(bench, keys, outputs, *test_setup);
 }
 
+/*
+ * Creates a test block whose transactions each spend a different output of an
+ * earlier block, and flushes the chainstate so that those outputs are only
+ * in the coins database.
+ * - All outputs are anyone-can-spend, so that reading the inputs and not
+ *   checking scripts dominates
+ */
+CBlock CreateColdCacheTestBlock(TestChain100Setup& test_setup, int num_txs = 2000)
+{
+    Chainstate& chainstate{test_setup.m_node.chainman->ActiveChainstate()};
+    const CScript op_true{CScript() << OP_TRUE};
+
+    auto& coinbase_to_spend{test_setup.m_coinbase_txns[0]};
+    const std::vector<CTxOut> outputs(num_txs, CTxOut{COIN / 100, op_true});
+    const auto [fan_out_tx, _]{test_setup.CreateValidTransaction(
+        {coinbase_to_spend},
+        {COutPoint(coinbase_to_spend->GetHash(), 0)},
+        chainstate.m_chain.Height() + 1, {test_setup.coinbaseKey}, outputs, {}, {})};
+    test_setup.CreateAndProcessBlock({fan_out_tx}, op_true, &chainstate);
+    chainstate.ForceFlushStateToDisk();
+
+    std::vector<CMutableTransaction> txs(num_txs);
+    for (int i{0}; i < num_txs; ++i) {
+        txs[i].vin.emplace_back(COutPoint(fan_out_tx.GetHash(), i));
+        txs[i].vout.emplace_back(COIN / 100, op_true);
+    }
+    return test_setup.CreateBlock(txs, op_true, chainstate);
+}
+
+/*
+ * Connects a block with no input in the coins cache, reading them on the
+ * input fetch queue first if fetch_inputs is set.
+ */
+void BenchmarkConnectBlockColdCache(benchmark::Bench& bench, bool fetch_inputs)
+{
+    const auto test_setup{MakeNoLogFileContext<TestChain100Setup>(ChainType::REGTEST, {.coins_db_in_memory = false})};
+    const auto test_block{CreateColdCacheTestBlock(*test_setup)};
+    bench.unit("block").run([&] {
+        LOCK(cs_main);
+        auto& chainman{test_setup->m_node.chainman};
+        auto& chainstate{chainman->ActiveChainstate()};
+        for (const auto& tx : test_block.vtx) {
+            for (const auto& txin : tx->vin) chainstate.CoinsTip().Uncache(txin.prevout);
+        }
+        BlockValidationState test_block_state;
+        auto* pindex{chainman->m_blockman.AddToBlockIndex(test_block, chainman->m_best_header)};
+        if (fetch_inputs) chainstate.FetchInputs(test_block);
+        CCoinsViewCache viewNew{&chainstate.CoinsTip()};
+
+        assert(chainstate.ConnectBlock(test_block, test_block_state, pindex, viewNew));
+    });
+}
+
+static void ConnectBlockColdCache(benchmark::Bench& bench)
+{
+    BenchmarkConnectBlockColdCache(bench, /*fetch_inputs=*/false);
+}
+
+static void ConnectBlockColdCacheFetchInputs(benchmark::Bench& bench)
+{
+    BenchmarkConnectBlockColdCache(bench, /*fetch_inputs=*/true);
+}
+
 BENCHMARK(ConnectBlockAllSchnorr, benchmark::PriorityLevel::HIGH);
+BENCHMARK(ConnectBlockAllSchnorrBatch, benchmark::PriorityLevel::HIGH);
 BENCHMARK(ConnectBlockMixedEcdsaSchnorr, benchmark::PriorityLevel::HIGH);
 BENCHMARK(ConnectBlockAllEcdsa, benchmark::PriorityLevel::HIGH);
+BENCHMARK(ConnectBlockColdCache, benchmark::PriorityLevel::HIGH);
+BENCHMARK(ConnectBlockColdCacheFetchInputs, benchmark::PriorityLevel::HIGH);
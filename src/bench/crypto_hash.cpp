@@ -181,6 +181,62 @@ static void SHA256D64_1024_SHANI(benchmark::Bench& bench)
     SHA256AutoDetect();
 }
 
+static void SHA256D80_1024_STANDARD(benchmark::Bench& bench)
+{
+    bench.name(strprintf("%s using the '%s' SHA256 implementation", __func__, SHA256AutoDetect(sha256_implementation::STANDARD)));
+    uint32_t midstate[8];
+    std::vector<uint8_t> header_prefix(64, 0);
+    SHA256Midstate(midstate, header_prefix.data());
+    std::vector<uint8_t> in(16 * 1024, 0);
+    std::vector<uint8_t> out(32 * 1024, 0);
+    bench.batch(1024).unit("header").run([&] {
+        SHA256D80Midstate(out.data(), midstate, in.data(), 1024);
+    });
+    SHA256AutoDetect();
+}
+
+static void SHA256D80_1024_SSE4(benchmark::Bench& bench)
+{
+    bench.name(strprintf("%s using the '%s' SHA256 implementation", __func__, SHA256AutoDetect(sha256_implementation::USE_SSE4)));
+    uint32_t midstate[8];
+    std::vector<uint8_t> header_prefix(64, 0);
+    SHA256Midstate(midstate, header_prefix.data());
+    std::vector<uint8_t> in(16 * 1024, 0);
+    std::vector<uint8_t> out(32 * 1024, 0);
+    bench.batch(1024).unit("header").run([&] {
+        SHA256D80Midstate(out.data(), midstate, in.data(), 1024);
+    });
+    SHA256AutoDetect();
+}
+
+static void SHA256D80_1024_AVX2(benchmark::Bench& bench)
+{
+    bench.name(strprintf("%s using the '%s' SHA256 implementation", __func__, SHA256AutoDetect(sha256_implementation::USE_SSE4_AND_AVX2)));
+    uint32_t midstate[8];
+    std::vector<uint8_t> header_prefix(64, 0);
+    SHA256Midstate(midstate, header_prefix.data());
+    std::vector<uint8_t> in(16 * 1024, 0);
+    std::vector<uint8_t> out(32 * 1024, 0);
+    bench.batch(1024).unit("header").run([&] {
+        SHA256D80Midstate(out.data(), midstate, in.data(), 1024);
+    });
+    SHA256AutoDetect();
+}
+
+static void SHA256D80_1024_SHANI(benchmark::Bench& bench)
+{
+    bench.name(strprintf("%s using the '%s' SHA256 implementation", __func__, SHA256AutoDetect(sha256_implementation::USE_SSE4_AND_SHANI)));
+    uint32_t midstate[8];
+    std::vector<uint8_t> header_prefix(64, 0);
+    SHA256Midstate(midstate, header_prefix.data());
+    std::vector<uint8_t> in(16 * 1024, 0);
+    std::vector<uint8_t> out(32 * 1024, 0);
+    bench.batch(1024).unit("header").run([&] {
+        SHA256D80Midstate(out.data(), midstate, in.data(), 1024);
+    });
+    SHA256AutoDetect();
+}
+
 static void SHA512(benchmark::Bench& bench)
 {
     uint8_t hash[CSHA512::OUTPUT_SIZE];
@@ -278,6 +334,10 @@ BENCHMARK(SHA256D64_1024_STANDARD, benchmark::PriorityLevel::HIGH);
 BENCHMARK(SHA256D64_1024_SSE4, benchmark::PriorityLevel::HIGH);
 BENCHMARK(SHA256D64_1024_AVX2, benchmark::PriorityLevel::HIGH);
 BENCHMARK(SHA256D64_1024_SHANI, benchmark::PriorityLevel::HIGH);
+BENCHMARK(SHA256D80_1024_STANDARD, benchmark::PriorityLevel::HIGH);
+BENCHMARK(SHA256D80_1024_SSE4, benchmark::PriorityLevel::HIGH);
+BENCHMARK(SHA256D80_1024_AVX2, benchmark::PriorityLevel::HIGH);
+BENCHMARK(SHA256D80_1024_SHANI, benchmark::PriorityLevel::HIGH);
 
 BENCHMARK(MuHash, benchmark::PriorityLevel::HIGH);
 BENCHMARK(MuHashMul, benchmark::PriorityLevel::HIGH);
@@ -5,7 +5,9 @@
 #include <bench/bench.h>
 #include <bench/data/block413567.raw.h>
 #include <chainparams.h>
+#include <common/system.h>
 #include <flatfile.h>
+#include <node/blockfilescanner.h>
 #include <node/blockstorage.h>
 #include <span.h>
 #include <streams.h>
@@ -14,6 +16,7 @@
 #include <util/fs.h>
 #include <validation.h>
 
+#include <cassert>
 #include <cstdint>
 #include <cstdio>
 #include <map>
@@ -71,4 +74,48 @@ static void LoadExternalBlockFile(benchmark::Bench& bench)
     fs::remove(blkfile);
 }
 
+/**
+ * -reindex scans the block files for blocks on several threads (see
+ * node::BlockFileScanner) before indexing them in order. This benchmark
+ * measures scanning a set of block files with a given number of threads.
+ */
+static void ScanBlockFiles(benchmark::Bench& bench, int threads)
+{
+    if (threads > GetNumCores()) return;
+
+    const auto testing_setup{MakeNoLogFileContext<const TestingSetup>(ChainType::MAIN)};
+    auto& chainman{*testing_setup->m_node.chainman};
+    constexpr int NUM_FILES{8};
+    constexpr size_t BLOCKS_PER_FILE{16};
+
+    DataStream ss{};
+    ss << chainman.GetParams().MessageStart();
+    ss << static_cast<uint32_t>(benchmark::data::block413567.size());
+    ss << std::span{benchmark::data::block413567};
+    for (int file_num{0}; file_num < NUM_FILES; ++file_num) {
+        // Written through the block manager, so that the files are obfuscated as blk*.dat files are.
+        AutoFile file{chainman.m_blockman.OpenBlockFile({file_num, 0}, /*fReadOnly=*/false)};
+        for (size_t i{0}; i < BLOCKS_PER_FILE; ++i) {
+            file << std::span{ss};
+        }
+        if (file.fclose() != 0) throw std::runtime_error("write to test file failed\n");
+    }
+
+    bench.batch(NUM_FILES).unit("file").run([&] {
+        node::BlockFileScanner scanner{chainman.m_blockman, chainman.GetParams().MessageStart(), NUM_FILES, threads, chainman.m_interrupt};
+        while (const auto blocks{scanner.Next()}) {
+            assert(blocks->size() == BLOCKS_PER_FILE);
+        }
+    });
+}
+
+static void ScanBlockFiles1Thread(benchmark::Bench& bench) { ScanBlockFiles(bench, 1); }
+static void ScanBlockFiles2Threads(benchmark::Bench& bench) { ScanBlockFiles(bench, 2); }
+static void ScanBlockFiles4Threads(benchmark::Bench& bench) { ScanBlockFiles(bench, 4); }
+static void ScanBlockFiles8Threads(benchmark::Bench& bench) { ScanBlockFiles(bench, 8); }
+
 BENCHMARK(LoadExternalBlockFile, benchmark::PriorityLevel::HIGH);
+BENCHMARK(ScanBlockFiles1Thread, benchmark::PriorityLevel::HIGH);
+BENCHMARK(ScanBlockFiles2Threads, benchmark::PriorityLevel::LOW);
+BENCHMARK(ScanBlockFiles4Threads, benchmark::PriorityLevel::LOW);
+BENCHMARK(ScanBlockFiles8Threads, benchmark::PriorityLevel::LOW);
@@ -0,0 +1,88 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <arith_uint256.h>
+#include <bench/bench.h>
+#include <chain.h>
+#include <consensus/params.h>
+#include <kernel/chainparams.h>
+#include <pow.h>
+#include <primitives/block.h>
+#include <uint256.h>
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace {
+/** A synthetic header chain with valid difficulty transitions. */
+struct HeaderChain {
+    std::vector<uint256> hashes;
+    std::vector<CBlockIndex> blocks;
+
+    HeaderChain(const Consensus::Params& params, int length, int64_t spacing, uint32_t genesis_bits)
+        : hashes(length), blocks(length)
+    {
+        for (int height{0}; height < length; ++height) {
+            CBlockIndex& block{blocks[height]};
+            hashes[height] = ArithToUint256(arith_uint256{uint64_t(height) + 1});
+            block.phashBlock = &hashes[height];
+            block.nHeight = height;
+            block.nTime = 1700000000 + height * spacing;
+            if (height == 0) {
+                block.nBits = genesis_bits;
+            } else {
+                block.pprev = &blocks[height - 1];
+                CBlockHeader header;
+                header.nTime = block.nTime;
+                block.nBits = GetNextWorkRequired(block.pprev, &header, params);
+            }
+            block.BuildSkip();
+        }
+    }
+
+    /** Check the difficulty of every header from height first on, as header validation does. */
+    void Validate(const Consensus::Params& params, int first) const
+    {
+        for (size_t height = first; height < blocks.size(); ++height) {
+            CBlockHeader header;
+            header.nTime = blocks[height].nTime;
+            const auto bits{GetNextWorkRequired(&blocks[height - 1], &header, params)};
+            assert(bits == blocks[height].nBits);
+        }
+    }
+};
+} // namespace
+
+/** Headers across the DRIP switch from 4032 to 1008 block retargets, arriving faster than the target spacing. */
+static void GetNextWorkRequiredDifficultyFork(benchmark::Bench& bench)
+{
+    const auto chain_params{CChainParams::Drip()};
+    const auto& params{chain_params->GetConsensus()};
+    assert(params.nDifficultyForkHeight > 0);
+    const int length{params.nDifficultyForkHeight + 4 * int(params.DifficultyAdjustmentIntervalAtHeight(params.nDifficultyForkHeight))};
+    const HeaderChain chain{params, length, params.nPowTargetSpacing / 2, UintToArith256(params.powLimit).GetCompact()};
+    const int first{params.nDifficultyForkHeight - int(params.DifficultyAdjustmentInterval())};
+
+    bench.batch(length - first).unit("header").run([&] {
+        chain.Validate(params, first);
+    });
+}
+
+/** A difficulty period of testnet min-difficulty headers, each of which looks back to the period start. */
+static void GetNextWorkRequiredMinDifficulty(benchmark::Bench& bench)
+{
+    const auto chain_params{CChainParams::TestNet()};
+    const auto& params{chain_params->GetConsensus()};
+    assert(params.fPowAllowMinDifficultyBlocks);
+    const int length{int(params.DifficultyAdjustmentInterval())};
+    const HeaderChain chain{params, length, params.nPowTargetSpacing, UintToArith256(params.powLimit).GetCompact()};
+
+    bench.batch(length - 1).unit("header").run([&] {
+        chain.Validate(params, 1);
+    });
+}
+
+BENCHMARK(GetNextWorkRequiredDifficultyFork, benchmark::PriorityLevel::HIGH);
+BENCHMARK(GetNextWorkRequiredMinDifficulty, benchmark::PriorityLevel::HIGH);
@@ -152,6 +152,11 @@ public:
     //! (memory only) Maximum nTime in the chain up to and including this block.
     unsigned int nTimeMax{0};
 
+    //! (memory only) nBits found by the min-difficulty walk from this block in
+    //! GetNextWorkRequired, or 0 if not known. Only accessed through
+    //! std::atomic_ref, as it is filled in from const block indexes.
+    mutable uint32_t m_min_difficulty_walk_bits{0};
+
     explicit CBlockIndex(const CBlockHeader& block)
         : nVersion{block.nVersion},
           hashMerkleRoot{block.hashMerkleRoot},
@@ -11,10 +11,29 @@
 #include <util/threadnames.h>
 
 #include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <deque>
 #include <iterator>
+#include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+/**
+ * A check that can leave part of its work to a batch, verified at once for
+ * all the checks that added to it. operator()(Batch&) may succeed on the
+ * assumption that the batch verifies; the check must then fail without the
+ * batch if it does not.
+ */
+template <typename T>
+concept BatchableCheck = requires(T check, typename T::Batch& batch) {
+    check(batch);
+    { std::as_const(batch).Verify() } -> std::same_as<bool>;
+};
+
 /**
  * Queue for verifications that have to be performed.
   * The verifications are represented by a type T, which must provide an
@@ -28,11 +47,31 @@
   * the master is done adding work, it temporarily joins the worker pool
   * as an N'th worker, until all jobs are done.
   *
+  * Every thread has its own deque of checks, which the master fills in
+  * turn. A thread takes chunks of checks from the back of its own deque and,
+  * once that is empty, steals from the front of the others. A chunk is half
+  * of the deque it is taken from, up to the batch size, so chunks are large
+  * while there is a lot of work and shrink towards the end of a block, when
+  * the last checks spread over all threads. Each deque has its own lock, so
+  * threads only contend when stealing, and idle threads are only woken when
+  * there are any.
+  *
+  * With batch verification enabled and a BatchableCheck T, each worker runs
+  * the checks it takes at once against a T::Batch and verifies that. Only if
+  * the batch fails are the checks run again one by one, to find the failure.
+  *
   */
 template <typename T, typename R = std::remove_cvref_t<decltype(std::declval<T>()().value())>>
 class CCheckQueue
 {
 private:
+    struct alignas(64) WorkQueue {
+        Mutex m_mutex;
+        std::deque<T> m_checks GUARDED_BY(m_mutex);
+        //! Size of m_checks, to skip an empty deque without locking it
+        std::atomic<size_t> m_size{0};
+    };
+
     //! Mutex to protect the inner state
     Mutex m_mutex;
 
@@ -42,114 +81,145 @@ private:
     //! Master thread blocks on this when out of work
     std::condition_variable m_master_cv;
 
-    //! The queue of elements to be processed.
-    //! As the order of booleans doesn't matter, it is used as a LIFO (stack)
-    std::vector<T> queue GUARDED_BY(m_mutex);
+    //! One deque of checks per worker thread, and the last one for the master.
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+
+    //! Deque that the next checks added go to. Only used by the thread adding checks.
+    size_t m_next_queue{0};
 
-    //! The number of workers (including the master) that are idle.
-    int nIdle GUARDED_BY(m_mutex){0};
+    //! Incremented whenever checks are added, so that idle workers notice.
+    std::atomic<uint64_t> m_epoch{0};
 
-    //! The total number of workers (including the master).
-    int nTotal GUARDED_BY(m_mutex){0};
+    //! The number of worker threads that are waiting for checks.
+    std::atomic<int> m_idle{0};
 
     //! The temporary evaluation result.
     std::optional<R> m_result GUARDED_BY(m_mutex);
 
+    //! Whether a check failed, so that the remaining ones need not run.
+    std::atomic<bool> m_failed{false};
+
     /**
      * Number of verifications that haven't completed yet.
      * This includes elements that are no longer queued, but still in the
      * worker's own batches.
      */
-    unsigned int nTodo GUARDED_BY(m_mutex){0};
+    std::atomic<size_t> m_todo{0};
 
     //! The maximum number of elements to be processed in one batch
     const unsigned int nBatchSize;
 
+    //! Whether to verify each batch of BatchableCheck checks at once
+    const bool m_batch_verify;
+
     std::vector<std::thread> m_worker_threads;
     bool m_request_stop GUARDED_BY(m_mutex){false};
 
-    /** Internal function that does bulk of the verification work. If fMaster, return the final result. */
-    std::optional<R> Loop(bool fMaster) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    /** Run a batch of checks, returning the first failure. */
+    std::optional<R> RunChecks(std::vector<T>& checks)
     {
-        std::condition_variable& cond = fMaster ? m_master_cv : m_worker_cv;
-        std::vector<T> vChecks;
-        vChecks.reserve(nBatchSize);
-        unsigned int nNow = 0;
-        std::optional<R> local_result;
-        bool do_work;
-        do {
-            {
-                WAIT_LOCK(m_mutex, lock);
-                // first do the clean-up of the previous loop run (allowing us to do it in the same critsect)
-                if (nNow) {
-                    if (local_result.has_value() && !m_result.has_value()) {
-                        std::swap(local_result, m_result);
-                    }
-                    nTodo -= nNow;
-                    if (nTodo == 0 && !fMaster) {
-                        // We processed the last element; inform the master it can exit and return the result
-                        m_master_cv.notify_one();
-                    }
-                } else {
-                    // first iteration
-                    nTotal++;
-                }
-                // logically, the do loop starts here
-                while (queue.empty() && !m_request_stop) {
-                    if (fMaster && nTodo == 0) {
-                        nTotal--;
-                        std::optional<R> to_return = std::move(m_result);
-                        // reset the status for new work later
-                        m_result = std::nullopt;
-                        // return the current status
-                        return to_return;
-                    }
-                    nIdle++;
-                    cond.wait(lock); // wait
-                    nIdle--;
+        if constexpr (BatchableCheck<T>) {
+            if (m_batch_verify) {
+                typename T::Batch batch;
+                for (T& check : checks) {
+                    if (auto result{check(batch)}) return result;
                 }
-                if (m_request_stop) {
-                    // return value does not matter, because m_request_stop is only set in the destructor.
-                    return std::nullopt;
-                }
-
-                // Decide how many work units to process now.
-                // * Do not try to do everything at once, but aim for increasingly smaller batches so
-                //   all workers finish approximately simultaneously.
-                // * Try to account for idle jobs which will instantly start helping.
-                // * Don't do batches smaller than 1 (duh), or larger than nBatchSize.
-                nNow = std::max(1U, std::min(nBatchSize, (unsigned int)queue.size() / (nTotal + nIdle + 1)));
-                auto start_it = queue.end() - nNow;
-                vChecks.assign(std::make_move_iterator(start_it), std::make_move_iterator(queue.end()));
-                queue.erase(start_it, queue.end());
-                // Check whether we need to do work at all
-                do_work = !m_result.has_value();
+                if (std::as_const(batch).Verify()) return std::nullopt;
             }
-            // execute work
-            if (do_work) {
-                for (T& check : vChecks) {
-                    local_result = check();
-                    if (local_result.has_value()) break;
-                }
+        }
+        for (T& check : checks) {
+            if (auto result{check()}) return result;
+        }
+        return std::nullopt;
+    }
+
+    /** Move a chunk of checks out of queue into checks, from its back if it is the caller's own. */
+    bool TakeFrom(WorkQueue& queue, std::vector<T>& checks, bool own) EXCLUSIVE_LOCKS_REQUIRED(!queue.m_mutex)
+    {
+        if (queue.m_size.load(std::memory_order_relaxed) == 0) return false;
+        LOCK(queue.m_mutex);
+        const size_t size{queue.m_checks.size()};
+        if (size == 0) return false;
+        const size_t n{std::clamp<size_t>(size / 2, 1, nBatchSize)};
+        if (own) {
+            const auto start_it{queue.m_checks.end() - n};
+            checks.assign(std::make_move_iterator(start_it), std::make_move_iterator(queue.m_checks.end()));
+            queue.m_checks.erase(start_it, queue.m_checks.end());
+        } else {
+            const auto end_it{queue.m_checks.begin() + n};
+            checks.assign(std::make_move_iterator(queue.m_checks.begin()), std::make_move_iterator(end_it));
+            queue.m_checks.erase(queue.m_checks.begin(), end_it);
+        }
+        queue.m_size.store(size - n, std::memory_order_relaxed);
+        return true;
+    }
+
+    /** Take a chunk of checks for the thread owning deque index, stealing if its own is empty. */
+    bool TakeWork(size_t index, std::vector<T>& checks)
+    {
+        if (TakeFrom(*m_queues[index], checks, /*own=*/true)) return true;
+        for (size_t i{1}; i < m_queues.size(); ++i) {
+            if (TakeFrom(*m_queues[(index + i) % m_queues.size()], checks, /*own=*/false)) return true;
+        }
+        return false;
+    }
+
+    /** Run (unless a check failed already) and destroy a chunk of checks, then count them as done. */
+    void ProcessChecks(std::vector<T>& checks) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        std::optional<R> result;
+        if (!m_failed.load(std::memory_order_relaxed)) result = RunChecks(checks);
+        const size_t n{checks.size()};
+        checks.clear();
+        if (result.has_value()) {
+            LOCK(m_mutex);
+            if (!m_result.has_value()) m_result = std::move(result);
+            m_failed.store(true, std::memory_order_relaxed);
+        }
+        if (m_todo.fetch_sub(n) == n) {
+            // We processed the last element; inform the master it can exit and return the result
+            LOCK(m_mutex);
+            m_master_cv.notify_one();
+        }
+    }
+
+    /** Worker thread owning deque index. */
+    void WorkerLoop(size_t index) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        std::vector<T> checks;
+        checks.reserve(nBatchSize);
+        while (true) {
+            const uint64_t epoch{m_epoch.load()};
+            if (TakeWork(index, checks)) {
+                ProcessChecks(checks);
+                continue;
             }
-            vChecks.clear();
-        } while (true);
+            WAIT_LOCK(m_mutex, lock);
+            m_idle.fetch_add(1);
+            m_worker_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_request_stop || m_epoch.load() != epoch; });
+            m_idle.fetch_sub(1);
+            if (m_request_stop) return;
+        }
     }
 
 public:
     //! Mutex to ensure only one concurrent CCheckQueueControl
     Mutex m_control_mutex;
 
-    //! Create a new check queue
-    explicit CCheckQueue(unsigned int batch_size, int worker_threads_num)
-        : nBatchSize(batch_size)
+    //! Create a new check queue, whose workers are named thread_name.N
+    explicit CCheckQueue(unsigned int batch_size, int worker_threads_num, std::string_view description = "Script verification", std::string_view thread_name = "scriptch", bool batch_verify = false)
+        : nBatchSize(batch_size), m_batch_verify(batch_verify)
     {
-        LogInfo("Script verification uses %d additional threads", worker_threads_num);
+        LogInfo("%s uses %d additional threads", description, worker_threads_num);
+        m_queues.reserve(worker_threads_num + 1);
+        for (int n = 0; n <= worker_threads_num; ++n) {
+            m_queues.push_back(std::make_unique<WorkQueue>());
+        }
         m_worker_threads.reserve(worker_threads_num);
         for (int n = 0; n < worker_threads_num; ++n) {
-            m_worker_threads.emplace_back([this, n]() {
-                util::ThreadRename(strprintf("scriptch.%i", n));
-                Loop(false /* worker thread */);
+            m_worker_threads.emplace_back([this, n, thread_name = std::string{thread_name}]() {
+                util::ThreadRename(strprintf("%s.%i", thread_name, n));
+                WorkerLoop(n);
             });
         }
     }
@@ -165,7 +235,19 @@ public:
     //! its error.
     std::optional<R> Complete() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
     {
-        return Loop(true /* master thread */);
+        std::vector<T> checks;
+        checks.reserve(nBatchSize);
+        while (TakeWork(m_queues.size() - 1, checks)) {
+            ProcessChecks(checks);
+        }
+        // Nothing is queued any more; wait for the checks that workers are still running.
+        WAIT_LOCK(m_mutex, lock);
+        m_master_cv.wait(lock, [&] { return m_todo.load() == 0; });
+        std::optional<R> to_return = std::move(m_result);
+        // reset the status for new work later
+        m_result = std::nullopt;
+        m_failed.store(false, std::memory_order_relaxed);
+        return to_return;
     }
 
     //! Add a batch of checks to the queue
@@ -175,16 +257,27 @@ public:
             return;
         }
 
-        {
-            LOCK(m_mutex);
-            queue.insert(queue.end(), std::make_move_iterator(vChecks.begin()), std::make_move_iterator(vChecks.end()));
-            nTodo += vChecks.size();
+        m_todo.fetch_add(vChecks.size());
+        // Spread large batches over the deques, in chunks of up to the batch size.
+        const size_t chunk{std::clamp<size_t>((vChecks.size() + m_queues.size() - 1) / m_queues.size(), 1, nBatchSize)};
+        for (auto it{vChecks.begin()}; it != vChecks.end();) {
+            const auto end{it + std::min<size_t>(chunk, vChecks.end() - it)};
+            WorkQueue& queue{*m_queues[m_next_queue]};
+            m_next_queue = (m_next_queue + 1) % m_queues.size();
+            LOCK(queue.m_mutex);
+            queue.m_checks.insert(queue.m_checks.end(), std::make_move_iterator(it), std::make_move_iterator(end));
+            queue.m_size.store(queue.m_checks.size(), std::memory_order_relaxed);
+            it = end;
         }
 
-        if (vChecks.size() == 1) {
-            m_worker_cv.notify_one();
-        } else {
-            m_worker_cv.notify_all();
+        m_epoch.fetch_add(1);
+        if (m_idle.load() > 0) {
+            LOCK(m_mutex);
+            if (vChecks.size() == 1) {
+                m_worker_cv.notify_one();
+            } else {
+                m_worker_cv.notify_all();
+            }
         }
     }
 
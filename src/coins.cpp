@@ -7,6 +7,7 @@
 #include <consensus/consensus.h>
 #include <logging.h>
 #include <random.h>
+#include <util/check.h>
 #include <util/trace.h>
 
 TRACEPOINT_SEMAPHORE(utxocache, add);
@@ -24,6 +25,12 @@ bool CCoinsView::HaveCoin(const COutPoint &outpoint) const
     return GetCoin(outpoint).has_value();
 }
 
+void CCoinsView::GetCoins(std::span<const COutPoint> outpoints, std::span<std::optional<Coin>> coins) const
+{
+    assert(outpoints.size() == coins.size());
+    for (size_t i{0}; i < outpoints.size(); ++i) coins[i] = GetCoin(outpoints[i]);
+}
+
 CCoinsViewBacked::CCoinsViewBacked(CCoinsView *viewIn) : base(viewIn) { }
 std::optional<Coin> CCoinsViewBacked::GetCoin(const COutPoint& outpoint) const { return base->GetCoin(outpoint); }
 bool CCoinsViewBacked::HaveCoin(const COutPoint &outpoint) const { return base->HaveCoin(outpoint); }
@@ -45,6 +52,10 @@ size_t CCoinsViewCache::DynamicMemoryUsage() const {
     return memusage::DynamicUsage(cacheCoins) + cachedCoinsUsage;
 }
 
+size_t CCoinsViewCache::InUseMemoryUsage() const {
+    return DynamicMemoryUsage() - m_cache_coins_memory_resource.FreeListBytes();
+}
+
 CCoinsMap::iterator CCoinsViewCache::FetchCoin(const COutPoint &outpoint) const {
     const auto [ret, inserted] = cacheCoins.try_emplace(outpoint);
     if (inserted) {
@@ -59,6 +70,8 @@ CCoinsMap::iterator CCoinsViewCache::FetchCoin(const COutPoint &outpoint) const
             cacheCoins.erase(ret);
             return cacheCoins.end();
         }
+    } else {
+        ret->second.SetReferenced();
     }
     return ret;
 }
@@ -119,6 +132,15 @@ void CCoinsViewCache::EmplaceCoinInternalDANGER(COutPoint&& outpoint, Coin&& coi
     }
 }
 
+void CCoinsViewCache::AddFetchedCoin(const COutPoint& outpoint, Coin&& coin)
+{
+    Assume(!coin.IsSpent());
+    const auto [it, inserted]{cacheCoins.try_emplace(outpoint)};
+    if (!inserted) return;
+    it->second.coin = std::move(coin);
+    cachedCoinsUsage += it->second.coin.DynamicMemoryUsage();
+}
+
 void AddCoins(CCoinsViewCache& cache, const CTransaction &tx, int nHeight, bool check_for_overwrite) {
     bool fCoinbase = tx.IsCoinBase();
     const Txid& txid = tx.GetHash();
@@ -258,6 +280,7 @@ bool CCoinsViewCache::Flush(bool will_reuse_cache) {
             ReallocateCache();
         }
         cachedCoinsUsage = 0;
+        m_clock_hand = 0;
     }
     return fOk;
 }
@@ -290,6 +313,24 @@ void CCoinsViewCache::Uncache(const COutPoint& hash)
     }
 }
 
+size_t CCoinsViewCache::EvictClean(size_t target_usage)
+{
+    size_t evicted{0};
+    size_t usage{InUseMemoryUsage()};
+    // Two rounds are enough to clear every referenced bit and then reach the entries again.
+    for (size_t steps{2 * cacheCoins.size()}; usage > target_usage && steps > 0 && !cacheCoins.empty(); --steps) {
+        auto it{cacheCoins.begin_at(m_clock_hand)};
+        if (it == cacheCoins.end()) it = cacheCoins.begin();
+        m_clock_hand = cacheCoins.slot(it) + 1;
+        if (it->second.IsDirty() || it->second.IsFresh() || it->second.ClearReferenced()) continue;
+        cachedCoinsUsage -= it->second.coin.DynamicMemoryUsage();
+        cacheCoins.erase(it);
+        ++evicted;
+        usage = InUseMemoryUsage();
+    }
+    return evicted;
+}
+
 unsigned int CCoinsViewCache::GetCacheSize() const {
     return cacheCoins.size();
 }
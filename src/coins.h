@@ -14,13 +14,18 @@
 #include <support/allocators/pool.h>
 #include <uint256.h>
 #include <util/check.h>
+#include <util/flatnodemap.h>
 #include <util/hasher.h>
 
 #include <cassert>
 #include <cstdint>
 
 #include <functional>
+#include <optional>
+#include <span>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 /**
  * A UTXO entry.
@@ -127,6 +132,8 @@ private:
     CoinsCachePair* m_prev{nullptr};
     CoinsCachePair* m_next{nullptr};
     uint8_t m_flags{0};
+    //! Whether the entry was used since the eviction clock last passed it, see CCoinsViewCache::EvictClean
+    bool m_referenced{true};
 
     //! Adding a flag requires a reference to the sentinel of the flagged pair linked list.
     static void AddFlags(uint8_t flags, CoinsCachePair& pair, CoinsCachePair& sentinel) noexcept
@@ -188,6 +195,10 @@ public:
     bool IsDirty() const noexcept { return m_flags & DIRTY; }
     bool IsFresh() const noexcept { return m_flags & FRESH; }
 
+    void SetReferenced() noexcept { m_referenced = true; }
+    //! Clear the referenced bit, returning whether it was set
+    bool ClearReferenced() noexcept { return std::exchange(m_referenced, false); }
+
     //! Only call Next when this entry is DIRTY, FRESH, or both
     CoinsCachePair* Next() const noexcept
     {
@@ -214,19 +225,16 @@ public:
 };
 
 /**
- * PoolAllocator's MAX_BLOCK_SIZE_BYTES parameter here uses sizeof the data, and adds the size
- * of 4 pointers. We do not know the exact node size used in the std::unordered_node implementation
- * because it is implementation defined. Most implementations have an overhead of 1 or 2 pointers,
- * so nodes can be connected in a linked list, and in some cases the hash value is stored as well.
- * Using an additional sizeof(void*)*4 for MAX_BLOCK_SIZE_BYTES should thus be sufficient so that
- * all implementations can allocate the nodes from the PoolAllocator.
+ * The coins cache map. FlatNodeMap keeps its open-addressing index apart from
+ * the entries, so each entry is allocated from the PoolAllocator on its own,
+ * as exactly one CoinsCachePair with no chain pointer, and stays in place for
+ * the flagged entry linked list.
  */
-using CCoinsMap = std::unordered_map<COutPoint,
-                                     CCoinsCacheEntry,
-                                     SaltedOutpointHasher,
-                                     std::equal_to<COutPoint>,
-                                     PoolAllocator<CoinsCachePair,
-                                                   sizeof(CoinsCachePair) + sizeof(void*) * 4>>;
+using CCoinsMap = FlatNodeMap<COutPoint,
+                              CCoinsCacheEntry,
+                              SaltedOutpointHasher,
+                              std::equal_to<COutPoint>,
+                              PoolAllocator<CoinsCachePair, sizeof(CoinsCachePair)>>;
 
 using CCoinsMapMemoryResource = CCoinsMap::allocator_type::ResourceType;
 
@@ -310,6 +318,10 @@ public:
     //! Retrieve the Coin (unspent transaction output) for a given outpoint.
     virtual std::optional<Coin> GetCoin(const COutPoint& outpoint) const;
 
+    //! Retrieve the Coins for several outpoints into the matching slots of coins, as GetCoin() would.
+    //! Views that read from disk override this to read them together.
+    virtual void GetCoins(std::span<const COutPoint> outpoints, std::span<std::optional<Coin>> coins) const;
+
     //! Just check whether a given outpoint is unspent.
     virtual bool HaveCoin(const COutPoint &outpoint) const;
 
@@ -376,6 +388,9 @@ protected:
     /* Cached dynamic memory usage for the inner Coin objects. */
     mutable size_t cachedCoinsUsage{0};
 
+    /* Index slot of cacheCoins where EvictClean resumes. */
+    size_t m_clock_hand{0};
+
 public:
     CCoinsViewCache(CCoinsView *baseIn, bool deterministic = false);
 
@@ -428,6 +443,13 @@ public:
      */
     void EmplaceCoinInternalDANGER(COutPoint&& outpoint, Coin&& coin);
 
+    /**
+     * Add an unspent coin that was read from the backing view ahead of use,
+     * as a cache miss would. It is not marked dirty. Does nothing if the
+     * outpoint is already cached, so that newer state is never overwritten.
+     */
+    void AddFetchedCoin(const COutPoint& outpoint, Coin&& coin);
+
     /**
      * Spend a coin. Pass moveto in order to get the deleted data.
      * If no unspent output exists for the passed outpoint, this call
@@ -466,6 +488,30 @@ public:
     //! Calculate the size of the cache (in bytes)
     size_t DynamicMemoryUsage() const;
 
+    /**
+     * Calculate the size of the cache (in bytes) less the memory of erased
+     * entries that the cache holds on to for new ones. This is what the
+     * entries actually use, while DynamicMemoryUsage() only grows until the
+     * cache is flushed.
+     */
+    size_t InUseMemoryUsage() const;
+
+    /**
+     * Erase unmodified entries until InUseMemoryUsage() is at most
+     * target_usage, or no unmodified entries are left.
+     *
+     * Entries are picked with the CLOCK approximation of least recently
+     * used: a hand sweeps over the entries, clearing the referenced bit
+     * that a lookup sets and evicting the entries whose bit was already
+     * clear. Coins that were used since the hand last passed survive.
+     *
+     * Calling Sync() first makes all entries unmodified, so that this can
+     * keep the cache within its budget without wiping it as Flush() does.
+     *
+     * @returns the number of entries evicted
+     */
+    size_t EvictClean(size_t target_usage);
+
     //! Check whether all prevouts of the transaction are present in the UTXO set represented by this view
     bool HaveInputs(const CTransaction& tx) const;
 
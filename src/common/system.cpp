@@ -29,11 +29,15 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <fstream>
 #include <locale>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <utility>
+#include <vector>
 
 using util::ReplaceAll;
 
@@ -130,6 +134,93 @@ std::optional<size_t> GetTotalRAM()
     return std::nullopt;
 }
 
+#ifdef __linux__
+namespace {
+//! Read the number a file starts with. A cgroup limit of "max" (none) reads as nothing.
+std::optional<uint64_t> ReadNumberFile(const std::string& path)
+{
+    std::ifstream file{path};
+    if (uint64_t value; file >> value) return value;
+    return std::nullopt;
+}
+
+//! Read a "<key>: <n> kB" line of /proc/meminfo, in bytes.
+std::optional<uint64_t> ReadMeminfo(std::string_view key)
+{
+    std::ifstream file{"/proc/meminfo"};
+    std::string name, unit;
+    for (uint64_t value; file >> name >> value;) {
+        std::getline(file, unit);
+        if (name.size() == key.size() + 1 && name.starts_with(key) && name.back() == ':') return value * 1024;
+    }
+    return std::nullopt;
+}
+
+//! Path of the cgroup this process is in, for controller ("" for the cgroup v2 hierarchy), from /proc/self/cgroup.
+std::string GetCgroupPath(std::string_view controller)
+{
+    std::ifstream file{"/proc/self/cgroup"};
+    for (std::string line; std::getline(file, line);) {
+        // hierarchy-ID:controller-list:cgroup-path
+        const auto first{line.find(':')}, second{line.find(':', first + 1)};
+        if (first == std::string::npos || second == std::string::npos) continue;
+        const std::string_view controllers{std::string_view{line}.substr(first + 1, second - first - 1)};
+        if (controller.empty() ? line.starts_with("0::") : std::ranges::count(util::SplitString(controllers, ','), controller) > 0) {
+            return line.substr(second + 1);
+        }
+    }
+    return "";
+}
+
+//! Memory limit and usage of every cgroup of this process with a limit.
+//! Limits of the parent cgroups apply too, so the hierarchy is walked up from
+//! the cgroup of this process to the root of the mount. Within a container
+//! that root is usually the cgroup of the container itself.
+std::vector<std::pair<uint64_t, uint64_t>> GetCgroupMemory()
+{
+    std::vector<std::pair<uint64_t, uint64_t>> cgroups;
+    const auto walk{[&](const std::string& root, const std::string& path, const std::string& limit_file, const std::string& usage_file) {
+        for (std::string dir{root + path};; dir.resize(dir.rfind('/'))) {
+            const auto limit{ReadNumberFile(dir + "/" + limit_file)};
+            const auto usage{ReadNumberFile(dir + "/" + usage_file)};
+            // cgroup v1 reports no limit as a very large one.
+            if (limit && usage && *limit < (uint64_t{1} << 62)) cgroups.emplace_back(*limit, *usage);
+            if (dir.size() <= root.size()) break;
+        }
+    }};
+    walk("/sys/fs/cgroup", GetCgroupPath(""), "memory.max", "memory.current");
+    if (cgroups.empty()) walk("/sys/fs/cgroup/memory", GetCgroupPath("memory"), "memory.limit_in_bytes", "memory.usage_in_bytes");
+    return cgroups;
+}
+} // namespace
+#endif
+
+std::optional<size_t> GetAvailableRAM()
+{
+    [[maybe_unused]] auto clamp{[](uint64_t v) { return size_t(std::min(v, uint64_t{std::numeric_limits<size_t>::max()})); }};
+#ifdef WIN32
+    if (MEMORYSTATUSEX m{}; (m.dwLength = sizeof(m), GlobalMemoryStatusEx(&m))) return clamp(m.ullAvailPhys);
+#elif defined(__linux__)
+    auto available{ReadMeminfo("MemAvailable")};
+    for (const auto& [limit, usage] : GetCgroupMemory()) {
+        const uint64_t headroom{limit > usage ? limit - usage : 0};
+        available = std::min(available.value_or(headroom), headroom);
+    }
+    if (available) return clamp(*available);
+#endif
+    return std::nullopt;
+}
+
+std::optional<size_t> GetCgroupMemoryLimit()
+{
+#ifdef __linux__
+    std::optional<uint64_t> min_limit;
+    for (const auto& [limit, usage] : GetCgroupMemory()) min_limit = std::min(min_limit.value_or(limit), limit);
+    if (min_limit) return size_t(std::min(*min_limit, uint64_t{std::numeric_limits<size_t>::max()}));
+#endif
+    return std::nullopt;
+}
+
 // Obtain the application startup time (used for uptime calculation)
 int64_t GetStartupTime()
 {
@@ -35,4 +35,18 @@ int GetNumCores();
  */
 std::optional<size_t> GetTotalRAM();
 
+/**
+ * Return the RAM currently available to this process without swapping, if
+ * detectable. On Linux, if the process runs under a cgroup memory limit (as
+ * in a container), this is at most what is left under the limit, or under the
+ * tightest limit of its parent cgroups.
+ */
+std::optional<size_t> GetAvailableRAM();
+
+/**
+ * Return the lowest cgroup memory limit this process runs under, of its own
+ * cgroup and the parent ones, if any (Linux only).
+ */
+std::optional<size_t> GetCgroupMemoryLimit();
+
 #endif // BITCOIN_COMMON_SYSTEM_H
@@ -33,4 +33,15 @@ uint256 BlockWitnessMerkleRoot(const CBlock& block);
  */
 std::vector<uint256> TransactionMerklePath(const CBlock& block, uint32_t position);
 
+/**
+ * Compute the Merkle root from a leaf and its merkle path
+ *
+ * @param[in] leaf the hash of the transaction at position
+ * @param[in] path merkle path ordered from the deepest, as returned by TransactionMerklePath()
+ * @param[in] position position of the transaction in the block
+ *
+ * @return the Merkle root, computed with one hash per level of the tree
+ */
+uint256 ComputeMerkleRootFromBranch(const uint256& leaf, const std::vector<uint256>& path, uint32_t position);
+
 #endif // BITCOIN_CONSENSUS_MERKLE_H
@@ -32,11 +32,13 @@ void Transform(uint32_t* s, const unsigned char* chunk, size_t blocks);
 namespace sha256d64_sse41
 {
 void Transform_4way(unsigned char* out, const unsigned char* in);
+void Transform_4way_D80(unsigned char* out, const uint32_t* midstate, const unsigned char* in);
 }
 
 namespace sha256d64_avx2
 {
 void Transform_8way(unsigned char* out, const unsigned char* in);
+void Transform_8way_D80(unsigned char* out, const uint32_t* midstate, const unsigned char* in);
 }
 
 namespace sha256d64_x86_shani
@@ -437,6 +439,7 @@ void TransformD64(unsigned char* out, const unsigned char* in)
 
 typedef void (*TransformType)(uint32_t*, const unsigned char*, size_t);
 typedef void (*TransformD64Type)(unsigned char*, const unsigned char*);
+typedef void (*TransformD80Type)(unsigned char*, const uint32_t*, const unsigned char*);
 
 template<TransformType tr>
 void TransformD64Wrapper(unsigned char* out, const unsigned char* in)
@@ -482,6 +485,34 @@ TransformD64Type TransformD64 = sha256::TransformD64;
 TransformD64Type TransformD64_2way = nullptr;
 TransformD64Type TransformD64_4way = nullptr;
 TransformD64Type TransformD64_8way = nullptr;
+TransformD80Type TransformD80_4way = nullptr;
+TransformD80Type TransformD80_8way = nullptr;
+
+/** Double-SHA256 of an 80-byte message, given the midstate of its first 64 bytes
+ *  and its last 16 bytes. Uses the best available single-way Transform. */
+void TransformD80(unsigned char* out, const uint32_t* midstate, const unsigned char* in)
+{
+    uint32_t s[8];
+    unsigned char buffer1[64] = {
+        0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0x80
+    };
+    unsigned char buffer2[64] = {
+        0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0
+    };
+    std::copy(in, in + 16, buffer1);
+    std::copy(midstate, midstate + 8, s);
+    Transform(s, buffer1, 1);
+    for (int i = 0; i < 8; ++i) WriteBE32(buffer2 + 4 * i, s[i]);
+    sha256::Initialize(s);
+    Transform(s, buffer2, 1);
+    for (int i = 0; i < 8; ++i) WriteBE32(out + 4 * i, s[i]);
+}
 
 bool SelfTest() {
     // Input state (equal to the initial SHA256 state)
@@ -565,6 +596,35 @@ bool SelfTest() {
         if (!std::equal(out, out + 256, result_d64)) return false;
     }
 
+    // Test TransformD80 against hashing the full 80-byte messages: the first
+    // 64 input bytes followed by each of the next 8 16-byte tails.
+    uint32_t midstate[8];
+    std::copy(init, init + 8, midstate);
+    Transform(midstate, data + 1, 1);
+    if (!std::equal(midstate, midstate + 8, result[1])) return false;
+    unsigned char result_d80[256];
+    for (size_t i = 0; i < 8; ++i) {
+        unsigned char hash[32];
+        CSHA256().Write(data + 1, 64).Write(data + 65 + 16 * i, 16).Finalize(hash);
+        CSHA256().Write(hash, 32).Finalize(result_d80 + 32 * i);
+        TransformD80(out, midstate, data + 65 + 16 * i);
+        if (!std::equal(out, out + 32, result_d80 + 32 * i)) return false;
+    }
+
+    // Test TransformD80_4way, if available.
+    if (TransformD80_4way) {
+        unsigned char out[128];
+        TransformD80_4way(out, midstate, data + 65);
+        if (!std::equal(out, out + 128, result_d80)) return false;
+    }
+
+    // Test TransformD80_8way, if available.
+    if (TransformD80_8way) {
+        unsigned char out[256];
+        TransformD80_8way(out, midstate, data + 65);
+        if (!std::equal(out, out + 256, result_d80)) return false;
+    }
+
     return true;
 }
 
@@ -590,6 +650,8 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
     TransformD64_2way = nullptr;
     TransformD64_4way = nullptr;
     TransformD64_8way = nullptr;
+    TransformD80_4way = nullptr;
+    TransformD80_8way = nullptr;
 
 #if !defined(DISABLE_OPTIMIZED_SHA256)
 #if defined(HAVE_GETCPUID)
@@ -639,6 +701,7 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
 #endif
 #if defined(ENABLE_SSE41)
         TransformD64_4way = sha256d64_sse41::Transform_4way;
+        TransformD80_4way = sha256d64_sse41::Transform_4way_D80;
         ret += ";sse41(4way)";
 #endif
     }
@@ -646,6 +709,7 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
 #if defined(ENABLE_AVX2)
     if (have_avx2 && have_avx && enabled_avx) {
         TransformD64_8way = sha256d64_avx2::Transform_8way;
+        TransformD80_8way = sha256d64_avx2::Transform_8way_D80;
         ret += ";avx2(8way)";
     }
 #endif
@@ -779,3 +843,35 @@ void SHA256D64(unsigned char* out, const unsigned char* in, size_t blocks)
         --blocks;
     }
 }
+
+void SHA256Midstate(uint32_t* midstate, const unsigned char* in)
+{
+    sha256::Initialize(midstate);
+    Transform(midstate, in, 1);
+}
+
+void SHA256D80Midstate(unsigned char* out, const uint32_t* midstate, const unsigned char* in, size_t blocks)
+{
+    if (TransformD80_8way) {
+        while (blocks >= 8) {
+            TransformD80_8way(out, midstate, in);
+            out += 256;
+            in += 128;
+            blocks -= 8;
+        }
+    }
+    if (TransformD80_4way) {
+        while (blocks >= 4) {
+            TransformD80_4way(out, midstate, in);
+            out += 128;
+            in += 64;
+            blocks -= 4;
+        }
+    }
+    while (blocks) {
+        TransformD80(out, midstate, in);
+        out += 32;
+        in += 16;
+        --blocks;
+    }
+}
@@ -50,4 +50,19 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
  */
 void SHA256D64(unsigned char* output, const unsigned char* input, size_t blocks);
 
+/** Compute the SHA-256 midstate of a single 64-byte chunk.
+ *  midstate: pointer to an 8-word output state
+ *  input:    pointer to a 64 byte input buffer
+ */
+void SHA256Midstate(uint32_t* midstate, const unsigned char* input);
+
+/** Compute multiple double-SHA256's of 80-byte messages (block headers) that
+ *  share their first 64 bytes, starting from the midstate of those bytes.
+ *  output:   pointer to a blocks*32 byte output buffer
+ *  midstate: the SHA256Midstate() of the shared first 64 bytes
+ *  input:    pointer to a blocks*16 byte buffer holding the last 16 bytes of each message
+ *  blocks:   the number of hashes to compute.
+ */
+void SHA256D80Midstate(unsigned char* output, const uint32_t* midstate, const unsigned char* input, size_t blocks);
+
 #endif // BITCOIN_CRYPTO_SHA256_H
@@ -171,6 +171,19 @@ private:
      * garbage collection to be allowed to occur from const methods */
     mutable bit_packed_atomic_flags collection_flags;
 
+    /** unpinned_flags is set for every element except those inserted pinned.
+     * A pinned element is not marked for erasure when its epoch ages, only
+     * when contains() is called for it with erase set, or once it has been
+     * in the old epoch for MAX_PINNED_EPOCHS epochs. It may still be evicted
+     * by an insert that runs out of depth. Mutable because contains() unpins.
+     */
+    mutable bit_packed_atomic_flags unpinned_flags;
+
+    /** pinned_epochs counts the epochs a pinned element has aged through
+     * while in the old epoch. Only read and written by insert().
+     */
+    std::vector<uint8_t> pinned_epochs;
+
     /** epoch_flags tracks how recently an element was inserted into
      * the cache. true denotes recent, false denotes not-recent. See insert()
      * method for full semantics.
@@ -274,14 +287,24 @@ private:
         collection_flags.bit_unset(n);
     }
 
+    inline void set_unpinned(uint32_t n, bool unpinned)
+    {
+        if (unpinned) {
+            unpinned_flags.bit_set(n);
+        } else {
+            unpinned_flags.bit_unset(n);
+        }
+    }
+
     /** epoch_check handles the changing of epochs for elements stored in the
      * cache. epoch_check should be run before every insert.
      *
      * First, epoch_check decrements and checks the cheap heuristic, and then does
      * a more expensive scan if the cheap heuristic runs out. If the expensive
-     * scan succeeds, the epochs are aged and old elements are allow_erased. The
-     * cheap heuristic is reset to retrigger after the worst case growth of the
-     * current epoch's elements would exceed the epoch_size.
+     * scan succeeds, the epochs are aged and old elements are allow_erased,
+     * except pinned ones that have not yet been old for MAX_PINNED_EPOCHS
+     * epochs. The cheap heuristic is reset to retrigger after the worst case
+     * growth of the current epoch's elements would exceed the epoch_size.
      */
     void epoch_check()
     {
@@ -303,8 +326,12 @@ private:
             for (uint32_t i = 0; i < size; ++i)
                 if (epoch_flags[i])
                     epoch_flags[i] = false;
-                else
+                else if (unpinned_flags.bit_is_set(i))
+                    allow_erase(i);
+                else if (++pinned_epochs[i] >= MAX_PINNED_EPOCHS) {
+                    unpinned_flags.bit_set(i);
                     allow_erase(i);
+                }
             epoch_heuristic_counter = epoch_size;
         } else
             // reset the epoch_heuristic_counter to next do a scan when worst
@@ -318,17 +345,26 @@ private:
     }
 
 public:
+    /** Number of epochs a pinned element is kept in the old epoch before it
+     * is unpinned, so that elements which are never looked up with erase set
+     * (e.g. for transactions that leave the mempool without being mined) do
+     * not stay in the cache forever.
+     */
+    static constexpr uint8_t MAX_PINNED_EPOCHS{16};
+
     /** You must always construct a cache with some elements via a subsequent
      * call to setup or setup_bytes, otherwise operations may segfault.
      */
-    cache() : table(), collection_flags(0), epoch_flags(), hash_function()
+    cache() : table(), collection_flags(0), unpinned_flags(0), pinned_epochs(), epoch_flags(), hash_function()
     {
     }
 
     /** setup initializes the container to store no more than new_size
      * elements and no less than 2 elements.
      *
-     * setup should only be called once.
+     * setup may be called again to resize the cache, which drops all
+     * elements stored in it. It must not run concurrently with any other
+     * method.
      *
      * @param new_size the desired number of elements to store
      * @returns the maximum number of elements storable
@@ -338,9 +374,13 @@ public:
         // depth_limit must be at least one otherwise errors can occur.
         size = std::max<uint32_t>(2, new_size);
         depth_limit = static_cast<uint8_t>(std::log2(static_cast<float>(size)));
-        table.resize(size);
+        // Replace rather than resize the vectors, so that shrinking the cache
+        // releases their memory.
+        std::vector<Element>(size).swap(table);
         collection_flags.setup(size);
-        epoch_flags.resize(size);
+        unpinned_flags.setup(size);
+        std::vector<uint8_t>(size).swap(pinned_epochs);
+        std::vector<bool>(size).swap(epoch_flags);
         // Set to 45% as described above
         epoch_size = std::max(uint32_t{1}, (45 * size) / 100);
         // Initially set to wait for a whole epoch
@@ -390,15 +430,21 @@ public:
      * is not guaranteed to return true.
      *
      * @param e the element to insert
+     * @param pin whether to keep e until contains() is called for it with
+     * erase set, rather than letting it age out with its epoch (but no
+     * longer than MAX_PINNED_EPOCHS epochs)
      * @post one of the following: All previously inserted elements and e are
      * now in the table, one previously inserted element is evicted from the
      * table, the entry attempted to be inserted is evicted.
+     * @returns false if an element was evicted
      */
-    inline void insert(Element e)
+    inline bool insert(Element e, bool pin = false)
     {
         epoch_check();
         uint32_t last_loc = invalid();
         bool last_epoch = true;
+        bool last_unpinned = !pin;
+        uint8_t last_pinned_epochs = 0;
         std::array<uint32_t, 8> locs = compute_hashes(e);
         // Make sure we have not already inserted this element
         // If we have, make sure that it does not get deleted
@@ -406,7 +452,11 @@ public:
             if (table[loc] == e) {
                 please_keep(loc);
                 epoch_flags[loc] = last_epoch;
-                return;
+                if (pin) {
+                    unpinned_flags.bit_unset(loc);
+                    pinned_epochs[loc] = 0;
+                }
+                return true;
             }
         for (uint8_t depth = 0; depth < depth_limit; ++depth) {
             // First try to insert to an empty slot, if one exists
@@ -416,7 +466,9 @@ public:
                 table[loc] = std::move(e);
                 please_keep(loc);
                 epoch_flags[loc] = last_epoch;
-                return;
+                set_unpinned(loc, last_unpinned);
+                pinned_epochs[loc] = last_pinned_epochs;
+                return true;
             }
             /** Swap with the element at the location that was
             * not the last one looked at. Example:
@@ -438,10 +490,15 @@ public:
             bool epoch = last_epoch;
             last_epoch = epoch_flags[last_loc];
             epoch_flags[last_loc] = epoch;
+            const bool unpinned = last_unpinned;
+            last_unpinned = unpinned_flags.bit_is_set(last_loc);
+            set_unpinned(last_loc, unpinned);
+            std::swap(pinned_epochs[last_loc], last_pinned_epochs);
 
             // Recompute the locs -- unfortunately happens one too many times!
             locs = compute_hashes(e);
         }
+        return false;
     }
 
     /** contains iterates through the hash locations for a given element
@@ -476,8 +533,10 @@ public:
         std::array<uint32_t, 8> locs = compute_hashes(e);
         for (const uint32_t loc : locs)
             if (table[loc] == e) {
-                if (erase)
+                if (erase) {
                     allow_erase(loc);
+                    unpinned_flags.bit_set(loc);
+                }
                 return true;
             }
         return false;
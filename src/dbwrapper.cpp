@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <leveldb/cache.h>
+#include <leveldb/comparator.h>
 #include <leveldb/db.h>
 #include <leveldb/env.h>
 #include <leveldb/filter_policy.h>
@@ -30,8 +31,10 @@
 #include <leveldb/status.h>
 #include <leveldb/write_batch.h>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <utility>
+#include <vector>
 
 static auto CharCast(const std::byte* data) { return reinterpret_cast<const char*>(data); }
 
@@ -315,6 +318,33 @@ std::optional<std::string> CDBWrapper::ReadImpl(std::span<const std::byte> key)
     return strValue;
 }
 
+std::vector<std::optional<std::string>> CDBWrapper::MultiReadImpl(std::span<const DataStream> keys) const
+{
+    const auto slice{[&](size_t i) { return leveldb::Slice(CharCast(keys[i].data()), keys[i].size()); }};
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::ranges::sort(order, [&](size_t a, size_t b) { return DBContext().options.comparator->Compare(slice(a), slice(b)) < 0; });
+
+    // Read all keys as of the same point, even if the database is written to meanwhile.
+    const auto release{[this](const leveldb::Snapshot* snapshot) { DBContext().pdb->ReleaseSnapshot(snapshot); }};
+    const std::unique_ptr<const leveldb::Snapshot, decltype(release)> snapshot{DBContext().pdb->GetSnapshot(), release};
+    leveldb::ReadOptions readoptions{DBContext().readoptions};
+    readoptions.snapshot = snapshot.get();
+
+    std::vector<std::optional<std::string>> values(keys.size());
+    for (const size_t i : order) {
+        std::string strValue;
+        leveldb::Status status = DBContext().pdb->Get(readoptions, slice(i), &strValue);
+        if (!status.ok()) {
+            if (status.IsNotFound()) continue;
+            LogError("LevelDB read failure: %s", status.ToString());
+            HandleError(status);
+        }
+        values[i] = std::move(strValue);
+    }
+    return values;
+}
+
 bool CDBWrapper::ExistsImpl(std::span<const std::byte> key) const
 {
     leveldb::Slice slKey(CharCast(key.data()), key.size());
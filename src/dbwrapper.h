@@ -18,6 +18,7 @@
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 static const size_t DBWRAPPER_PREALLOC_KEY_SIZE = 64;
 static const size_t DBWRAPPER_PREALLOC_VALUE_SIZE = 1024;
@@ -192,6 +193,7 @@ private:
     inline static const std::string OBFUSCATION_KEY{"\000obfuscate_key", 14}; // explicit size to avoid truncation at leading \0
 
     std::optional<std::string> ReadImpl(std::span<const std::byte> key) const;
+    std::vector<std::optional<std::string>> MultiReadImpl(std::span<const DataStream> keys) const;
     bool ExistsImpl(std::span<const std::byte> key) const;
     size_t EstimateSizeImpl(std::span<const std::byte> key1, std::span<const std::byte> key2) const;
     auto& DBContext() const LIFETIMEBOUND { return *Assert(m_db_context); }
@@ -223,6 +225,47 @@ public:
         return true;
     }
 
+    /**
+     * Read the values of several keys from one snapshot of the database.
+     *
+     * The keys are looked up in the database's key order, so that neighbouring
+     * keys are found in table blocks that were just read, rather than each
+     * lookup seeking from scratch.
+     *
+     * The reads are done on the calling thread. There is no read pool in
+     * here: the coins lookups for a block are already spread over the input
+     * fetch queue's threads, each with a MultiRead of its own, and a second
+     * pool under them would only contend with those threads for the same
+     * disk. Callers that want more reads in flight split their keys into
+     * several MultiRead calls on their own threads.
+     *
+     * @returns the value of each key, in the order of the keys, or
+     *          std::nullopt if a key is not found or its value does not
+     *          deserialize
+     */
+    template <typename V, typename Keys>
+    std::vector<std::optional<V>> MultiRead(const Keys& keys) const
+    {
+        std::vector<DataStream> ssKeys;
+        for (const auto& key : keys) {
+            ssKeys.emplace_back().reserve(DBWRAPPER_PREALLOC_KEY_SIZE);
+            ssKeys.back() << key;
+        }
+        std::vector<std::optional<std::string>> strValues{MultiReadImpl(ssKeys)};
+        std::vector<std::optional<V>> values(strValues.size());
+        for (size_t i{0}; i < strValues.size(); ++i) {
+            if (!strValues[i]) continue;
+            try {
+                DataStream ssValue{MakeByteSpan(*strValues[i])};
+                m_obfuscation(ssValue);
+                ssValue >> values[i].emplace();
+            } catch (const std::exception&) {
+                values[i].reset();
+            }
+        }
+        return values;
+    }
+
     template <typename K, typename V>
     void Write(const K& key, const V& value, bool fSync = false)
     {
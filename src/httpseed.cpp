@@ -0,0 +1,274 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bitcoin-build-config.h> // IWYU pragma: keep
+
+#include <httpseed.h>
+
+#include <logging.h>
+#include <support/events.h>
+#include <tinyformat.h>
+#include <util/fs_helpers.h>
+#include <util/readwritefile.h>
+#include <util/threadinterrupt.h>
+#include <util/time.h>
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#include <event2/buffer.h>
+#include <event2/bufferevent.h>
+#include <event2/event.h>
+#include <event2/http.h>
+#include <event2/keyvalq_struct.h>
+
+#ifdef ENABLE_HTTPSEED_TLS
+#include <event2/bufferevent_ssl.h>
+#include <openssl/ssl.h>
+#endif
+
+namespace {
+/** How often the event loop checks for an interrupt or the deadline */
+constexpr auto HTTP_SEED_POLL_INTERVAL{100ms};
+
+/** An in-process request to one seed */
+struct SeedRequest {
+    const std::string url;
+    raii_evhttp_connection connection;
+    std::string body;
+    int status{0};
+    bool done{false};
+    //! Requests still in flight, and the loop to stop once there are none
+    size_t* pending;
+    event_base* base;
+};
+
+void AppendInput(evhttp_request* req, std::string& body)
+{
+    evbuffer* buf{evhttp_request_get_input_buffer(req)};
+    if (!buf) return;
+    const size_t size{evbuffer_get_length(buf)};
+    if (size == 0) return;
+    if (const auto* data{evbuffer_pullup(buf, size)}) body.append(reinterpret_cast<const char*>(data), size);
+    evbuffer_drain(buf, size);
+}
+
+void SeedChunk(evhttp_request* req, void* arg)
+{
+    AppendInput(req, static_cast<SeedRequest*>(arg)->body);
+}
+
+void SeedDone(evhttp_request* req, void* arg)
+{
+    auto& request{*static_cast<SeedRequest*>(arg)};
+    // A null request means the connection failed
+    if (req) {
+        request.status = evhttp_request_get_response_code(req);
+        AppendInput(req, request.body);
+    }
+    request.done = true;
+    if (--*request.pending == 0) event_base_loopbreak(request.base);
+}
+
+struct PollState {
+    const CThreadInterrupt& interrupt;
+    SteadyClock::time_point deadline;
+    event_base* base;
+};
+
+void SeedPoll(evutil_socket_t, short, void* arg)
+{
+    const auto& state{*static_cast<PollState*>(arg)};
+    if (state.interrupt || SteadyClock::now() >= state.deadline) event_base_loopbreak(state.base);
+}
+
+/**
+ * TLS for https:// seeds, in-process through libevent's OpenSSL bufferevents.
+ * Certificates are verified against the system's trusted roots and must be
+ * valid for the seed's host name.
+ */
+class SeedTLS
+{
+public:
+    SeedTLS()
+    {
+#ifdef ENABLE_HTTPSEED_TLS
+        m_ctx = SSL_CTX_new(TLS_client_method());
+        if (!m_ctx) return;
+        if (SSL_CTX_set_min_proto_version(m_ctx, TLS1_2_VERSION) != 1 || SSL_CTX_set_default_verify_paths(m_ctx) != 1) {
+            SSL_CTX_free(m_ctx);
+            m_ctx = nullptr;
+            return;
+        }
+        SSL_CTX_set_verify(m_ctx, SSL_VERIFY_PEER, nullptr);
+#endif
+    }
+    ~SeedTLS()
+    {
+#ifdef ENABLE_HTTPSEED_TLS
+        if (m_ctx) SSL_CTX_free(m_ctx);
+#endif
+    }
+    SeedTLS(const SeedTLS&) = delete;
+    SeedTLS& operator=(const SeedTLS&) = delete;
+
+    /** Whether https:// seeds can be fetched: the build has TLS support and it could be set up. */
+    bool Available() const
+    {
+#ifdef ENABLE_HTTPSEED_TLS
+        return m_ctx != nullptr;
+#else
+        return false;
+#endif
+    }
+
+    /** Bufferevent for a TLS connection to host on base, or nullptr. Freed along with the connection using it. */
+    bufferevent* NewBufferevent(event_base* base, const std::string& host) const
+    {
+#ifdef ENABLE_HTTPSEED_TLS
+        if (!m_ctx) return nullptr;
+        SSL* ssl{SSL_new(m_ctx)};
+        if (!ssl) return nullptr;
+        // Send the host name for virtual hosting, and check the certificate against it.
+        if (SSL_set_tlsext_host_name(ssl, host.c_str()) != 1 || SSL_set1_host(ssl, host.c_str()) != 1) {
+            SSL_free(ssl);
+            return nullptr;
+        }
+        // The bufferevent owns ssl from here on, also if it could not be created.
+        bufferevent* bev{bufferevent_openssl_socket_new(base, -1, ssl, BUFFEREVENT_SSL_CONNECTING, BEV_OPT_CLOSE_ON_FREE | BEV_OPT_DEFER_CALLBACKS)};
+        // Servers often close the connection without a TLS shutdown once the response is sent.
+        if (bev) bufferevent_openssl_set_allow_dirty_shutdown(bev, 1);
+        return bev;
+#else
+        return nullptr;
+#endif
+    }
+
+private:
+#ifdef ENABLE_HTTPSEED_TLS
+    SSL_CTX* m_ctx{nullptr};
+#endif
+};
+
+/** Start a request for request.url on base, over tls for an https:// url. Returns false if it could not be sent. */
+bool StartSeedRequest(event_base* base, const SeedTLS& tls, SeedRequest& request, std::chrono::seconds timeout)
+{
+    std::unique_ptr<evhttp_uri, decltype(&evhttp_uri_free)> uri{evhttp_uri_parse(request.url.c_str()), &evhttp_uri_free};
+    if (!uri || !evhttp_uri_get_host(uri.get())) return false;
+    const bool https{request.url.starts_with("https://")};
+    const std::string host{evhttp_uri_get_host(uri.get())};
+    const int port{evhttp_uri_get_port(uri.get())};
+    std::string path{evhttp_uri_get_path(uri.get()) ? evhttp_uri_get_path(uri.get()) : ""};
+    if (path.empty()) path = "/";
+    if (const char* query{evhttp_uri_get_query(uri.get())}) path += std::string{"?"} + query;
+
+    // Given no bufferevent, libevent opens a plain connection.
+    bufferevent* bev{nullptr};
+    if (https) {
+        bev = tls.NewBufferevent(base, host);
+        if (!bev) return false;
+    }
+    request.connection = raii_evhttp_connection{evhttp_connection_base_bufferevent_new(base, nullptr, bev, host.c_str(), port < 0 ? (https ? 443 : 80) : port)};
+    if (!request.connection) {
+        if (bev) bufferevent_free(bev);
+        return false;
+    }
+    evhttp_connection_set_timeout(request.connection.get(), count_seconds(timeout));
+    evhttp_connection_set_max_body_size(request.connection.get(), MAX_HTTP_SEED_RESPONSE_SIZE);
+
+    raii_evhttp_request req{obtain_evhttp_request(SeedDone, &request)};
+    if (!req) return false;
+    evhttp_request_set_chunked_cb(req.get(), SeedChunk);
+    evkeyvalq* headers{evhttp_request_get_output_headers(req.get())};
+    evhttp_add_header(headers, "Host", host.c_str());
+    evhttp_add_header(headers, "Connection", "close");
+    evhttp_add_header(headers, "Accept", "application/json");
+    // On failure the request is freed without calling SeedDone
+    return evhttp_make_request(request.connection.get(), req.release(), EVHTTP_REQ_GET, path.c_str()) == 0;
+}
+} // namespace
+
+bool IsValidHTTPSeedURL(const std::string& url, bool allow_http)
+{
+    const std::string_view scheme{url.starts_with("https://") || !allow_http ? "https://" : "http://"};
+    if (!url.starts_with(scheme) || url.size() == scheme.size()) return false;
+
+    // Only allow characters that are safe in a URL and cannot break out of
+    // the request line.
+    for (size_t i = scheme.size(); i < url.size(); ++i) {
+        const char c = url[i];
+        const bool safe = (c >= 'a' && c <= 'z') ||
+                          (c >= 'A' && c <= 'Z') ||
+                          (c >= '0' && c <= '9') ||
+                          c == '.' || c == '-' || c == '_' ||
+                          c == '/' || c == ':' || c == '?' ||
+                          c == '=' || c == '&' || c == '%' ||
+                          c == '+' || c == '#';
+        if (!safe) return false;
+    }
+    return true;
+}
+
+std::vector<std::optional<std::string>> FetchHTTPSeeds(const std::vector<std::string>& urls, std::chrono::seconds timeout, bool allow_http, const CThreadInterrupt& interrupt)
+{
+    std::vector<std::optional<std::string>> responses(urls.size());
+    raii_event_base base{obtain_event_base()};
+    const SeedTLS tls;
+    std::vector<std::pair<size_t, std::unique_ptr<SeedRequest>>> requests;
+    size_t pending{0};
+    for (size_t i = 0; i < urls.size(); ++i) {
+        const std::string& url{urls[i]};
+        if (!IsValidHTTPSeedURL(url, allow_http)) {
+            LogInfo("HTTP seed URL rejected (invalid format or unsafe characters): %s", url);
+            continue;
+        }
+        if (url.starts_with("https://") && !tls.Available()) {
+            LogInfo("HTTP seed %s skipped: https:// is not supported by this build, or TLS could not be set up", url);
+            continue;
+        }
+        auto request{std::make_unique<SeedRequest>(url, raii_evhttp_connection{}, std::string{}, 0, false, &pending, base.get())};
+        if (!StartSeedRequest(base.get(), tls, *request, timeout)) {
+            LogDebug(BCLog::NET, "Could not send a request to HTTP seed %s", url);
+            continue;
+        }
+        ++pending;
+        requests.emplace_back(i, std::move(request));
+    }
+
+    if (pending > 0) {
+        PollState poll{interrupt, SteadyClock::now() + timeout, base.get()};
+        raii_event poll_event{obtain_event(base.get(), -1, EV_PERSIST, SeedPoll, &poll)};
+        const timeval poll_interval{0, int(count_microseconds(HTTP_SEED_POLL_INTERVAL))};
+        event_add(poll_event.get(), &poll_interval);
+        event_base_dispatch(base.get());
+    }
+
+    for (auto& [i, request] : requests) {
+        if (!request->done) {
+            LogDebug(BCLog::NET, "HTTP seed %s did not answer in time", request->url);
+        } else if (request->status != 200) {
+            LogDebug(BCLog::NET, "HTTP seed %s failed with status %d", request->url, request->status);
+        } else if (!request->body.empty()) {
+            responses[i] = std::move(request->body);
+        }
+    }
+    return responses;
+}
+
+std::optional<std::string> ReadHTTPSeedCache(const fs::path& path)
+{
+    auto [ok, response]{ReadBinaryFile(path, MAX_HTTP_SEED_RESPONSE_SIZE + 1)};
+    if (!ok || response.empty() || response.size() > MAX_HTTP_SEED_RESPONSE_SIZE) return std::nullopt;
+    return std::move(response);
+}
+
+bool WriteHTTPSeedCache(const fs::path& path, const std::string& response)
+{
+    fs::path path_tmp{path};
+    path_tmp += ".new";
+    if (!WriteBinaryFile(path_tmp, response)) return false;
+    return RenameOver(path_tmp, path);
+}
@@ -0,0 +1,52 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_HTTPSEED_H
+#define BITCOIN_HTTPSEED_H
+
+#include <util/fs.h>
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+class CThreadInterrupt;
+
+/** Maximum size of a response from an HTTP seed */
+static constexpr size_t MAX_HTTP_SEED_RESPONSE_SIZE{1024 * 1024};
+/** How long to wait for the HTTP seeds to answer */
+static constexpr std::chrono::seconds HTTP_SEED_TIMEOUT{10};
+/** File in the data directory holding the last good HTTP seed response */
+static const char* const HTTP_SEED_CACHE_FILENAME{"httpseeds.json"};
+
+/**
+ * Check that url is an https:// URL, or an http:// one if allow_http is set,
+ * with no characters that could be unsafe to put in a request.
+ */
+bool IsValidHTTPSeedURL(const std::string& url, bool allow_http);
+
+/**
+ * Query all urls concurrently on a single libevent loop, giving up after
+ * timeout or once interrupted.
+ *
+ * https:// seeds are fetched over TLS in-process, with the certificate
+ * verified against the system's trusted roots. This needs a build with
+ * OpenSSL (WITH_HTTPSEED_TLS); otherwise these seeds are skipped and the
+ * node relies on its seed cache and on DNS seeding.
+ *
+ * Plain http:// seeds are only queried when allow_http is set, as used by
+ * regtest to test against a local server.
+ *
+ * @returns the body of each successful response, by position of its url
+ */
+std::vector<std::optional<std::string>> FetchHTTPSeeds(const std::vector<std::string>& urls, std::chrono::seconds timeout, bool allow_http, const CThreadInterrupt& interrupt);
+
+/** Read the cached HTTP seed response, if there is one. */
+std::optional<std::string> ReadHTTPSeedCache(const fs::path& path);
+/** Replace the cached HTTP seed response. */
+bool WriteHTTPSeedCache(const fs::path& path, const std::string& response);
+
+#endif // BITCOIN_HTTPSEED_H
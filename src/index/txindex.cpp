@@ -11,6 +11,7 @@
 #include <index/disktxpos.h>
 #include <interfaces/chain.h>
 #include <logging.h>
+#include <node/blockcompression.h>
 #include <node/blockstorage.h>
 #include <primitives/block.h>
 #include <primitives/transaction.h>
@@ -24,9 +25,12 @@
 #include <cstdint>
 #include <cstdio>
 #include <exception>
+#include <ios>
 #include <iterator>
+#include <optional>
 #include <span>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -45,6 +49,10 @@ public:
     /// transaction hash is not indexed.
     bool ReadTxPos(const Txid& txid, CDiskTxPos& pos) const;
 
+    /// Read the disk locations of several transactions together, std::nullopt for a transaction
+    /// hash that is not indexed.
+    std::vector<std::optional<CDiskTxPos>> ReadTxPositions(std::span<const Txid> txids) const;
+
     /// Write a batch of transaction positions to the DB.
     void WriteTxs(const std::vector<std::pair<Txid, CDiskTxPos>>& v_pos);
 };
@@ -58,6 +66,14 @@ bool TxIndex::DB::ReadTxPos(const Txid& txid, CDiskTxPos& pos) const
     return Read(std::make_pair(DB_TXINDEX, txid.ToUint256()), pos);
 }
 
+std::vector<std::optional<CDiskTxPos>> TxIndex::DB::ReadTxPositions(std::span<const Txid> txids) const
+{
+    std::vector<std::pair<uint8_t, uint256>> keys;
+    keys.reserve(txids.size());
+    for (const Txid& txid : txids) keys.emplace_back(DB_TXINDEX, txid.ToUint256());
+    return MultiRead<CDiskTxPos>(keys);
+}
+
 void TxIndex::DB::WriteTxs(const std::vector<std::pair<Txid, CDiskTxPos>>& v_pos)
 {
     CDBBatch batch(*this);
@@ -92,23 +108,87 @@ bool TxIndex::CustomAppend(const interfaces::BlockInfo& block)
 
 BaseIndex::DB& TxIndex::GetDB() const { return *m_db; }
 
+/** A decompressed block, kept to read several transactions of it. */
+struct TxIndex::DecompressedBlock {
+    FlatFilePos pos;
+    std::vector<std::byte> data;
+};
+
 bool TxIndex::FindTx(const Txid& tx_hash, uint256& block_hash, CTransactionRef& tx) const
 {
     CDiskTxPos postx;
     if (!m_db->ReadTxPos(tx_hash, postx)) {
         return false;
     }
+    return ReadTx(postx, tx_hash, block_hash, tx, /*last_block=*/nullptr);
+}
 
-    AutoFile file{m_chainstate->m_blockman.OpenBlockFile(postx, true)};
-    if (file.IsNull()) {
-        LogError("OpenBlockFile failed");
-        return false;
+size_t TxIndex::FindTxs(std::span<const Txid> tx_hashes, std::vector<uint256>& block_hashes, std::vector<CTransactionRef>& txs) const
+{
+    block_hashes.assign(tx_hashes.size(), uint256{});
+    txs.assign(tx_hashes.size(), nullptr);
+    const auto positions{m_db->ReadTxPositions(tx_hashes)};
+    std::vector<size_t> order;
+    for (size_t i{0}; i < positions.size(); ++i) {
+        if (positions[i]) order.push_back(i);
+    }
+    // Read the transactions in the order they are stored in the block files.
+    std::ranges::sort(order, {}, [&](size_t i) {
+        const CDiskTxPos& pos{*positions[i]};
+        return std::tuple{pos.nFile, pos.nPos, pos.nTxOffset};
+    });
+
+    size_t found{0};
+    DecompressedBlock last_block;
+    for (const size_t i : order) {
+        if (ReadTx(*positions[i], tx_hashes[i], block_hashes[i], txs[i], &last_block)) {
+            ++found;
+        } else {
+            txs[i] = nullptr;
+        }
     }
+    return found;
+}
+
+bool TxIndex::ReadTx(const CDiskTxPos& postx, const Txid& tx_hash, uint256& block_hash, CTransactionRef& tx, DecompressedBlock* last_block) const
+{
+    const auto& blockman{m_chainstate->m_blockman};
     CBlockHeader header;
     try {
-        file >> header;
-        file.seek(postx.nTxOffset, SEEK_CUR);
-        file >> TX_WITH_WITNESS(tx);
+        // Transaction offsets are into the uncompressed block, so for a
+        // compressed block the whole block is read and decompressed to get
+        // one transaction: up to a few milliseconds for a full block, against
+        // a single read otherwise. Only FindTxs keeps the last block, for the
+        // transactions that follow in it.
+        const auto read_from_block = [&](std::span<const std::byte> block_data) {
+            SpanReader reader{block_data};
+            reader >> header;
+            if (postx.nTxOffset > reader.size()) throw std::ios_base::failure("transaction offset past the end of the block");
+            reader.ignore(postx.nTxOffset);
+            reader >> TX_WITH_WITNESS(tx);
+        };
+        if (last_block && last_block->pos == postx) {
+            read_from_block(last_block->data);
+        } else {
+            AutoFile file{blockman.OpenBlockFile({postx.nFile, postx.nPos - node::STORAGE_HEADER_BYTES}, true)};
+            if (file.IsNull()) {
+                LogError("OpenBlockFile failed");
+                return false;
+            }
+            MessageStartChars message_start;
+            uint32_t size;
+            file >> message_start >> size;
+            if (size & node::COMPRESSED_BLOCK_RECORD) {
+                auto block_data{blockman.ReadRawBlock(postx)};
+                if (!block_data) return false;
+                read_from_block(*block_data);
+                if (last_block) *last_block = {.pos = postx, .data = std::move(*block_data)};
+            } else {
+                file >> header;
+                file.seek(postx.nTxOffset, SEEK_CUR);
+                file >> TX_WITH_WITNESS(tx);
+            }
+        }
     } catch (const std::exception& e) {
         LogError("Deserialize or I/O error - %s", e.what());
         return false;
@@ -10,8 +10,11 @@
 
 #include <cstddef>
 #include <memory>
+#include <span>
+#include <vector>
 
 class uint256;
+struct CDiskTxPos;
 namespace interfaces {
 class Chain;
 }
@@ -33,6 +36,13 @@ private:
 
     bool AllowPrune() const override { return false; }
 
+    struct DecompressedBlock;
+
+    /// Read the transaction at postx, which is expected to have the hash tx_hash.
+    /// If last_block is set, a compressed block is decompressed into it, or
+    /// taken from it if it is the same one.
+    bool ReadTx(const CDiskTxPos& postx, const Txid& tx_hash, uint256& block_hash, CTransactionRef& tx, DecompressedBlock* last_block) const;
+
 protected:
     bool CustomAppend(const interfaces::BlockInfo& block) override;
 
@@ -52,6 +62,16 @@ public:
     /// @param[out]  tx  The transaction itself.
     /// @return  true if transaction is found, false otherwise
     bool FindTx(const Txid& tx_hash, uint256& block_hash, CTransactionRef& tx) const;
+
+    /// Look up several transactions by hash. Their positions are read together
+    /// from one snapshot of the index, then the transactions in the order they
+    /// are stored in the block files.
+    ///
+    /// @param[in]   tx_hashes  The hashes of the transactions to be returned.
+    /// @param[out]  block_hashes  The hash of the block each transaction is found in.
+    /// @param[out]  txs  Each transaction, or nullptr if it is not found.
+    /// @return  the number of transactions found
+    size_t FindTxs(std::span<const Txid> tx_hashes, std::vector<uint256>& block_hashes, std::vector<CTransactionRef>& txs) const;
 };
 
 /// The global transaction index, used in GetTransaction. May be null.
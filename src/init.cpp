@@ -37,6 +37,7 @@
 #include <kernel/caches.h>
 #include <kernel/context.h>
 #include <key.h>
+#include <key_io.h>
 #include <logging.h>
 #include <mapport.h>
 #include <net.h>
@@ -45,17 +46,20 @@
 #include <netbase.h>
 #include <netgroup.h>
 #include <node/blockmanager_args.h>
+#include <node/blockservecache.h>
 #include <node/blockstorage.h>
 #include <node/caches.h>
 #include <node/chainstate.h>
 #include <node/chainstatemanager_args.h>
 #include <node/context.h>
+#include <node/cpu_miner.h>
 #include <node/interface_ui.h>
 #include <node/kernel_notifications.h>
 #include <node/mempool_args.h>
 #include <node/mempool_persist.h>
 #include <node/mempool_persist_args.h>
 #include <node/miner.h>
+#include <node/mining_service.h>
 #include <node/peerman_args.h>
 #include <policy/feerate.h>
 #include <policy/fees/block_policy_estimator.h>
@@ -68,6 +72,7 @@
 #include <rpc/server.h>
 #include <rpc/util.h>
 #include <scheduler.h>
+#include <stratum.h>
 #include <script/sigcache.h>
 #include <sync.h>
 #include <torcontrol.h>
@@ -123,6 +128,7 @@ using common::InvalidPortErrMsg;
 using common::ResolveErrMsg;
 
 using node::ApplyArgsManOptions;
+using node::BlockAssembler;
 using node::BlockManager;
 using node::CalculateCacheSizes;
 using node::ChainstateLoadResult;
@@ -271,7 +277,12 @@ void Interrupt(NodeContext& node)
     InterruptRPC();
     InterruptREST();
     InterruptTorControl();
+    InterruptStratum();
+#ifdef ENABLE_ZMQ
+    if (g_zmq_notification_interface) g_zmq_notification_interface->InterruptMiningJobs();
+#endif
     InterruptMapPort();
+    if (node.mining_service) node.mining_service->Interrupt();
     if (node.connman)
         node.connman->Interrupt();
     for (auto* index : node.indexes) {
@@ -307,6 +318,10 @@ void Shutdown(NodeContext& node)
         }
     }
     StopMapPort();
+    if (node.mining_service) {
+        node.mining_service->Stop();
+        if (node.validation_signals) node.validation_signals->UnregisterValidationInterface(node.mining_service.get());
+    }
 
     // Because these depend on each-other, we make sure that neither can be
     // using the other before destroying them.
@@ -314,6 +329,10 @@ void Shutdown(NodeContext& node)
     if (node.connman) node.connman->Stop();
 
     StopTorControl();
+    StopStratum();
+#ifdef ENABLE_ZMQ
+    if (g_zmq_notification_interface) g_zmq_notification_interface->StopMiningJobs();
+#endif
 
     if (node.background_init_thread.joinable()) node.background_init_thread.join();
     // After everything has been shut down, but before things get flushed, stop the
@@ -323,6 +342,7 @@ void Shutdown(NodeContext& node)
 
     // After the threads that potentially access these pointers have been stopped,
     // destruct and reset all to nullptr.
+    node.mining_service.reset();
     node.peerman.reset();
     node.connman.reset();
     node.banman.reset();
@@ -478,6 +498,9 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-alertnotify=<cmd>", "Execute command when an alert is raised (%s in cmd is replaced by message)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
 #endif
     argsman.AddArg("-assumevalid=<hex>", strprintf("If this block is in the chain assume that it and its ancestors are valid and potentially skip their script verification (0 to verify all, default: %s, testnet3: %s, testnet4: %s, signet: %s)", defaultChainParams->GetConsensus().defaultAssumeValid.GetHex(), testnetChainParams->GetConsensus().defaultAssumeValid.GetHex(), testnet4ChainParams->GetConsensus().defaultAssumeValid.GetHex(), signetChainParams->GetConsensus().defaultAssumeValid.GetHex()), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-batchschnorr", strprintf("Verify the Schnorr signatures of a block's inputs in batches rather than one by one, when verifying scripts on more than one thread (default: %u)", DEFAULT_BATCH_SCHNORR_VERIFY), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-blockscompress", strprintf("Store new blocks compressed in the block files, each on its own, with a script-aware encoding. Blocks stored before stay readable, and so do compressed blocks once this is unset. Block files written with this set cannot be read by older versions, and -txindex lookups of transactions in compressed blocks decompress the whole block (default: %u)", kernel::DEFAULT_BLOCKS_COMPRESS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-blocksmmap", strprintf("Read blocks from finalized block files through memory mappings, rather than file reads (default: %u)", kernel::DEFAULT_BLOCKS_MMAP), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blocksdir=<dir>", "Specify directory to hold blocks subdirectory for *.dat files (default: <datadir>)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blocksxor",
                    strprintf("Whether an XOR-key applies to blocksdir *.dat files. "
@@ -491,11 +514,14 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-blocknotify=<cmd>", "Execute command when the best block changes (%s in cmd is replaced by block hash)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
 #endif
     argsman.AddArg("-blockreconstructionextratxn=<n>", strprintf("Extra transactions to keep in memory for compact block reconstructions (default: %u)", DEFAULT_BLOCK_RECONSTRUCTION_EXTRA_TXN), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-blockservecache=<n>", strprintf("Maximum size of the cache of blocks recently served to peers, shared across them, in MiB (default: %u)", node::DEFAULT_BLOCK_SERVE_CACHE_SIZE), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blocksonly", strprintf("Whether to reject transactions from network peers. Disables automatic broadcast and rebroadcast of transactions, unless the source peer has the 'forcerelay' permission. RPC transactions are not affected. (default: %u)", DEFAULT_BLOCKSONLY), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-coinstatsindex", strprintf("Maintain coinstats index used by the gettxoutsetinfo RPC (default: %u)", DEFAULT_COINSTATSINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-conf=<file>", strprintf("Specify path to read-only configuration file. Relative paths will be prefixed by datadir location (only useable from command line, not configuration file) (default: %s)", BITCOIN_CONF_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-datadir=<dir>", "Specify data directory", ArgsManager::ALLOW_ANY | ArgsManager::DISALLOW_NEGATION, OptionsCategory::OPTIONS);
     argsman.AddArg("-dbbatchsize", strprintf("Maximum database write batch size in bytes (default: %u)", DEFAULT_DB_CACHE_BATCH), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-dbbackgroundflush", strprintf("Write the coins cache to disk on a background thread when it is flushed while blocks are being connected, instead of pausing validation until the write completes. The coins being written are held in memory on top of -dbcache until then (default: %u)", DEFAULT_DB_BACKGROUND_FLUSH), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-dbcacheadaptive", strprintf("Resize the coins cache to the memory available while running: grow it beyond -dbcache while memory is plentiful, and shrink it, down to %d MiB, when other processes need the memory. The signature and script execution caches are reduced to 1/%d of their size at the same time. Available memory is read from the system, within any cgroup memory limit (default: %u)", MIN_ADAPTIVE_COINS_CACHE >> 20, ADAPTIVE_VALIDATION_CACHE_DIVISOR, DEFAULT_DB_CACHE_ADAPTIVE), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-dbcache=<n>", strprintf("Maximum database cache size <n> MiB (minimum %d, default: %d). Make sure you have enough RAM. In addition, unused memory allocated to the mempool is shared with this cache (see -maxmempool).", MIN_DB_CACHE >> 20, DEFAULT_DB_CACHE >> 20), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-includeconf=<file>", "Specify additional configuration file, relative to the -datadir path (only useable from configuration file, not command line)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-allowignoredconf", strprintf("For backwards compatibility, treat an unused %s file in the datadir as a warning, not an error.", BITCOIN_CONF_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
@@ -517,6 +543,7 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
             "(default: 0 = disable pruning blocks, 1 = allow manual pruning via RPC, >=%u = automatically prune block files to stay under the specified target size in MiB)", MIN_DISK_SPACE_FOR_BLOCK_FILES / 1024 / 1024), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-reindex", "If enabled, wipe chain state and block index, and rebuild them from blk*.dat files on disk. Also wipe and rebuild other optional indexes that are active. If an assumeutxo snapshot was loaded, its chainstate will be wiped as well. The snapshot can then be reloaded via RPC.", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-reindex-chainstate", "If enabled, wipe chain state, and rebuild it from blk*.dat files on disk. If an assumeutxo snapshot was loaded, its chainstate will be wiped as well. The snapshot can then be reloaded via RPC.", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-reindexthreads=<n>", strprintf("Number of threads scanning the block files for blocks during -reindex (1 to %d, default: %d)", kernel::MAX_REINDEX_THREADS, kernel::DEFAULT_REINDEX_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-settings=<file>", strprintf("Specify path to dynamic settings data file. Can be disabled with -nosettings. File is written at runtime and not meant to be edited by users (use %s instead for custom settings). Relative paths will be prefixed by datadir location. (default: %s)", BITCOIN_CONF_FILENAME, BITCOIN_SETTINGS_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
 #if HAVE_SYSTEM
     argsman.AddArg("-startupnotify=<cmd>", "Execute command on startup.", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
@@ -540,6 +567,7 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-externalip=<ip>", "Specify your own public address", ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-fixedseeds", strprintf("Allow fixed seeds if DNS seeds don't provide peers (default: %u)", DEFAULT_FIXEDSEEDS), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-forcednsseed", strprintf("Always query for peer addresses via DNS lookup (default: %u)", DEFAULT_FORCEDNSSEED), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
+    argsman.AddArg("-httpseed=<url>", "Query this https:// seed for peer addresses along with DNS seeding, instead of the built-in HTTP seeds. Plain http:// seeds are only accepted on regtest. This option can be specified multiple times to query multiple seeds.", ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::CONNECTION);
     argsman.AddArg("-listen", strprintf("Accept connections from outside (default: %u if no -proxy, -connect or -maxconnections=0)", DEFAULT_LISTEN), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-listenonion", strprintf("Automatically create Tor onion service (default: %d)", DEFAULT_LISTEN_ONION), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-maxconnections=<n>", strprintf("Maintain at most <n> automatic connections to peers (default: %u). This limit does not apply to connections manually added via -addnode or the addnode RPC, which have a separate limit of %u.", DEFAULT_MAX_PEER_CONNECTIONS, MAX_ADDNODE_CONNECTIONS), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
@@ -605,22 +633,28 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-zmqpubrawblock=<address>", "Enable publish raw block in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawtx=<address>", "Enable publish raw transaction in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubsequence=<address>", "Enable publish hash block and tx sequence in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubminingjob=<address>", "Enable publish mining jobs paying to -genaddress in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqminingsubmit=<address>", "Accept solutions to published mining jobs in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubhashblockhwm=<n>", strprintf("Set publish hash block outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubhashtxhwm=<n>", strprintf("Set publish hash transaction outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawblockhwm=<n>", strprintf("Set publish raw block outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawtxhwm=<n>", strprintf("Set publish raw transaction outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubsequencehwm=<n>", strprintf("Set publish hash sequence message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubminingjobhwm=<n>", strprintf("Set publish mining job outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
 #else
     hidden_args.emplace_back("-zmqpubhashblock=<address>");
     hidden_args.emplace_back("-zmqpubhashtx=<address>");
     hidden_args.emplace_back("-zmqpubrawblock=<address>");
     hidden_args.emplace_back("-zmqpubrawtx=<address>");
     hidden_args.emplace_back("-zmqpubsequence=<n>");
+    hidden_args.emplace_back("-zmqpubminingjob=<address>");
+    hidden_args.emplace_back("-zmqminingsubmit=<address>");
     hidden_args.emplace_back("-zmqpubhashblockhwm=<n>");
     hidden_args.emplace_back("-zmqpubhashtxhwm=<n>");
     hidden_args.emplace_back("-zmqpubrawblockhwm=<n>");
     hidden_args.emplace_back("-zmqpubrawtxhwm=<n>");
     hidden_args.emplace_back("-zmqpubsequencehwm=<n>");
+    hidden_args.emplace_back("-zmqpubminingjobhwm=<n>");
 #endif
 
     argsman.AddArg("-checkblocks=<n>", strprintf("How many blocks to check at startup (default: %u, 0 = all)", DEFAULT_CHECKBLOCKS), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
@@ -645,6 +679,7 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-limitclustersize=<n>", strprintf("Do not accept transactions whose virtual size with all in-mempool connected transactions exceeds <n> kilobytes (default: %u)", DEFAULT_CLUSTER_SIZE_LIMIT_KVB), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-capturemessages", "Capture all P2P messages to disk", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-mocktime=<n>", "Replace actual time with " + UNIX_EPOCH_TIME + " (default: 0)", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
+    argsman.AddArg("-sigcachepin", strprintf("Keep signatures verified when accepting a transaction to the mempool in the signature cache until its block is connected, rather than letting them age out. Signatures of transactions that are not mined still expire after %u cache generations (default: %u)", int{CuckooCache::cache<uint256, SignatureCacheHasher>::MAX_PINNED_EPOCHS}, DEFAULT_SIGNATURE_CACHE_PIN), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-maxsigcachesize=<n>", strprintf("Limit sum of signature cache and script execution cache sizes to <n> MiB (default: %u)", DEFAULT_VALIDATION_CACHE_BYTES >> 20), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-maxtipage=<n>",
                    strprintf("Maximum tip age in seconds to consider node in initial block download (default: %u)",
@@ -678,6 +713,11 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-blockreservedweight=<n>", strprintf("Reserve space for the fixed-size block header plus the largest coinbase transaction the mining software may add to the block. (default: %d).", DEFAULT_BLOCK_RESERVED_WEIGHT), ArgsManager::ALLOW_ANY, OptionsCategory::BLOCK_CREATION);
     argsman.AddArg("-blockmintxfee=<amt>", strprintf("Set lowest fee rate (in %s/kvB) for transactions to be included in block creation. (default: %s)", CURRENCY_UNIT, FormatMoney(DEFAULT_BLOCK_MIN_TX_FEE)), ArgsManager::ALLOW_ANY, OptionsCategory::BLOCK_CREATION);
     argsman.AddArg("-blockversion=<n>", "Override block version to test forking scenarios", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::BLOCK_CREATION);
+    argsman.AddArg("-gen", strprintf("Mine blocks in the background to -genaddress (default: %u)", node::DEFAULT_GENERATE), ArgsManager::ALLOW_ANY, OptionsCategory::BLOCK_CREATION);
+    argsman.AddArg("-genaddress=<address>", "Address the coinbase of blocks mined with -gen, setgenerate or -stratumbind pays to", ArgsManager::ALLOW_ANY, OptionsCategory::BLOCK_CREATION);
+    argsman.AddArg("-stratumbind=<addr>[:port]", strprintf("Bind to given address to serve Stratum v1 mining work, paying to -genaddress (default port: %u). Use [host]:port notation for IPv6. This option can be specified multiple times (default: none)", DEFAULT_STRATUM_PORT), ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::BLOCK_CREATION);
+    argsman.AddArg("-stratumdifficulty=<n>", strprintf("Share difficulty asked of Stratum miners, lowered to the network difficulty if that is easier (default: %u)", DEFAULT_STRATUM_DIFFICULTY), ArgsManager::ALLOW_ANY, OptionsCategory::BLOCK_CREATION);
+    argsman.AddArg("-genthreads=<n>", strprintf("Number of threads used to search for proof-of-work with -gen, setgenerate, generatetoaddress, generatetodescriptor and generateblock (-1 = all cores, up to %d, default: %d)", node::MAX_GENERATE_THREADS, node::DEFAULT_GENERATE_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::BLOCK_CREATION);
 
     argsman.AddArg("-rest", strprintf("Accept public REST requests (default: %u)", DEFAULT_REST_ENABLE), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     argsman.AddArg("-rpcallowip=<ip>", "Allow JSON-RPC connections from specified source. Valid values for <ip> are a single IP (e.g. 1.2.3.4), a network/netmask (e.g. 1.2.3.4/255.255.255.0), a network/CIDR (e.g. 1.2.3.4/24), all ipv4 (0.0.0.0/0), or all ipv6 (::/0). RFC4193 is allowed only if -cjdnsreachable=0. This option can be specified multiple times", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
@@ -1054,6 +1094,10 @@ bool AppInitParameterInteraction(const ArgsManager& args)
         }
     }
 
+    if (!node::GetMiningThreads(args.GetIntArg("-genthreads", node::DEFAULT_GENERATE_THREADS))) {
+        return InitError(strprintf(_("Specified -genthreads exceeds the maximum of %d"), node::MAX_GENERATE_THREADS));
+    }
+
     {
         const auto block_reserved_weight = args.GetIntArg("-blockreservedweight", DEFAULT_BLOCK_RESERVED_WEIGHT);
         if (block_reserved_weight > MAX_BLOCK_WEIGHT) {
@@ -1210,6 +1254,8 @@ bool CheckHostPortOptions(const ArgsManager& args) {
         {"-zmqpubrawblock",  true,                false},
         {"-zmqpubrawtx",     true,                false},
         {"-zmqpubsequence",  true,                false},
+        {"-zmqpubminingjob", true,                false},
+        {"-zmqminingsubmit", true,                false},
     }) {
         for (const std::string& param_value : args.GetArgs(param_name)) {
             const std::string param_value_hostport{
@@ -1836,6 +1882,18 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     ChainstateManager& chainman = *Assert(node.chainman);
     auto& kernel_notifications{*Assert(node.notifications)};
 
+    if (args.GetBoolArg("-dbcacheadaptive", DEFAULT_DB_CACHE_ADAPTIVE)) {
+        if (GetAvailableRAM()) {
+            LogInfo("* Resizing the coins cache to the memory available every %d seconds", count_seconds(ADAPTIVE_DB_CACHE_INTERVAL));
+            node.scheduler->scheduleEvery([&chainman] {
+                node::AdaptCoinsCache(chainman);
+                node::AdaptValidationCaches(chainman);
+            }, ADAPTIVE_DB_CACHE_INTERVAL);
+        } else {
+            LogWarning("-dbcacheadaptive is not supported on this system, keeping the coins cache size set by -dbcache");
+        }
+    }
+
     assert(!node.peerman);
     node.peerman = PeerManager::make(*node.connman, *node.addrman,
                                      node.banman.get(), chainman,
@@ -2196,6 +2254,55 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         return false;
     }
 
+    // The mining service is always created so that setgenerate can start it.
+    BlockAssembler::Options assemble_options;
+    ApplyArgsManOptions(args, assemble_options);
+    node.mining_service = std::make_unique<node::MiningService>(chainman, node.mempool.get(), assemble_options);
+    validation_signals.RegisterValidationInterface(node.mining_service.get());
+    if (args.GetBoolArg("-gen", node::DEFAULT_GENERATE)) {
+        const CTxDestination dest{DecodeDestination(args.GetArg("-genaddress", ""))};
+        if (!IsValidDestination(dest)) {
+            return InitError(_("-gen requires a valid -genaddress"));
+        }
+        node.mining_service->Start(GetScriptForDestination(dest), *node::GetMiningThreads(args.GetIntArg("-genthreads", node::DEFAULT_GENERATE_THREADS)));
+    }
+
+    if (!args.GetArgs("-stratumbind").empty()) {
+        std::vector<CService> stratum_binds;
+        for (const std::string& bind_arg : args.GetArgs("-stratumbind")) {
+            const std::optional<CService> bind_addr{Lookup(bind_arg, DEFAULT_STRATUM_PORT, false)};
+            if (!bind_addr || !bind_addr->IsValid()) {
+                return InitError(ResolveErrMsg("stratumbind", bind_arg));
+            }
+            stratum_binds.push_back(*bind_addr);
+        }
+        const CTxDestination dest{DecodeDestination(args.GetArg("-genaddress", ""))};
+        if (!IsValidDestination(dest)) {
+            return InitError(_("-stratumbind requires a valid -genaddress"));
+        }
+        const int64_t difficulty{args.GetIntArg("-stratumdifficulty", DEFAULT_STRATUM_DIFFICULTY)};
+        if (difficulty < 1) {
+            return InitError(_("-stratumdifficulty must be at least 1"));
+        }
+        if (!StartStratum(*Assert(node.mining), stratum_binds, GetScriptForDestination(dest), difficulty)) {
+            return InitError(_("Unable to start Stratum server. See debug log for details."));
+        }
+    }
+
+#ifdef ENABLE_ZMQ
+    if (g_zmq_notification_interface && g_zmq_notification_interface->HasMiningJobNotifiers()) {
+        const CTxDestination dest{DecodeDestination(args.GetArg("-genaddress", ""))};
+        if (!IsValidDestination(dest)) {
+            return InitError(_("-zmqpubminingjob requires a valid -genaddress"));
+        }
+        if (!g_zmq_notification_interface->StartMiningJobs(*Assert(node.mining), GetScriptForDestination(dest), args.GetArgs("-zmqminingsubmit"))) {
+            return InitError(_("Unable to start publishing mining jobs. See debug log for details."));
+        }
+    } else if (!args.GetArgs("-zmqminingsubmit").empty()) {
+        return InitError(_("-zmqminingsubmit requires -zmqpubminingjob"));
+    }
+#endif
+
     // ********************************************************* Step 13: finished
 
     // At this point, the RPC is "started", but still in warmup, which means it
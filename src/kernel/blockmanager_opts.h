@@ -16,6 +16,10 @@ class CChainParams;
 namespace kernel {
 
 static constexpr bool DEFAULT_XOR_BLOCKSDIR{true};
+static constexpr bool DEFAULT_BLOCKS_MMAP{true};
+static constexpr bool DEFAULT_BLOCKS_COMPRESS{false};
+static constexpr int DEFAULT_REINDEX_THREADS{4};
+static constexpr int MAX_REINDEX_THREADS{16};
 
 /**
  * An options struct for `BlockManager`, more ergonomically referred to as
@@ -26,6 +30,12 @@ struct BlockManagerOpts {
     bool use_xor{DEFAULT_XOR_BLOCKSDIR};
     uint64_t prune_target{0};
     bool fast_prune{false};
+    //! Whether to read blocks from finalized block files through memory mappings
+    bool use_mmap{DEFAULT_BLOCKS_MMAP};
+    //! Whether to store new blocks compressed
+    bool compress_blocks{DEFAULT_BLOCKS_COMPRESS};
+    //! Number of threads scanning the block files for blocks during -reindex
+    int reindex_threads{DEFAULT_REINDEX_THREADS};
     const fs::path blocks_dir;
     Notifications& notifications;
     DBParams block_tree_db_params;
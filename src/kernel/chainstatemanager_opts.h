@@ -22,6 +22,7 @@ class CChainParams;
 class ValidationSignals;
 
 static constexpr auto DEFAULT_MAX_TIP_AGE{24h};
+static constexpr bool DEFAULT_BATCH_SCHNORR_VERIFY{false};
 
 namespace kernel {
 
@@ -46,8 +47,12 @@ struct ChainstateManagerOpts {
     ValidationSignals* signals{nullptr};
     //! Number of script check worker threads. Zero means no parallel verification.
     int worker_threads_num{0};
+    //! Whether the script check workers verify the Schnorr signatures of the checks they take at once.
+    bool batch_schnorr_verify{DEFAULT_BATCH_SCHNORR_VERIFY};
     size_t script_execution_cache_bytes{DEFAULT_SCRIPT_EXECUTION_CACHE_BYTES};
     size_t signature_cache_bytes{DEFAULT_SIGNATURE_CACHE_BYTES};
+    //! Whether signatures cached at mempool acceptance are kept until their block is connected.
+    bool signature_cache_pin{DEFAULT_SIGNATURE_CACHE_PIN};
 };
 
 } // namespace kernel
@@ -116,6 +116,7 @@ namespace BCLog {
         SCAN        = (CategoryMask{1} << 27),
         TXPACKAGES  = (CategoryMask{1} << 28),
         KERNEL      = (CategoryMask{1} << 29),
+        STRATUM     = (CategoryMask{1} << 30),
         ALL         = ~NONE,
     };
     enum class Level {
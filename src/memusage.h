@@ -8,6 +8,7 @@
 #include <indirectmap.h>
 #include <prevector.h>
 #include <support/allocators/pool.h>
+#include <util/flatnodemap.h>
 
 #include <cassert>
 #include <cstdlib>
@@ -215,6 +216,37 @@ static inline size_t DynamicUsage(const std::unordered_map<Key,
     return usage_resource + usage_chunks + MallocUsage(sizeof(void*) * m.bucket_count());
 }
 
+template <class Key, class T, class Hash, class Pred, class Alloc>
+static inline size_t FlatNodeMapIndexUsage(const FlatNodeMap<Key, T, Hash, Pred, Alloc>& m)
+{
+    // One control byte and one node pointer per slot
+    return MallocUsage(m.bucket_count()) + MallocUsage(sizeof(void*) * m.bucket_count());
+}
+
+template <class Key, class T, class Hash, class Pred>
+static inline size_t DynamicUsage(const FlatNodeMap<Key, T, Hash, Pred>& m)
+{
+    return MallocUsage(sizeof(std::pair<const Key, T>)) * m.size() + FlatNodeMapIndexUsage(m);
+}
+
+template <class Key, class T, class Hash, class Pred, std::size_t MAX_BLOCK_SIZE_BYTES, std::size_t ALIGN_BYTES>
+static inline size_t DynamicUsage(const FlatNodeMap<Key,
+                                                    T,
+                                                    Hash,
+                                                    Pred,
+                                                    PoolAllocator<std::pair<const Key, T>,
+                                                                  MAX_BLOCK_SIZE_BYTES,
+                                                                  ALIGN_BYTES>>& m)
+{
+    auto* pool_resource = m.get_allocator().resource();
+
+    // See the std::unordered_map overload above.
+    size_t estimated_list_node_size = MallocUsage(sizeof(void*) * 3);
+    size_t usage_resource = estimated_list_node_size * pool_resource->NumAllocatedChunks();
+    size_t usage_chunks = MallocUsage(pool_resource->ChunkSizeBytes()) * pool_resource->NumAllocatedChunks();
+    return usage_resource + usage_chunks + FlatNodeMapIndexUsage(m);
+}
+
 } // namespace memusage
 
 #endif // BITCOIN_MEMUSAGE_H
@@ -16,6 +16,7 @@
 #include <compat/compat.h>
 #include <consensus/consensus.h>
 #include <crypto/sha256.h>
+#include <httpseed.h>
 #include <i2p.h>
 #include <key.h>
 #include <logging.h>
@@ -28,6 +29,7 @@
 #include <protocol.h>
 #include <random.h>
 #include <scheduler.h>
+#include <util/chaintype.h>
 #include <util/fs.h>
 #include <util/sock.h>
 #include <util/strencodings.h>
@@ -2256,6 +2258,12 @@ void CConnman::WakeMessageHandler()
 void CConnman::ThreadDNSAddressSeed()
 {
     int outbound_connection_count = 0;
+    FastRandomContext rng;
+
+    const std::vector<std::string> httpSeeds{gArgs.IsArgSet("-httpseed") ? gArgs.GetArgs("-httpseed") : m_params.HTTPSeeds()};
+    // Start from the last good HTTP seed response, so a restart does not have
+    // to wait for the seeds to answer.
+    if (!httpSeeds.empty()) LoadHTTPSeedCache(rng);
 
     if (!gArgs.GetArgs("-seednode").empty()) {
         auto start = NodeClock::now();
@@ -2281,7 +2289,6 @@ void CConnman::ThreadDNSAddressSeed()
         }
     }
 
-    FastRandomContext rng;
     std::vector<std::string> seeds = m_params.DNSSeeds();
     std::shuffle(seeds.begin(), seeds.end(), rng);
     int seeds_right_now = 0; // Number of seeds left before testing if we have enough connections
@@ -2394,7 +2401,6 @@ void CConnman::ThreadDNSAddressSeed()
     
     // Query HTTP seeds if available
     // Check current connection count, not stale outbound_connection_count
-    std::vector<std::string> httpSeeds = m_params.HTTPSeeds();
     int current_outbound = GetFullOutboundConnCount();
     if (!httpSeeds.empty()) {
         if (current_outbound < SEED_OUTBOUND_CONNECTION_THRESHOLD) {
@@ -2408,135 +2414,52 @@ void CConnman::ThreadDNSAddressSeed()
 
 void CConnman::ThreadHTTPAddressSeed(const std::vector<std::string>& httpSeeds, FastRandomContext& rng)
 {
+    LogInfo("Loading addresses from %d HTTP seeds\n", httpSeeds.size());
+    const auto responses{FetchHTTPSeeds(httpSeeds, HTTP_SEED_TIMEOUT, /*allow_http=*/m_params.GetChainType() == ChainType::REGTEST, *m_interrupt_net)};
+
     int found = 0;
-    
-    for (const std::string& seedUrl : httpSeeds) {
-        if (m_interrupt_net->interrupted()) return;
-        
-        if (GetFullOutboundConnCount() >= SEED_OUTBOUND_CONNECTION_THRESHOLD) {
-            LogInfo("%d addresses found from HTTP seeds\n", found);
-            return;
-        }
-        
-        LogInfo("Loading addresses from HTTP seed %s\n", seedUrl);
-        
-        // Fetch JSON from HTTP seed
-        std::string jsonResponse;
-        if (!FetchHTTPSeed(seedUrl, jsonResponse)) {
-            LogInfo("Failed to fetch HTTP seed %s (curl may not be installed or URL unreachable)\n", seedUrl);
+    const std::string* last_good{nullptr};
+    for (size_t i = 0; i < httpSeeds.size(); ++i) {
+        if (!responses[i]) {
+            LogInfo("Failed to fetch HTTP seed %s\n", httpSeeds[i]);
             continue;
         }
-        
-        LogInfo("Successfully fetched HTTP seed response (%zu bytes)\n", jsonResponse.size());
-        
-        // Parse JSON and extract node addresses
         std::vector<CAddress> vAdd;
-        if (ParseHTTPSeedResponse(jsonResponse, vAdd, rng)) {
-            if (!vAdd.empty()) {
-                CNetAddr resolveSource;
-                resolveSource.SetInternal("httpseed");
-                addrman.Add(vAdd, resolveSource);
-                found += vAdd.size();
-                LogInfo("Added %d addresses from HTTP seed %s\n", vAdd.size(), seedUrl);
-            }
+        if (!ParseHTTPSeedResponse(*responses[i], vAdd, rng)) {
+            LogInfo("Invalid response from HTTP seed %s\n", httpSeeds[i]);
+            continue;
+        }
+        last_good = &*responses[i];
+        if (!vAdd.empty()) {
+            CNetAddr resolveSource;
+            resolveSource.SetInternal("httpseed");
+            addrman.Add(vAdd, resolveSource);
+            found += vAdd.size();
+            LogInfo("Added %d addresses from HTTP seed %s\n", vAdd.size(), httpSeeds[i]);
         }
     }
-    
-    if (found > 0) {
-        LogInfo("%d addresses found from HTTP seeds\n", found);
-    }
-}
 
-/** Validate URL contains only safe characters to prevent shell injection.
- *  Only allows: alphanumeric, dots, hyphens, underscores, slashes, colons, 
- *  question marks, equals, ampersands, percent (for URL encoding).
- */
-static bool IsValidHTTPSeedURL(const std::string& url)
-{
-    // Must start with https://
-    if (url.size() < 9 || url.substr(0, 8) != "https://") {
-        return false;
+    if (last_good && !WriteHTTPSeedCache(gArgs.GetDataDirNet() / HTTP_SEED_CACHE_FILENAME, *last_good)) {
+        LogWarning("Failed to write %s", HTTP_SEED_CACHE_FILENAME);
     }
-    
-    // Check each character after https://
-    for (size_t i = 8; i < url.size(); ++i) {
-        char c = url[i];
-        // Allow: alphanumeric, safe URL characters
-        bool safe = (c >= 'a' && c <= 'z') ||
-                    (c >= 'A' && c <= 'Z') ||
-                    (c >= '0' && c <= '9') ||
-                    c == '.' || c == '-' || c == '_' ||
-                    c == '/' || c == ':' || c == '?' ||
-                    c == '=' || c == '&' || c == '%' ||
-                    c == '+' || c == '#';
-        if (!safe) {
-            return false;
-        }
-    }
-    
-    // Reject URLs with suspicious patterns that could be shell injection attempts
-    // Even with valid chars, patterns like $( or ` should not appear in URLs
-    if (url.find("$(") != std::string::npos ||
-        url.find('`') != std::string::npos ||
-        url.find("${") != std::string::npos ||
-        url.find('\n') != std::string::npos ||
-        url.find('\r') != std::string::npos ||
-        url.find(';') != std::string::npos ||
-        url.find('|') != std::string::npos ||
-        url.find('<') != std::string::npos ||
-        url.find('>') != std::string::npos ||
-        url.find('"') != std::string::npos ||
-        url.find('\'') != std::string::npos ||
-        url.find('\\') != std::string::npos) {
-        return false;
+    if (found > 0) {
+        LogInfo("%d addresses found from HTTP seeds\n", found);
     }
-    
-    return true;
 }
 
-bool CConnman::FetchHTTPSeed(const std::string& url, std::string& response)
+void CConnman::LoadHTTPSeedCache(FastRandomContext& rng)
 {
-    // Simple HTTP fetch using system curl
-    // Note: Requires curl to be installed. Can be improved with libcurl later.
-    
-    // SECURITY: Strict URL validation to prevent shell injection
-    if (!IsValidHTTPSeedURL(url)) {
-        LogInfo("HTTP seed URL rejected (invalid format or unsafe characters): %s\n", url);
-        return false;
-    }
-    
-    // URL is validated - safe to use in shell command
-    // Platform-specific command construction
-#ifdef WIN32
-    // Windows: use double quotes and redirect stderr to NUL
-    std::string command = "curl -s --max-time 10 --connect-timeout 5 --fail \"" + url + "\" 2>NUL";
-    FILE* pipe = _popen(command.c_str(), "r");
-#else
-    // Unix: use single quotes and redirect stderr to /dev/null
-    std::string command = "curl -s --max-time 10 --connect-timeout 5 --fail '" + url + "' 2>/dev/null";
-    FILE* pipe = popen(command.c_str(), "r");
-#endif
-    if (!pipe) {
-        return false;
-    }
-    
-    char buffer[4096];
-    response.clear();
-    while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-        response += buffer;
-    }
-    
-#ifdef WIN32
-    int status = _pclose(pipe);
-#else
-    int status = pclose(pipe);
-#endif
-    // Check if curl succeeded and we got a response
-    if (status != 0 || response.empty()) {
-        return false;
+    const auto response{ReadHTTPSeedCache(gArgs.GetDataDirNet() / HTTP_SEED_CACHE_FILENAME)};
+    if (!response) return;
+    std::vector<CAddress> vAdd;
+    if (!ParseHTTPSeedResponse(*response, vAdd, rng)) {
+        LogInfo("Ignoring invalid %s\n", HTTP_SEED_CACHE_FILENAME);
+        return;
     }
-    
-    return true;
+    CNetAddr resolveSource;
+    resolveSource.SetInternal("httpseed");
+    addrman.Add(vAdd, resolveSource);
+    LogInfo("Loaded %d addresses from the HTTP seed cache\n", vAdd.size());
 }
 
 bool CConnman::ParseHTTPSeedResponse(const std::string& json, std::vector<CAddress>& addresses, FastRandomContext& rng)
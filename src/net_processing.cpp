@@ -30,6 +30,7 @@
 #include <netaddress.h>
 #include <netbase.h>
 #include <netmessagemaker.h>
+#include <node/blockservecache.h>
 #include <node/blockstorage.h>
 #include <node/connection_types.h>
 #include <node/protocol_version.h>
@@ -645,7 +646,7 @@ private:
         EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_headers_presync_mutex, g_msgproc_mutex);
     /** Various helpers for headers processing, invoked by ProcessHeadersMessage() */
     /** Return true if headers are continuous and have valid proof-of-work (DoS points assigned on failure) */
-    bool CheckHeadersPoW(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, Peer& peer);
+    bool CheckHeadersPoW(const std::vector<CBlockHeader>& headers, Peer& peer);
     /** Calculate an anti-DoS work threshold for headers chains */
     arith_uint256 GetAntiDoSWorkThreshold();
     /** Deal with state tracking and headers sync for peers that send
@@ -855,6 +856,9 @@ private:
     uint256 m_most_recent_block_hash GUARDED_BY(m_most_recent_block_mutex);
     std::unique_ptr<const std::map<GenTxid, CTransactionRef>> m_most_recent_block_txs GUARDED_BY(m_most_recent_block_mutex);
 
+    /** Blocks other than the most recent one, as last serialized for a peer */
+    node::BlockServeCache m_block_serve_cache;
+
     // Data about the low-work headers synchronization, aggregated from all peers' HeadersSyncStates.
     /** Mutex guarding the other m_headers_presync_* variables. */
     Mutex m_headers_presync_mutex;
@@ -1765,6 +1769,7 @@ PeerManagerInfo PeerManagerImpl::GetInfo() const
     return PeerManagerInfo{
         .median_outbound_time_offset = m_outbound_time_offsets.Median(),
         .ignores_incoming_txs = m_opts.ignore_incoming_txs,
+        .block_serve_cache = m_block_serve_cache.GetStats(),
     };
 }
 
@@ -1901,7 +1906,8 @@ PeerManagerImpl::PeerManagerImpl(CConnman& connman, AddrMan& addrman,
       m_mempool(pool),
       m_txdownloadman(node::TxDownloadOptions{pool, m_rng, opts.deterministic_rng}),
       m_warnings{warnings},
-      m_opts{opts}
+      m_opts{opts},
+      m_block_serve_cache{opts.block_serve_cache_bytes}
 {
     // While Erlay support is incomplete, it must be enabled explicitly via -txreconciliation.
     // This argument can go away after Erlay support is complete.
@@ -2196,6 +2202,15 @@ void PeerManagerImpl::RelayAddress(NodeId originator,
     }
 }
 
+/** Serialize a block message payload for the block serve cache. */
+template <typename T>
+static node::BlockServeCache::Payload SerializeBlockPayload(const T& obj)
+{
+    DataStream stream;
+    stream << obj;
+    return std::make_shared<const std::vector<std::byte>>(stream.begin(), stream.end());
+}
+
 void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv& inv)
 {
     std::shared_ptr<const CBlock> a_recent_block;
@@ -2271,26 +2286,55 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
         block_pos = pindex->GetBlockPos();
     }
 
+    // If a peer is asking for old blocks, we're almost guaranteed
+    // they won't have a useful mempool to match against a compact block,
+    // and we don't feel like constructing the object for them, so
+    // instead we respond with the full, non-compact block.
+    const bool send_compact{inv.IsMsgCmpctBlk() && can_direct_fetch && pindex->nHeight >= tip->nHeight - MAX_CMPCTBLOCK_DEPTH};
+    // The format the block is sent in, unless it is a filtered block
+    std::optional<node::BlockServeCache::Format> format;
+    if (inv.IsMsgBlk()) {
+        format = node::BlockServeCache::Format::NO_WITNESS;
+    } else if (inv.IsMsgWitnessBlk() || (inv.IsMsgCmpctBlk() && !send_compact)) {
+        format = node::BlockServeCache::Format::WITNESS;
+    } else if (send_compact) {
+        format = node::BlockServeCache::Format::COMPACT;
+    }
+
     std::shared_ptr<const CBlock> pblock;
     if (a_recent_block && a_recent_block->GetHash() == inv.hash) {
         pblock = a_recent_block;
-    } else if (inv.IsMsgWitnessBlk()) {
-        // Fast-path: in this case it is possible to serve the block directly from disk,
-        // as the network format matches the format on disk
-        if (const auto block_data{m_chainman.m_blockman.ReadRawBlock(block_pos)}) {
-            MakeAndPushMessage(pfrom, NetMsgType::BLOCK, std::span{*block_data});
-        } else {
-            if (WITH_LOCK(m_chainman.GetMutex(), return m_chainman.m_blockman.IsBlockPruned(*pindex))) {
-                LogDebug(BCLog::NET, "Block was pruned before it could be read, %s\n", pfrom.DisconnectMsg(fLogIPs));
-            } else {
-                LogError("Cannot load block from disk, %s\n", pfrom.DisconnectMsg(fLogIPs));
+    } else if (format) {
+        // Other blocks are often fetched by many peers in a row (when they
+        // sync from us), so keep them serialized and share them across peers.
+        auto payload{m_block_serve_cache.Get(inv.hash, *format)};
+        if (!payload) {
+            if (*format == node::BlockServeCache::Format::WITNESS) {
+                // Fast-path: in this case it is possible to serve the block directly from disk,
+                // as the network format matches the format on disk
+                if (auto block_data{m_chainman.m_blockman.ReadRawBlock(block_pos)}) {
+                    payload = std::make_shared<const std::vector<std::byte>>(std::move(*block_data));
+                }
+            } else if (CBlock block; m_chainman.m_blockman.ReadBlock(block, block_pos, inv.hash)) {
+                payload = *format == node::BlockServeCache::Format::COMPACT ?
+                              SerializeBlockPayload(CBlockHeaderAndShortTxIDs{block, m_rng.rand64()}) :
+                              SerializeBlockPayload(TX_NO_WITNESS(block));
             }
-            pfrom.fDisconnect = true;
-            return;
+            if (!payload) {
+                if (WITH_LOCK(m_chainman.GetMutex(), return m_chainman.m_blockman.IsBlockPruned(*pindex))) {
+                    LogDebug(BCLog::NET, "Block was pruned before it could be read, %s\n", pfrom.DisconnectMsg(fLogIPs));
+                } else {
+                    LogError("Cannot load block from disk, %s\n", pfrom.DisconnectMsg(fLogIPs));
+                }
+                pfrom.fDisconnect = true;
+                return;
+            }
+            m_block_serve_cache.Add(inv.hash, *format, payload);
         }
+        MakeAndPushMessage(pfrom, *format == node::BlockServeCache::Format::COMPACT ? NetMsgType::CMPCTBLOCK : NetMsgType::BLOCK, std::span{*payload});
         // Don't set pblock as we've sent the block
     } else {
-        // Send block from disk
+        // Send filtered block from disk
         std::shared_ptr<CBlock> pblockRead = std::make_shared<CBlock>();
         if (!m_chainman.m_blockman.ReadBlock(*pblockRead, block_pos, inv.hash)) {
             if (WITH_LOCK(m_chainman.GetMutex(), return m_chainman.m_blockman.IsBlockPruned(*pindex))) {
@@ -2332,11 +2376,7 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
             // else
             // no response
         } else if (inv.IsMsgCmpctBlk()) {
-            // If a peer is asking for old blocks, we're almost guaranteed
-            // they won't have a useful mempool to match against a compact block,
-            // and we don't feel like constructing the object for them, so
-            // instead we respond with the full, non-compact block.
-            if (can_direct_fetch && pindex->nHeight >= tip->nHeight - MAX_CMPCTBLOCK_DEPTH) {
+            if (send_compact) {
                 if (a_recent_compact_block && a_recent_compact_block->header.GetHash() == inv.hash) {
                     MakeAndPushMessage(pfrom, NetMsgType::CMPCTBLOCK, *a_recent_compact_block);
                 } else {
@@ -2485,10 +2525,10 @@ void PeerManagerImpl::SendBlockTransactions(CNode& pfrom, Peer& peer, const CBlo
     MakeAndPushMessage(pfrom, NetMsgType::BLOCKTXN, resp);
 }
 
-bool PeerManagerImpl::CheckHeadersPoW(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, Peer& peer)
+bool PeerManagerImpl::CheckHeadersPoW(const std::vector<CBlockHeader>& headers, Peer& peer)
 {
     // Do these headers have proof-of-work matching what's claimed?
-    if (!HasValidProofOfWork(headers, consensusParams)) {
+    if (!m_chainman.HasValidProofOfWork(headers)) {
         Misbehaving(peer, "header with invalid proof of work");
         return false;
     }
@@ -2853,7 +2893,7 @@ void PeerManagerImpl::ProcessHeadersMessage(CNode& pfrom, Peer& peer,
     // We'll rely on headers having valid proof-of-work further down, as an
     // anti-DoS criteria (note: this check is required before passing any
     // headers into HeadersSyncState).
-    if (!CheckHeadersPoW(headers, m_chainparams.GetConsensus(), peer)) {
+    if (!CheckHeadersPoW(headers, peer)) {
         // Misbehaving() calls are handled within CheckHeadersPoW(), so we can
         // just return. (Note that even if a header is announced via compact
         // block, the header itself should be valid, so this type of error can
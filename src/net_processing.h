@@ -8,6 +8,7 @@
 
 #include <consensus/amount.h>
 #include <net.h>
+#include <node/blockservecache.h>
 #include <node/txorphanage.h>
 #include <protocol.h>
 #include <threadsafety.h>
@@ -69,6 +70,7 @@ struct CNodeStateStats {
 struct PeerManagerInfo {
     std::chrono::seconds median_outbound_time_offset{0s};
     bool ignores_incoming_txs{false};
+    node::BlockServeCacheStats block_serve_cache;
 };
 
 class PeerManager : public CValidationInterface, public NetEventsInterface
@@ -90,6 +92,8 @@ public:
         //! Number of headers sent in one getheaders message result (this is
         //! a test-only option).
         uint32_t max_headers_result{MAX_HEADERS_RESULTS};
+        //! Size of the cache of blocks served to peers, in bytes
+        size_t block_serve_cache_bytes{node::DEFAULT_BLOCK_SERVE_CACHE_SIZE << 20};
     };
 
     static std::unique_ptr<PeerManager> make(CConnman& connman, AddrMan& addrman,
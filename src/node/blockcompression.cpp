@@ -0,0 +1,212 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/blockcompression.h>
+
+#include <compressor.h>
+#include <consensus/amount.h>
+#include <primitives/block.h>
+#include <primitives/transaction.h>
+#include <script/script.h>
+#include <serialize.h>
+#include <uint256.h>
+
+#include <algorithm>
+#include <array>
+#include <ios>
+
+namespace node {
+namespace {
+/** Serialized size of a block header */
+constexpr size_t BLOCK_HEADER_SIZE{80};
+
+/** An output script made of a fixed prefix, payload_size variable bytes and a fixed suffix */
+struct ScriptTemplate {
+    std::array<uint8_t, 3> prefix;
+    uint8_t prefix_size;
+    uint8_t payload_size;
+    std::array<uint8_t, 2> suffix;
+    uint8_t suffix_size;
+
+    size_t size() const { return prefix_size + payload_size + suffix_size; }
+
+    bool Matches(const CScript& script) const
+    {
+        return script.size() == size() &&
+               std::equal(prefix.begin(), prefix.begin() + prefix_size, script.begin()) &&
+               std::equal(suffix.begin(), suffix.begin() + suffix_size, script.end() - suffix_size);
+    }
+};
+
+/** Output scripts stored as their number in this list and their payload. The numbers are part of the format. */
+constexpr std::array<ScriptTemplate, 6> SCRIPT_TEMPLATES{{
+    {{OP_DUP, OP_HASH160, 20}, 3, 20, {OP_EQUALVERIFY, OP_CHECKSIG}, 2}, // P2PKH
+    {{OP_HASH160, 20}, 2, 20, {OP_EQUAL}, 1},                             // P2SH
+    {{OP_0, 20}, 2, 20, {}, 0},                                           // P2WPKH
+    {{OP_0, 32}, 2, 32, {}, 0},                                           // P2WSH
+    {{OP_1, 32}, 2, 32, {}, 0},                                           // P2TR
+    {{33}, 1, 33, {OP_CHECKSIG}, 1},                                      // P2PK with a compressed key
+}};
+
+/** Input sequences stored as their number in this list. Others are stored in full after the next number. */
+constexpr std::array<uint32_t, 3> SEQUENCES{CTxIn::SEQUENCE_FINAL, CTxIn::MAX_SEQUENCE_NONFINAL, CTxIn::MAX_SEQUENCE_NONFINAL - 1};
+
+/** Appends serialized data to a byte vector. */
+class ByteWriter
+{
+    std::vector<std::byte>& m_data;
+
+public:
+    explicit ByteWriter(std::vector<std::byte>& data) : m_data{data} {}
+
+    void write(std::span<const std::byte> src) { m_data.insert(m_data.end(), src.begin(), src.end()); }
+
+    template <typename T>
+    ByteWriter& operator<<(const T& obj)
+    {
+        ::Serialize(*this, obj);
+        return *this;
+    }
+
+    /** Append the next size bytes of reader. */
+    void Copy(SpanReader& reader, size_t size)
+    {
+        const size_t pos{m_data.size()};
+        m_data.resize(pos + size);
+        reader.read(std::span{m_data}.subspan(pos));
+    }
+
+    /** Append a length-prefixed byte vector read from reader, as it is serialized in a transaction. */
+    void CopyVector(SpanReader& reader)
+    {
+        const uint64_t size{ReadCompactSize(reader)};
+        WriteCompactSize(*this, size);
+        Copy(reader, size);
+    }
+};
+
+void CompressTransaction(DataStream& s, const CTransaction& tx)
+{
+    const bool witness{tx.HasWitness()};
+    s << VARINT(tx.version) << uint8_t{witness};
+    WriteCompactSize(s, tx.vin.size());
+    for (const CTxIn& in : tx.vin) {
+        // The null index of a coinbase input wraps around to 0.
+        s << in.prevout.hash << VARINT(uint32_t(in.prevout.n + 1)) << in.scriptSig;
+        const auto sequence{std::ranges::find(SEQUENCES, in.nSequence)};
+        s << uint8_t(sequence - SEQUENCES.begin());
+        if (sequence == SEQUENCES.end()) s << in.nSequence;
+    }
+    WriteCompactSize(s, tx.vout.size());
+    for (const CTxOut& out : tx.vout) {
+        if (MoneyRange(out.nValue)) {
+            s << VARINT(CompressAmount(out.nValue) + 1);
+        } else {
+            s << VARINT(uint64_t{0}) << out.nValue;
+        }
+        const auto it{std::ranges::find_if(SCRIPT_TEMPLATES, [&](const ScriptTemplate& t) { return t.Matches(out.scriptPubKey); })};
+        if (it != SCRIPT_TEMPLATES.end()) {
+            s << VARINT(uint64_t(it - SCRIPT_TEMPLATES.begin())) << std::span{out.scriptPubKey}.subspan(it->prefix_size, it->payload_size);
+        } else {
+            s << VARINT(uint64_t(out.scriptPubKey.size() + SCRIPT_TEMPLATES.size())) << std::span{out.scriptPubKey};
+        }
+    }
+    if (witness) {
+        for (const CTxIn& in : tx.vin) s << in.scriptWitness.stack;
+    }
+    s << VARINT(tx.nLockTime);
+}
+
+void DecompressTransaction(SpanReader& r, ByteWriter& w)
+{
+    uint32_t version;
+    uint8_t witness;
+    r >> VARINT(version) >> witness;
+    if (witness > 1) throw std::ios_base::failure("unknown compressed transaction flags");
+    w << version;
+    // Extended format marker and flags
+    if (witness) w << uint8_t{0} << uint8_t{1};
+
+    const uint64_t num_inputs{ReadCompactSize(r)};
+    WriteCompactSize(w, num_inputs);
+    for (uint64_t i{0}; i < num_inputs; ++i) {
+        w.Copy(r, uint256::size());
+        uint32_t n;
+        r >> VARINT(n);
+        w << uint32_t(n - 1);
+        w.CopyVector(r);
+        uint8_t sequence;
+        r >> sequence;
+        if (sequence < SEQUENCES.size()) {
+            w << SEQUENCES[sequence];
+        } else if (sequence == SEQUENCES.size()) {
+            w.Copy(r, sizeof(uint32_t));
+        } else {
+            throw std::ios_base::failure("unknown compressed sequence");
+        }
+    }
+
+    const uint64_t num_outputs{ReadCompactSize(r)};
+    WriteCompactSize(w, num_outputs);
+    for (uint64_t i{0}; i < num_outputs; ++i) {
+        uint64_t amount;
+        r >> VARINT(amount);
+        if (amount == 0) {
+            w.Copy(r, sizeof(CAmount));
+        } else {
+            w << CAmount(DecompressAmount(amount - 1));
+        }
+        uint64_t script;
+        r >> VARINT(script);
+        if (script < SCRIPT_TEMPLATES.size()) {
+            const ScriptTemplate& t{SCRIPT_TEMPLATES[script]};
+            WriteCompactSize(w, t.size());
+            w.write(std::as_bytes(std::span{t.prefix}.first(t.prefix_size)));
+            w.Copy(r, t.payload_size);
+            w.write(std::as_bytes(std::span{t.suffix}.first(t.suffix_size)));
+        } else {
+            const uint64_t size{script - SCRIPT_TEMPLATES.size()};
+            if (size > MAX_SIZE) throw std::ios_base::failure("compressed script too large");
+            WriteCompactSize(w, size);
+            w.Copy(r, size);
+        }
+    }
+
+    if (witness) {
+        for (uint64_t i{0}; i < num_inputs; ++i) {
+            const uint64_t num_items{ReadCompactSize(r)};
+            WriteCompactSize(w, num_items);
+            for (uint64_t j{0}; j < num_items; ++j) w.CopyVector(r);
+        }
+    }
+
+    uint32_t lock_time;
+    r >> VARINT(lock_time);
+    w << lock_time;
+}
+} // namespace
+
+DataStream CompressBlock(const CBlock& block)
+{
+    DataStream s;
+    s << static_cast<const CBlockHeader&>(block);
+    WriteCompactSize(s, block.vtx.size());
+    for (const auto& tx : block.vtx) CompressTransaction(s, *tx);
+    return s;
+}
+
+std::vector<std::byte> DecompressBlock(std::span<const std::byte> data)
+{
+    SpanReader r{data};
+    std::vector<std::byte> out;
+    out.reserve(data.size() * 3 / 2);
+    ByteWriter w{out};
+    w.Copy(r, BLOCK_HEADER_SIZE);
+    const uint64_t num_txs{ReadCompactSize(r)};
+    WriteCompactSize(w, num_txs);
+    for (uint64_t i{0}; i < num_txs; ++i) DecompressTransaction(r, w);
+    if (!r.empty()) throw std::ios_base::failure("data after the compressed block");
+    return out;
+}
+} // namespace node
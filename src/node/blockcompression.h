@@ -0,0 +1,48 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_BLOCKCOMPRESSION_H
+#define BITCOIN_NODE_BLOCKCOMPRESSION_H
+
+#include <streams.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class CBlock;
+
+namespace node {
+/**
+ * Set in the size field of a block file record whose data is a compressed
+ * block. Block sizes are far below it, so records of both kinds can share a
+ * file, and a file written before -blockscompress was set stays readable.
+ */
+static constexpr uint32_t COMPRESSED_BLOCK_RECORD{1U << 31};
+
+/**
+ * Compressed serialization of a block, for storage in block files.
+ *
+ * Each block is compressed on its own, so a record is still read from its
+ * position alone. The header is stored as is, so that a block file can be
+ * scanned for the headers without decompressing the blocks. Transactions are
+ * stored field by field, as for the coins in compressor.h: standard output
+ * scripts (P2PKH, P2SH, P2WPKH, P2WSH, P2TR and compressed P2PK) as a one
+ * byte template number and their hash or key, amounts with CompressAmount(),
+ * and input indexes, versions, sequences and lock times as VARINTs or short
+ * codes. Unlike ScriptCompression it is lossless for any script, as the block
+ * must hash the same once decompressed.
+ */
+DataStream CompressBlock(const CBlock& block);
+
+/**
+ * The network serialization (with witness data) of a compressed block.
+ *
+ * @throws std::ios_base::failure if the data is not a compressed block
+ */
+std::vector<std::byte> DecompressBlock(std::span<const std::byte> data);
+} // namespace node
+
+#endif // BITCOIN_NODE_BLOCKCOMPRESSION_H
@@ -0,0 +1,119 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/blockfilescanner.h>
+
+#include <consensus/consensus.h>
+#include <logging.h>
+#include <node/blockcompression.h>
+#include <node/blockstorage.h>
+#include <primitives/block.h>
+#include <streams.h>
+#include <tinyformat.h>
+#include <util/signalinterrupt.h>
+#include <util/threadnames.h>
+
+#include <algorithm>
+#include <exception>
+
+namespace node {
+std::vector<ScannedBlock> ScanBlockFile(AutoFile& file, int file_num, const MessageStartChars& message_start, const util::SignalInterrupt& interrupt)
+{
+    std::vector<ScannedBlock> blocks;
+    try {
+        BufferedFile blkdat{file, 2 * MAX_BLOCK_SERIALIZED_SIZE, MAX_BLOCK_SERIALIZED_SIZE + 8};
+        uint64_t rewind{blkdat.GetPos()};
+        while (!blkdat.eof()) {
+            if (interrupt) break;
+
+            blkdat.SetPos(rewind);
+            rewind++; // start one byte further next time, in case of failure
+            blkdat.SetLimit();
+            unsigned int size{0};
+            try {
+                MessageStartChars buf;
+                blkdat.FindByte(std::byte(message_start[0]));
+                rewind = blkdat.GetPos() + 1;
+                blkdat >> buf;
+                if (buf != message_start) continue;
+                blkdat >> size;
+                size &= ~COMPRESSED_BLOCK_RECORD;
+                if (size < 80 || size > MAX_BLOCK_SERIALIZED_SIZE) continue;
+            } catch (const std::exception&) {
+                // No more blocks (this happens at the end of every blk.dat file)
+                break;
+            }
+            try {
+                const uint64_t block_pos{blkdat.GetPos()};
+                blkdat.SetLimit(block_pos + size);
+                CBlockHeader header;
+                blkdat >> header;
+                rewind = block_pos + size;
+                // Make sure the whole block is in the file.
+                blkdat.SkipTo(rewind);
+                blocks.push_back({.hash = header.GetHash(), .prev_hash = header.hashPrevBlock, .pos = {file_num, static_cast<unsigned int>(block_pos)}, .size = size});
+            } catch (const std::exception& e) {
+                LogDebug(BCLog::REINDEX, "%s: unexpected data at file offset 0x%x - %s. continuing", __func__, (rewind - 1), e.what());
+            }
+        }
+    } catch (const std::runtime_error& e) {
+        LogWarning("Failed to scan block file blk%05u.dat: %s", file_num, e.what());
+    }
+    return blocks;
+}
+
+BlockFileScanner::BlockFileScanner(const BlockManager& blockman, const MessageStartChars& message_start, int num_files, int threads, const util::SignalInterrupt& interrupt)
+    : m_blockman{blockman}, m_message_start{message_start}, m_num_files{num_files}, m_max_ahead{2 * std::max(threads, 1)}, m_interrupt{interrupt}
+{
+    for (int n{0}; n < std::clamp(threads, 1, std::max(num_files, 1)); ++n) {
+        m_threads.emplace_back([this, n] {
+            util::ThreadRename(strprintf("blockscan.%i", n));
+            ThreadScan();
+        });
+    }
+}
+
+BlockFileScanner::~BlockFileScanner()
+{
+    WITH_LOCK(m_mutex, m_stop = true);
+    m_cv.notify_all();
+    for (auto& thread : m_threads) thread.join();
+}
+
+std::optional<std::vector<ScannedBlock>> BlockFileScanner::Next()
+{
+    WAIT_LOCK(m_mutex, lock);
+    if (m_next_file >= m_num_files) return std::nullopt;
+    const int file_num{m_next_file};
+    m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_scanned.contains(file_num); });
+    auto node{m_scanned.extract(file_num)};
+    ++m_next_file;
+    m_cv.notify_all();
+    return std::move(node.mapped());
+}
+
+void BlockFileScanner::ThreadScan()
+{
+    WAIT_LOCK(m_mutex, lock);
+    while (true) {
+        m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) {
+            return m_stop || m_next_scan >= m_num_files || m_next_scan < m_next_file + m_max_ahead;
+        });
+        if (m_stop || m_next_scan >= m_num_files) return;
+        const int file_num{m_next_scan++};
+
+        std::optional<std::vector<ScannedBlock>> blocks;
+        {
+            REVERSE_LOCK(lock, m_mutex);
+            // A file that cannot be opened is logged in OpenBlockFile, and ends the reindex.
+            AutoFile file{m_blockman.OpenBlockFile({file_num, 0}, /*fReadOnly=*/true)};
+            if (!file.IsNull()) {
+                blocks = ScanBlockFile(file, file_num, m_message_start, m_interrupt);
+            }
+        }
+        m_scanned.emplace(file_num, std::move(blocks));
+        m_cv.notify_all();
+    }
+}
+} // namespace node
@@ -0,0 +1,92 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_BLOCKFILESCANNER_H
+#define BITCOIN_NODE_BLOCKFILESCANNER_H
+
+#include <flatfile.h>
+#include <kernel/messagestartchars.h>
+#include <sync.h>
+#include <uint256.h>
+
+#include <condition_variable>
+#include <map>
+#include <optional>
+#include <thread>
+#include <vector>
+
+class AutoFile;
+
+namespace util {
+class SignalInterrupt;
+} // namespace util
+
+namespace node {
+class BlockManager;
+
+/** A block found in a block file */
+struct ScannedBlock {
+    uint256 hash;
+    uint256 prev_hash;
+    //! Position of the block data, after the message start and size
+    FlatFilePos pos;
+    //! Size of the block data as stored, compressed or not
+    unsigned int size{0};
+};
+
+/**
+ * Find the blocks in a block file, the way LoadExternalBlockFile() does,
+ * only reading and hashing their headers.
+ */
+std::vector<ScannedBlock> ScanBlockFile(AutoFile& file, int file_num, const MessageStartChars& message_start, const util::SignalInterrupt& interrupt);
+
+/**
+ * Scans the block files for -reindex on several threads, and hands out their
+ * blocks file by file, in order.
+ *
+ * Each thread scans the next file nobody has started on, up to
+ * 2 * threads files ahead of the one being indexed, so that the scan of
+ * the next files (the disk reads and header hashing) overlaps with indexing
+ * the current one.
+ */
+class BlockFileScanner
+{
+public:
+    BlockFileScanner(const BlockManager& blockman, const MessageStartChars& message_start, int num_files, int threads, const util::SignalInterrupt& interrupt);
+    ~BlockFileScanner();
+
+    BlockFileScanner(const BlockFileScanner&) = delete;
+    BlockFileScanner& operator=(const BlockFileScanner&) = delete;
+
+    /**
+     * The blocks of the next file, waiting for its scan if needed.
+     *
+     * @returns the blocks, or std::nullopt if there are no more files or the
+     *          file could not be opened
+     */
+    std::optional<std::vector<ScannedBlock>> Next() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    void ThreadScan() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    const BlockManager& m_blockman;
+    const MessageStartChars m_message_start;
+    const int m_num_files;
+    const int m_max_ahead;
+    const util::SignalInterrupt& m_interrupt;
+
+    Mutex m_mutex;
+    std::condition_variable m_cv;
+    //! Next file to scan
+    int m_next_scan GUARDED_BY(m_mutex){0};
+    //! Next file to hand out
+    int m_next_file GUARDED_BY(m_mutex){0};
+    //! Scanned files not handed out yet, std::nullopt if a file could not be opened
+    std::map<int, std::optional<std::vector<ScannedBlock>>> m_scanned GUARDED_BY(m_mutex);
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::vector<std::thread> m_threads;
+};
+} // namespace node
+
+#endif // BITCOIN_NODE_BLOCKFILESCANNER_H
@@ -12,6 +12,7 @@
 #include <util/translation.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <cstdint>
 
 namespace node {
@@ -34,6 +35,11 @@ util::Result<void> ApplyArgsManOptions(const ArgsManager& args, BlockManager::Op
     opts.prune_target = nPruneTarget;
 
     if (auto value{args.GetBoolArg("-fastprune")}) opts.fast_prune = *value;
+    if (auto value{args.GetBoolArg("-blocksmmap")}) opts.use_mmap = *value;
+    if (auto value{args.GetBoolArg("-blockscompress")}) opts.compress_blocks = *value;
+    if (auto value{args.GetIntArg("-reindexthreads")}) {
+        opts.reindex_threads = std::clamp<int64_t>(*value, 1, kernel::MAX_REINDEX_THREADS);
+    }
 
     ReadDatabaseArgs(args, opts.block_tree_db_params.options);
 
@@ -0,0 +1,107 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/blockreadahead.h>
+
+#include <node/blockstorage.h>
+#include <primitives/block.h>
+#include <util/threadnames.h>
+
+#include <algorithm>
+
+namespace node {
+BlockReadAhead::BlockReadAhead(const BlockManager& blockman, PrepareFn prepare, size_t depth)
+    : m_blockman{blockman}, m_prepare{std::move(prepare)}, m_depth{depth} {}
+
+BlockReadAhead::~BlockReadAhead()
+{
+    std::thread thread;
+    {
+        LOCK(m_mutex);
+        m_stop = true;
+        std::swap(thread, m_thread);
+    }
+    m_cv.notify_all();
+    if (thread.joinable()) thread.join();
+}
+
+void BlockReadAhead::Schedule(std::span<const std::pair<uint256, FlatFilePos>> blocks)
+{
+    {
+        LOCK(m_mutex);
+        std::erase_if(m_blocks, [&](const Entry& entry) {
+            return std::ranges::none_of(blocks, [&](const auto& block) { return block.first == entry.hash; });
+        });
+        for (const auto& [hash, pos] : blocks) {
+            if (m_blocks.size() >= m_depth) break;
+            if (std::ranges::any_of(m_blocks, [&](const Entry& entry) { return entry.hash == hash; })) continue;
+            m_blocks.push_back({.hash = hash, .pos = pos});
+        }
+        if (!m_blocks.empty() && !m_thread.joinable()) {
+            m_thread = std::thread{[this] {
+                util::ThreadRename("blockreadahead");
+                ThreadReadAhead();
+            }};
+        }
+    }
+    m_cv.notify_all();
+}
+
+std::shared_ptr<const CBlock> BlockReadAhead::Take(const uint256& hash)
+{
+    WAIT_LOCK(m_mutex, lock);
+    while (true) {
+        const auto it{std::ranges::find(m_blocks, hash, &Entry::hash)};
+        if (it == m_blocks.end()) return nullptr;
+        switch (it->state) {
+        case Entry::State::QUEUED:
+            // Not started: reading it on the caller is no slower.
+            m_blocks.erase(it);
+            return nullptr;
+        case Entry::State::READING:
+            m_cv.wait(lock);
+            continue;
+        case Entry::State::DONE: {
+            auto block{std::move(it->block)};
+            m_blocks.erase(it);
+            return block;
+        }
+        }
+    }
+}
+
+void BlockReadAhead::ThreadReadAhead()
+{
+    WAIT_LOCK(m_mutex, lock);
+    while (!m_stop) {
+        const auto it{std::ranges::find(m_blocks, Entry::State::QUEUED, &Entry::state)};
+        if (it == m_blocks.end()) {
+            m_cv.wait(lock);
+            continue;
+        }
+        it->state = Entry::State::READING;
+        const uint256 hash{it->hash};
+        const FlatFilePos pos{it->pos};
+
+        std::shared_ptr<CBlock> block;
+        {
+            REVERSE_LOCK(lock, m_mutex);
+            block = std::make_shared<CBlock>();
+            if (m_blockman.ReadBlock(*block, pos, hash)) {
+                m_prepare(*block);
+            } else {
+                block.reset();
+            }
+        }
+
+        // The entry may have been dropped, or taken and scheduled again, meanwhile.
+        const auto done{std::ranges::find(m_blocks, hash, &Entry::hash)};
+        if (done != m_blocks.end() && done->state == Entry::State::READING) {
+            done->state = Entry::State::DONE;
+            done->block = std::move(block);
+        }
+        m_cv.notify_all();
+    }
+}
+} // namespace node
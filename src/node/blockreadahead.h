@@ -0,0 +1,91 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_BLOCKREADAHEAD_H
+#define BITCOIN_NODE_BLOCKREADAHEAD_H
+
+#include <flatfile.h>
+#include <sync.h>
+#include <uint256.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <span>
+#include <thread>
+#include <utility>
+
+class CBlock;
+
+namespace node {
+class BlockManager;
+
+/** Maximum number of blocks read ahead of the one being connected */
+static constexpr size_t BLOCK_READ_AHEAD_DEPTH{8};
+
+/**
+ * Reads the blocks that are about to be connected on a background thread,
+ * so that reading and deserializing the next blocks overlaps with connecting
+ * the current one.
+ *
+ * Each block is passed to a prepare function once read, still on the
+ * background thread, so that context-free work on it (such as CheckBlock())
+ * is done ahead too. The thread is only started once blocks are scheduled,
+ * and it never takes cs_main: the block positions are captured by the
+ * caller.
+ */
+class BlockReadAhead
+{
+public:
+    using PrepareFn = std::function<void(CBlock&)>;
+
+    BlockReadAhead(const BlockManager& blockman, PrepareFn prepare, size_t depth = BLOCK_READ_AHEAD_DEPTH);
+    ~BlockReadAhead();
+
+    BlockReadAhead(const BlockReadAhead&) = delete;
+    BlockReadAhead& operator=(const BlockReadAhead&) = delete;
+
+    /**
+     * Set the blocks to read, in the order they will be connected. Blocks
+     * scheduled before that are not in the list any more (after a reorg, say)
+     * are dropped. Only the first depth blocks are read ahead.
+     */
+    void Schedule(std::span<const std::pair<uint256, FlatFilePos>> blocks) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    /**
+     * Take the block with this hash. Waits if it is being read right now.
+     *
+     * @returns the block, or nullptr if it was not read ahead (or failed to
+     *          read), in which case the caller reads it itself
+     */
+    std::shared_ptr<const CBlock> Take(const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    struct Entry {
+        enum class State { QUEUED, READING, DONE };
+
+        uint256 hash;
+        FlatFilePos pos;
+        State state{State::QUEUED};
+        std::shared_ptr<const CBlock> block{};
+    };
+
+    void ThreadReadAhead() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    const BlockManager& m_blockman;
+    const PrepareFn m_prepare;
+    const size_t m_depth;
+
+    Mutex m_mutex;
+    std::condition_variable m_cv;
+    //! Blocks to connect next, in order
+    std::deque<Entry> m_blocks GUARDED_BY(m_mutex);
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::thread m_thread GUARDED_BY(m_mutex);
+};
+} // namespace node
+
+#endif // BITCOIN_NODE_BLOCKREADAHEAD_H
@@ -0,0 +1,50 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/blockservecache.h>
+
+namespace node {
+BlockServeCache::Payload BlockServeCache::Get(const uint256& hash, Format format)
+{
+    LOCK(m_mutex);
+    const auto it{m_entries.find({hash, format})};
+    if (it == m_entries.end()) {
+        ++m_misses;
+        return nullptr;
+    }
+    ++m_hits;
+    m_lru.splice(m_lru.end(), m_lru, it->second.lru);
+    return it->second.payload;
+}
+
+void BlockServeCache::Add(const uint256& hash, Format format, Payload payload)
+{
+    const size_t size{payload->size()};
+    if (size > m_max_bytes) return;
+    LOCK(m_mutex);
+    const Key key{hash, format};
+    if (m_entries.contains(key)) return;
+    while (m_bytes + size > m_max_bytes) {
+        const auto oldest{m_entries.find(m_lru.front())};
+        m_bytes -= oldest->second.payload->size();
+        m_entries.erase(oldest);
+        m_lru.pop_front();
+    }
+    m_lru.push_back(key);
+    m_entries.emplace(key, Entry{.payload = std::move(payload), .lru = std::prev(m_lru.end())});
+    m_bytes += size;
+}
+
+BlockServeCacheStats BlockServeCache::GetStats() const
+{
+    LOCK(m_mutex);
+    return {
+        .hits = m_hits,
+        .misses = m_misses,
+        .entries = m_entries.size(),
+        .bytes = m_bytes,
+        .max_bytes = m_max_bytes,
+    };
+}
+} // namespace node
@@ -0,0 +1,87 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_BLOCKSERVECACHE_H
+#define BITCOIN_NODE_BLOCKSERVECACHE_H
+
+#include <sync.h>
+#include <uint256.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace node {
+/** Default for -blockservecache, in MiB */
+static constexpr int64_t DEFAULT_BLOCK_SERVE_CACHE_SIZE{32};
+
+struct BlockServeCacheStats {
+    uint64_t hits{0};
+    uint64_t misses{0};
+    size_t entries{0};
+    size_t bytes{0};
+    size_t max_bytes{0};
+};
+
+/**
+ * Serialized blocks and compact blocks recently sent to peers, shared across
+ * them, so that peers fetching the same range (a wave of new nodes syncing
+ * from us, say) do not each cost a disk read and a serialization.
+ *
+ * Holds at most max_bytes of payloads and evicts the least recently served
+ * ones first. Payloads are shared, so one being sent stays valid when
+ * evicted.
+ */
+class BlockServeCache
+{
+public:
+    /** Serialization a payload is in */
+    enum class Format : uint8_t {
+        WITNESS,    //!< BLOCK message, with witness data
+        NO_WITNESS, //!< BLOCK message, without witness data
+        COMPACT,    //!< CMPCTBLOCK message
+    };
+
+    using Payload = std::shared_ptr<const std::vector<std::byte>>;
+
+    explicit BlockServeCache(size_t max_bytes) : m_max_bytes{max_bytes} {}
+
+    /** The payload of the block with this hash in this format, or nullptr. Counts a hit or a miss. */
+    Payload Get(const uint256& hash, Format format) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    /** Add a payload, evicting the least recently served ones to make room. Payloads larger than the cache are not kept. */
+    void Add(const uint256& hash, Format format, Payload payload) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    BlockServeCacheStats GetStats() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    using Key = std::pair<uint256, Format>;
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const { return key.first.GetUint64(0) + uint8_t(key.second); }
+    };
+
+    struct Entry {
+        Payload payload;
+        //! Position in m_lru
+        std::list<Key>::iterator lru;
+    };
+
+    const size_t m_max_bytes;
+
+    mutable Mutex m_mutex;
+    std::unordered_map<Key, Entry, KeyHasher> m_entries GUARDED_BY(m_mutex);
+    //! Keys from the least to the most recently served
+    std::list<Key> m_lru GUARDED_BY(m_mutex);
+    size_t m_bytes GUARDED_BY(m_mutex){0};
+    uint64_t m_hits GUARDED_BY(m_mutex){0};
+    uint64_t m_misses GUARDED_BY(m_mutex){0};
+};
+} // namespace node
+
+#endif // BITCOIN_NODE_BLOCKSERVECACHE_H
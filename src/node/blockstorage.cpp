@@ -16,6 +16,8 @@
 #include <kernel/notifications_interface.h>
 #include <kernel/types.h>
 #include <logging.h>
+#include <node/blockcompression.h>
+#include <node/blockfilescanner.h>
 #include <pow.h>
 #include <primitives/block.h>
 #include <primitives/transaction.h>
@@ -30,6 +32,7 @@
 #include <util/check.h>
 #include <util/expected.h>
 #include <util/fs.h>
+#include <util/mappedfile.h>
 #include <util/obfuscation.h>
 #include <util/overflow.h>
 #include <util/result.h>
@@ -44,6 +47,7 @@
 #include <compare>
 #include <cstddef>
 #include <cstdio>
+#include <cstring>
 #include <exception>
 #include <map>
 #include <optional>
@@ -787,6 +791,11 @@ uint64_t BlockManager::CalculateCurrentUsage()
 void BlockManager::UnlinkPrunedFiles(const std::set<int>& setFilesToPrune) const
 {
     std::error_code ec;
+    {
+        // Mappings still in use stay valid after the file is deleted.
+        LOCK(m_mapped_files_mutex);
+        for (const int file_num : setFilesToPrune) m_mapped_files.erase(file_num);
+    }
     for (std::set<int>::iterator it = setFilesToPrune.begin(); it != setFilesToPrune.end(); ++it) {
         FlatFilePos pos(*it, 0);
         const bool removed_blockfile{fs::remove(m_block_file_seq.FileName(pos), ec)};
@@ -903,8 +912,26 @@ FlatFilePos BlockManager::FindNextBlockPos(unsigned int nAddSize, unsigned int n
     return pos;
 }
 
-void BlockManager::UpdateBlockInfo(const CBlock& block, unsigned int nHeight, const FlatFilePos& pos)
+std::optional<unsigned int> BlockManager::ReadStoredBlockSize(const FlatFilePos& pos) const
+{
+    if (pos.nPos < STORAGE_HEADER_BYTES) return std::nullopt;
+    AutoFile file{m_block_file_seq.Open({pos.nFile, pos.nPos - STORAGE_HEADER_BYTES}, /*read_only=*/true), m_obfuscation};
+    if (file.IsNull()) return std::nullopt;
+    try {
+        MessageStartChars blk_start;
+        unsigned int blk_size;
+        file >> blk_start >> blk_size;
+        if (blk_start != GetParams().MessageStart()) return std::nullopt;
+        return blk_size & ~COMPRESSED_BLOCK_RECORD;
+    } catch (const std::ios_base::failure&) {
+        return std::nullopt;
+    }
+}
+
+void BlockManager::UpdateBlockInfo(const CBlock& block, unsigned int nHeight, const FlatFilePos& pos, std::optional<unsigned int> stored_size)
 {
+    if (!stored_size) stored_size = ReadStoredBlockSize(pos);
+
     LOCK(cs_LastBlockFile);
 
     // Update the cursor so it points to the last file.
@@ -914,8 +941,9 @@ void BlockManager::UpdateBlockInfo(const CBlock& block, unsigned int nHeight, co
         m_blockfile_cursors[chain_type] = BlockfileCursor{pos.nFile};
     }
 
-    // Update the file information with the current block.
-    const unsigned int added_size = ::GetSerializeSize(TX_WITH_WITNESS(block));
+    // Update the file information with the current block, as stored: a
+    // compressed record is smaller than the block's serialization.
+    const unsigned int added_size{stored_size.value_or(::GetSerializeSize(TX_WITH_WITNESS(block)))};
     const int nFile = pos.nFile;
     if (static_cast<int>(m_blockfile_info.size()) <= nFile) {
         m_blockfile_info.resize(nFile + 1);
@@ -1072,17 +1100,41 @@ BlockManager::ReadRawBlockResult BlockManager::ReadRawBlock(const FlatFilePos& p
         LogError("Failed for %s while reading raw block storage header", pos.ToString());
         return util::Unexpected{ReadRawError::IO};
     }
-    AutoFile filein{OpenBlockFile({pos.nFile, pos.nPos - STORAGE_HEADER_BYTES}, /*fReadOnly=*/true)};
-    if (filein.IsNull()) {
+    std::shared_ptr<const MappedFile> mapped{MapBlockFile(pos.nFile)};
+    std::optional<AutoFile> filein;
+    const auto open_file{[&] {
+        filein.emplace(m_block_file_seq.Open({pos.nFile, pos.nPos - STORAGE_HEADER_BYTES}, /*read_only=*/true), m_obfuscation);
+        return !filein->IsNull();
+    }};
+    if (!mapped && !open_file()) {
         LogError("OpenBlockFile failed for %s while reading raw block", pos.ToString());
         return util::Unexpected{ReadRawError::IO};
     }
+    // Read the bytes at offset in the block file, in sequence.
+    const auto read{[&](std::span<std::byte> dst, uint64_t offset) {
+        if (mapped && (offset > mapped->size() || dst.size() > mapped->size() - offset)) {
+            // The file grew after it was mapped. Drop the mapping, so that the
+            // file is mapped again with its new size, and read from the file.
+            WITH_LOCK(m_mapped_files_mutex, std::erase_if(m_mapped_files, [&](const auto& entry) { return entry.second.file == mapped; }));
+            mapped.reset();
+            if (!open_file()) throw std::ios_base::failure("cannot open block file");
+        }
+        if (!mapped) {
+            if (uint64_t(filein->tell()) != offset) filein->seek(offset, SEEK_SET);
+            filein->read(dst);
+            return;
+        }
+        std::memcpy(dst.data(), mapped->data().data() + offset, dst.size());
+        m_obfuscation(dst, offset);
+    }};
 
     try {
         MessageStartChars blk_start;
         unsigned int blk_size;
 
-        filein >> blk_start >> blk_size;
+        std::array<std::byte, STORAGE_HEADER_BYTES> header;
+        read(header, pos.nPos - STORAGE_HEADER_BYTES);
+        SpanReader{header} >> blk_start >> blk_size;
 
         if (blk_start != GetParams().MessageStart()) {
             LogError("Block magic mismatch for %s: %s versus expected %s while reading raw block",
@@ -1090,23 +1142,40 @@ BlockManager::ReadRawBlockResult BlockManager::ReadRawBlock(const FlatFilePos& p
             return util::Unexpected{ReadRawError::IO};
         }
 
+        const bool compressed{(blk_size & COMPRESSED_BLOCK_RECORD) != 0};
+        blk_size &= ~COMPRESSED_BLOCK_RECORD;
         if (blk_size > MAX_SIZE) {
             LogError("Block data is larger than maximum deserialization size for %s: %s versus %s while reading raw block",
                 pos.ToString(), blk_size, MAX_SIZE);
             return util::Unexpected{ReadRawError::IO};
         }
 
+        if (compressed) {
+            std::vector<std::byte> record(blk_size);
+            read(record, pos.nPos);
+            std::vector<std::byte> data{DecompressBlock(record)};
+            if (block_part) {
+                const auto [offset, size]{*block_part};
+                if (size == 0 || SaturatingAdd(offset, size) > data.size()) {
+                    return util::Unexpected{ReadRawError::BadPartRange};
+                }
+                return std::vector<std::byte>(data.begin() + offset, data.begin() + offset + size);
+            }
+            return data;
+        }
+
+        uint64_t data_pos{pos.nPos};
         if (block_part) {
             const auto [offset, size]{*block_part};
             if (size == 0 || SaturatingAdd(offset, size) > blk_size) {
                 return util::Unexpected{ReadRawError::BadPartRange}; // Avoid logging - offset/size come from untrusted REST input
             }
-            filein.seek(offset, SEEK_CUR);
+            data_pos += offset;
             blk_size = size;
         }
 
         std::vector<std::byte> data(blk_size); // Zeroing of memory is intentional here
-        filein.read(data);
+        read(data, data_pos);
         return data;
     } catch (const std::exception& e) {
         LogError("Read from block file failed: %s for %s while reading raw block", e.what(), pos.ToString());
@@ -1114,9 +1183,56 @@ BlockManager::ReadRawBlockResult BlockManager::ReadRawBlock(const FlatFilePos& p
     }
 }
 
+std::shared_ptr<const MappedFile> BlockManager::MapBlockFile(int file_num) const
+{
+    if (!m_opts.use_mmap || !MappedFile::SUPPORTED) return nullptr;
+    // While reindexing, the used size of a file is only known once all its blocks are indexed.
+    if (!m_blockfiles_indexed) return nullptr;
+    {
+        LOCK(m_mapped_files_mutex);
+        if (const auto it{m_mapped_files.find(file_num)}; it != m_mapped_files.end()) {
+            it->second.last_used = ++m_mapped_files_clock;
+            return it->second.file;
+        }
+    }
+
+    size_t size;
+    {
+        LOCK(cs_LastBlockFile);
+        if (file_num < 0 || file_num >= static_cast<int>(m_blockfile_info.size())) return nullptr;
+        for (const auto& cursor : m_blockfile_cursors) {
+            if (cursor && cursor->file_num == file_num) return nullptr;
+        }
+        // Only the used part: finalizing the file truncated it to that size.
+        size = m_blockfile_info[file_num].nSize;
+    }
+    std::shared_ptr<const MappedFile> mapped{MappedFile::Open(m_block_file_seq.FileName({file_num, 0}), size)};
+    if (!mapped) return nullptr;
+
+    LOCK(m_mapped_files_mutex);
+    if (m_mapped_files.size() >= MAX_MAPPED_BLOCK_FILES) {
+        m_mapped_files.erase(std::ranges::min_element(m_mapped_files, {}, [](const auto& entry) { return entry.second.last_used; }));
+    }
+    // Another thread may have mapped the file meanwhile.
+    const auto [it, inserted]{m_mapped_files.try_emplace(file_num, MappedBlockFile{.file = std::move(mapped), .last_used = 0})};
+    it->second.last_used = ++m_mapped_files_clock;
+    return it->second.file;
+}
+
 FlatFilePos BlockManager::WriteBlock(const CBlock& block, int nHeight)
 {
-    const unsigned int block_size{static_cast<unsigned int>(GetSerializeSize(TX_WITH_WITNESS(block)))};
+    unsigned int block_size{static_cast<unsigned int>(GetSerializeSize(TX_WITH_WITNESS(block)))};
+    // A block is only stored compressed if that makes it smaller, so that
+    // the raw size is always an upper bound of the stored size.
+    std::optional<DataStream> compressed;
+    if (m_opts.compress_blocks) {
+        compressed = CompressBlock(block);
+        if (compressed->size() < block_size) {
+            block_size = compressed->size();
+        } else {
+            compressed.reset();
+        }
+    }
     FlatFilePos pos{FindNextBlockPos(block_size + STORAGE_HEADER_BYTES, nHeight, block.GetBlockTime())};
     if (pos.IsNull()) {
         LogError("FindNextBlockPos failed for %s while writing block", pos.ToString());
@@ -1132,10 +1248,14 @@ FlatFilePos BlockManager::WriteBlock(const CBlock& block, int nHeight)
         BufferedWriter fileout{file};
 
         // Write index header
-        fileout << GetParams().MessageStart() << block_size;
+        fileout << GetParams().MessageStart() << (compressed ? block_size | COMPRESSED_BLOCK_RECORD : block_size);
         pos.nPos += STORAGE_HEADER_BYTES;
         // Write block
-        fileout << TX_WITH_WITNESS(block);
+        if (compressed) {
+            fileout << std::span{*compressed};
+        } else {
+            fileout << TX_WITH_WITNESS(block);
+        }
     }
 
     if (file.fclose() != 0) {
@@ -1256,14 +1376,17 @@ void ImportBlocks(ChainstateManager& chainman, std::span<const fs::path> import_
         // parent hash -> child disk position, multiple children can have the same parent.
         std::multimap<uint256, FlatFilePos> blocks_with_unknown_parent;
 
+        // The files are scanned for blocks on several threads, ahead of the
+        // one being indexed; blocks are indexed in file order on this thread.
+        BlockFileScanner scanner{chainman.m_blockman, chainman.GetParams().MessageStart(), total_files,
+                                 chainman.m_blockman.ReindexThreads(), chainman.m_interrupt};
         for (int nFile{0}; nFile < total_files; ++nFile) {
-            FlatFilePos pos(nFile, 0);
-            AutoFile file{chainman.m_blockman.OpenBlockFile(pos, /*fReadOnly=*/true)};
-            if (file.IsNull()) {
+            const auto blocks{scanner.Next()};
+            if (!blocks) {
                 break; // This error is logged in OpenBlockFile
             }
             LogInfo("Reindexing block file blk%05u.dat (%d%% complete)...", (unsigned int)nFile, nFile * 100 / total_files);
-            chainman.LoadExternalBlockFile(file, &pos, &blocks_with_unknown_parent);
+            chainman.LoadScannedBlockFile(*blocks, blocks_with_unknown_parent);
             if (chainman.m_interrupt) {
                 LogInfo("Interrupt requested. Exit reindexing.");
                 return;
@@ -45,6 +45,7 @@ class BlockValidationState;
 class CBlockUndo;
 class Chainstate;
 class ChainstateManager;
+class MappedFile;
 namespace Consensus {
 struct Params;
 }
@@ -121,6 +122,8 @@ static const unsigned int BLOCKFILE_CHUNK_SIZE = 0x1000000; // 16 MiB
 static const unsigned int UNDOFILE_CHUNK_SIZE = 0x100000; // 1 MiB
 /** The maximum size of a blk?????.dat file (since 0.8) */
 static const unsigned int MAX_BLOCKFILE_SIZE = 0x8000000; // 128 MiB
+/** The maximum number of block files kept memory mapped for reading */
+static constexpr size_t MAX_MAPPED_BLOCK_FILES{64};
 
 /** Size of header written by WriteBlock before a serialized CBlock (8 bytes) */
 static constexpr uint32_t STORAGE_HEADER_BYTES{std::tuple_size_v<MessageStartChars> + sizeof(unsigned int)};
@@ -224,6 +227,9 @@ private:
 
     AutoFile OpenUndoFile(const FlatFilePos& pos, bool fReadOnly = false) const;
 
+    /** Size of the block record stored at pos, compressed or not, from the storage header before it. */
+    std::optional<unsigned int> ReadStoredBlockSize(const FlatFilePos& pos) const;
+
     /* Calculate the block/rev files to delete based on height specified by user with RPC command pruneblockchain */
     void FindFilesToPruneManual(
         std::set<int>& setFilesToPrune,
@@ -252,7 +258,7 @@ private:
         const Chainstate& chain,
         ChainstateManager& chainman);
 
-    RecursiveMutex cs_LastBlockFile;
+    mutable RecursiveMutex cs_LastBlockFile;
 
     //! Since assumedvalid chainstates may be syncing a range of the chain that is very
     //! far away from the normal/background validation process, we should segment blockfiles
@@ -302,6 +308,23 @@ private:
     const FlatFileSeq m_block_file_seq;
     const FlatFileSeq m_undo_file_seq;
 
+    struct MappedBlockFile {
+        std::shared_ptr<const MappedFile> file;
+        uint64_t last_used;
+    };
+    mutable Mutex m_mapped_files_mutex;
+    //! Memory mappings of finalized block files, the least recently used dropped beyond MAX_MAPPED_BLOCK_FILES
+    mutable std::map<int, MappedBlockFile> m_mapped_files GUARDED_BY(m_mapped_files_mutex);
+    mutable uint64_t m_mapped_files_clock GUARDED_BY(m_mapped_files_mutex){0};
+
+    /**
+     * Map the used part of a block file for reading, if it is finalized: not
+     * the file of a blockfile cursor, so no longer appended to or truncated.
+     *
+     * @returns the mapping, or nullptr if the file is not to be mapped
+     */
+    std::shared_ptr<const MappedFile> MapBlockFile(int file_num) const EXCLUSIVE_LOCKS_REQUIRED(!m_mapped_files_mutex);
+
 protected:
     std::vector<CBlockFileInfo> m_blockfile_info;
 
@@ -396,8 +419,10 @@ public:
      * @param[in]  block        the block being processed
      * @param[in]  nHeight      the height of the block
      * @param[in]  pos          the position of the serialized CBlock on disk
+     * @param[in]  stored_size  the size of the block's record at pos, compressed or not, if known;
+     *                          read from the storage header before pos otherwise
      */
-    void UpdateBlockInfo(const CBlock& block, unsigned int nHeight, const FlatFilePos& pos);
+    void UpdateBlockInfo(const CBlock& block, unsigned int nHeight, const FlatFilePos& pos, std::optional<unsigned int> stored_size = std::nullopt);
 
     /** Whether running in -prune mode. */
     [[nodiscard]] bool IsPruneMode() const { return m_prune_mode; }
@@ -406,6 +431,9 @@ public:
     [[nodiscard]] uint64_t GetPruneTarget() const { return m_opts.prune_target; }
     static constexpr auto PRUNE_TARGET_MANUAL{std::numeric_limits<uint64_t>::max()};
 
+    /** Number of threads scanning the block files during -reindex. */
+    [[nodiscard]] int ReindexThreads() const { return m_opts.reindex_threads; }
+
     [[nodiscard]] bool LoadingBlocks() const { return m_importing || !m_blockfiles_indexed; }
 
     /** Calculate the amount of disk space the block & undo files currently use */
@@ -462,12 +490,17 @@ public:
     /**
      *  Actually unlink the specified files
      */
-    void UnlinkPrunedFiles(const std::set<int>& setFilesToPrune) const;
+    void UnlinkPrunedFiles(const std::set<int>& setFilesToPrune) const EXCLUSIVE_LOCKS_REQUIRED(!m_mapped_files_mutex);
 
     /** Functions for disk access for blocks */
     bool ReadBlock(CBlock& block, const FlatFilePos& pos, const std::optional<uint256>& expected_hash) const;
     bool ReadBlock(CBlock& block, const CBlockIndex& index) const;
-    ReadRawBlockResult ReadRawBlock(const FlatFilePos& pos, std::optional<std::pair<size_t, size_t>> block_part = std::nullopt) const;
+    /**
+     * Read the serialized block at pos, or part of it. Blocks in finalized
+     * files are copied from a memory mapping of the file instead of read
+     * through a FILE, sparing the syscalls when serving blocks to peers.
+     */
+    ReadRawBlockResult ReadRawBlock(const FlatFilePos& pos, std::optional<std::pair<size_t, size_t>> block_part = std::nullopt) const EXCLUSIVE_LOCKS_REQUIRED(!m_mapped_files_mutex);
 
     bool ReadBlockUndo(CBlockUndo& blockundo, const CBlockIndex& index) const;
 
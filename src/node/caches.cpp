@@ -12,9 +12,11 @@
 #include <node/interface_ui.h>
 #include <tinyformat.h>
 #include <util/byte_units.h>
+#include <validation.h>
 
 #include <algorithm>
 #include <string>
+#include <utility>
 
 // Unlike for the UTXO database, for the txindex scenario the leveldb cache make
 // a meaningful difference: https://github.com/drip/drip/pull/8273#issuecomment-229601991
@@ -62,4 +64,102 @@ void LogOversizedDbCache(const ArgsManager& args) noexcept
         }
     }
 }
+
+//! Memory -dbcacheadaptive keeps free for the rest of the system
+static size_t AdaptiveFreeRAM(size_t total_ram) noexcept
+{
+    return std::max(MIN_ADAPTIVE_FREE_RAM, total_ram / 10);
+}
+
+//! Memory available now and the total memory, within any cgroup limit
+static std::optional<std::pair<size_t, size_t>> GetAdaptiveRAM()
+{
+    auto total_ram{GetTotalRAM()};
+    const auto available_ram{GetAvailableRAM()};
+    if (!total_ram || !available_ram) return std::nullopt;
+    if (const auto limit{GetCgroupMemoryLimit()}) total_ram = std::min(*total_ram, *limit);
+    return std::make_pair(*available_ram, *total_ram);
+}
+
+std::optional<size_t> AdaptiveCoinsCacheSize(size_t budget, size_t usage, size_t available_ram, size_t total_ram) noexcept
+{
+    const size_t reserve{AdaptiveFreeRAM(total_ram)};
+    const size_t ceiling{std::max(MIN_ADAPTIVE_COINS_CACHE, total_ram / 4 * 3)};
+    if (available_ram >= reserve) {
+        const size_t target{std::min(ceiling, usage + (available_ram - reserve) / 2)};
+        if (target <= budget + budget / 8) return std::nullopt;
+        return target;
+    }
+    const size_t shortfall{reserve - available_ram};
+    const size_t target{std::max(MIN_ADAPTIVE_COINS_CACHE, usage > shortfall ? usage - shortfall : 0)};
+    if (target >= budget) return std::nullopt;
+    return target;
+}
+
+std::optional<bool> ReduceValidationCaches(bool reduced, size_t available_ram, size_t total_ram) noexcept
+{
+    const size_t reserve{AdaptiveFreeRAM(total_ram)};
+    if (!reduced && available_ram < reserve) return true;
+    if (reduced && available_ram >= 2 * reserve) return false;
+    return std::nullopt;
+}
+
+size_t GetCoinsCacheUsage(const ChainstateManager& chainman)
+{
+    AssertLockHeld(::cs_main);
+    size_t usage{0};
+    for (Chainstate* chainstate : {&chainman.CurrentChainstate(), chainman.HistoricalChainstate()}) {
+        if (chainstate && chainstate->CanFlushToDisk()) usage += chainstate->CoinsTip().DynamicMemoryUsage();
+    }
+    return usage;
+}
+
+void AdaptCoinsCache(ChainstateManager& chainman)
+{
+    const auto ram{GetAdaptiveRAM()};
+    if (!ram) return;
+    AdaptCoinsCache(chainman, ram->first, ram->second);
+}
+
+void AdaptCoinsCache(ChainstateManager& chainman, size_t available_ram, size_t total_ram)
+{
+    LOCK(cs_main);
+    const size_t usage{GetCoinsCacheUsage(chainman)};
+    const auto budget{AdaptiveCoinsCacheSize(chainman.m_total_coinstip_cache, usage, available_ram, total_ram)};
+    if (!budget) return;
+    LogInfo("Resizing the coins cache from %.1f MiB to %.1f MiB (%.1f MiB in use, %.1f MiB of memory available)",
+            chainman.m_total_coinstip_cache * (1.0 / 1024 / 1024), *budget * (1.0 / 1024 / 1024),
+            usage * (1.0 / 1024 / 1024), available_ram * (1.0 / 1024 / 1024));
+    const bool shrink{*budget < chainman.m_total_coinstip_cache};
+    chainman.m_total_coinstip_cache = *budget;
+    chainman.MaybeRebalanceCaches();
+    if (!shrink) return;
+    for (Chainstate* chainstate : {&chainman.CurrentChainstate(), chainman.HistoricalChainstate()}) {
+        if (!chainstate || !chainstate->CanFlushToDisk()) continue;
+        // The pool keeps the memory of evicted coins for new ones, so only
+        // emptying the cache gives it back.
+        if (chainstate->CoinsTip().DynamicMemoryUsage() > chainstate->m_coinstip_cache_size_bytes) {
+            chainstate->ForceFlushStateToDisk();
+        }
+    }
+}
+
+void AdaptValidationCaches(ChainstateManager& chainman)
+{
+    const auto ram{GetAdaptiveRAM()};
+    if (!ram) return;
+    const auto [available_ram, total_ram]{*ram};
+
+    ValidationCache& cache{chainman.m_validation_cache};
+    const auto& opts{chainman.m_options};
+    if (opts.signature_cache_bytes == 0) return;
+    // Both caches are sized together, so the signature cache tells whether they are reduced.
+    const bool reduced{cache.m_signature_cache.MaxSizeBytes() < opts.signature_cache_bytes};
+    const auto reduce{ReduceValidationCaches(reduced, available_ram, total_ram)};
+    if (!reduce) return;
+    const size_t divisor{*reduce ? ADAPTIVE_VALIDATION_CACHE_DIVISOR : 1};
+    LogInfo("%s the signature and script execution caches (%.1f MiB of memory available)",
+            *reduce ? "Reducing" : "Restoring", available_ram * (1.0 / 1024 / 1024));
+    cache.Resize(opts.script_execution_cache_bytes / divisor, opts.signature_cache_bytes / divisor);
+}
 } // namespace node
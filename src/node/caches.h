@@ -6,16 +6,31 @@
 #define BITCOIN_NODE_CACHES_H
 
 #include <kernel/caches.h>
+#include <kernel/cs_main.h>
+#include <sync.h>
 #include <util/byte_units.h>
 
+#include <chrono>
 #include <cstddef>
+#include <optional>
 
 class ArgsManager;
+class ChainstateManager;
 
 //! min. -dbcache (bytes)
 static constexpr size_t MIN_DB_CACHE{4_MiB};
 //! -dbcache default (bytes)
 static constexpr size_t DEFAULT_DB_CACHE{DEFAULT_KERNEL_CACHE};
+//! -dbcacheadaptive default
+static constexpr bool DEFAULT_DB_CACHE_ADAPTIVE{false};
+//! Smallest coins cache -dbcacheadaptive shrinks to (bytes)
+static constexpr size_t MIN_ADAPTIVE_COINS_CACHE{32_MiB};
+//! Memory -dbcacheadaptive leaves to the rest of the system, at least (bytes)
+static constexpr size_t MIN_ADAPTIVE_FREE_RAM{512_MiB};
+//! How often -dbcacheadaptive checks the memory available
+static constexpr std::chrono::seconds ADAPTIVE_DB_CACHE_INTERVAL{10};
+//! -dbcacheadaptive divides the signature and script execution cache sizes by this while memory is short
+static constexpr size_t ADAPTIVE_VALIDATION_CACHE_DIVISOR{4};
 
 namespace node {
 struct IndexCacheSizes {
@@ -34,6 +49,48 @@ constexpr bool ShouldWarnOversizedDbCache(size_t dbcache, size_t total_ram) noex
 }
 
 void LogOversizedDbCache(const ArgsManager& args) noexcept;
+
+/**
+ * The coins cache budget for -dbcacheadaptive to move to, if it should change.
+ *
+ * Memory is kept free for the rest of the system: the larger of
+ * MIN_ADAPTIVE_FREE_RAM and a tenth of total_ram. While more than that is
+ * available, the cache may grow into half of the excess, on top of what it
+ * uses now. Growth by less than an eighth of the budget is ignored, so that
+ * the caches are not resized over noise. When less than that is available,
+ * the budget drops below the current usage by the shortfall, which has the
+ * cache written out and its memory released. The budget stays between
+ * MIN_ADAPTIVE_COINS_CACHE and three quarters of total_ram.
+ */
+std::optional<size_t> AdaptiveCoinsCacheSize(size_t budget, size_t usage, size_t available_ram, size_t total_ram) noexcept;
+
+/**
+ * Whether -dbcacheadaptive should reduce the signature and script execution
+ * caches (true) or restore them to their configured size (false), if that
+ * should change. They are reduced while less memory is available than
+ * AdaptiveCoinsCacheSize keeps free, and restored only once twice that is
+ * available again, since resizing them drops their entries.
+ */
+std::optional<bool> ReduceValidationCaches(bool reduced, size_t available_ram, size_t total_ram) noexcept;
+
+/** Memory used by the in-memory coins caches of all chainstates. */
+size_t GetCoinsCacheUsage(const ChainstateManager& chainman) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+
+/** Resize the coins caches of chainman to the memory available now, for -dbcacheadaptive. */
+void AdaptCoinsCache(ChainstateManager& chainman);
+
+/**
+ * Resize the coins caches of chainman to available_ram out of total_ram.
+ *
+ * Evicting coins only returns their memory to the cache's own pool, so a
+ * cache that still holds more than its new size after shrinking is written
+ * out and released. The usage the next call sees then reflects what was
+ * given back.
+ */
+void AdaptCoinsCache(ChainstateManager& chainman, size_t available_ram, size_t total_ram);
+
+/** Resize the signature and script execution caches of chainman to the memory available now, for -dbcacheadaptive. */
+void AdaptValidationCaches(ChainstateManager& chainman);
 } // namespace node
 
 #endif // BITCOIN_NODE_CACHES_H
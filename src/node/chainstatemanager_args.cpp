@@ -58,6 +58,7 @@ util::Result<void> ApplyArgsManOptions(const ArgsManager& args, ChainstateManage
     }
     // Subtract 1 because the main thread counts towards the par threads.
     opts.worker_threads_num = script_threads - 1;
+    opts.batch_schnorr_verify = args.GetBoolArg("-batchschnorr", opts.batch_schnorr_verify);
 
     if (auto max_size = args.GetIntArg("-maxsigcachesize")) {
         // 1. When supplied with a max_size of 0, both the signature cache and
@@ -68,6 +69,7 @@ util::Result<void> ApplyArgsManOptions(const ArgsManager& args, ChainstateManage
         opts.script_execution_cache_bytes = clamped_size_each;
         opts.signature_cache_bytes = clamped_size_each;
     }
+    opts.signature_cache_pin = args.GetBoolArg("-sigcachepin", opts.signature_cache_pin);
 
     return {};
 }
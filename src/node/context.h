@@ -41,6 +41,7 @@ class SignalInterrupt;
 
 namespace node {
 class KernelNotifications;
+class MiningService;
 class Warnings;
 
 //! NodeContext struct containing references to chain state and connection
@@ -79,6 +80,8 @@ struct NodeContext {
     //! Reference to chain client that should used to load or create wallets
     //! opened by the gui.
     std::unique_ptr<interfaces::Mining> mining;
+    //! Background in-process miner (-gen, setgenerate)
+    std::unique_ptr<MiningService> mining_service;
     interfaces::WalletLoader* wallet_loader{nullptr};
     std::unique_ptr<CScheduler> scheduler;
     std::function<void()> rpc_interruption_point = [] {};
@@ -0,0 +1,249 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/cpu_miner.h>
+
+#include <common/system.h>
+#include <crypto/common.h>
+#include <crypto/sha256.h>
+#include <node/mining_job.h>
+#include <streams.h>
+#include <tinyformat.h>
+#include <util/check.h>
+#include <util/signalinterrupt.h>
+#include <util/threadnames.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace node {
+namespace {
+//! Number of nonces handed to SHA256D80Midstate at once, the width of the widest kernel.
+constexpr uint32_t NONCES_PER_CALL{8};
+} // namespace
+
+HeaderHasher::HeaderHasher(const CBlockHeader& header)
+{
+    DataStream ss{};
+    ss << header;
+    Assert(ss.size() == 80);
+    const auto* data{UCharCast(ss.data())};
+    SHA256Midstate(m_midstate, data);
+    std::copy(data + 64, data + 80, m_tail);
+    WriteLE32(m_tail + 12, 0);
+}
+
+void HeaderHasher::SetTime(uint32_t time)
+{
+    WriteLE32(m_tail + 4, time);
+}
+
+uint256 HeaderHasher::GetHash(uint32_t nonce) const
+{
+    unsigned char tail[16];
+    std::copy(m_tail, m_tail + 16, tail);
+    WriteLE32(tail + 12, nonce);
+    uint256 hash;
+    SHA256D80Midstate(hash.begin(), m_midstate, tail, 1);
+    return hash;
+}
+
+std::optional<uint32_t> HeaderHasher::ScanNonces(const arith_uint256& target, uint32_t first_nonce, uint32_t count) const
+{
+    unsigned char tails[16 * NONCES_PER_CALL];
+    unsigned char hashes[32 * NONCES_PER_CALL];
+    for (uint32_t i = 0; i < NONCES_PER_CALL; ++i) {
+        std::copy(m_tail, m_tail + 16, tails + 16 * i);
+    }
+    // Most hashes are rejected by comparing their most significant 32 bits
+    // against the target's, before building a full arith_uint256.
+    const uint64_t target_high{(target >> 224).GetLow64()};
+
+    for (uint32_t done = 0; done < count;) {
+        const uint32_t n{std::min(NONCES_PER_CALL, count - done)};
+        for (uint32_t i = 0; i < n; ++i) {
+            WriteLE32(tails + 16 * i + 12, first_nonce + done + i);
+        }
+        SHA256D80Midstate(hashes, m_midstate, tails, n);
+        for (uint32_t i = 0; i < n; ++i) {
+            const unsigned char* hash{hashes + 32 * i};
+            if (ReadLE32(hash + 28) > target_high) continue;
+            if (UintToArith256(uint256{std::span{hash, 32}}) <= target) return first_nonce + done + i;
+        }
+        done += n;
+    }
+    return std::nullopt;
+}
+
+void HashRateMeter::AddHashes(uint64_t hashes)
+{
+    const uint64_t total{m_total_hashes.fetch_add(hashes, std::memory_order_relaxed) + hashes};
+    const auto now{SteadyClock::now()};
+    LOCK(m_mutex);
+    if (m_samples.empty() || now - m_samples.back().first >= 1s) {
+        m_samples.emplace_back(now, total);
+        while (now - m_samples.front().first > HASH_RATE_WINDOW) m_samples.pop_front();
+    }
+}
+
+double HashRateMeter::GetHashesPerSecond() const
+{
+    const auto now{SteadyClock::now()};
+    const uint64_t total{GetTotalHashes()};
+    LOCK(m_mutex);
+    while (!m_samples.empty() && now - m_samples.front().first > HASH_RATE_WINDOW) m_samples.pop_front();
+    if (m_samples.empty()) return 0;
+    const auto elapsed{Ticks<SecondsDouble>(now - m_samples.front().first)};
+    if (elapsed <= 0) return 0;
+    return (total - m_samples.front().second) / elapsed;
+}
+
+HashRateMeter& GetLocalHashRate()
+{
+    static HashRateMeter g_local_hash_rate;
+    return g_local_hash_rate;
+}
+
+std::optional<int> GetMiningThreads(int64_t requested)
+{
+    if (requested > MAX_GENERATE_THREADS) return std::nullopt;
+    if (requested > 0) return int(requested);
+    return std::clamp(GetNumCores(), 1, MAX_GENERATE_THREADS);
+}
+
+std::optional<uint32_t> NonceScan::operator()()
+{
+    State& state{*m_state};
+    HashRateMeter& meter{GetLocalHashRate()};
+    for (uint64_t done = 0; done < m_size && !state.found.load(std::memory_order_relaxed) && !state.interrupt;) {
+        const uint32_t n{static_cast<uint32_t>(std::min<uint64_t>(m_size - done, MINER_BATCH_NONCES))};
+        const uint32_t first{static_cast<uint32_t>(m_begin + done)};
+        const auto nonce{state.hasher.ScanNonces(state.target, first, n)};
+        const uint32_t hashed{nonce ? *nonce - first + 1 : n};
+        meter.AddHashes(hashed);
+        state.hashes_done.fetch_add(hashed, std::memory_order_relaxed);
+        if (nonce) {
+            state.found = true;
+            return nonce;
+        }
+        done += n;
+    }
+    return std::nullopt;
+}
+
+MinerThreadPool::MinerThreadPool(int threads)
+    : m_threads{std::max(threads, 1)}
+{
+    m_workers.reserve(m_threads - 1);
+    for (int n = 0; n < m_threads - 1; ++n) {
+        m_workers.emplace_back([this, n] {
+            util::ThreadRename(strprintf("miner.%i", n));
+            ThreadWorker();
+        });
+    }
+}
+
+MinerThreadPool::~MinerThreadPool()
+{
+    WITH_LOCK(m_mutex, m_stop = true);
+    m_work_cv.notify_all();
+    for (std::thread& worker : m_workers) worker.join();
+}
+
+void MinerThreadPool::ThreadWorker()
+{
+    WAIT_LOCK(m_mutex, lock);
+    while (!m_stop) {
+        ScanPending(lock);
+        m_work_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_stop || !m_pending.empty(); });
+    }
+}
+
+void MinerThreadPool::ScanPending(UniqueLock<Mutex>& lock)
+{
+    while (!m_pending.empty()) {
+        NonceScan slice{m_pending.back()};
+        m_pending.pop_back();
+        std::optional<uint32_t> nonce;
+        {
+            REVERSE_LOCK(lock, m_mutex);
+            nonce = slice();
+        }
+        if (nonce && !m_solution) m_solution = nonce;
+        if (--m_unfinished == 0) m_done_cv.notify_all();
+    }
+}
+
+std::optional<uint32_t> MinerThreadPool::Scan(std::vector<NonceScan> slices)
+{
+    WAIT_LOCK(m_mutex, lock);
+    m_solution.reset();
+    m_unfinished = slices.size();
+    m_pending = std::move(slices);
+    m_work_cv.notify_all();
+    ScanPending(lock);
+    m_done_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_unfinished == 0; });
+    return m_solution;
+}
+
+std::optional<uint32_t> ScanHeaderNonces(const CBlockHeader& header, const arith_uint256& target, uint64_t count,
+                                         MinerThreadPool& pool, const util::SignalInterrupt& interrupt, uint64_t& hashes_done)
+{
+    Assume(count <= (uint64_t{1} << 32) - header.nNonce);
+    const HeaderHasher hasher{header};
+    NonceScan::State state{.hasher = hasher, .target = target, .interrupt = interrupt};
+
+    const uint64_t inline_count{std::min<uint64_t>(count, MINER_INLINE_NONCES)};
+    auto solution{NonceScan{state, header.nNonce, inline_count}()};
+
+    const uint64_t remaining{count - inline_count};
+    if (!solution && !interrupt && remaining > 0) {
+        const uint32_t begin{static_cast<uint32_t>(header.nNonce + inline_count)};
+        const uint64_t num_slices{std::clamp<uint64_t>(pool.GetThreads(), 1, remaining)};
+        const uint64_t slice_size{remaining / num_slices};
+        std::vector<NonceScan> slices;
+        slices.reserve(num_slices);
+        for (uint64_t i = 0; i < num_slices; ++i) {
+            slices.emplace_back(state, static_cast<uint32_t>(begin + i * slice_size), i + 1 == num_slices ? remaining - i * slice_size : slice_size);
+        }
+        solution = pool.Scan(std::move(slices));
+    }
+
+    hashes_done = state.hashes_done.load();
+    return solution;
+}
+
+bool SolveBlock(CBlock& block, const arith_uint256& target, int64_t min_time, uint64_t& max_tries,
+                MinerThreadPool& pool, const util::SignalInterrupt& interrupt)
+{
+    // Created the first time the nonce space is exhausted
+    std::optional<MiningJob> job;
+    uint64_t extra_nonce{0};
+    // If max_tries is 0, mine until a block is found or interrupted
+    const bool infinite_mining{max_tries == 0};
+    while (!interrupt) {
+        const uint64_t nonces_left{(uint64_t{1} << 32) - block.nNonce};
+        const uint64_t count{infinite_mining ? nonces_left : std::min(nonces_left, max_tries)};
+        uint64_t hashes_done{0};
+        const auto nonce{ScanHeaderNonces(block, target, count, pool, interrupt, hashes_done)};
+        if (!infinite_mining) max_tries -= hashes_done;
+        if (nonce) {
+            block.nNonce = *nonce;
+            if (job) block = job->GetBlock(extra_nonce, block.nTime, block.nNonce);
+            return true;
+        }
+        if (!infinite_mining && max_tries == 0) return false;
+
+        // The nonce space is exhausted. Roll the extranonce in the coinbase
+        // for a fresh one; only the coinbase hash and its merkle path need to
+        // be rehashed. Keep the header time current while at it.
+        if (!job) job.emplace(block);
+        block.hashMerkleRoot = job->GetHeader(++extra_nonce).hashMerkleRoot;
+        block.nTime = std::max<int64_t>({block.nTime, min_time, TicksSinceEpoch<std::chrono::seconds>(NodeClock::now())});
+        block.nNonce = 0;
+    }
+    return false;
+}
+} // namespace node
@@ -0,0 +1,194 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_CPU_MINER_H
+#define BITCOIN_NODE_CPU_MINER_H
+
+#include <arith_uint256.h>
+#include <primitives/block.h>
+#include <sync.h>
+#include <util/time.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace util {
+class SignalInterrupt;
+} // namespace util
+
+namespace node {
+/** Default for -genthreads, the number of threads used to grind nonces (-1 = all cores) */
+static constexpr int DEFAULT_GENERATE_THREADS{-1};
+/** Maximum number of threads used to grind nonces */
+static constexpr int MAX_GENERATE_THREADS{256};
+/** Nonces scanned on the calling thread before worker threads are started */
+static constexpr uint32_t MINER_INLINE_NONCES{1 << 16};
+/** Nonces a worker thread scans between checks for a solution or an interrupt */
+static constexpr uint32_t MINER_BATCH_NONCES{1 << 12};
+/** Period over which the local hash rate is averaged */
+static constexpr std::chrono::seconds HASH_RATE_WINDOW{60};
+
+/**
+ * Double-SHA256 of block headers that only differ in their last 16 bytes
+ * (the tail of the merkle root, time, bits and nonce). The SHA-256 midstate
+ * of the first 64 bytes is computed once, so each try costs two compression
+ * function calls instead of three, and several nonces are hashed per call
+ * by the multi-way SHA256D80Midstate kernels.
+ */
+class HeaderHasher
+{
+public:
+    explicit HeaderHasher(const CBlockHeader& header);
+
+    /** Change the header time. The midstate does not cover it, so this is cheap. */
+    void SetTime(uint32_t time);
+
+    /** Hash of the header with the given nonce. */
+    uint256 GetHash(uint32_t nonce) const;
+
+    /**
+     * Scan the nonces [first_nonce, first_nonce + count) for a header hash at
+     * or below target.
+     *
+     * @returns the first nonce that satisfies target, or nullopt.
+     */
+    std::optional<uint32_t> ScanNonces(const arith_uint256& target, uint32_t first_nonce, uint32_t count) const;
+
+private:
+    uint32_t m_midstate[8];
+    //! Last 16 bytes of the serialized header, with a zero nonce.
+    unsigned char m_tail[16];
+};
+
+/** Rolling hash rate of in-process mining. */
+class HashRateMeter
+{
+public:
+    void AddHashes(uint64_t hashes) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    /** Average hashes per second over the last HASH_RATE_WINDOW. */
+    double GetHashesPerSecond() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    uint64_t GetTotalHashes() const { return m_total_hashes.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> m_total_hashes{0};
+    mutable Mutex m_mutex;
+    //! (time, total hashes) samples, at most one per second, pruned to HASH_RATE_WINDOW
+    mutable std::deque<std::pair<SteadyClock::time_point, uint64_t>> m_samples GUARDED_BY(m_mutex);
+};
+
+/** Hash rate of all in-process mining, reported by getmininginfo. */
+HashRateMeter& GetLocalHashRate();
+
+/**
+ * Resolve the -genthreads value to a number of worker threads: all cores, up
+ * to MAX_GENERATE_THREADS, if it is not positive.
+ *
+ * @returns nullopt if more than MAX_GENERATE_THREADS are requested.
+ */
+std::optional<int> GetMiningThreads(int64_t requested);
+
+/** A contiguous slice of the nonce space of a header, scanned by a MinerThreadPool thread. */
+class NonceScan
+{
+public:
+    struct State {
+        const HeaderHasher& hasher;
+        const arith_uint256& target;
+        const util::SignalInterrupt& interrupt;
+        //! Set once any slice found a solution, so the others stop early
+        std::atomic<bool> found{false};
+        std::atomic<uint64_t> hashes_done{0};
+    };
+
+    NonceScan(State& state, uint32_t begin, uint64_t size) : m_state{&state}, m_begin{begin}, m_size{size} {}
+
+    /** Scan the slice in batches of MINER_BATCH_NONCES, returning the winning nonce. */
+    std::optional<uint32_t> operator()();
+
+private:
+    State* m_state;
+    uint32_t m_begin;
+    uint64_t m_size;
+};
+
+/**
+ * Threads that grind nonces for ScanHeaderNonces. They are started once and
+ * wait for work between headers, so that mining many headers (e.g. a new one
+ * per extranonce or per template) does not start threads for each of them.
+ * The thread calling ScanHeaderNonces takes part in the scan, so a pool of
+ * threads has threads - 1 workers. Only one thread may scan at a time.
+ */
+class MinerThreadPool
+{
+public:
+    explicit MinerThreadPool(int threads);
+    ~MinerThreadPool();
+
+    int GetThreads() const { return m_threads; }
+
+private:
+    friend std::optional<uint32_t> ScanHeaderNonces(const CBlockHeader&, const arith_uint256&, uint64_t,
+                                                    MinerThreadPool&, const util::SignalInterrupt&, uint64_t&);
+
+    /** Scan slices on the workers and the calling thread, returning a winning nonce once all are done. */
+    std::optional<uint32_t> Scan(std::vector<NonceScan> slices) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Scan the slices not taken yet. */
+    void ScanPending(UniqueLock<Mutex>& lock) EXCLUSIVE_LOCKS_REQUIRED(m_mutex);
+    void ThreadWorker() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    const int m_threads;
+    Mutex m_mutex;
+    //! Signalled when slices are added or the workers should stop
+    std::condition_variable m_work_cv;
+    //! Signalled when the last slice of a scan is done
+    std::condition_variable m_done_cv;
+    //! Slices of the current scan no thread has taken yet
+    std::vector<NonceScan> m_pending GUARDED_BY(m_mutex);
+    //! Slices of the current scan not done yet, including those being scanned
+    size_t m_unfinished GUARDED_BY(m_mutex){0};
+    std::optional<uint32_t> m_solution GUARDED_BY(m_mutex);
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::vector<std::thread> m_workers;
+};
+
+/**
+ * Scan up to count nonces of header, starting at header.nNonce, for a hash at
+ * or below target. The first MINER_INLINE_NONCES are tried on the calling
+ * thread, so easy targets never wake the pool; the rest of the range is split
+ * into contiguous slices across the threads of pool.
+ *
+ * @param[in]  count        number of nonces to try; must not run past the
+ *                          end of the 32-bit nonce space
+ * @param[out] hashes_done  number of hashes computed
+ * @returns the winning nonce, or nullopt if the range was exhausted or the
+ *          interrupt was raised.
+ */
+std::optional<uint32_t> ScanHeaderNonces(const CBlockHeader& header, const arith_uint256& target, uint64_t count,
+                                         MinerThreadPool& pool, const util::SignalInterrupt& interrupt, uint64_t& hashes_done);
+
+/**
+ * Grind block until its header hash is at or below target. Whenever the nonce
+ * space is exhausted, a coinbase extranonce is rolled (see MiningJob) and the
+ * header time moved forward to max(min_time, now).
+ *
+ * @param[in,out] block      block to solve, with its merkle root set; on
+ *                           success its coinbase, merkle root, time and nonce
+ *                           are those of the solution
+ * @param[in,out] max_tries  number of hashes left to try, 0 for no limit
+ * @returns whether a solution was found before max_tries ran out or the
+ *          interrupt was raised.
+ */
+bool SolveBlock(CBlock& block, const arith_uint256& target, int64_t min_time, uint64_t& max_tries,
+                MinerThreadPool& pool, const util::SignalInterrupt& interrupt);
+} // namespace node
+
+#endif // BITCOIN_NODE_CPU_MINER_H
@@ -14,6 +14,7 @@
 #include <logging.h>
 #include <node/abort.h>
 #include <node/interface_ui.h>
+#include <node/mining_metrics.h>
 #include <node/warnings.h>
 #include <util/check.h>
 #include <util/signalinterrupt.h>
@@ -56,6 +57,7 @@ kernel::InterruptResult KernelNotifications::blockTip(SynchronizationState state
         m_tip_block = index.GetBlockHash();
         m_tip_block_cv.notify_all();
     }
+    GetMiningMetrics().TipChanged(index.GetBlockHash());
 
     uiInterface.NotifyBlockTip(state, index, verification_progress);
     if (m_stop_at_height && index.nHeight >= m_stop_at_height) {
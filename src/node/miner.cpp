@@ -15,9 +15,11 @@
 #include <consensus/tx_verify.h>
 #include <consensus/validation.h>
 #include <deploymentstatus.h>
+#include <hash.h>
 #include <logging.h>
 #include <node/context.h>
 #include <node/kernel_notifications.h>
+#include <node/mining_metrics.h>
 #include <policy/feerate.h>
 #include <policy/policy.h>
 #include <pow.h>
@@ -25,12 +27,15 @@
 #include <util/moneystr.h>
 #include <util/signalinterrupt.h>
 #include <util/time.h>
+#include <util/trace.h>
 #include <validation.h>
 
 #include <algorithm>
 #include <utility>
 #include <numeric>
 
+TRACEPOINT_SEMAPHORE(mining, block_template);
+
 namespace node {
 
 int64_t GetMinimumTime(const CBlockIndex* pindexPrev, const int64_t difficulty_adjustment_interval)
@@ -146,9 +151,27 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock()
 
     if (m_mempool) {
         LOCK(m_mempool->cs);
-        m_mempool->StartBlockBuilding();
-        addChunks();
-        m_mempool->StopBlockBuilding();
+        const uint256 selection_key{SelectionKey(*pindexPrev)};
+        if (const auto* selection{m_mempool->GetUnchangedMempoolSelection(selection_key)}) {
+            // Nothing was added to, removed from or prioritised in the mempool
+            // since the last template for this tip and these limits, so walking
+            // the chunks again would pick the same transactions.
+            for (const auto& entry : selection->entries) {
+                AddToBlock(entry);
+            }
+            pblocktemplate->m_package_feerates = selection->chunk_feerates;
+        } else {
+            std::vector<CTxMemPoolEntryRef> selected;
+            m_mempool->StartBlockBuilding();
+            addChunks(selected);
+            m_mempool->StopBlockBuilding();
+            m_mempool->CacheUnchangedMempoolSelection({
+                .key = selection_key,
+                .transactions_updated = m_mempool->GetTransactionsUpdated(),
+                .entries = std::move(selected),
+                .chunk_feerates = pblocktemplate->m_package_feerates,
+            });
+        }
     }
 
     const auto time_1{SteadyClock::now()};
@@ -190,9 +213,33 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock()
              Ticks<MillisecondsDouble>(time_2 - time_1),
              Ticks<MillisecondsDouble>(time_2 - time_start));
 
+    const auto build_time{std::chrono::duration_cast<std::chrono::microseconds>(time_2 - time_start)};
+    const auto tip_to_template{GetMiningMetrics().TemplateBuilt(pblock->hashPrevBlock, build_time)};
+    TRACEPOINT(mining, block_template,
+        pblock->hashPrevBlock.data(),
+        (int32_t)nHeight,
+        (uint32_t)pblock->vtx.size(),
+        (int64_t)nFees,
+        (int64_t)count_microseconds(build_time),
+        (int64_t)(tip_to_template ? count_microseconds(*tip_to_template) : -1));
+
     return std::move(pblocktemplate);
 }
 
+uint256 BlockAssembler::SelectionKey(const CBlockIndex& prev) const
+{
+    // Locktime finality depends on nHeight and m_lock_time_cutoff. They follow
+    // from the tip, but are keyed on as well, as that is what the walk checks.
+    return (HashWriter{} << prev.GetBlockHash()
+                         << nHeight
+                         << m_lock_time_cutoff
+                         << uint64_t{m_options.nBlockMaxWeight}
+                         << m_options.blockMinFeeRate.GetFeePerK()
+                         << uint64_t{m_options.block_reserved_weight}
+                         << uint64_t{m_options.coinbase_output_max_additional_sigops})
+        .GetHash();
+}
+
 bool BlockAssembler::TestChunkBlockLimits(FeePerWeight chunk_feerate, int64_t chunk_sigops_cost) const
 {
     if (nBlockWeight + chunk_feerate.size >= m_options.nBlockMaxWeight) {
@@ -233,7 +280,7 @@ void BlockAssembler::AddToBlock(const CTxMemPoolEntry& entry)
     }
 }
 
-void BlockAssembler::addChunks()
+void BlockAssembler::addChunks(std::vector<CTxMemPoolEntryRef>& selected)
 {
     // Limit the number of attempts to add transactions to the block when it is
     // close to full; this is just a simple heuristic to finish quickly if the
@@ -280,6 +327,7 @@ void BlockAssembler::addChunks()
             nConsecutiveFailed = 0;
             for (const auto& tx : selected_transactions) {
                 AddToBlock(tx);
+                selected.push_back(tx);
             }
             pblocktemplate->m_package_feerates.emplace_back(chunk_feerate_vsize);
         }
@@ -11,6 +11,7 @@
 #include <policy/policy.h>
 #include <primitives/block.h>
 #include <txmempool.h>
+#include <uint256.h>
 #include <util/feefrac.h>
 
 #include <cstdint>
@@ -103,11 +104,13 @@ private:
     void AddToBlock(const CTxMemPoolEntry& entry);
 
     // Methods for how to add transactions to a block.
-    /** Add transactions based on chunk feerate
+    /** Add transactions based on chunk feerate, appending the added entries to selected
       *
       * @pre BlockAssembler::m_mempool must not be nullptr
     */
-    void addChunks() EXCLUSIVE_LOCKS_REQUIRED(m_mempool->cs);
+    void addChunks(std::vector<CTxMemPoolEntryRef>& selected) EXCLUSIVE_LOCKS_REQUIRED(m_mempool->cs);
+    /** Identifies the chain tip and block limits a mempool selection is valid for */
+    uint256 SelectionKey(const CBlockIndex& prev) const;
 
     // helper functions for addChunks()
     /** Test if a new chunk would "fit" in the block */
@@ -0,0 +1,151 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/mining_job.h>
+
+#include <arith_uint256.h>
+#include <consensus/merkle.h>
+#include <crypto/common.h>
+#include <crypto/sha256.h>
+#include <hash.h>
+#include <interfaces/mining.h>
+#include <script/script.h>
+#include <serialize.h>
+#include <streams.h>
+#include <util/check.h>
+
+#include <array>
+
+namespace node {
+namespace {
+std::array<unsigned char, EXTRANONCE_SIZE> ExtraNonceBytes(uint64_t extra_nonce)
+{
+    std::array<unsigned char, EXTRANONCE_SIZE> bytes;
+    WriteLE64(bytes.data(), extra_nonce);
+    return bytes;
+}
+} // namespace
+
+MiningJob::MiningJob(const CBlock& block)
+    : m_block{block}
+{
+    Assert(!m_block.vtx.empty() && m_block.vtx[0]->IsCoinBase());
+    m_merkle_path = TransactionMerklePath(m_block, 0);
+
+    CMutableTransaction coinbase{*m_block.vtx[0]};
+    CScript& script_sig{coinbase.vin[0].scriptSig};
+    script_sig << std::vector<unsigned char>(EXTRANONCE_SIZE, 0);
+    Assert(script_sig.size() <= 100);
+
+    DataStream ss{};
+    ss << TX_NO_WITNESS(coinbase);
+    // The extranonce ends the scriptSig of the only input, which comes after
+    // the version, the input count and the prevout.
+    const size_t script_end{4 + GetSizeOfCompactSize(1) + 36 + GetSizeOfCompactSize(script_sig.size()) + script_sig.size()};
+    const auto* data{UCharCast(ss.data())};
+    m_coinbase_prefix.assign(data, data + script_end - EXTRANONCE_SIZE);
+    m_coinbase_suffix.assign(data + script_end, data + ss.size());
+}
+
+Txid MiningJob::GetCoinbaseHash(std::span<const unsigned char, EXTRANONCE_SIZE> extra_nonce) const
+{
+    uint256 hash;
+    CHash256().Write(m_coinbase_prefix).Write(extra_nonce).Write(m_coinbase_suffix).Finalize(hash);
+    return Txid::FromUint256(hash);
+}
+
+CBlockHeader MiningJob::GetHeader(std::span<const unsigned char, EXTRANONCE_SIZE> extra_nonce) const
+{
+    CBlockHeader header{m_block.GetBlockHeader()};
+    header.hashMerkleRoot = ComputeMerkleRootFromBranch(GetCoinbaseHash(extra_nonce).ToUint256(), m_merkle_path, 0);
+    header.nNonce = 0;
+    return header;
+}
+
+CBlockHeader MiningJob::GetHeader(uint64_t extra_nonce) const
+{
+    return GetHeader(ExtraNonceBytes(extra_nonce));
+}
+
+CBlock MiningJob::GetBlock(std::span<const unsigned char, EXTRANONCE_SIZE> extra_nonce, uint32_t time, uint32_t nonce) const
+{
+    CBlock block{m_block};
+    CMutableTransaction coinbase{*block.vtx[0]};
+    coinbase.vin[0].scriptSig << std::vector<unsigned char>(extra_nonce.begin(), extra_nonce.end());
+    block.vtx[0] = MakeTransactionRef(std::move(coinbase));
+    block.hashMerkleRoot = GetHeader(extra_nonce).hashMerkleRoot;
+    block.nTime = time;
+    block.nNonce = nonce;
+
+    // Reset cached checks
+    block.m_checked_witness_commitment = false;
+    block.m_checked_merkle_root = false;
+    block.fChecked = false;
+    return block;
+}
+
+CBlock MiningJob::GetBlock(uint64_t extra_nonce, uint32_t time, uint32_t nonce) const
+{
+    return GetBlock(ExtraNonceBytes(extra_nonce), time, nonce);
+}
+
+std::vector<unsigned char> SerializeMiningWork(const MiningJob& job, uint64_t job_id, bool clean)
+{
+    const CBlockHeader header{job.GetHeader(uint64_t{0})};
+    DataStream header_bytes{};
+    header_bytes << header;
+    std::array<uint32_t, 8> midstate;
+    SHA256Midstate(midstate.data(), UCharCast(header_bytes.data()));
+
+    DataStream ss{};
+    ss << job_id << uint8_t{clean} << header;
+    for (const uint32_t word : midstate) ss << word;
+    ss << ArithToUint256(arith_uint256{}.SetCompact(header.nBits));
+    ss << job.GetCoinbasePrefix() << job.GetCoinbaseSuffix() << job.GetMerklePath();
+    const auto* data{UCharCast(ss.data())};
+    return {data, data + ss.size()};
+}
+
+BlockTemplateFeed::BlockTemplateFeed(interfaces::Mining& mining, const CScript& coinbase_output_script, std::chrono::milliseconds refresh)
+    : m_mining{mining}, m_coinbase_output_script{coinbase_output_script}, m_refresh{refresh} {}
+
+std::shared_ptr<interfaces::BlockTemplate> BlockTemplateFeed::Next(bool& clean)
+{
+    std::shared_ptr<interfaces::BlockTemplate> current;
+    {
+        LOCK(m_mutex);
+        if (m_interrupted) return nullptr;
+        current = m_template;
+    }
+    std::unique_ptr<interfaces::BlockTemplate> next;
+    if (current) {
+        next = current->waitNext({.timeout = m_refresh});
+        if (!next && Interrupted()) return nullptr;
+    }
+    if (!next) {
+        // First template, or no new tip for a while: build one to pick up
+        // the transactions that have arrived since.
+        next = m_mining.createNewBlock({.coinbase_output_script = m_coinbase_output_script});
+        if (!next) return nullptr; // shutting down
+    }
+    clean = !current || next->getBlockHeader().hashPrevBlock != current->getBlockHeader().hashPrevBlock;
+
+    LOCK(m_mutex);
+    if (m_interrupted) return nullptr;
+    m_template = std::move(next);
+    return m_template;
+}
+
+void BlockTemplateFeed::Interrupt()
+{
+    LOCK(m_mutex);
+    m_interrupted = true;
+    if (m_template) m_template->interruptWait();
+}
+
+bool BlockTemplateFeed::Interrupted() const
+{
+    return WITH_LOCK(m_mutex, return m_interrupted);
+}
+} // namespace node
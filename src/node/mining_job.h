@@ -0,0 +1,205 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_MINING_JOB_H
+#define BITCOIN_NODE_MINING_JOB_H
+
+#include <primitives/block.h>
+#include <primitives/transaction.h>
+#include <script/script.h>
+#include <serialize.h>
+#include <sync.h>
+#include <uint256.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace interfaces {
+class BlockTemplate;
+class Mining;
+} // namespace interfaces
+
+namespace node {
+/** Size of the extranonce pushed at the end of the coinbase scriptSig */
+static constexpr size_t EXTRANONCE_SIZE{8};
+/** Number of newest jobs kept by MiningJobList */
+static constexpr size_t MAX_MINING_JOBS{8};
+/** Number of older jobs MiningJobList still recognizes */
+static constexpr size_t MAX_RETIRED_MINING_JOBS{8};
+
+/**
+ * A block template prepared for extranonce rolling.
+ *
+ * The coinbase scriptSig is extended by an EXTRANONCE_SIZE push, and the
+ * coinbase serialization (without witness) is split around it into a prefix
+ * and a suffix. Together with the cached merkle path of the coinbase, a new
+ * extranonce yields a fresh header by hashing the coinbase and one node per
+ * level of the merkle tree, instead of rebuilding the template or
+ * recomputing the whole merkle tree.
+ */
+class MiningJob
+{
+public:
+    /** @pre block.vtx[0] is a coinbase whose scriptSig leaves room for the extranonce push */
+    explicit MiningJob(const CBlock& block);
+
+    /** Header for the given extranonce, with nNonce set to zero. */
+    CBlockHeader GetHeader(std::span<const unsigned char, EXTRANONCE_SIZE> extra_nonce) const;
+    CBlockHeader GetHeader(uint64_t extra_nonce) const;
+
+    /** Full block for a solved header. */
+    CBlock GetBlock(std::span<const unsigned char, EXTRANONCE_SIZE> extra_nonce, uint32_t time, uint32_t nonce) const;
+    CBlock GetBlock(uint64_t extra_nonce, uint32_t time, uint32_t nonce) const;
+
+    /** Coinbase txid for the given extranonce. */
+    Txid GetCoinbaseHash(std::span<const unsigned char, EXTRANONCE_SIZE> extra_nonce) const;
+
+    /** Serialized coinbase (without witness) up to the extranonce. */
+    const std::vector<unsigned char>& GetCoinbasePrefix() const { return m_coinbase_prefix; }
+    /** Serialized coinbase (without witness) after the extranonce. */
+    const std::vector<unsigned char>& GetCoinbaseSuffix() const { return m_coinbase_suffix; }
+    /** Merkle path of the coinbase, ordered from the deepest. */
+    const std::vector<uint256>& GetMerklePath() const { return m_merkle_path; }
+    /** The block the job was created from. */
+    const CBlock& GetTemplate() const { return m_block; }
+
+private:
+    CBlock m_block;
+    std::vector<unsigned char> m_coinbase_prefix;
+    std::vector<unsigned char> m_coinbase_suffix;
+    std::vector<uint256> m_merkle_path;
+};
+
+/**
+ * Compact work unit handed to external miners for job, all integers little-endian:
+ *
+ * - job_id (8 bytes) and a flags byte, bit 0 set if older jobs are now stale
+ * - the 80-byte header for extranonce zero, with nNonce zero
+ * - the SHA256 midstate of its first 64 bytes, as eight 4-byte words
+ * - the 32-byte block target
+ * - the coinbase prefix and suffix around the extranonce, and the coinbase
+ *   merkle path, each prefixed by its CompactSize length
+ *
+ * Miners that only roll nNonce and nTime can hash from the midstate directly;
+ * others roll the extranonce and fold the coinbase hash up the merkle path.
+ */
+std::vector<unsigned char> SerializeMiningWork(const MiningJob& job, uint64_t job_id, bool clean);
+
+/** Solution for a work unit from SerializeMiningWork, as sent back by miners. */
+struct MiningWorkSubmission {
+    uint64_t job_id;
+    std::array<unsigned char, EXTRANONCE_SIZE> extra_nonce;
+    uint32_t time;
+    uint32_t nonce;
+
+    SERIALIZE_METHODS(MiningWorkSubmission, obj) { READWRITE(obj.job_id, obj.extra_nonce, obj.time, obj.nonce); }
+};
+static constexpr size_t MINING_WORK_SUBMISSION_SIZE{8 + EXTRANONCE_SIZE + 4 + 4};
+
+/**
+ * The recent jobs of a server handing out work to external miners, to look
+ * up the job a solution was found for. Job must have an id member.
+ *
+ * The MAX_MINING_JOBS newest jobs are kept, and the MAX_RETIRED_MINING_JOBS
+ * before them are still recognized. Only jobs on a previous tip are stale:
+ * a job pushed out by newer ones on the same tip still builds on the best
+ * block, so a solution for it is as good as one for the newest.
+ *
+ * Not thread-safe: servers guard it with their own mutex.
+ */
+template <typename Job>
+class MiningJobList
+{
+public:
+    /** Make job the newest. If clean, it is on a new tip and all others are stale. */
+    void Add(std::shared_ptr<Job> job, bool clean)
+    {
+        if (clean) {
+            for (auto& retired : m_retired) retired.second = true;
+            for (auto& old : m_jobs) Retire(std::move(old), /*stale=*/true);
+            m_jobs.clear();
+        }
+        m_jobs.push_back(std::move(job));
+        while (m_jobs.size() > MAX_MINING_JOBS) {
+            Retire(std::move(m_jobs.front()), /*stale=*/false);
+            m_jobs.pop_front();
+        }
+    }
+
+    /** The job with the given id, or nullptr if unknown. stale is set if it is on a previous tip. */
+    template <typename Id>
+    std::shared_ptr<Job> Find(const Id& id, bool& stale) const
+    {
+        stale = false;
+        for (const auto& job : m_jobs) {
+            if (job->id == id) return job;
+        }
+        for (const auto& [job, retired_stale] : m_retired) {
+            if (job->id == id) {
+                stale = retired_stale;
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    /** The newest job, or nullptr if there is none. */
+    std::shared_ptr<Job> Newest() const { return m_jobs.empty() ? nullptr : m_jobs.back(); }
+
+private:
+    void Retire(std::shared_ptr<Job> job, bool stale)
+    {
+        m_retired.emplace_back(std::move(job), stale);
+        while (m_retired.size() > MAX_RETIRED_MINING_JOBS) m_retired.pop_front();
+    }
+
+    //! The newest jobs, newest last
+    std::deque<std::shared_ptr<Job>> m_jobs;
+    //! Older jobs, newest last, and whether they are on a previous tip
+    std::deque<std::pair<std::shared_ptr<Job>, bool>> m_retired;
+};
+
+/**
+ * Follows the block templates of the Mining interface for a server handing
+ * out jobs to external miners.
+ *
+ * Each Next() call waits for the current template to be replaced after a new
+ * tip. Without a new tip for refresh, a template is built anyway to pick up
+ * the transactions that have arrived since.
+ */
+class BlockTemplateFeed
+{
+public:
+    BlockTemplateFeed(interfaces::Mining& mining, const CScript& coinbase_output_script, std::chrono::milliseconds refresh);
+
+    /**
+     * Wait for the next template. clean is set if it is on a new tip, so
+     * that work on the previous ones is stale.
+     *
+     * @returns nullptr once interrupted or shutting down
+     */
+    std::shared_ptr<interfaces::BlockTemplate> Next(bool& clean) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Stop waiting for a template, and make later Next() calls return nullptr. */
+    void Interrupt() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    bool Interrupted() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    interfaces::Mining& m_mining;
+    const CScript m_coinbase_output_script;
+    const std::chrono::milliseconds m_refresh;
+
+    mutable Mutex m_mutex;
+    //! Template being waited on, so that the wait can be interrupted
+    std::shared_ptr<interfaces::BlockTemplate> m_template GUARDED_BY(m_mutex);
+    bool m_interrupted GUARDED_BY(m_mutex){false};
+};
+} // namespace node
+
+#endif // BITCOIN_NODE_MINING_JOB_H
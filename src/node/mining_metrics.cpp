@@ -0,0 +1,63 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/mining_metrics.h>
+
+#include <util/trace.h>
+
+#include <algorithm>
+
+TRACEPOINT_SEMAPHORE(mining, solution_found);
+
+namespace node {
+void DurationStats::Add(std::chrono::microseconds duration)
+{
+    ++count;
+    total += duration;
+    last = duration;
+    max = std::max(max, duration);
+}
+
+void MiningMetrics::TipChanged(const uint256& hash)
+{
+    LOCK(m_mutex);
+    if (hash == m_tip) return;
+    m_tip = hash;
+    m_tip_time = SteadyClock::now();
+    m_tip_has_template = false;
+    ++m_metrics.tip_changes;
+}
+
+std::optional<std::chrono::microseconds> MiningMetrics::TemplateBuilt(const uint256& prev_hash, std::chrono::microseconds build_time)
+{
+    const auto bucket{std::ranges::lower_bound(TEMPLATE_BUILD_TIME_BUCKETS, build_time) - TEMPLATE_BUILD_TIME_BUCKETS.begin()};
+    LOCK(m_mutex);
+    m_metrics.template_build.Add(build_time);
+    ++m_metrics.template_build_histogram[bucket];
+    if (m_tip_has_template || prev_hash != m_tip) return std::nullopt;
+    m_tip_has_template = true;
+    const auto tip_to_template{std::chrono::duration_cast<std::chrono::microseconds>(SteadyClock::now() - m_tip_time)};
+    m_metrics.tip_to_template.Add(tip_to_template);
+    return tip_to_template;
+}
+
+void MiningMetrics::SolutionFound(bool stale)
+{
+    TRACEPOINT(mining, solution_found, stale);
+    LOCK(m_mutex);
+    ++m_metrics.solutions;
+    if (stale) ++m_metrics.stale_solutions;
+}
+
+MiningMetricsSnapshot MiningMetrics::GetSnapshot() const
+{
+    return WITH_LOCK(m_mutex, return m_metrics);
+}
+
+MiningMetrics& GetMiningMetrics()
+{
+    static MiningMetrics g_mining_metrics;
+    return g_mining_metrics;
+}
+} // namespace node
@@ -0,0 +1,85 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_MINING_METRICS_H
+#define BITCOIN_NODE_MINING_METRICS_H
+
+#include <sync.h>
+#include <uint256.h>
+#include <util/time.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace node {
+/** Upper bounds of the template build time histogram buckets. A last bucket holds the slower builds. */
+static constexpr std::array<std::chrono::milliseconds, 10> TEMPLATE_BUILD_TIME_BUCKETS{
+    1ms, 2ms, 5ms, 10ms, 25ms, 50ms, 100ms, 250ms, 500ms, 1000ms};
+
+/** Running totals of a duration. */
+struct DurationStats {
+    uint64_t count{0};
+    std::chrono::microseconds total{0};
+    std::chrono::microseconds last{0};
+    std::chrono::microseconds max{0};
+
+    void Add(std::chrono::microseconds duration);
+    std::chrono::microseconds Average() const { return count ? total / int64_t(count) : std::chrono::microseconds{0}; }
+};
+
+struct MiningMetricsSnapshot {
+    //! Block templates built, and how long each took
+    DurationStats template_build;
+    //! Builds per TEMPLATE_BUILD_TIME_BUCKETS bucket
+    std::array<uint64_t, TEMPLATE_BUILD_TIME_BUCKETS.size() + 1> template_build_histogram{};
+    //! From a tip change to the first template on the new tip
+    DurationStats tip_to_template;
+    uint64_t tip_changes{0};
+    //! Blocks found by in-process mining or submitted by external miners
+    uint64_t solutions{0};
+    //! Solutions for a template whose tip had already been replaced
+    uint64_t stale_solutions{0};
+
+    double StaleRatio() const { return solutions ? double(stale_solutions) / solutions : 0.0; }
+};
+
+/**
+ * Mining telemetry gathered by the node: how quickly block templates are
+ * built, how quickly a template follows a new tip, and how much of the work
+ * coming back was done on templates that were already stale.
+ */
+class MiningMetrics
+{
+public:
+    /** The active tip changed to hash. */
+    void TipChanged(const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    /**
+     * A template on top of prev_hash was built in build_time.
+     *
+     * @returns the time since prev_hash became the tip if this is the first template on it
+     */
+    std::optional<std::chrono::microseconds> TemplateBuilt(const uint256& prev_hash, std::chrono::microseconds build_time) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    /** A block was found for a template, which was stale if the template had been replaced after a new tip. */
+    void SolutionFound(bool stale) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    MiningMetricsSnapshot GetSnapshot() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    mutable Mutex m_mutex;
+    MiningMetricsSnapshot m_metrics GUARDED_BY(m_mutex);
+    uint256 m_tip GUARDED_BY(m_mutex);
+    SteadyClock::time_point m_tip_time GUARDED_BY(m_mutex);
+    //! Whether a template was built on m_tip yet
+    bool m_tip_has_template GUARDED_BY(m_mutex){true};
+};
+
+/** Mining metrics of this node, reported by getminingmetrics. */
+MiningMetrics& GetMiningMetrics();
+} // namespace node
+
+#endif // BITCOIN_NODE_MINING_METRICS_H
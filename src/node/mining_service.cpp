@@ -0,0 +1,161 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/mining_service.h>
+
+#include <chain.h>
+#include <consensus/merkle.h>
+#include <logging.h>
+#include <node/cpu_miner.h>
+#include <node/mining_metrics.h>
+#include <pow.h>
+#include <primitives/block.h>
+#include <util/threadnames.h>
+#include <validation.h>
+
+#include <exception>
+#include <memory>
+
+namespace node {
+MiningService::MiningService(ChainstateManager& chainman, const CTxMemPool* mempool, const BlockAssembler::Options& options)
+    : m_chainman{chainman}, m_mempool{mempool}, m_options{options} {}
+
+MiningService::~MiningService()
+{
+    Stop();
+}
+
+void MiningService::Start(const CScript& script, int threads)
+{
+    LOCK(m_control_mutex);
+    StopThread();
+    m_stop = false;
+    if (!m_work_interrupt.reset()) {
+        LogError("Internal error: failed to reset mining interrupt");
+        return;
+    }
+    m_threads = threads;
+    m_mining = true;
+    m_thread = std::thread(&MiningService::ThreadMine, this, script, threads);
+}
+
+void MiningService::Interrupt()
+{
+    m_stop = true;
+    InterruptWork();
+    WITH_LOCK(m_mutex, m_cv.notify_all());
+}
+
+void MiningService::Stop()
+{
+    LOCK(m_control_mutex);
+    StopThread();
+}
+
+void MiningService::StopThread()
+{
+    Interrupt();
+    if (m_thread.joinable()) m_thread.join();
+    m_mining = false;
+    m_threads = 0;
+}
+
+void MiningService::InterruptWork()
+{
+    if (!m_work_interrupt()) LogError("Internal error: failed to interrupt mining");
+}
+
+MiningStats MiningService::GetStats() const
+{
+    return MiningStats{
+        .templates = m_templates.load(),
+        .blocks_found = m_blocks_found.load(),
+        .blocks_accepted = m_blocks_accepted.load(),
+        .blocks_stale = m_blocks_stale.load(),
+    };
+}
+
+void MiningService::UpdatedBlockTip(const CBlockIndex* pindexNew, const CBlockIndex* pindexFork, bool fInitialDownload)
+{
+    if (!m_mining) return;
+    LOCK(m_mutex);
+    if (pindexNew->GetBlockHash() == m_work_prev_hash) return;
+    InterruptWork();
+}
+
+void MiningService::TransactionAddedToMempool(const NewMempoolTransactionInfo& tx, uint64_t mempool_sequence)
+{
+    if (!m_mining) return;
+    LOCK(m_mutex);
+    if (SteadyClock::now() - m_work_time < MINING_MEMPOOL_REFRESH_INTERVAL) return;
+    InterruptWork();
+}
+
+void MiningService::ThreadMine(CScript script, int threads)
+{
+    util::ThreadRename("miner");
+    LogInfo("Mining service started with %d threads", threads);
+    BlockAssembler::Options options{m_options};
+    options.coinbase_output_script = std::move(script);
+    // The workers are kept for the life of the service, not per template.
+    MinerThreadPool pool{threads};
+
+    while (!m_stop) {
+        // Any interrupt raised from here on makes the next template stale.
+        if (!m_work_interrupt.reset()) {
+            LogError("Internal error: failed to reset mining interrupt");
+            break;
+        }
+        if (m_stop) break;
+
+        std::unique_ptr<CBlockTemplate> block_template;
+        try {
+            block_template = BlockAssembler{m_chainman.ActiveChainstate(), m_mempool, options}.CreateNewBlock();
+        } catch (const std::exception& e) {
+            LogWarning("Mining service could not create a block template: %s", e.what());
+        }
+        if (!block_template) {
+            WAIT_LOCK(m_mutex, lock);
+            m_cv.wait_for(lock, MINING_RETRY_INTERVAL, [&] { return m_stop.load(); });
+            continue;
+        }
+        ++m_templates;
+
+        CBlock& block{block_template->block};
+        {
+            LOCK(m_mutex);
+            m_work_prev_hash = block.hashPrevBlock;
+            m_work_time = SteadyClock::now();
+        }
+        const auto target{DeriveTarget(block.nBits, m_chainman.GetConsensus().powLimit)};
+        if (!target) {
+            LogWarning("Mining service got a template with invalid nBits %08x", block.nBits);
+            WAIT_LOCK(m_mutex, lock);
+            m_cv.wait_for(lock, MINING_RETRY_INTERVAL, [&] { return m_stop.load(); });
+            continue;
+        }
+        block.hashMerkleRoot = BlockMerkleRoot(block);
+
+        // CreateNewBlock already picked a valid time, which SolveBlock only
+        // moves forward when rolling the extranonce.
+        uint64_t max_tries{0};
+        if (!SolveBlock(block, *target, block.nTime, max_tries, pool, m_work_interrupt)) continue;
+        ++m_blocks_found;
+
+        const auto shared_block{std::make_shared<const CBlock>(std::move(block))};
+        const uint256 hash{shared_block->GetHash()};
+        m_chainman.ProcessNewBlock(shared_block, /*force_processing=*/true, /*min_pow_checked=*/true, /*new_block=*/nullptr);
+        const bool accepted{WITH_LOCK(cs_main, return m_chainman.ActiveTip()->GetBlockHash()) == hash};
+        GetMiningMetrics().SolutionFound(/*stale=*/!accepted);
+        if (accepted) {
+            ++m_blocks_accepted;
+            LogInfo("Mining service found block %s", hash.ToString());
+        } else {
+            ++m_blocks_stale;
+            LogInfo("Mining service found block %s, which did not become the tip", hash.ToString());
+        }
+    }
+    LogInfo("Mining service stopped");
+}
+} // namespace node
@@ -0,0 +1,112 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_MINING_SERVICE_H
+#define BITCOIN_NODE_MINING_SERVICE_H
+
+#include <node/miner.h>
+#include <script/script.h>
+#include <sync.h>
+#include <uint256.h>
+#include <util/signalinterrupt.h>
+#include <util/time.h>
+#include <validationinterface.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <thread>
+
+class CBlockIndex;
+class ChainstateManager;
+class CTxMemPool;
+struct NewMempoolTransactionInfo;
+
+namespace node {
+/** Default for -gen */
+static constexpr bool DEFAULT_GENERATE{false};
+/** Minimum age of a block template before mempool changes cause it to be rebuilt */
+static constexpr std::chrono::seconds MINING_MEMPOOL_REFRESH_INTERVAL{10};
+/** How long to wait before retrying after a block template could not be built */
+static constexpr std::chrono::seconds MINING_RETRY_INTERVAL{1};
+
+struct MiningStats {
+    //! Block templates built
+    uint64_t templates{0};
+    //! Solutions found
+    uint64_t blocks_found{0};
+    //! Solutions that became the active tip
+    uint64_t blocks_accepted{0};
+    //! Solutions that were rejected or did not become the active tip
+    uint64_t blocks_stale{0};
+};
+
+/**
+ * Background in-process miner, started with -gen or the setgenerate RPC.
+ *
+ * A coordinator thread builds a block template through BlockAssembler and
+ * grinds it with SolveBlock on a MinerThreadPool of the configured number of
+ * threads, started once with the service. The template is rebuilt as soon as
+ * the tip changes, or on a mempool change once it is older than
+ * MINING_MEMPOOL_REFRESH_INTERVAL: the validation callbacks
+ * raise the work interrupt, which the worker threads poll between batches of
+ * MINER_BATCH_NONCES, so stale work is abandoned within milliseconds.
+ */
+class MiningService final : public CValidationInterface
+{
+public:
+    MiningService(ChainstateManager& chainman, const CTxMemPool* mempool, const BlockAssembler::Options& options);
+    ~MiningService();
+
+    /** Start mining to script on threads workers, restarting if already running. */
+    void Start(const CScript& script, int threads) EXCLUSIVE_LOCKS_REQUIRED(!m_control_mutex, !m_mutex);
+    /** Ask the coordinator thread to stop, without waiting for it. */
+    void Interrupt() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Stop mining and wait for the coordinator thread to exit. */
+    void Stop() EXCLUSIVE_LOCKS_REQUIRED(!m_control_mutex, !m_mutex);
+
+    bool IsMining() const { return m_mining.load(); }
+    int GetThreads() const { return m_threads.load(); }
+    MiningStats GetStats() const;
+
+protected:
+    // CValidationInterface
+    void UpdatedBlockTip(const CBlockIndex* pindexNew, const CBlockIndex* pindexFork, bool fInitialDownload) override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void TransactionAddedToMempool(const NewMempoolTransactionInfo& tx, uint64_t mempool_sequence) override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    void ThreadMine(CScript script, int threads) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void StopThread() EXCLUSIVE_LOCKS_REQUIRED(m_control_mutex, !m_mutex);
+    /** Abandon the current work, so the coordinator builds a new template. */
+    void InterruptWork();
+
+    ChainstateManager& m_chainman;
+    const CTxMemPool* const m_mempool;
+    const BlockAssembler::Options m_options;
+
+    //! Serializes Start and Stop
+    Mutex m_control_mutex;
+    std::thread m_thread GUARDED_BY(m_control_mutex);
+
+    std::atomic<bool> m_mining{false};
+    std::atomic<bool> m_stop{false};
+    std::atomic<int> m_threads{0};
+    //! Raised when the current work is stale or mining stops
+    util::SignalInterrupt m_work_interrupt;
+
+    mutable Mutex m_mutex;
+    std::condition_variable m_cv;
+    //! Previous block and creation time of the template being mined
+    uint256 m_work_prev_hash GUARDED_BY(m_mutex);
+    SteadyClock::time_point m_work_time GUARDED_BY(m_mutex);
+
+    std::atomic<uint64_t> m_templates{0};
+    std::atomic<uint64_t> m_blocks_found{0};
+    std::atomic<uint64_t> m_blocks_accepted{0};
+    std::atomic<uint64_t> m_blocks_stale{0};
+};
+} // namespace node
+
+#endif // BITCOIN_NODE_MINING_SERVICE_H
@@ -23,6 +23,10 @@ void ApplyArgsManOptions(const ArgsManager& argsman, PeerManager::Options& optio
     if (auto value{argsman.GetBoolArg("-capturemessages")}) options.capture_messages = *value;
 
     if (auto value{argsman.GetBoolArg("-blocksonly")}) options.ignore_incoming_txs = *value;
+
+    if (auto value{argsman.GetIntArg("-blockservecache")}) {
+        options.block_serve_cache_bytes = size_t(std::clamp<int64_t>(*value, 0, std::numeric_limits<int64_t>::max() >> 20)) << 20;
+    }
 }
 
 } // namespace node
@@ -11,6 +11,8 @@
 #include <uint256.h>
 #include <util/check.h>
 
+#include <atomic>
+
 /** DRIP: Check if a height is a difficulty adjustment boundary */
 static bool IsDifficultyAdjustmentBoundary(int height, const Consensus::Params& params)
 {
@@ -60,11 +62,21 @@ unsigned int GetNextWorkRequired(const CBlockIndex* pindexLast, const CBlockHead
                 return nProofOfWorkLimit;
             else
             {
-                // Return the last non-special-min-difficulty-rules-block
+                // Return the last non-special-min-difficulty-rules-block.
+                // The result is kept on pindexLast, and the walk stops at a
+                // block that has one, so that a run of min-difficulty headers
+                // takes one step per header instead of a walk back to the
+                // start of the difficulty period.
                 const CBlockIndex* pindex = pindexLast;
-                while (pindex->pprev && !IsDifficultyAdjustmentBoundary(pindex->nHeight, params) && pindex->nBits == nProofOfWorkLimit)
+                uint32_t bits{0};
+                while (pindex->pprev && !IsDifficultyAdjustmentBoundary(pindex->nHeight, params) && pindex->nBits == nProofOfWorkLimit) {
                     pindex = pindex->pprev;
-                return pindex->nBits;
+                    // The walk from pindex continues the one from pindexLast
+                    if ((bits = std::atomic_ref{pindex->m_min_difficulty_walk_bits}.load(std::memory_order_relaxed))) break;
+                }
+                if (!bits) bits = pindex->nBits;
+                if (pindex != pindexLast) std::atomic_ref{pindexLast->m_min_difficulty_walk_bits}.store(bits, std::memory_order_relaxed);
+                return bits;
             }
         }
         return pindexLast->nBits;
@@ -241,6 +241,33 @@ bool XOnlyPubKey::VerifySchnorr(const uint256& msg, std::span<const unsigned cha
     return secp256k1_schnorrsig_verify(secp256k1_context_static, sigbytes.data(), msg.begin(), 32, &pubkey);
 }
 
+void SchnorrBatch::Add(std::span<const unsigned char> sigbytes, const XOnlyPubKey& pubkey, const uint256& msg)
+{
+    assert(sigbytes.size() == 64);
+    Entry& entry{m_entries.emplace_back()};
+    std::copy(sigbytes.begin(), sigbytes.end(), entry.sig.begin());
+    entry.pubkey = pubkey;
+    entry.msg = msg;
+}
+
+bool SchnorrBatch::Verify() const
+{
+    std::vector<secp256k1_xonly_pubkey> pubkeys(m_entries.size());
+    std::vector<const unsigned char*> sigs, msgs;
+    std::vector<const secp256k1_xonly_pubkey*> pubkey_ptrs;
+    sigs.reserve(m_entries.size());
+    msgs.reserve(m_entries.size());
+    pubkey_ptrs.reserve(m_entries.size());
+    for (size_t i{0}; i < m_entries.size(); ++i) {
+        if (!secp256k1_xonly_pubkey_parse(secp256k1_context_static, &pubkeys[i], m_entries[i].pubkey.data())) return false;
+        sigs.push_back(m_entries[i].sig.data());
+        msgs.push_back(m_entries[i].msg.begin());
+        pubkey_ptrs.push_back(&pubkeys[i]);
+    }
+    const std::vector<size_t> msglens(m_entries.size(), uint256::size());
+    return secp256k1_schnorrsig_verify_batch(secp256k1_context_static, sigs.data(), msgs.data(), msglens.data(), pubkey_ptrs.data(), m_entries.size());
+}
+
 static const HashWriter HASHER_TAPTWEAK{TaggedHash("TapTweak")};
 
 uint256 XOnlyPubKey::ComputeTapTweakHash(const uint256* merkle_root) const
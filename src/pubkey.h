@@ -12,6 +12,7 @@
 #include <span.h>
 #include <uint256.h>
 
+#include <array>
 #include <cstring>
 #include <optional>
 #include <vector>
@@ -304,6 +305,37 @@ public:
     SERIALIZE_METHODS(XOnlyPubKey, obj) { READWRITE(obj.m_keydata); }
 };
 
+/**
+ * Schnorr signatures collected to be verified together, which is faster than
+ * calling XOnlyPubKey::VerifySchnorr on each of them.
+ */
+class SchnorrBatch
+{
+private:
+    struct Entry {
+        std::array<unsigned char, 64> sig;
+        XOnlyPubKey pubkey;
+        uint256 msg;
+    };
+    std::vector<Entry> m_entries;
+
+public:
+    /** Add a signature to verify. sigbytes must be exactly 64 bytes. */
+    void Add(std::span<const unsigned char> sigbytes, const XOnlyPubKey& pubkey, const uint256& msg);
+
+    /**
+     * Verify all signatures added.
+     *
+     * @returns whether they are all valid. A failure does not tell which of
+     *          them is not.
+     */
+    bool Verify() const;
+
+    size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+    void clear() { m_entries.clear(); }
+};
+
 /** An ElligatorSwift-encoded public key. */
 struct EllSwiftPubKey
 {
@@ -37,6 +37,7 @@
 #include <rpc/server_util.h>
 #include <rpc/util.h>
 #include <script/descriptor.h>
+#include <script/sigcache.h>
 #include <serialize.h>
 #include <streams.h>
 #include <sync.h>
@@ -3464,6 +3465,71 @@ return RPCHelpMan{
     };
 }
 
+static std::vector<RPCResult> SignatureCacheStatsDoc()
+{
+    return {
+        {RPCResult::Type::NUM, "hits", "Signatures found in the cache when accepting transactions to the mempool"},
+        {RPCResult::Type::NUM, "misses", "Signatures not found in the cache when accepting transactions to the mempool"},
+        {RPCResult::Type::NUM, "block_hits", "Signatures found in the cache when connecting blocks"},
+        {RPCResult::Type::NUM, "block_misses", "Signatures not found in the cache when connecting blocks"},
+        {RPCResult::Type::NUM, "block_hit_rate", "The ratio of block_hits to lookups when connecting blocks"},
+        {RPCResult::Type::NUM, "inserts", "Signatures added to the cache"},
+        {RPCResult::Type::NUM, "evictions", "Signatures dropped from the cache for lack of room"},
+    };
+}
+
+static UniValue SignatureCacheStatsToJSON(const SignatureCacheStats& stats)
+{
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("hits", stats.hits);
+    obj.pushKV("misses", stats.misses);
+    obj.pushKV("block_hits", stats.block_hits);
+    obj.pushKV("block_misses", stats.block_misses);
+    obj.pushKV("block_hit_rate", stats.BlockHitRate());
+    obj.pushKV("inserts", stats.inserts);
+    obj.pushKV("evictions", stats.evictions);
+    return obj;
+}
+
+static RPCHelpMan getsignaturecacheinfo()
+{
+    return RPCHelpMan{
+        "getsignaturecacheinfo",
+        "Returns statistics of the signature cache, in total and for each of its shards.",
+        {},
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::BOOL, "pinned", "Whether signatures cached at mempool acceptance are kept until their block is connected (-sigcachepin)"},
+                {RPCResult::Type::OBJ, "total", "Statistics of the whole cache", SignatureCacheStatsDoc()},
+                {RPCResult::Type::ARR, "shards", "Statistics of each shard",
+                {
+                    {RPCResult::Type::OBJ, "", "", SignatureCacheStatsDoc()},
+                }},
+            }},
+        RPCExamples{
+            HelpExampleCli("getsignaturecacheinfo", "")
+            + HelpExampleRpc("getsignaturecacheinfo", "")
+        },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    ChainstateManager& chainman = EnsureAnyChainman(request.context);
+    const std::vector<SignatureCacheStats> shard_stats{chainman.m_validation_cache.m_signature_cache.GetShardStats()};
+
+    SignatureCacheStats total;
+    UniValue shards(UniValue::VARR);
+    for (const SignatureCacheStats& stats : shard_stats) {
+        total += stats;
+        shards.push_back(SignatureCacheStatsToJSON(stats));
+    }
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("pinned", chainman.m_options.signature_cache_pin);
+    obj.pushKV("total", SignatureCacheStatsToJSON(total));
+    obj.pushKV("shards", std::move(shards));
+    return obj;
+},
+    };
+}
 
 void RegisterBlockchainRPCCommands(CRPCTable& t)
 {
@@ -3492,6 +3558,7 @@ void RegisterBlockchainRPCCommands(CRPCTable& t)
         {"blockchain", &dumptxoutset},
         {"blockchain", &loadtxoutset},
         {"blockchain", &getchainstates},
+        {"blockchain", &getsignaturecacheinfo},
         {"hidden", &invalidateblock},
         {"hidden", &reconsiderblock},
         {"blockchain", &waitfornewblock},
@@ -66,6 +66,8 @@ static const CRPCConvertParam vRPCConvertParams[] =
     { "generatetodescriptor", 2, "maxtries" },
     { "generateblock", 1, "transactions" },
     { "generateblock", 2, "submit" },
+    { "setgenerate", 0, "generate" },
+    { "setgenerate", 1, "genthreads" },
     { "getnetworkhashps", 0, "nblocks" },
     { "getnetworkhashps", 1, "height" },
     { "sendtoaddress", 0, "address", ParamFormat::STRING },
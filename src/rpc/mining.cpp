@@ -8,6 +8,7 @@
 #include <chain.h>
 #include <chainparams.h>
 #include <chainparamsbase.h>
+#include <common/args.h>
 #include <common/system.h>
 #include <consensus/amount.h>
 #include <consensus/consensus.h>
@@ -22,7 +23,10 @@
 #include <logging.h>
 #include <net.h>
 #include <node/context.h>
+#include <node/cpu_miner.h>
 #include <node/miner.h>
+#include <node/mining_metrics.h>
+#include <node/mining_service.h>
 #include <node/warnings.h>
 #include <policy/ephemeral_policy.h>
 #include <pow.h>
@@ -44,7 +48,9 @@
 #include <validation.h>
 #include <validationinterface.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <deque>
 #include <memory>
 
 using interfaces::BlockRef;
@@ -57,13 +63,32 @@ using node::RegenerateCommitments;
 using node::UpdateTime;
 using util::ToString;
 
+namespace {
+/** Time range of the blocks from start to end, kept so that later estimates can extend it. */
+struct HashRateWindow {
+    uint256 start;
+    uint256 end;
+    int end_height;
+    int64_t min_time;
+    int64_t max_time;
+};
+//! Recently used windows, at most one per start block, most recent first
+std::deque<HashRateWindow> g_hash_rate_windows GUARDED_BY(cs_main);
+constexpr size_t MAX_HASH_RATE_WINDOWS{8};
+} // namespace
+
 /**
  * Return average network hashes per second based on the last 'lookup' blocks,
  * or from the last difficulty change if 'lookup' is -1.
  * If 'height' is -1, compute the estimate from current chain tip.
  * If 'height' is a valid block height, compute the estimate at the time when a given block was found.
+ *
+ * The time range of the blocks is cached, so that repeated calls for the same
+ * blocks do not walk the chain again, and an estimate whose window starts at
+ * the same block as an earlier one (such as every -1 estimate within a
+ * difficulty period) only walks the blocks added since.
  */
-static UniValue GetNetworkHashPS(int lookup, int height, const CChain& active_chain) {
+static UniValue GetNetworkHashPS(int lookup, int height, const CChain& active_chain) EXCLUSIVE_LOCKS_REQUIRED(cs_main) {
     if (lookup < -1 || lookup == 0) {
         throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid nblocks. Must be a positive number or -1.");
     }
@@ -89,22 +114,28 @@ static UniValue GetNetworkHashPS(int lookup, int height, const CChain& active_ch
     if (lookup > pb->nHeight)
         lookup = pb->nHeight;
 
-    const CBlockIndex* pb0 = pb;
-    int64_t minTime = pb0->GetBlockTime();
-    int64_t maxTime = minTime;
-    for (int i = 0; i < lookup; i++) {
-        pb0 = pb0->pprev;
-        int64_t time = pb0->GetBlockTime();
-        minTime = std::min(time, minTime);
-        maxTime = std::max(time, maxTime);
+    const CBlockIndex* pb0 = pb->GetAncestor(pb->nHeight - lookup);
+    HashRateWindow window{pb0->GetBlockHash(), pb0->GetBlockHash(), pb0->nHeight, pb0->GetBlockTime(), pb0->GetBlockTime()};
+    const auto cached{std::ranges::find_if(g_hash_rate_windows, [&](const HashRateWindow& w) { return w.start == window.start; })};
+    if (cached != g_hash_rate_windows.end()) {
+        if (cached->end_height <= pb->nHeight && pb->GetAncestor(cached->end_height)->GetBlockHash() == cached->end) window = *cached;
+        g_hash_rate_windows.erase(cached);
+    }
+    for (const CBlockIndex* block = pb; block->nHeight > window.end_height; block = block->pprev) {
+        window.min_time = std::min(block->GetBlockTime(), window.min_time);
+        window.max_time = std::max(block->GetBlockTime(), window.max_time);
     }
+    window.end = pb->GetBlockHash();
+    window.end_height = pb->nHeight;
+    g_hash_rate_windows.push_front(window);
+    if (g_hash_rate_windows.size() > MAX_HASH_RATE_WINDOWS) g_hash_rate_windows.pop_back();
 
     // In case there's a situation where minTime == maxTime, we don't want a divide by zero exception.
-    if (minTime == maxTime)
+    if (window.min_time == window.max_time)
         return 0;
 
     arith_uint256 workDiff = pb->nChainWork - pb0->nChainWork;
-    int64_t timeDiff = maxTime - minTime;
+    int64_t timeDiff = window.max_time - window.min_time;
 
     return workDiff.getdouble() / timeDiff;
 }
@@ -135,91 +166,17 @@ static RPCHelpMan getnetworkhashps()
     };
 }
 
-static bool GenerateBlock(ChainstateManager& chainman, CBlock&& block, uint64_t& max_tries, std::shared_ptr<const CBlock>& block_out, bool process_new_block)
+static bool GenerateBlock(ChainstateManager& chainman, CBlock&& block, uint64_t& max_tries, node::MinerThreadPool& pool, std::shared_ptr<const CBlock>& block_out, bool process_new_block)
 {
     block_out.reset();
     block.hashMerkleRoot = BlockMerkleRoot(block);
 
-    // Log block structure for debugging
-    auto target = DeriveTarget(block.nBits, chainman.GetConsensus().powLimit);
-    LogInfo("Mining: Block height=%d, nBits=0x%08x, target=%s, prevHash=%s, merkleRoot=%s\n",
-            -1, // Can't easily get height here
-            block.nBits,
-            target ? target->GetHex() : "INVALID",
-            block.hashPrevBlock.ToString(),
-            block.hashMerkleRoot.ToString());
-
-    uint64_t tries_done = 0;
-    uint32_t start_nonce = block.nNonce;
+    const auto target{DeriveTarget(block.nBits, chainman.GetConsensus().powLimit)};
+    if (!target) return false;
+
     const CBlockIndex* pindexPrev = WITH_LOCK(chainman.GetMutex(), return chainman.ActiveTip());
-    constexpr uint32_t TIMESTAMP_UPDATE_INTERVAL = 0x1000000; // Update timestamp every 16M nonces
-    
-    // If max_tries is 0, mine infinitely until a block is found or interrupted
-    const bool infinite_mining = (max_tries == 0);
-    while ((infinite_mining || max_tries > 0) && !CheckProofOfWork(block.GetHash(), block.nBits, chainman.GetConsensus()) && !chainman.m_interrupt) {
-        ++block.nNonce;
-        if (!infinite_mining) {
-            --max_tries;
-        }
-        ++tries_done;
-        
-        // If nonce wraps, update timestamp and reset nonce
-        if (block.nNonce == 0) { // Wrapped around
-            int64_t nNewTime = std::max<int64_t>(pindexPrev ? pindexPrev->GetMedianTimePast() + 1 : 0,
-                                                 TicksSinceEpoch<std::chrono::seconds>(NodeClock::now()));
-            if (nNewTime > block.nTime) {
-                block.nTime = nNewTime;
-                block.hashMerkleRoot = BlockMerkleRoot(block); // Recalculate merkle root if time changed
-                LogInfo("Mining: updated timestamp to %d, recalculated merkle root\n", block.nTime);
-            } else {
-                // Can't update timestamp, need new template
-                LogInfo("Mining: nonce wrapped, timestamp can't be updated, need new template\n");
-                return false;
-            }
-        }
-        
-        // Update timestamp periodically even if nonce hasn't wrapped
-        else if (tries_done % TIMESTAMP_UPDATE_INTERVAL == 0) {
-            int64_t nNewTime = std::max<int64_t>(pindexPrev ? pindexPrev->GetMedianTimePast() + 1 : 0,
-                                                 TicksSinceEpoch<std::chrono::seconds>(NodeClock::now()));
-            if (nNewTime > block.nTime) {
-                block.nTime = nNewTime;
-                block.hashMerkleRoot = BlockMerkleRoot(block);
-                LogInfo("Mining: updated timestamp to %d at %llu tries, recalculated merkle root\n", block.nTime, tries_done);
-            } else {
-                // Force timestamp update if we've tried many nonces without success
-                if (tries_done >= 50000000) {
-                    block.nTime = TicksSinceEpoch<std::chrono::seconds>(NodeClock::now());
-                    block.hashMerkleRoot = BlockMerkleRoot(block);
-                    LogInfo("Mining: forced timestamp update to %d at %llu tries\n", block.nTime, tries_done);
-                }
-            }
-        }
-        
-        // Log progress every 1M tries for debugging
-        if (tries_done % 1000000 == 0) {
-            LogInfo("Mining: tried %llu nonces (current: %u, target: %s)\n", 
-                     tries_done, block.nNonce, block.GetHash().ToString());
-        }
-    }
-    
-    if (chainman.m_interrupt) {
-        LogInfo("Mining: interrupted after %llu tries, nonce range %u-%u, final hash: %s\n",
-                 tries_done, start_nonce, block.nNonce, block.GetHash().ToString());
-        return false;
-    }
-    if (!infinite_mining && max_tries == 0) {
-        LogInfo("Mining: exhausted %llu tries, nonce range %u-%u, final hash: %s\n",
-                 tries_done, start_nonce, block.nNonce, block.GetHash().ToString());
-        return false;
-    }
-    if (block.nNonce == std::numeric_limits<uint32_t>::max()) {
-        LogInfo("Mining: nonce wrapped around, need new template\n");
-        return false; // Changed from true - nonce wrap means we need a new template
-    }
-    
-    LogInfo("Mining: found block after %llu tries, nonce: %u, hash: %s\n",
-             tries_done, block.nNonce, block.GetHash().ToString());
+    const int64_t min_time{pindexPrev ? pindexPrev->GetMedianTimePast() + 1 : 0};
+    if (!node::SolveBlock(block, *target, min_time, max_tries, pool, chainman.m_interrupt)) return false;
 
     block_out = std::make_shared<const CBlock>(std::move(block));
 
@@ -228,19 +185,21 @@ static bool GenerateBlock(ChainstateManager& chainman, CBlock&& block, uint64_t&
     if (!chainman.ProcessNewBlock(block_out, /*force_processing=*/true, /*min_pow_checked=*/true, nullptr)) {
         throw JSONRPCError(RPC_INTERNAL_ERROR, "ProcessNewBlock, block not accepted");
     }
+    node::GetMiningMetrics().SolutionFound(/*stale=*/WITH_LOCK(cs_main, return chainman.ActiveTip()->GetBlockHash()) != block_out->GetHash());
 
     return true;
 }
 
-static UniValue generateBlocks(ChainstateManager& chainman, Mining& miner, const CScript& coinbase_output_script, int nGenerate, uint64_t nMaxTries)
+static UniValue generateBlocks(ChainstateManager& chainman, Mining& miner, const CScript& coinbase_output_script, int nGenerate, uint64_t nMaxTries, int threads)
 {
     UniValue blockHashes(UniValue::VARR);
+    node::MinerThreadPool pool{threads};
     while (nGenerate > 0 && !chainman.m_interrupt) {
         std::unique_ptr<BlockTemplate> block_template(miner.createNewBlock({ .coinbase_output_script = coinbase_output_script }));
         CHECK_NONFATAL(block_template);
 
         std::shared_ptr<const CBlock> block_out;
-        if (!GenerateBlock(chainman, block_template->getBlock(), nMaxTries, block_out, /*process_new_block=*/true)) {
+        if (!GenerateBlock(chainman, block_template->getBlock(), nMaxTries, pool, block_out, /*process_new_block=*/true)) {
             break;
         }
 
@@ -252,6 +211,20 @@ static UniValue generateBlocks(ChainstateManager& chainman, Mining& miner, const
     return blockHashes;
 }
 
+static int GetMiningThreads(int64_t requested)
+{
+    const auto threads{node::GetMiningThreads(requested)};
+    if (!threads) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("genthreads must be at most %d", node::MAX_GENERATE_THREADS));
+    }
+    return *threads;
+}
+
+static int GetGenerateThreads(const NodeContext& node)
+{
+    return GetMiningThreads(node.args->GetIntArg("-genthreads", node::DEFAULT_GENERATE_THREADS));
+}
+
 static bool getScriptFromDescriptor(std::string_view descriptor, CScript& script, std::string& error)
 {
     FlatSigningProvider key_provider;
@@ -321,7 +294,7 @@ static RPCHelpMan generatetodescriptor()
     Mining& miner = EnsureMining(node);
     ChainstateManager& chainman = EnsureChainman(node);
 
-    return generateBlocks(chainman, miner, coinbase_output_script, num_blocks, max_tries);
+    return generateBlocks(chainman, miner, coinbase_output_script, num_blocks, max_tries, GetGenerateThreads(node));
 },
     };
 }
@@ -369,7 +342,7 @@ static RPCHelpMan generatetoaddress()
 
     CScript coinbase_output_script = GetScriptForDestination(destination);
 
-    return generateBlocks(chainman, miner, coinbase_output_script, num_blocks, max_tries);
+    return generateBlocks(chainman, miner, coinbase_output_script, num_blocks, max_tries, GetGenerateThreads(node));
 },
     };
 }
@@ -468,7 +441,8 @@ static RPCHelpMan generateblock()
     std::shared_ptr<const CBlock> block_out;
     uint64_t max_tries{0}; // 0 = infinite mining
 
-    if (!GenerateBlock(chainman, std::move(block), max_tries, block_out, process_new_block) || !block_out) {
+    node::MinerThreadPool pool{GetGenerateThreads(node)};
+    if (!GenerateBlock(chainman, std::move(block), max_tries, pool, block_out, process_new_block) || !block_out) {
         throw JSONRPCError(RPC_MISC_ERROR, "Failed to make block.");
     }
 
@@ -484,6 +458,163 @@ static RPCHelpMan generateblock()
     };
 }
 
+static RPCHelpMan setgenerate()
+{
+    return RPCHelpMan{
+        "setgenerate",
+        "Start or stop mining blocks in the background.\n"
+        "Mining runs until it is stopped, rebuilding its block template whenever the tip changes.",
+        {
+            {"generate", RPCArg::Type::BOOL, RPCArg::Optional::NO, "Set to true to start mining, false to stop."},
+            {"genthreads", RPCArg::Type::NUM, RPCArg::DefaultHint{"-genthreads"}, "The number of threads to mine with (-1 = all cores)."},
+            {"address", RPCArg::Type::STR, RPCArg::DefaultHint{"-genaddress"}, "The address to send the newly generated drip to."},
+        },
+        RPCResult{RPCResult::Type::NONE, "", ""},
+        RPCExamples{
+            HelpExampleCli("setgenerate", "true 2 \"myaddress\"")
+            + HelpExampleCli("setgenerate", "false")
+            + HelpExampleRpc("setgenerate", "true, 2, \"myaddress\"")
+        },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    NodeContext& node = EnsureAnyNodeContext(request.context);
+    node::MiningService& mining_service = EnsureMiningService(node);
+
+    if (!self.Arg<bool>("generate")) {
+        mining_service.Stop();
+        return UniValue::VNULL;
+    }
+
+    const auto threads{self.MaybeArg<int64_t>("genthreads")};
+    const auto address{self.MaybeArg<std::string_view>("address")};
+    const CTxDestination destination = DecodeDestination(address ? std::string{*address} : node.args->GetArg("-genaddress", ""));
+    if (!IsValidDestination(destination)) {
+        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Error: Invalid address");
+    }
+
+    mining_service.Start(GetScriptForDestination(destination), threads ? GetMiningThreads(*threads) : GetGenerateThreads(node));
+    return UniValue::VNULL;
+},
+    };
+}
+
+static RPCHelpMan getgenerate()
+{
+    return RPCHelpMan{
+        "getgenerate",
+        "Returns the state of background mining started with -gen or setgenerate.",
+        {},
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::BOOL, "generate", "Whether background mining is running"},
+                {RPCResult::Type::NUM, "genthreads", "The number of threads mining"},
+                {RPCResult::Type::NUM, "localhashps", "The hashes per second of in-process mining, averaged over the last minute"},
+                {RPCResult::Type::NUM, "templates", "The number of block templates built"},
+                {RPCResult::Type::NUM, "blocksfound", "The number of blocks found"},
+                {RPCResult::Type::NUM, "blocksaccepted", "The number of blocks found that became the active tip"},
+                {RPCResult::Type::NUM, "blocksstale", "The number of blocks found that did not become the active tip"},
+            }},
+        RPCExamples{
+            HelpExampleCli("getgenerate", "")
+            + HelpExampleRpc("getgenerate", "")
+        },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    NodeContext& node = EnsureAnyNodeContext(request.context);
+    const node::MiningService& mining_service = EnsureMiningService(node);
+    const node::MiningStats stats{mining_service.GetStats()};
+
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("generate", mining_service.IsMining());
+    obj.pushKV("genthreads", mining_service.GetThreads());
+    obj.pushKV("localhashps", node::GetLocalHashRate().GetHashesPerSecond());
+    obj.pushKV("templates", stats.templates);
+    obj.pushKV("blocksfound", stats.blocks_found);
+    obj.pushKV("blocksaccepted", stats.blocks_accepted);
+    obj.pushKV("blocksstale", stats.blocks_stale);
+    return obj;
+},
+    };
+}
+
+static UniValue DurationStatsToJSON(const node::DurationStats& stats)
+{
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("count", stats.count);
+    obj.pushKV("last_ms", Ticks<MillisecondsDouble>(stats.last));
+    obj.pushKV("average_ms", Ticks<MillisecondsDouble>(stats.Average()));
+    obj.pushKV("max_ms", Ticks<MillisecondsDouble>(stats.max));
+    return obj;
+}
+
+static std::vector<RPCResult> DurationStatsDoc()
+{
+    return {
+        {RPCResult::Type::NUM, "count", "The number of samples"},
+        {RPCResult::Type::NUM, "last_ms", "The latest sample, in milliseconds"},
+        {RPCResult::Type::NUM, "average_ms", "The average, in milliseconds"},
+        {RPCResult::Type::NUM, "max_ms", "The largest sample, in milliseconds"},
+    };
+}
+
+static RPCHelpMan getminingmetrics()
+{
+    return RPCHelpMan{
+        "getminingmetrics",
+        "Returns telemetry on the block templates built by this node and the work done on them.",
+        {},
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::NUM, "local_hashps", "The hashes per second of in-process mining, averaged over the last minute"},
+                {RPCResult::Type::NUM, "network_hashps", "The estimated network hashes per second over the last 120 blocks"},
+                {RPCResult::Type::NUM, "tip_changes", "The number of times the active tip changed"},
+                {RPCResult::Type::OBJ, "template_build", "Time taken to build a block template", DurationStatsDoc()},
+                {RPCResult::Type::ARR, "template_build_histogram", "Block templates by build time",
+                {
+                    {RPCResult::Type::OBJ, "", "",
+                    {
+                        {RPCResult::Type::NUM, "max_ms", /*optional=*/true, "The upper bound of the bucket, in milliseconds (absent for the last bucket)"},
+                        {RPCResult::Type::NUM, "count", "The number of templates built within it"},
+                    }},
+                }},
+                {RPCResult::Type::OBJ, "tip_to_template", "Time from a tip change to the first block template on the new tip", DurationStatsDoc()},
+                {RPCResult::Type::NUM, "solutions", "The number of blocks found by in-process mining or submitted over Stratum or ZMQ"},
+                {RPCResult::Type::NUM, "stale_solutions", "The number of those solutions that were for a template on a replaced tip"},
+                {RPCResult::Type::NUM, "stale_ratio", "The ratio of stale solutions to solutions"},
+            }},
+        RPCExamples{
+            HelpExampleCli("getminingmetrics", "")
+            + HelpExampleRpc("getminingmetrics", "")
+        },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    ChainstateManager& chainman = EnsureAnyChainman(request.context);
+    const node::MiningMetricsSnapshot metrics{node::GetMiningMetrics().GetSnapshot()};
+
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("local_hashps", node::GetLocalHashRate().GetHashesPerSecond());
+    obj.pushKV("network_hashps", WITH_LOCK(cs_main, return GetNetworkHashPS(120, -1, chainman.ActiveChain())));
+    obj.pushKV("tip_changes", metrics.tip_changes);
+    obj.pushKV("template_build", DurationStatsToJSON(metrics.template_build));
+    UniValue histogram(UniValue::VARR);
+    for (size_t i = 0; i < metrics.template_build_histogram.size(); ++i) {
+        UniValue bucket(UniValue::VOBJ);
+        if (i < node::TEMPLATE_BUILD_TIME_BUCKETS.size()) bucket.pushKV("max_ms", count_milliseconds(node::TEMPLATE_BUILD_TIME_BUCKETS[i]));
+        bucket.pushKV("count", metrics.template_build_histogram[i]);
+        histogram.push_back(std::move(bucket));
+    }
+    obj.pushKV("template_build_histogram", std::move(histogram));
+    obj.pushKV("tip_to_template", DurationStatsToJSON(metrics.tip_to_template));
+    obj.pushKV("solutions", metrics.solutions);
+    obj.pushKV("stale_solutions", metrics.stale_solutions);
+    obj.pushKV("stale_ratio", metrics.StaleRatio());
+    return obj;
+},
+    };
+}
+
 static RPCHelpMan getmininginfo()
 {
     return RPCHelpMan{
@@ -500,6 +631,7 @@ static RPCHelpMan getmininginfo()
                         {RPCResult::Type::NUM, "difficulty", "The current difficulty"},
                         {RPCResult::Type::STR_HEX, "target", "The current target"},
                         {RPCResult::Type::NUM, "networkhashps", "The network hashes per second"},
+                        {RPCResult::Type::NUM, "localhashps", "The hashes per second of in-process mining (generatetoaddress, generateblock, ...), averaged over the last minute"},
                         {RPCResult::Type::NUM, "pooledtx", "The size of the mempool"},
                         {RPCResult::Type::STR_AMOUNT, "blockmintxfee", "Minimum feerate of packages selected for block inclusion in " + CURRENCY_UNIT + "/kvB"},
                         {RPCResult::Type::STR, "chain", "current network name (" LIST_CHAIN_NAMES ")"},
@@ -541,6 +673,7 @@ static RPCHelpMan getmininginfo()
     obj.pushKV("difficulty", GetDifficulty(tip));
     obj.pushKV("target", GetTarget(tip, chainman.GetConsensus().powLimit).GetHex());
     obj.pushKV("networkhashps",    getnetworkhashps().HandleRequest(request));
+    obj.pushKV("localhashps",      node::GetLocalHashRate().GetHashesPerSecond());
     obj.pushKV("pooledtx",         (uint64_t)mempool.size());
     BlockAssembler::Options assembler_options;
     ApplyArgsManOptions(*node.args, assembler_options);
@@ -1216,6 +1349,9 @@ void RegisterMiningRPCCommands(CRPCTable& t)
         {"mining", &getblocktemplate},
         {"mining", &submitblock},
         {"mining", &submitheader},
+        {"mining", &setgenerate},
+        {"mining", &getgenerate},
+        {"mining", &getminingmetrics},
 
         {"hidden", &generatetoaddress},
         {"hidden", &generatetodescriptor},
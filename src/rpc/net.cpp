@@ -660,6 +660,14 @@ static RPCHelpMan getnetworkinfo()
                                 {RPCResult::Type::BOOL, "proxy_randomize_credentials", "Whether randomized credentials are used"},
                             }},
                         }},
+                        {RPCResult::Type::OBJ, "blockservecache", "cache of blocks recently served to peers (see -blockservecache)",
+                        {
+                            {RPCResult::Type::NUM, "hits", "block requests served from the cache"},
+                            {RPCResult::Type::NUM, "misses", "block requests read from disk"},
+                            {RPCResult::Type::NUM, "entries", "serialized blocks and compact blocks in the cache"},
+                            {RPCResult::Type::NUM, "bytes", "size of the cached blocks, in bytes"},
+                            {RPCResult::Type::NUM, "maxbytes", "maximum size of the cached blocks, in bytes"},
+                        }},
                         {RPCResult::Type::NUM, "relayfee", "minimum relay fee rate for transactions in " + CURRENCY_UNIT + "/kvB"},
                         {RPCResult::Type::NUM, "incrementalfee", "minimum fee rate increment for mempool limiting or replacement in " + CURRENCY_UNIT + "/kvB"},
                         {RPCResult::Type::ARR, "localaddresses", "list of local addresses",
@@ -710,6 +718,16 @@ static RPCHelpMan getnetworkinfo()
         obj.pushKV("connections_out", node.connman->GetNodeCount(ConnectionDirection::Out));
     }
     obj.pushKV("networks",      GetNetworksInfo());
+    if (node.peerman) {
+        const auto stats{node.peerman->GetInfo().block_serve_cache};
+        UniValue cache(UniValue::VOBJ);
+        cache.pushKV("hits", stats.hits);
+        cache.pushKV("misses", stats.misses);
+        cache.pushKV("entries", uint64_t(stats.entries));
+        cache.pushKV("bytes", uint64_t(stats.bytes));
+        cache.pushKV("maxbytes", uint64_t(stats.max_bytes));
+        obj.pushKV("blockservecache", std::move(cache));
+    }
     if (node.mempool) {
         // Those fields can be deprecated, to be replaced by the getmempoolinfo fields
         obj.pushKV("relayfee", ValueFromAmount(node.mempool->m_opts.min_relay_feerate.GetFeePerK()));
@@ -6,6 +6,8 @@
 #include <bitcoin-build-config.h> // IWYU pragma: keep
 
 #include <chainparams.h>
+#include <common/args.h>
+#include <common/system.h>
 #include <httpserver.h>
 #include <index/blockfilterindex.h>
 #include <index/coinstatsindex.h>
@@ -16,6 +18,7 @@
 #include <interfaces/ipc.h>
 #include <kernel/cs_main.h>
 #include <logging.h>
+#include <node/caches.h>
 #include <node/context.h>
 #include <rpc/server.h>
 #include <rpc/server_util.h>
@@ -26,6 +29,7 @@
 #include <util/any.h>
 #include <util/check.h>
 #include <util/time.h>
+#include <validation.h>
 
 #include <cstdint>
 #ifdef HAVE_MALLOC_INFO
@@ -122,6 +126,19 @@ static UniValue RPCLockedMemoryInfo()
     return obj;
 }
 
+static UniValue RPCDbCacheInfo(const NodeContext& node)
+{
+    ChainstateManager& chainman{*node.chainman};
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("adaptive", node.args && node.args->GetBoolArg("-dbcacheadaptive", DEFAULT_DB_CACHE_ADAPTIVE));
+    LOCK(::cs_main);
+    obj.pushKV("coins_cache_limit", uint64_t(chainman.m_total_coinstip_cache));
+    obj.pushKV("coins_cache_usage", uint64_t(node::GetCoinsCacheUsage(chainman)));
+    obj.pushKV("coins_db_cache", uint64_t(chainman.m_total_coinsdb_cache));
+    if (const auto available_ram{GetAvailableRAM()}) obj.pushKV("available_ram", uint64_t(*available_ram));
+    return obj;
+}
+
 #ifdef HAVE_MALLOC_INFO
 static std::string RPCMallocInfo()
 {
@@ -166,6 +183,14 @@ static RPCHelpMan getmemoryinfo()
                                 {RPCResult::Type::NUM, "chunks_used", "Number allocated chunks"},
                                 {RPCResult::Type::NUM, "chunks_free", "Number unused chunks"},
                             }},
+                            {RPCResult::Type::OBJ, "dbcache", /*optional=*/true, "Information about the chain state caches, once the chain state is loaded",
+                            {
+                                {RPCResult::Type::BOOL, "adaptive", "Whether the coins cache is resized to the memory available (-dbcacheadaptive)"},
+                                {RPCResult::Type::NUM, "coins_cache_limit", "Number of bytes the in-memory coins caches may use"},
+                                {RPCResult::Type::NUM, "coins_cache_usage", "Number of bytes the in-memory coins caches use"},
+                                {RPCResult::Type::NUM, "coins_db_cache", "Number of bytes of cache given to the coins databases"},
+                                {RPCResult::Type::NUM, "available_ram", /*optional=*/true, "Number of bytes of memory currently available to the node, if known"},
+                            }},
                         }
                     },
                     RPCResult{"mode \"mallocinfo\"",
@@ -182,6 +207,9 @@ static RPCHelpMan getmemoryinfo()
     if (mode == "stats") {
         UniValue obj(UniValue::VOBJ);
         obj.pushKV("locked", RPCLockedMemoryInfo());
+        if (const NodeContext* node{util::AnyPtr<NodeContext>(request.context)}; node && node->chainman) {
+            obj.pushKV("dbcache", RPCDbCacheInfo(*node));
+        }
         return obj;
     } else if (mode == "mallocinfo") {
 #ifdef HAVE_MALLOC_INFO
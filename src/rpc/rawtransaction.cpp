@@ -143,8 +143,17 @@ PartiallySignedTransaction ProcessPSBT(const std::string& psbt_string, const std
     std::map<COutPoint, Coin> coins;
 
     // Fetch previous transactions:
-    // First, look in the txindex and the mempool
-    for (unsigned int i = 0; i < psbtx.tx->vin.size(); ++i) {
+    // First, look in the txindex, for all inputs at once, and the mempool
+    std::vector<Txid> index_txids;
+    std::vector<CTransactionRef> index_txs;
+    if (g_txindex) {
+        for (unsigned int i = 0; i < psbtx.tx->vin.size(); ++i) {
+            if (!psbtx.inputs.at(i).non_witness_utxo) index_txids.push_back(psbtx.tx->vin.at(i).prevout.hash);
+        }
+        std::vector<uint256> block_hashes;
+        g_txindex->FindTxs(index_txids, block_hashes, index_txs);
+    }
+    for (unsigned int i = 0, index_pos = 0; i < psbtx.tx->vin.size(); ++i) {
         PSBTInput& psbt_input = psbtx.inputs.at(i);
         const CTxIn& tx_in = psbtx.tx->vin.at(i);
 
@@ -154,10 +163,7 @@ PartiallySignedTransaction ProcessPSBT(const std::string& psbt_string, const std
         CTransactionRef tx;
 
         // Look in the txindex
-        if (g_txindex) {
-            uint256 block_hash;
-            g_txindex->FindTx(tx_in.prevout.hash, block_hash, tx);
-        }
+        if (g_txindex) tx = index_txs.at(index_pos++);
         // If we still don't have it look in the mempool
         if (!tx) {
             tx = node.mempool->get(tx_in.prevout.hash);
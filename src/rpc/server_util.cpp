@@ -113,6 +113,14 @@ interfaces::Mining& EnsureMining(const NodeContext& node)
     return *node.mining;
 }
 
+node::MiningService& EnsureMiningService(const NodeContext& node)
+{
+    if (!node.mining_service) {
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Node mining service not found");
+    }
+    return *node.mining_service;
+}
+
 PeerManager& EnsurePeerman(const NodeContext& node)
 {
     if (!node.peerman) {
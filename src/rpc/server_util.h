@@ -19,6 +19,7 @@ class ChainstateManager;
 class PeerManager;
 class BanMan;
 namespace node {
+class MiningService;
 struct NodeContext;
 } // namespace node
 namespace interfaces {
@@ -38,6 +39,7 @@ CBlockPolicyEstimator& EnsureFeeEstimator(const node::NodeContext& node);
 CBlockPolicyEstimator& EnsureAnyFeeEstimator(const std::any& context);
 CConnman& EnsureConnman(const node::NodeContext& node);
 interfaces::Mining& EnsureMining(const node::NodeContext& node);
+node::MiningService& EnsureMiningService(const node::NodeContext& node);
 PeerManager& EnsurePeerman(const node::NodeContext& node);
 AddrMan& EnsureAddrman(const node::NodeContext& node);
 AddrMan& EnsureAnyAddrman(const std::any& context);
@@ -15,9 +15,73 @@
 
 #include <mutex>
 #include <shared_mutex>
+#include <utility>
 #include <vector>
 
-SignatureCache::SignatureCache(const size_t max_size_bytes)
+SignatureCacheStats& SignatureCacheStats::operator+=(const SignatureCacheStats& other)
+{
+    hits += other.hits;
+    misses += other.misses;
+    block_hits += other.block_hits;
+    block_misses += other.block_misses;
+    inserts += other.inserts;
+    evictions += other.evictions;
+    return *this;
+}
+
+std::pair<size_t, size_t> ShardedValidationCache::Resize(const size_t max_size_bytes)
+{
+    size_t num_elems{0};
+    size_t approx_size_bytes{0};
+    for (Shard& shard : m_shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.cs_cache);
+        const auto [shard_elems, shard_bytes] = shard.setValid.setup_bytes(max_size_bytes / m_shards.size());
+        num_elems += shard_elems;
+        approx_size_bytes += shard_bytes;
+    }
+    m_max_size_bytes.store(max_size_bytes, std::memory_order_relaxed);
+    return {num_elems, approx_size_bytes};
+}
+
+bool ShardedValidationCache::Get(const uint256& entry, const bool erase)
+{
+    Shard& shard{GetShard(entry)};
+    bool found;
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.cs_cache);
+        found = shard.setValid.contains(entry, erase);
+    }
+    auto& counter{erase ? (found ? shard.block_hits : shard.block_misses) : (found ? shard.hits : shard.misses)};
+    counter.fetch_add(1, std::memory_order_relaxed);
+    return found;
+}
+
+void ShardedValidationCache::Set(const uint256& entry)
+{
+    Shard& shard{GetShard(entry)};
+    std::unique_lock<std::shared_mutex> lock(shard.cs_cache);
+    if (!shard.setValid.insert(entry, m_pin)) shard.evictions.fetch_add(1, std::memory_order_relaxed);
+    shard.inserts.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<SignatureCacheStats> ShardedValidationCache::GetShardStats() const
+{
+    std::vector<SignatureCacheStats> stats;
+    stats.reserve(m_shards.size());
+    for (const Shard& shard : m_shards) {
+        stats.push_back({
+            .hits = shard.hits.load(std::memory_order_relaxed),
+            .misses = shard.misses.load(std::memory_order_relaxed),
+            .block_hits = shard.block_hits.load(std::memory_order_relaxed),
+            .block_misses = shard.block_misses.load(std::memory_order_relaxed),
+            .inserts = shard.inserts.load(std::memory_order_relaxed),
+            .evictions = shard.evictions.load(std::memory_order_relaxed),
+        });
+    }
+    return stats;
+}
+
+SignatureCache::SignatureCache(const size_t max_size_bytes, bool pin) : m_cache{pin}
 {
     uint256 nonce = GetRandHash();
     // We want the nonce to be 64 bytes long to force the hasher to process
@@ -31,7 +95,12 @@ SignatureCache::SignatureCache(const size_t max_size_bytes)
     m_salted_hasher_schnorr.Write(nonce.begin(), 32);
     m_salted_hasher_schnorr.Write(PADDING_SCHNORR, 32);
 
-    const auto [num_elems, approx_size_bytes] = setValid.setup_bytes(max_size_bytes);
+    Resize(max_size_bytes);
+}
+
+void SignatureCache::Resize(const size_t max_size_bytes)
+{
+    const auto [num_elems, approx_size_bytes] = m_cache.Resize(max_size_bytes);
     LogInfo("Using %zu MiB out of %zu MiB requested for signature cache, able to store %zu elements",
               approx_size_bytes >> 20, max_size_bytes >> 20, num_elems);
 }
@@ -48,18 +117,6 @@ void SignatureCache::ComputeEntrySchnorr(uint256& entry, const uint256& hash, st
     hasher.Write(hash.begin(), 32).Write(pubkey.data(), pubkey.size()).Write(sig.data(), sig.size()).Finalize(entry.begin());
 }
 
-bool SignatureCache::Get(const uint256& entry, const bool erase)
-{
-    std::shared_lock<std::shared_mutex> lock(cs_sigcache);
-    return setValid.contains(entry, erase);
-}
-
-void SignatureCache::Set(const uint256& entry)
-{
-    std::unique_lock<std::shared_mutex> lock(cs_sigcache);
-    setValid.insert(entry);
-}
-
 bool CachingTransactionSignatureChecker::VerifyECDSASignature(const std::vector<unsigned char>& vchSig, const CPubKey& pubkey, const uint256& sighash) const
 {
     uint256 entry;
@@ -78,6 +135,11 @@ bool CachingTransactionSignatureChecker::VerifySchnorrSignature(std::span<const
     uint256 entry;
     m_signature_cache.ComputeEntrySchnorr(entry, sighash, sig, pubkey);
     if (m_signature_cache.Get(entry, !store)) return true;
+    // An invalid signature fails the whole script, so the batch failing later stands for it.
+    if (m_batch && !store) {
+        m_batch->Add(sig, pubkey, sighash);
+        return true;
+    }
     if (!TransactionSignatureChecker::VerifySchnorrSignature(sig, pubkey, sighash)) return false;
     if (store) m_signature_cache.Set(entry);
     return true;
@@ -14,12 +14,17 @@
 #include <uint256.h>
 #include <util/hasher.h>
 
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <shared_mutex>
+#include <utility>
 #include <vector>
 
 class CPubKey;
 class CTransaction;
+class SchnorrBatch;
 class XOnlyPubKey;
 
 // DoS prevention: limit cache size to 32MiB (over 1000000 entries on 64-bit
@@ -29,6 +34,81 @@ static constexpr size_t DEFAULT_VALIDATION_CACHE_BYTES{32 << 20};
 static constexpr size_t DEFAULT_SIGNATURE_CACHE_BYTES{DEFAULT_VALIDATION_CACHE_BYTES / 2};
 static constexpr size_t DEFAULT_SCRIPT_EXECUTION_CACHE_BYTES{DEFAULT_VALIDATION_CACHE_BYTES / 2};
 static_assert(DEFAULT_VALIDATION_CACHE_BYTES == DEFAULT_SIGNATURE_CACHE_BYTES + DEFAULT_SCRIPT_EXECUTION_CACHE_BYTES);
+//! Whether to keep signatures cached at mempool acceptance until their block is connected
+static constexpr bool DEFAULT_SIGNATURE_CACHE_PIN{false};
+//! Number of independently locked parts the signature and script execution caches are each split into
+static constexpr size_t VALIDATION_CACHE_SHARDS{16};
+
+struct SignatureCacheStats {
+    //! Lookups when accepting transactions to the mempool
+    uint64_t hits{0};
+    uint64_t misses{0};
+    //! Lookups when connecting blocks
+    uint64_t block_hits{0};
+    uint64_t block_misses{0};
+    uint64_t inserts{0};
+    //! Entries dropped by an insert because there was no room for them
+    uint64_t evictions{0};
+
+    SignatureCacheStats& operator+=(const SignatureCacheStats& other);
+    double BlockHitRate() const { return block_hits + block_misses ? double(block_hits) / (block_hits + block_misses) : 0.0; }
+};
+
+/**
+ * Cache of salted hashes of validation results, split into
+ * VALIDATION_CACHE_SHARDS shards by entry, each with its own lock, so that
+ * script check threads looking up entries rarely wait for one inserting.
+ *
+ * With pinning, entries inserted at mempool acceptance are not aged out of
+ * the cache, only dropped once looked up when connecting their block (or
+ * evicted when the cache is full, or expired after
+ * CuckooCache::cache::MAX_PINNED_EPOCHS epochs).
+ */
+class ShardedValidationCache
+{
+private:
+    typedef CuckooCache::cache<uint256, SignatureCacheHasher> map_type;
+
+    struct alignas(64) Shard {
+        map_type setValid;
+        std::shared_mutex cs_cache;
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> block_hits{0};
+        std::atomic<uint64_t> block_misses{0};
+        std::atomic<uint64_t> inserts{0};
+        std::atomic<uint64_t> evictions{0};
+    };
+    std::array<Shard, VALIDATION_CACHE_SHARDS> m_shards;
+    const bool m_pin;
+    //! Size last requested by Resize()
+    std::atomic<size_t> m_max_size_bytes{0};
+
+    Shard& GetShard(const uint256& entry) { return m_shards[entry.GetUint64(0) % m_shards.size()]; }
+
+public:
+    explicit ShardedValidationCache(bool pin = false) : m_pin{pin} {}
+
+    ShardedValidationCache(const ShardedValidationCache&) = delete;
+    ShardedValidationCache& operator=(const ShardedValidationCache&) = delete;
+
+    /**
+     * Size the cache to about max_size_bytes, dropping all entries. Safe to
+     * call while the cache is in use.
+     *
+     * @returns the number of entries the cache can store and their approximate size in bytes
+     */
+    std::pair<size_t, size_t> Resize(size_t max_size_bytes);
+
+    size_t MaxSizeBytes() const { return m_max_size_bytes.load(std::memory_order_relaxed); }
+
+    /** Look up an entry. Lookups with erase set are those made when connecting blocks. */
+    bool Get(const uint256& entry, const bool erase);
+
+    void Set(const uint256& entry);
+
+    std::vector<SignatureCacheStats> GetShardStats() const;
+};
 
 /**
  * Valid signature cache, to avoid doing expensive ECDSA signature checking
@@ -41,12 +121,10 @@ private:
     //! Entries are SHA256(nonce || 'E' or 'S' || 31 zero bytes || signature hash || public key || signature):
     CSHA256 m_salted_hasher_ecdsa;
     CSHA256 m_salted_hasher_schnorr;
-    typedef CuckooCache::cache<uint256, SignatureCacheHasher> map_type;
-    map_type setValid;
-    std::shared_mutex cs_sigcache;
+    ShardedValidationCache m_cache;
 
 public:
-    SignatureCache(size_t max_size_bytes);
+    SignatureCache(size_t max_size_bytes, bool pin = DEFAULT_SIGNATURE_CACHE_PIN);
 
     SignatureCache(const SignatureCache&) = delete;
     SignatureCache& operator=(const SignatureCache&) = delete;
@@ -55,9 +133,17 @@ public:
 
     void ComputeEntrySchnorr(uint256& entry, const uint256 &hash, std::span<const unsigned char> sig, const XOnlyPubKey& pubkey) const;
 
-    bool Get(const uint256& entry, const bool erase);
+    /** Look up an entry. Lookups with erase set are those made when connecting blocks. */
+    bool Get(const uint256& entry, const bool erase) { return m_cache.Get(entry, erase); }
 
-    void Set(const uint256& entry);
+    void Set(const uint256& entry) { m_cache.Set(entry); }
+
+    /** Size the cache to about max_size_bytes, dropping all entries. */
+    void Resize(size_t max_size_bytes);
+
+    size_t MaxSizeBytes() const { return m_cache.MaxSizeBytes(); }
+
+    std::vector<SignatureCacheStats> GetShardStats() const { return m_cache.GetShardStats(); }
 };
 
 class CachingTransactionSignatureChecker : public TransactionSignatureChecker
@@ -65,9 +151,11 @@ class CachingTransactionSignatureChecker : public TransactionSignatureChecker
 private:
     bool store;
     SignatureCache& m_signature_cache;
+    //! If set, Schnorr signatures that are not cached and need not be stored are added to it instead of being verified
+    SchnorrBatch* m_batch;
 
 public:
-    CachingTransactionSignatureChecker(const CTransaction* txToIn, unsigned int nInIn, const CAmount& amountIn, bool storeIn, SignatureCache& signature_cache, PrecomputedTransactionData& txdataIn) : TransactionSignatureChecker(txToIn, nInIn, amountIn, txdataIn, MissingDataBehavior::ASSERT_FAIL), store(storeIn), m_signature_cache(signature_cache)  {}
+    CachingTransactionSignatureChecker(const CTransaction* txToIn, unsigned int nInIn, const CAmount& amountIn, bool storeIn, SignatureCache& signature_cache, PrecomputedTransactionData& txdataIn, SchnorrBatch* batch = nullptr) : TransactionSignatureChecker(txToIn, nInIn, amountIn, txdataIn, MissingDataBehavior::ASSERT_FAIL), store(storeIn), m_signature_cache(signature_cache), m_batch(batch)  {}
 
     bool VerifyECDSASignature(const std::vector<unsigned char>& vchSig, const CPubKey& vchPubKey, const uint256& sighash) const override;
     bool VerifySchnorrSignature(std::span<const unsigned char> sig, const XOnlyPubKey& pubkey, const uint256& sighash) const override;
@@ -183,6 +183,37 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_schnorrsig_verify(
     const secp256k1_xonly_pubkey *pubkey
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(5);
 
+/** Verify a batch of Schnorr signatures at once.
+ *
+ *  All signatures are checked together with a single multi-scalar
+ *  multiplication, which is considerably faster than verifying them one by
+ *  one. The terms of each signature are multiplied by a randomizer derived
+ *  from a hash of the whole batch, so that invalid signatures cannot cancel
+ *  each other out.
+ *
+ *  This function is a local patch, not part of upstream libsecp256k1 (see
+ *  "Local patches to subtrees" in doc/developer-notes.md).
+ *
+ *  Returns: 1: all signatures are correct (or n_sigs is 0)
+ *           0: at least one signature is incorrect. Which one is not reported;
+ *              verify them individually to find out.
+ *  Args:    ctx: pointer to a context object.
+ *  In:    sig64: array of n_sigs pointers to 64-byte signatures.
+ *           msg: array of n_sigs pointers to the messages. A message can only
+ *                be NULL if its length is 0.
+ *        msglen: array of n_sigs message lengths.
+ *        pubkey: array of n_sigs pointers to x-only public keys.
+ *        n_sigs: number of signatures in the batch.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_schnorrsig_verify_batch(
+    const secp256k1_context *ctx,
+    const unsigned char * const *sig64,
+    const unsigned char * const *msg,
+    const size_t *msglen,
+    const secp256k1_xonly_pubkey * const *pubkey,
+    size_t n_sigs
+) SECP256K1_ARG_NONNULL(1);
+
 #ifdef __cplusplus
 }
 #endif
@@ -269,4 +269,140 @@ int secp256k1_schnorrsig_verify(const secp256k1_context* ctx, const unsigned cha
            secp256k1_fe_equal(&rx, &r.x);
 }
 
+typedef struct {
+    const secp256k1_ge *points;
+    const secp256k1_scalar *scalars;
+} secp256k1_schnorrsig_batch_data;
+
+static int secp256k1_schnorrsig_batch_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *data) {
+    const secp256k1_schnorrsig_batch_data *batch = (const secp256k1_schnorrsig_batch_data *)data;
+    *sc = batch->scalars[idx];
+    *pt = batch->points[idx];
+    return 1;
+}
+
+/* Returns the scratch space secp256k1_ecmult_multi_var needs to multiply n_points
+ * points in a single batch. From ECMULT_PIPPENGER_THRESHOLD points on it uses
+ * Pippenger's algorithm, which needs far less space per point than Strauss'
+ * (and whose bucket table and extra scratch object Strauss' size does not
+ * account for), so the space is sized for the algorithm that will be used. */
+static size_t secp256k1_schnorrsig_batch_scratch_size(size_t n_points) {
+    if (n_points >= ECMULT_PIPPENGER_THRESHOLD) {
+        return secp256k1_pippenger_scratch_size(n_points, secp256k1_pippenger_bucket_window(n_points)) + PIPPENGER_SCRATCH_OBJECTS * ALIGNMENT;
+    }
+    return secp256k1_strauss_scratch_size(n_points) + STRAUSS_SCRATCH_OBJECTS * ALIGNMENT;
+}
+
+/* Loads signature i into points[2i] = R_i, points[2i+1] = P_i, scalars[2i] = s_i
+ * and scalars[2i+1] = e_i, and commits to it in sha. Returns 0 if it is
+ * malformed. */
+static int secp256k1_schnorrsig_batch_load(const secp256k1_context* ctx, secp256k1_ge *points, secp256k1_scalar *scalars, secp256k1_sha256 *sha, const unsigned char *sig64, const unsigned char *msg, size_t msglen, const secp256k1_xonly_pubkey *pubkey) {
+    secp256k1_fe rx;
+    unsigned char buf[32];
+    int overflow;
+
+    if (!secp256k1_fe_set_b32_limit(&rx, &sig64[0])) {
+        return 0;
+    }
+    /* R is the point with even Y and X coordinate r. */
+    if (!secp256k1_ge_set_xo_var(&points[0], &rx, 0)) {
+        return 0;
+    }
+    secp256k1_scalar_set_b32(&scalars[0], &sig64[32], &overflow);
+    if (overflow) {
+        return 0;
+    }
+    if (!secp256k1_xonly_pubkey_load(ctx, &points[1], pubkey)) {
+        return 0;
+    }
+    secp256k1_fe_get_b32(buf, &points[1].x);
+    secp256k1_schnorrsig_challenge(&scalars[1], &sig64[0], msg, msglen, buf);
+
+    /* The challenge commits to the message, so hashing it stands in for the message. */
+    secp256k1_sha256_write(sha, sig64, 64);
+    secp256k1_sha256_write(sha, buf, 32);
+    secp256k1_scalar_get_b32(buf, &scalars[1]);
+    secp256k1_sha256_write(sha, buf, 32);
+    return 1;
+}
+
+int secp256k1_schnorrsig_verify_batch(const secp256k1_context *ctx, const unsigned char * const *sig64, const unsigned char * const *msg, const size_t *msglen, const secp256k1_xonly_pubkey * const *pubkey, size_t n_sigs) {
+    secp256k1_schnorrsig_batch_data data;
+    secp256k1_ge *points;
+    secp256k1_scalar *scalars;
+    secp256k1_scratch *scratch;
+    secp256k1_sha256 sha;
+    unsigned char seed[32];
+    secp256k1_scalar s_sum;
+    secp256k1_gej rj;
+    size_t i;
+    int ret = 1;
+
+    VERIFY_CHECK(ctx != NULL);
+    if (n_sigs == 0) {
+        return 1;
+    }
+    ARG_CHECK(sig64 != NULL);
+    ARG_CHECK(msg != NULL);
+    ARG_CHECK(msglen != NULL);
+    ARG_CHECK(pubkey != NULL);
+    ARG_CHECK(n_sigs <= ECMULT_MAX_POINTS_PER_BATCH / 2);
+    for (i = 0; i < n_sigs; i++) {
+        ARG_CHECK(sig64[i] != NULL);
+        ARG_CHECK(msg[i] != NULL || msglen[i] == 0);
+        ARG_CHECK(pubkey[i] != NULL);
+    }
+
+    points = (secp256k1_ge *)checked_malloc(&ctx->error_callback, 2 * n_sigs * sizeof(*points));
+    scalars = (secp256k1_scalar *)checked_malloc(&ctx->error_callback, 2 * n_sigs * sizeof(*scalars));
+    scratch = secp256k1_scratch_space_create(ctx, secp256k1_schnorrsig_batch_scratch_size(2 * n_sigs));
+    if (points == NULL || scalars == NULL || scratch == NULL) {
+        ret = 0;
+    }
+
+    secp256k1_sha256_initialize(&sha);
+    for (i = 0; ret && i < n_sigs; i++) {
+        ret = secp256k1_schnorrsig_batch_load(ctx, &points[2 * i], &scalars[2 * i], &sha, sig64[i], msg[i], msglen[i], pubkey[i]);
+    }
+
+    if (ret) {
+        /* With randomizers a_i, check that
+         *   (sum a_i*s_i)*G + sum (-a_i)*R_i + sum (-a_i*e_i)*P_i
+         * is infinity. The randomizers are derived from a seed that commits to
+         * the whole batch, and a_0 = 1. */
+        secp256k1_sha256_finalize(&sha, seed);
+        secp256k1_scalar_clear(&s_sum);
+        for (i = 0; i < n_sigs; i++) {
+            secp256k1_scalar a;
+            if (i == 0) {
+                secp256k1_scalar_set_int(&a, 1);
+            } else {
+                unsigned char buf[32];
+                secp256k1_write_be64(buf, i);
+                secp256k1_sha256_initialize(&sha);
+                secp256k1_sha256_write(&sha, seed, 32);
+                secp256k1_sha256_write(&sha, buf, 8);
+                secp256k1_sha256_finalize(&sha, buf);
+                secp256k1_scalar_set_b32(&a, buf, NULL);
+            }
+            secp256k1_scalar_mul(&scalars[2 * i], &scalars[2 * i], &a);
+            secp256k1_scalar_add(&s_sum, &s_sum, &scalars[2 * i]);
+            secp256k1_scalar_negate(&scalars[2 * i], &a);
+            secp256k1_scalar_mul(&scalars[2 * i + 1], &scalars[2 * i + 1], &scalars[2 * i]);
+        }
+
+        data.points = points;
+        data.scalars = scalars;
+        ret = secp256k1_ecmult_multi_var(&ctx->error_callback, scratch, &rj, &s_sum, secp256k1_schnorrsig_batch_callback, &data, 2 * n_sigs) &&
+              secp256k1_gej_is_infinity(&rj);
+    }
+
+    if (scratch != NULL) {
+        secp256k1_scratch_space_destroy(ctx, scratch);
+    }
+    free(scalars);
+    free(points);
+    return ret;
+}
+
 #endif
@@ -857,6 +857,10 @@ static void test_schnorrsig_sign_verify_internal(void) {
     unsigned char sk[32];
     unsigned char msg[N_SIGS][32];
     unsigned char sig[N_SIGS][64];
+    const unsigned char *sig_ptr[N_SIGS];
+    const unsigned char *msg_ptr[N_SIGS];
+    size_t msglens[N_SIGS];
+    const secp256k1_xonly_pubkey *pk_ptr[N_SIGS];
     size_t i;
     secp256k1_keypair keypair;
     secp256k1_xonly_pubkey pk;
@@ -870,30 +874,41 @@ static void test_schnorrsig_sign_verify_internal(void) {
         testrand256(msg[i]);
         CHECK(secp256k1_schnorrsig_sign32(CTX, sig[i], msg[i], &keypair, NULL));
         CHECK(secp256k1_schnorrsig_verify(CTX, sig[i], msg[i], sizeof(msg[i]), &pk));
+        sig_ptr[i] = sig[i];
+        msg_ptr[i] = msg[i];
+        msglens[i] = sizeof(msg[i]);
+        pk_ptr[i] = &pk;
     }
+    CHECK(secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglens, pk_ptr, N_SIGS));
+    CHECK(secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglens, pk_ptr, 1));
+    CHECK(secp256k1_schnorrsig_verify_batch(CTX, NULL, NULL, NULL, NULL, 0));
 
     {
         /* Flip a few bits in the signature and in the message and check that
-         * verify and verify_batch (TODO) fail */
+         * verify and verify_batch fail */
         size_t sig_idx = testrand_int(N_SIGS);
         size_t byte_idx = testrand_bits(5);
         unsigned char xorbyte = testrand_int(254)+1;
         sig[sig_idx][byte_idx] ^= xorbyte;
         CHECK(!secp256k1_schnorrsig_verify(CTX, sig[sig_idx], msg[sig_idx], sizeof(msg[sig_idx]), &pk));
+        CHECK(!secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglens, pk_ptr, N_SIGS));
         sig[sig_idx][byte_idx] ^= xorbyte;
 
         byte_idx = testrand_bits(5);
         sig[sig_idx][32+byte_idx] ^= xorbyte;
         CHECK(!secp256k1_schnorrsig_verify(CTX, sig[sig_idx], msg[sig_idx], sizeof(msg[sig_idx]), &pk));
+        CHECK(!secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglens, pk_ptr, N_SIGS));
         sig[sig_idx][32+byte_idx] ^= xorbyte;
 
         byte_idx = testrand_bits(5);
         msg[sig_idx][byte_idx] ^= xorbyte;
         CHECK(!secp256k1_schnorrsig_verify(CTX, sig[sig_idx], msg[sig_idx], sizeof(msg[sig_idx]), &pk));
+        CHECK(!secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglens, pk_ptr, N_SIGS));
         msg[sig_idx][byte_idx] ^= xorbyte;
 
         /* Check that above bitflips have been reversed correctly */
         CHECK(secp256k1_schnorrsig_verify(CTX, sig[sig_idx], msg[sig_idx], sizeof(msg[sig_idx]), &pk));
+        CHECK(secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglens, pk_ptr, N_SIGS));
     }
 
     /* Test overflowing s */
@@ -909,6 +924,7 @@ static void test_schnorrsig_sign_verify_internal(void) {
     secp256k1_scalar_negate(&s, &s);
     secp256k1_scalar_get_b32(&sig[0][32], &s);
     CHECK(!secp256k1_schnorrsig_verify(CTX, sig[0], msg[0], sizeof(msg[0]), &pk));
+    CHECK(!secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglens, pk_ptr, N_SIGS));
 
     /* The empty message can be signed & verified */
     CHECK(secp256k1_schnorrsig_sign_custom(CTX, sig[0], NULL, 0, &keypair, NULL) == 1);
@@ -966,6 +982,76 @@ static void test_schnorrsig_taproot(void) {
     CHECK(secp256k1_xonly_pubkey_tweak_add_check(CTX, output_pk_bytes, pk_parity, &internal_pk, tweak) == 1);
 }
 
+/* The scratch space fits the whole batch for the algorithm ecmult_multi_var
+ * picks, on both sides of ECMULT_PIPPENGER_THRESHOLD. */
+static void test_schnorrsig_batch_scratch_size(void) {
+    static const size_t n_points[] = {2, 10, ECMULT_PIPPENGER_THRESHOLD - 2, ECMULT_PIPPENGER_THRESHOLD,
+                                      ECMULT_PIPPENGER_THRESHOLD + 2, 136, 138, 1000, 10000, 100000};
+    size_t i;
+
+    for (i = 0; i < sizeof(n_points) / sizeof(n_points[0]); i++) {
+        const size_t n = n_points[i];
+        secp256k1_scratch *scratch = secp256k1_scratch_space_create(CTX, secp256k1_schnorrsig_batch_scratch_size(n));
+        CHECK(scratch != NULL);
+        if (n >= ECMULT_PIPPENGER_THRESHOLD) {
+            CHECK(secp256k1_pippenger_max_points(&CTX->error_callback, scratch) >= n);
+            /* Much less than Strauss' algorithm would need. */
+            CHECK(secp256k1_schnorrsig_batch_scratch_size(n) < secp256k1_strauss_scratch_size(n));
+        } else {
+            CHECK(secp256k1_strauss_max_points(&CTX->error_callback, scratch) >= n);
+        }
+        secp256k1_scratch_space_destroy(CTX, scratch);
+    }
+}
+
+/* Batches large enough for the Pippenger algorithm, with distinct keys. */
+static void test_schnorrsig_verify_batch(void) {
+    unsigned char sk[32];
+    unsigned char msg[50][32];
+    unsigned char sig[50][64];
+    secp256k1_xonly_pubkey pk[50];
+    const unsigned char *sig_ptr[50];
+    const unsigned char *msg_ptr[50];
+    size_t msglen[50];
+    const secp256k1_xonly_pubkey *pk_ptr[50];
+    secp256k1_keypair keypair;
+    size_t i, sig_idx;
+
+    for (i = 0; i < 50; i++) {
+        testrand256(sk);
+        testrand256(msg[i]);
+        CHECK(secp256k1_keypair_create(CTX, &keypair, sk));
+        CHECK(secp256k1_keypair_xonly_pub(CTX, &pk[i], NULL, &keypair));
+        CHECK(secp256k1_schnorrsig_sign32(CTX, sig[i], msg[i], &keypair, NULL));
+        sig_ptr[i] = sig[i];
+        msg_ptr[i] = msg[i];
+        msglen[i] = sizeof(msg[i]);
+        pk_ptr[i] = &pk[i];
+    }
+    CHECK(secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglen, pk_ptr, 50));
+    /* Around the switch from Strauss' to Pippenger's algorithm, at two points per signature. */
+    for (i = ECMULT_PIPPENGER_THRESHOLD / 2 - 2; i <= ECMULT_PIPPENGER_THRESHOLD / 2 + 2; i++) {
+        CHECK(secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglen, pk_ptr, i));
+    }
+
+    /* A signature under another key fails the batch. */
+    sig_idx = testrand_int(50);
+    pk_ptr[sig_idx] = &pk[(sig_idx + 1) % 50];
+    CHECK(!secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglen, pk_ptr, 50));
+    pk_ptr[sig_idx] = &pk[sig_idx];
+
+    /* So do two signatures swapped between messages. */
+    sig_ptr[0] = sig[1];
+    sig_ptr[1] = sig[0];
+    CHECK(!secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglen, pk_ptr, 50));
+    sig_ptr[0] = sig[0];
+    sig_ptr[1] = sig[1];
+
+    /* And an R that is not on the curve. */
+    memset(sig[sig_idx], 0xFF, 32);
+    CHECK(!secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglen, pk_ptr, 50));
+}
+
 /* --- Test registry --- */
 REPEAT_TEST(test_schnorrsig_sign)
 REPEAT_TEST(test_schnorrsig_sign_verify)
@@ -977,6 +1063,8 @@ static const struct tf_test_entry tests_schnorrsig[] = {
     CASE1(test_schnorrsig_bip_vectors),
     CASE1(test_schnorrsig_sign),
     CASE1(test_schnorrsig_sign_verify),
+    CASE1(test_schnorrsig_batch_scratch_size),
+    CASE1(test_schnorrsig_verify_batch),
     CASE1(test_schnorrsig_taproot),
 };
 
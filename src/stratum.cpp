@@ -0,0 +1,520 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <stratum.h>
+
+#include <chain.h>
+#include <crypto/common.h>
+#include <interfaces/mining.h>
+#include <logging.h>
+#include <netaddress.h>
+#include <node/mining_metrics.h>
+#include <primitives/block.h>
+#include <random.h>
+#include <script/script.h>
+#include <support/events.h>
+#include <tinyformat.h>
+#include <univalue.h>
+#include <util/strencodings.h>
+#include <util/thread.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include <event2/buffer.h>
+#include <event2/bufferevent.h>
+#include <event2/event.h>
+#include <event2/listener.h>
+#include <event2/thread.h>
+#include <event2/util.h>
+
+namespace {
+//! Error codes used by stratum pools
+enum StratumErrorCode {
+    STRATUM_OTHER = 20,
+    STRATUM_JOB_NOT_FOUND = 21,
+    STRATUM_DUPLICATE_SHARE = 22,
+    STRATUM_LOW_DIFFICULTY = 23,
+    STRATUM_UNAUTHORIZED = 24,
+    STRATUM_NOT_SUBSCRIBED = 25,
+};
+
+struct StratumError {
+    StratumErrorCode code;
+    std::string message;
+};
+
+/** Target of a difficulty 1 share */
+arith_uint256 Difficulty1Target()
+{
+    return arith_uint256{}.SetCompact(0x1d00ffff);
+}
+
+std::string ResponseLine(const UniValue& id, UniValue result, UniValue error)
+{
+    UniValue reply{UniValue::VOBJ};
+    reply.pushKV("id", id);
+    reply.pushKV("result", std::move(result));
+    reply.pushKV("error", std::move(error));
+    return reply.write() + "\n";
+}
+
+std::string ErrorLine(const UniValue& id, const StratumError& error)
+{
+    UniValue err{UniValue::VARR};
+    err.push_back(int{error.code});
+    err.push_back(error.message);
+    err.push_back(UniValue{});
+    return ResponseLine(id, UniValue{}, std::move(err));
+}
+
+std::string MethodLine(const std::string& method, UniValue params)
+{
+    UniValue request{UniValue::VOBJ};
+    request.pushKV("id", UniValue{});
+    request.pushKV("method", method);
+    request.pushKV("params", std::move(params));
+    return request.write() + "\n";
+}
+
+/** Previous block hash as stratum sends it: the header bytes, with each 32-bit word byte swapped. */
+std::string StratumPrevHash(const uint256& hash)
+{
+    std::array<unsigned char, 32> swapped;
+    for (size_t i = 0; i < swapped.size(); ++i) {
+        swapped[i] = hash.data()[(i & ~size_t{3}) + 3 - (i & 3)];
+    }
+    return HexStr(swapped);
+}
+
+/** Parse a 32-bit header field sent as 8 big-endian hex digits. */
+std::optional<uint32_t> ParseHexUInt32(const std::string& hex)
+{
+    const auto bytes{TryParseHex<unsigned char>(hex)};
+    if (!bytes || bytes->size() != 4) return std::nullopt;
+    return ReadBE32(bytes->data());
+}
+} // namespace
+
+StratumServer::Job::Job(std::string id_in, std::shared_ptr<interfaces::BlockTemplate> block_template_in, const arith_uint256& share_target_in)
+    : id{std::move(id_in)},
+      block_template{std::move(block_template_in)},
+      work{block_template->getBlock()}
+{
+    block_target.SetCompact(work.GetTemplate().nBits);
+    share_target = std::max(share_target_in, block_target);
+}
+
+StratumServer::StratumServer(int64_t difficulty)
+    : m_share_target{Difficulty1Target() / arith_uint256(std::max<int64_t>(difficulty, 1))},
+      m_next_extranonce1{FastRandomContext{}.rand32()} {}
+
+void StratumServer::AddJob(std::shared_ptr<interfaces::BlockTemplate> block_template, bool clean)
+{
+    LOCK(m_mutex);
+    m_jobs.Add(std::make_shared<Job>(strprintf("%x", ++m_job_counter), std::move(block_template), m_share_target), clean);
+}
+
+std::string StratumServer::GetNotify(bool clean) const
+{
+    LOCK(m_mutex);
+    const auto job{m_jobs.Newest()};
+    if (!job) return "";
+    return NotifyMessage(*job, clean);
+}
+
+std::string StratumServer::NotifyMessage(const Job& job, bool clean) const
+{
+    const CBlock& block{job.work.GetTemplate()};
+
+    UniValue difficulty{UniValue::VARR};
+    difficulty.push_back(Difficulty1Target().getdouble() / job.share_target.getdouble());
+
+    UniValue branches{UniValue::VARR};
+    for (const uint256& hash : job.work.GetMerklePath()) {
+        branches.push_back(HexStr(hash));
+    }
+    UniValue params{UniValue::VARR};
+    params.push_back(job.id);
+    params.push_back(StratumPrevHash(block.hashPrevBlock));
+    params.push_back(HexStr(job.work.GetCoinbasePrefix()));
+    params.push_back(HexStr(job.work.GetCoinbaseSuffix()));
+    params.push_back(std::move(branches));
+    params.push_back(strprintf("%08x", static_cast<uint32_t>(block.nVersion)));
+    params.push_back(strprintf("%08x", block.nBits));
+    params.push_back(strprintf("%08x", block.nTime));
+    params.push_back(clean);
+    return MethodLine("mining.set_difficulty", std::move(difficulty)) + MethodLine("mining.notify", std::move(params));
+}
+
+StratumSession StratumServer::NewSession()
+{
+    StratumSession session;
+    WriteBE32(session.extranonce1.data(), m_next_extranonce1++);
+    return session;
+}
+
+std::string StratumServer::HandleRequest(StratumSession& session, std::string_view line)
+{
+    if (line.find_first_not_of(" \t\r") == std::string_view::npos) return "";
+    UniValue request;
+    if (!request.read(line) || !request.isObject()) {
+        return ErrorLine(UniValue{}, {STRATUM_OTHER, "Parse error"});
+    }
+    const UniValue& id{request.find_value("id")};
+    const UniValue& method{request.find_value("method")};
+    const UniValue& params{request.find_value("params")};
+    if (!method.isStr()) return ErrorLine(id, {STRATUM_OTHER, "Invalid request"});
+
+    const std::string& name{method.get_str()};
+    LogDebug(BCLog::STRATUM, "Received %s", name);
+    if (name == "mining.subscribe") {
+        session.subscribed = true;
+        const std::string subscription{HexStr(session.extranonce1)};
+        UniValue subscriptions{UniValue::VARR};
+        for (const char* notification : {"mining.set_difficulty", "mining.notify"}) {
+            UniValue entry{UniValue::VARR};
+            entry.push_back(notification);
+            entry.push_back(subscription);
+            subscriptions.push_back(std::move(entry));
+        }
+        UniValue result{UniValue::VARR};
+        result.push_back(std::move(subscriptions));
+        result.push_back(HexStr(session.extranonce1));
+        result.push_back(uint64_t{STRATUM_EXTRANONCE2_SIZE});
+        return ResponseLine(id, std::move(result), UniValue{}) + GetNotify(/*clean=*/true);
+    }
+    if (name == "mining.authorize") {
+        // Blocks pay to -genaddress, so worker names are only informational.
+        session.authorized = true;
+        return ResponseLine(id, true, UniValue{});
+    }
+    if (name == "mining.extranonce.subscribe") {
+        return ResponseLine(id, true, UniValue{});
+    }
+    if (name == "mining.configure") {
+        // No extensions (such as version rolling) are supported.
+        UniValue result{UniValue::VOBJ};
+        if (params.isArray() && !params.empty() && params[0].isArray()) {
+            for (const UniValue& extension : params[0].getValues()) {
+                if (extension.isStr()) result.pushKV(extension.get_str(), false);
+            }
+        }
+        return ResponseLine(id, std::move(result), UniValue{});
+    }
+    if (name == "mining.submit") {
+        try {
+            return ResponseLine(id, Submit(session, params), UniValue{});
+        } catch (const StratumError& error) {
+            ++m_rejected_shares;
+            LogDebug(BCLog::STRATUM, "Rejected share: %s", error.message);
+            return ErrorLine(id, error);
+        }
+    }
+    return ErrorLine(id, {STRATUM_OTHER, "Method not found"});
+}
+
+UniValue StratumServer::Submit(const StratumSession& session, const UniValue& params)
+{
+    if (!session.subscribed) throw StratumError{STRATUM_NOT_SUBSCRIBED, "Not subscribed"};
+    if (!session.authorized) throw StratumError{STRATUM_UNAUTHORIZED, "Unauthorized worker"};
+    if (!params.isArray() || params.size() < 5) throw StratumError{STRATUM_OTHER, "Invalid parameters"};
+    if (params.size() > 5) throw StratumError{STRATUM_OTHER, "Version rolling is not supported"};
+    for (size_t i = 0; i < 5; ++i) {
+        if (!params[i].isStr()) throw StratumError{STRATUM_OTHER, "Invalid parameters"};
+    }
+
+    bool stale;
+    const std::shared_ptr<Job> job{WITH_LOCK(m_mutex, return m_jobs.Find(params[1].get_str(), stale))};
+    // Jobs are only forgotten once many newer ones were sent.
+    if (!job) throw StratumError{STRATUM_JOB_NOT_FOUND, "Job not found"};
+
+    const auto extranonce2{TryParseHex<unsigned char>(params[2].get_str())};
+    if (!extranonce2 || extranonce2->size() != STRATUM_EXTRANONCE2_SIZE) throw StratumError{STRATUM_OTHER, "Invalid extranonce2"};
+    const auto time{ParseHexUInt32(params[3].get_str())};
+    if (!time) throw StratumError{STRATUM_OTHER, "Invalid ntime"};
+    const auto nonce{ParseHexUInt32(params[4].get_str())};
+    if (!nonce) throw StratumError{STRATUM_OTHER, "Invalid nonce"};
+
+    std::array<unsigned char, node::EXTRANONCE_SIZE> extranonce;
+    std::copy(session.extranonce1.begin(), session.extranonce1.end(), extranonce.begin());
+    std::copy(extranonce2->begin(), extranonce2->end(), extranonce.begin() + STRATUM_EXTRANONCE1_SIZE);
+
+    CBlockHeader header{job->work.GetHeader(extranonce)};
+    if (*time < header.nTime || int64_t{*time} > int64_t{header.nTime} + MAX_FUTURE_BLOCK_TIME) {
+        throw StratumError{STRATUM_OTHER, "ntime out of range"};
+    }
+    header.nTime = *time;
+    header.nNonce = *nonce;
+    const uint256 hash{header.GetHash()};
+    const arith_uint256 hash_value{UintToArith256(hash)};
+    if (hash_value > job->share_target) throw StratumError{STRATUM_LOW_DIFFICULTY, "Low difficulty share"};
+    const bool solves_block{hash_value <= job->block_target};
+    bool duplicate;
+    {
+        LOCK(m_mutex);
+        duplicate = !job->shares.insert(hash).second;
+        if (!duplicate) {
+            job->share_order.push_back(hash);
+            if (job->share_order.size() > STRATUM_MAX_JOB_SHARES) {
+                job->shares.erase(job->share_order.front());
+                job->share_order.pop_front();
+            }
+        }
+    }
+    if (stale) {
+        // A block on a replaced tip: work lost to latency.
+        if (solves_block && !duplicate) node::GetMiningMetrics().SolutionFound(/*stale=*/true);
+        throw StratumError{STRATUM_JOB_NOT_FOUND, "Stale job"};
+    }
+    if (duplicate) throw StratumError{STRATUM_DUPLICATE_SHARE, "Duplicate share"};
+    ++m_accepted_shares;
+
+    if (solves_block) {
+        {
+            LOCK(m_mutex);
+            m_found_blocks.push_back({job, extranonce, *time, *nonce});
+        }
+        m_found_cv.notify_one();
+    }
+    return true;
+}
+
+void StratumServer::SubmitBlocks(std::chrono::milliseconds timeout)
+{
+    std::vector<FoundBlock> found_blocks;
+    {
+        WAIT_LOCK(m_mutex, lock);
+        m_found_cv.wait_for(lock, timeout, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return !m_found_blocks.empty(); });
+        found_blocks.swap(m_found_blocks);
+    }
+    for (const FoundBlock& found : found_blocks) {
+        const CBlock block{found.job->work.GetBlock(found.extranonce, found.time, found.nonce)};
+        const bool accepted{found.job->block_template->submitSolution(block.nVersion, found.time, found.nonce, block.vtx[0])};
+        // Counted once the node processed it, as one that it turned down is no better than stale.
+        node::GetMiningMetrics().SolutionFound(/*stale=*/!accepted);
+        if (accepted) {
+            ++m_blocks_found;
+            LogInfo("stratum: Found block %s", block.GetHash().ToString());
+        } else {
+            LogWarning("stratum: Block %s was not processed", block.GetHash().ToString());
+        }
+    }
+}
+
+namespace {
+/**
+ * Serves a StratumServer over TCP with libevent, and feeds it a new job
+ * whenever the Mining interface has a new template.
+ */
+class StratumListener
+{
+public:
+    StratumListener(interfaces::Mining& mining, const CScript& coinbase_output_script, int64_t difficulty)
+        : m_feed{mining, coinbase_output_script, STRATUM_TEMPLATE_REFRESH}, m_server{difficulty} {}
+
+    bool Start(const std::vector<CService>& binds) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void Interrupt() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void Stop();
+
+private:
+    static void AcceptCallback(evconnlistener* listener, evutil_socket_t fd, sockaddr* addr, int len, void* arg);
+    static void ReadCallback(bufferevent* bev, void* arg);
+    static void EventCallback(bufferevent* bev, short what, void* arg);
+    static void NotifyCallback(evutil_socket_t, short, void* arg);
+    void Disconnect(bufferevent* bev);
+    void ThreadTemplates() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    node::BlockTemplateFeed m_feed;
+    StratumServer m_server;
+
+    raii_event_base m_base;
+    raii_event m_notify_event;
+    std::vector<evconnlistener*> m_listeners;
+    //! Connected clients, only accessed from the event thread
+    std::map<bufferevent*, StratumSession> m_clients;
+    std::thread m_event_thread;
+    std::thread m_template_thread;
+    std::thread m_submit_thread;
+
+    Mutex m_mutex;
+    //! Whether the job to broadcast next invalidates the previous ones
+    bool m_notify_clean GUARDED_BY(m_mutex){false};
+};
+
+bool StratumListener::Start(const std::vector<CService>& binds)
+{
+#ifdef WIN32
+    evthread_use_windows_threads();
+#else
+    evthread_use_pthreads();
+#endif
+    m_base = obtain_event_base();
+    m_notify_event = obtain_event(m_base.get(), -1, 0, NotifyCallback, this);
+
+    for (const CService& bind : binds) {
+        sockaddr_storage addr;
+        socklen_t len{sizeof(addr)};
+        if (!bind.GetSockAddr(reinterpret_cast<sockaddr*>(&addr), &len)) {
+            LogError("stratum: Cannot bind to %s: unsupported address", bind.ToStringAddrPort());
+            continue;
+        }
+        evconnlistener* listener{evconnlistener_new_bind(m_base.get(), AcceptCallback, this, LEV_OPT_CLOSE_ON_FREE | LEV_OPT_REUSEABLE,
+                                                         /*backlog=*/-1, reinterpret_cast<sockaddr*>(&addr), len)};
+        if (!listener) {
+            LogError("stratum: Unable to bind to %s", bind.ToStringAddrPort());
+            continue;
+        }
+        LogInfo("stratum: Listening on %s", bind.ToStringAddrPort());
+        m_listeners.push_back(listener);
+    }
+    if (m_listeners.empty()) return false;
+
+    m_event_thread = std::thread(&util::TraceThread, "stratum", [this] {
+        event_base_loop(m_base.get(), EVLOOP_NO_EXIT_ON_EMPTY);
+    });
+    m_template_thread = std::thread(&util::TraceThread, "stratumtmpl", [this] { ThreadTemplates(); });
+    m_submit_thread = std::thread(&util::TraceThread, "stratumsubmit", [this] {
+        while (!m_feed.Interrupted()) m_server.SubmitBlocks(STRATUM_SUBMIT_POLL_INTERVAL);
+    });
+    return true;
+}
+
+void StratumListener::Interrupt()
+{
+    m_feed.Interrupt();
+    if (m_base) {
+        // Break from within the loop, so this also works before it started.
+        event_base_once(m_base.get(), -1, EV_TIMEOUT, [](evutil_socket_t, short, void* base) {
+            event_base_loopbreak(static_cast<event_base*>(base));
+        }, m_base.get(), nullptr);
+    }
+}
+
+void StratumListener::Stop()
+{
+    if (m_template_thread.joinable()) m_template_thread.join();
+    if (m_submit_thread.joinable()) m_submit_thread.join();
+    if (m_event_thread.joinable()) m_event_thread.join();
+    for (auto& [bev, session] : m_clients) bufferevent_free(bev);
+    m_clients.clear();
+    for (evconnlistener* listener : m_listeners) evconnlistener_free(listener);
+    m_listeners.clear();
+    m_notify_event.reset();
+    m_base.reset();
+}
+
+void StratumListener::ThreadTemplates()
+{
+    bool clean;
+    while (auto block_template{m_feed.Next(clean)}) {
+        WITH_LOCK(m_mutex, m_notify_clean |= clean);
+        m_server.AddJob(std::move(block_template), clean);
+        event_active(m_notify_event.get(), 0, 0);
+    }
+}
+
+void StratumListener::AcceptCallback(evconnlistener* listener, evutil_socket_t fd, sockaddr* addr, int len, void* arg)
+{
+    auto* self{static_cast<StratumListener*>(arg)};
+    if (self->m_clients.size() >= STRATUM_MAX_CLIENTS) {
+        LogDebug(BCLog::STRATUM, "Too many clients, dropping connection");
+        evutil_closesocket(fd);
+        return;
+    }
+    bufferevent* bev{bufferevent_socket_new(self->m_base.get(), fd, BEV_OPT_CLOSE_ON_FREE)};
+    if (!bev) {
+        evutil_closesocket(fd);
+        return;
+    }
+    bufferevent_setcb(bev, ReadCallback, nullptr, EventCallback, self);
+    bufferevent_enable(bev, EV_READ | EV_WRITE);
+    self->m_clients.emplace(bev, self->m_server.NewSession());
+    LogDebug(BCLog::STRATUM, "New client, %d connected", self->m_clients.size());
+}
+
+void StratumListener::ReadCallback(bufferevent* bev, void* arg)
+{
+    auto* self{static_cast<StratumListener*>(arg)};
+    const auto it{self->m_clients.find(bev)};
+    if (it == self->m_clients.end()) return;
+    evbuffer* input{bufferevent_get_input(bev)};
+    size_t n_read_out{0};
+    char* line;
+    while ((line = evbuffer_readln(input, &n_read_out, EVBUFFER_EOL_CRLF)) != nullptr) {
+        const std::string reply{n_read_out <= STRATUM_MAX_LINE_LENGTH ? self->m_server.HandleRequest(it->second, {line, n_read_out}) : ""};
+        free(line);
+        if (n_read_out > STRATUM_MAX_LINE_LENGTH) {
+            self->Disconnect(bev);
+            return;
+        }
+        if (!reply.empty()) bufferevent_write(bev, reply.data(), reply.size());
+    }
+    // Do not buffer an unbounded partial line.
+    if (evbuffer_get_length(input) > STRATUM_MAX_LINE_LENGTH) self->Disconnect(bev);
+}
+
+void StratumListener::EventCallback(bufferevent* bev, short what, void* arg)
+{
+    auto* self{static_cast<StratumListener*>(arg)};
+    if (what & (BEV_EVENT_EOF | BEV_EVENT_ERROR)) self->Disconnect(bev);
+}
+
+void StratumListener::NotifyCallback(evutil_socket_t, short, void* arg)
+{
+    auto* self{static_cast<StratumListener*>(arg)};
+    const bool clean{WITH_LOCK(self->m_mutex, return std::exchange(self->m_notify_clean, false))};
+    const std::string notify{self->m_server.GetNotify(clean)};
+    if (notify.empty()) return;
+    std::vector<bufferevent*> slow;
+    for (const auto& [bev, session] : self->m_clients) {
+        if (!session.subscribed) continue;
+        if (evbuffer_get_length(bufferevent_get_output(bev)) > STRATUM_MAX_SEND_BUFFER) {
+            slow.push_back(bev);
+            continue;
+        }
+        bufferevent_write(bev, notify.data(), notify.size());
+    }
+    for (bufferevent* bev : slow) self->Disconnect(bev);
+    LogDebug(BCLog::STRATUM, "Sent new job to %d clients", self->m_clients.size());
+}
+
+void StratumListener::Disconnect(bufferevent* bev)
+{
+    m_clients.erase(bev);
+    bufferevent_free(bev);
+    LogDebug(BCLog::STRATUM, "Client disconnected, %d connected", m_clients.size());
+}
+
+std::unique_ptr<StratumListener> g_stratum;
+} // namespace
+
+bool StartStratum(interfaces::Mining& mining, const std::vector<CService>& binds, const CScript& coinbase_output_script, int64_t difficulty)
+{
+    assert(!g_stratum);
+    g_stratum = std::make_unique<StratumListener>(mining, coinbase_output_script, difficulty);
+    if (!g_stratum->Start(binds)) {
+        g_stratum->Stop();
+        g_stratum.reset();
+        return false;
+    }
+    return true;
+}
+
+void InterruptStratum()
+{
+    if (g_stratum) g_stratum->Interrupt();
+}
+
+void StopStratum()
+{
+    if (g_stratum) {
+        g_stratum->Stop();
+        g_stratum.reset();
+    }
+}
@@ -0,0 +1,148 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * Stratum v1 server handing out work from the Mining interface.
+ */
+
+#ifndef BITCOIN_STRATUM_H
+#define BITCOIN_STRATUM_H
+
+#include <arith_uint256.h>
+#include <node/mining_job.h>
+#include <sync.h>
+#include <uint256.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class CScript;
+class CService;
+class UniValue;
+namespace interfaces {
+class BlockTemplate;
+class Mining;
+} // namespace interfaces
+
+static constexpr uint16_t DEFAULT_STRATUM_PORT{3333};
+/** Default for -stratumdifficulty, the share difficulty asked of miners */
+static constexpr int64_t DEFAULT_STRATUM_DIFFICULTY{1};
+/** Part of the coinbase extranonce assigned by the server to each connection */
+static constexpr size_t STRATUM_EXTRANONCE1_SIZE{4};
+/** Part of the coinbase extranonce rolled by the miner */
+static constexpr size_t STRATUM_EXTRANONCE2_SIZE{node::EXTRANONCE_SIZE - STRATUM_EXTRANONCE1_SIZE};
+/** Without a new tip, how often a new template is built to pick up mempool transactions */
+static constexpr std::chrono::seconds STRATUM_TEMPLATE_REFRESH{30};
+/** Number of share hashes kept per job to reject duplicates, oldest forgotten first */
+static constexpr size_t STRATUM_MAX_JOB_SHARES{16 * 1024};
+/** How long the submission thread waits for a found block before checking for shutdown */
+static constexpr std::chrono::milliseconds STRATUM_SUBMIT_POLL_INTERVAL{100};
+/** Maximum length of a request line, and of unread input, from a client */
+static constexpr size_t STRATUM_MAX_LINE_LENGTH{16 * 1024};
+/** Clients whose unsent data exceeds this are disconnected */
+static constexpr size_t STRATUM_MAX_SEND_BUFFER{1024 * 1024};
+/** Maximum number of connected clients */
+static constexpr size_t STRATUM_MAX_CLIENTS{1024};
+
+/** Start serving work from mining on binds, paying to coinbase_output_script. */
+bool StartStratum(interfaces::Mining& mining, const std::vector<CService>& binds, const CScript& coinbase_output_script, int64_t difficulty);
+void InterruptStratum();
+void StopStratum();
+
+/** Per-connection state. */
+struct StratumSession {
+    std::array<unsigned char, STRATUM_EXTRANONCE1_SIZE> extranonce1{};
+    bool subscribed{false};
+    bool authorized{false};
+};
+
+/**
+ * Stratum v1 protocol state: the recent jobs and the handling of client
+ * requests, independent of the transport.
+ *
+ * Each job wraps a block template in a node::MiningJob, so mining.notify
+ * hands out its coinbase prefix and suffix around the extranonce and the
+ * coinbase merkle branch, and a submitted share is checked by hashing the
+ * coinbase and one node per merkle level.
+ */
+class StratumServer
+{
+public:
+    explicit StratumServer(int64_t difficulty);
+
+    /** Make block_template the current job. Older jobs become stale if clean. */
+    void AddJob(std::shared_ptr<interfaces::BlockTemplate> block_template, bool clean) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    /** mining.set_difficulty and mining.notify messages for the current job, or "" if there is none. */
+    std::string GetNotify(bool clean) const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    /** Set up a session with a fresh extranonce1. */
+    StratumSession NewSession();
+
+    /** Handle one request line from session. Returns the newline-terminated messages to send back. */
+    std::string HandleRequest(StratumSession& session, std::string_view line) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    /**
+     * Pass the blocks found by shares to the node, waiting up to timeout for
+     * one. Blocks are queued by HandleRequest() and submitted here, so that
+     * validating them does not hold up the thread serving the clients.
+     */
+    void SubmitBlocks(std::chrono::milliseconds timeout) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    uint64_t GetAcceptedShares() const { return m_accepted_shares.load(); }
+    uint64_t GetRejectedShares() const { return m_rejected_shares.load(); }
+    uint64_t GetBlocksFound() const { return m_blocks_found.load(); }
+
+private:
+    struct Job {
+        Job(std::string id_in, std::shared_ptr<interfaces::BlockTemplate> block_template_in, const arith_uint256& share_target_in);
+
+        const std::string id;
+        const std::shared_ptr<interfaces::BlockTemplate> block_template;
+        const node::MiningJob work;
+        arith_uint256 block_target;
+        //! Share target, never harder than the block target
+        arith_uint256 share_target;
+        //! Hashes of the recent shares, to reject duplicates
+        std::set<uint256> shares;
+        //! The same hashes, oldest first, to keep at most STRATUM_MAX_JOB_SHARES
+        std::deque<uint256> share_order;
+    };
+
+    //! A share that solves the block of its job, waiting to be submitted
+    struct FoundBlock {
+        std::shared_ptr<Job> job;
+        std::array<unsigned char, node::EXTRANONCE_SIZE> extranonce;
+        uint32_t time;
+        uint32_t nonce;
+    };
+
+    std::string NotifyMessage(const Job& job, bool clean) const;
+    UniValue Submit(const StratumSession& session, const UniValue& params) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    //! Share target for -stratumdifficulty
+    const arith_uint256 m_share_target;
+    std::atomic<uint32_t> m_next_extranonce1;
+
+    mutable Mutex m_mutex;
+    uint64_t m_job_counter GUARDED_BY(m_mutex){0};
+    node::MiningJobList<Job> m_jobs GUARDED_BY(m_mutex);
+    std::vector<FoundBlock> m_found_blocks GUARDED_BY(m_mutex);
+    std::condition_variable m_found_cv;
+
+    std::atomic<uint64_t> m_accepted_shares{0};
+    std::atomic<uint64_t> m_rejected_shares{0};
+    std::atomic<uint64_t> m_blocks_found{0};
+};
+
+#endif // BITCOIN_STRATUM_H
@@ -121,6 +121,11 @@ class PoolResource final
      */
     std::byte* m_available_memory_end = nullptr;
 
+    /**
+     * Total size of the blocks in m_free_lists.
+     */
+    std::size_t m_free_list_bytes = 0;
+
     /**
      * How many multiple of ELEM_ALIGN_BYTES are necessary to fit bytes. We use that result directly as an index
      * into m_free_lists. Round up for the special case when bytes==0.
@@ -160,6 +165,7 @@ class PoolResource final
             ASAN_UNPOISON_MEMORY_REGION(m_available_memory_it, sizeof(ListNode));
             PlacementAddToList(m_available_memory_it, m_free_lists[remaining_available_bytes / ELEM_ALIGN_BYTES]);
             ASAN_POISON_MEMORY_REGION(m_available_memory_it, sizeof(ListNode));
+            m_free_list_bytes += remaining_available_bytes;
         }
 
         void* storage = ::operator new (m_chunk_size_bytes, std::align_val_t{ELEM_ALIGN_BYTES});
@@ -227,6 +233,7 @@ public:
                 auto* next{m_free_lists[num_alignments]->m_next};
                 ASAN_POISON_MEMORY_REGION(m_free_lists[num_alignments], sizeof(ListNode));
                 ASAN_UNPOISON_MEMORY_REGION(m_free_lists[num_alignments], bytes);
+                m_free_list_bytes -= num_alignments * ELEM_ALIGN_BYTES;
                 return std::exchange(m_free_lists[num_alignments], next);
             }
 
@@ -258,6 +265,7 @@ public:
             ASAN_UNPOISON_MEMORY_REGION(p, sizeof(ListNode));
             PlacementAddToList(p, m_free_lists[num_alignments]);
             ASAN_POISON_MEMORY_REGION(p, std::max(bytes, sizeof(ListNode)));
+            m_free_list_bytes += num_alignments * ELEM_ALIGN_BYTES;
         } else {
             // Can't use the pool => forward deallocation to ::operator delete().
             ::operator delete (p, std::align_val_t{alignment});
@@ -279,6 +287,14 @@ public:
     {
         return m_chunk_size_bytes;
     }
+
+    /**
+     * Bytes of the allocated chunks that were given back and wait in the freelists to be reused.
+     */
+    [[nodiscard]] std::size_t FreeListBytes() const
+    {
+        return m_free_list_bytes;
+    }
 };
 
 
@@ -0,0 +1,124 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <chainparams.h>
+#include <consensus/amount.h>
+#include <node/blockcompression.h>
+#include <primitives/block.h>
+#include <primitives/transaction.h>
+#include <script/script.h>
+#include <streams.h>
+#include <test/util/random.h>
+#include <test/util/setup_common.h>
+#include <util/chaintype.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <ios>
+
+using node::CompressBlock;
+using node::DecompressBlock;
+
+BOOST_FIXTURE_TEST_SUITE(blockcompression_tests, BasicTestingSetup)
+
+static std::vector<std::byte> Serialize(const CBlock& block)
+{
+    DataStream s;
+    s << TX_WITH_WITNESS(block);
+    return {s.begin(), s.end()};
+}
+
+static void CheckRoundTrip(const CBlock& block)
+{
+    const DataStream compressed{CompressBlock(block)};
+    BOOST_CHECK(DecompressBlock(compressed) == Serialize(block));
+}
+
+BOOST_AUTO_TEST_CASE(genesis_block)
+{
+    for (const auto chain : {ChainType::MAIN, ChainType::REGTEST, ChainType::DRIP}) {
+        CheckRoundTrip(CreateChainParams(m_args, chain)->GenesisBlock());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(transactions)
+{
+    CBlock block;
+    block.nVersion = 0x20000000;
+    block.hashPrevBlock = m_rng.rand256();
+    block.hashMerkleRoot = m_rng.rand256();
+    block.nTime = 1700000000;
+    block.nBits = 0x207fffff;
+    block.nNonce = 42;
+
+    CMutableTransaction coinbase;
+    coinbase.vin.resize(1);
+    coinbase.vin[0].scriptSig = CScript() << 101 << OP_0;
+    coinbase.vout.emplace_back(50 * COIN, CScript() << OP_RETURN << m_rng.randbytes(36));
+    block.vtx.push_back(MakeTransactionRef(coinbase));
+
+    const auto hash{[&](size_t size) { return m_rng.randbytes(size); }};
+    CMutableTransaction spend;
+    spend.version = 2;
+    spend.nLockTime = 123456;
+    for (const uint32_t sequence : {CTxIn::SEQUENCE_FINAL, CTxIn::MAX_SEQUENCE_NONFINAL, CTxIn::MAX_SEQUENCE_NONFINAL - 1, uint32_t{0}, uint32_t{0x12345678}}) {
+        CTxIn in{COutPoint{Txid::FromUint256(m_rng.rand256()), m_rng.randrange<uint32_t>(10)}, CScript() << hash(71), sequence};
+        in.scriptWitness.stack = {hash(72), hash(33)};
+        spend.vin.push_back(in);
+    }
+    // Standard scripts, scripts that only look like them, and amounts at and past the limits.
+    std::vector<uint8_t> key(33);
+    key[0] = 0x02;
+    for (const CScript& script : {
+             CScript() << OP_DUP << OP_HASH160 << hash(20) << OP_EQUALVERIFY << OP_CHECKSIG,
+             CScript() << OP_HASH160 << hash(20) << OP_EQUAL,
+             CScript() << OP_0 << hash(20),
+             CScript() << OP_0 << hash(32),
+             CScript() << OP_1 << hash(32),
+             CScript() << key << OP_CHECKSIG,
+             CScript() << OP_DUP << OP_HASH160 << hash(20) << OP_EQUALVERIFY << OP_CHECKSIGVERIFY,
+             CScript() << OP_0 << hash(19) << OP_0,
+             CScript() << OP_2 << hash(32),
+             CScript(),
+         }) {
+        spend.vout.emplace_back(m_rng.randrange(MAX_MONEY), script);
+    }
+    spend.vout.emplace_back(0, CScript() << OP_TRUE);
+    spend.vout.emplace_back(MAX_MONEY, CScript() << OP_TRUE);
+    spend.vout.emplace_back(MAX_MONEY + 1, CScript() << OP_TRUE);
+    spend.vout.emplace_back(-1, CScript() << OP_TRUE);
+    block.vtx.push_back(MakeTransactionRef(spend));
+
+    // A transaction without witness data, and one with an empty witness for some inputs.
+    CMutableTransaction legacy{spend};
+    for (auto& in : legacy.vin) in.scriptWitness.SetNull();
+    block.vtx.push_back(MakeTransactionRef(legacy));
+    legacy.vin[2].scriptWitness.stack = {{}, hash(10)};
+    block.vtx.push_back(MakeTransactionRef(legacy));
+
+    CheckRoundTrip(block);
+    BOOST_CHECK_LT(CompressBlock(block).size(), Serialize(block).size());
+}
+
+BOOST_AUTO_TEST_CASE(invalid_data)
+{
+    const auto params{CreateChainParams(m_args, ChainType::MAIN)};
+    const DataStream compressed{CompressBlock(params->GenesisBlock())};
+    const std::span<const std::byte> data{compressed};
+
+    // Truncated data
+    for (const size_t size : {size_t{0}, size_t{79}, size_t{80}, data.size() - 1}) {
+        BOOST_CHECK_THROW(DecompressBlock(data.first(size)), std::ios_base::failure);
+    }
+    // Trailing data
+    std::vector<std::byte> extended{data.begin(), data.end()};
+    extended.push_back(std::byte{0});
+    BOOST_CHECK_THROW(DecompressBlock(extended), std::ios_base::failure);
+    // Unknown transaction flags
+    std::vector<std::byte> flags{data.begin(), data.end()};
+    flags[80 + 1 + 1] = std::byte{2};
+    BOOST_CHECK_THROW(DecompressBlock(flags), std::ios_base::failure);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -5,6 +5,8 @@
 #include <chain.h>
 #include <chainparams.h>
 #include <clientversion.h>
+#include <node/blockfilescanner.h>
+#include <node/blockreadahead.h>
 #include <node/blockstorage.h>
 #include <node/context.h>
 #include <node/kernel_notifications.h>
@@ -166,6 +168,179 @@ BOOST_FIXTURE_TEST_CASE(blockmanager_block_data_part, TestChain100Setup)
     expect_part(block->size() - 1, 1);
 }
 
+BOOST_AUTO_TEST_CASE(blockmanager_read_mapped)
+{
+    const auto params{CreateChainParams(ArgsManager{}, ChainType::MAIN)};
+    KernelNotifications notifications{Assert(m_node.shutdown_request), m_node.exit_status, *Assert(m_node.warnings)};
+    const BlockManager::Options blockman_opts{
+        .chainparams = *params,
+        .fast_prune = true,
+        .blocks_dir = m_args.GetBlocksDirPath(),
+        .notifications = notifications,
+        .block_tree_db_params = DBParams{
+            .path = m_args.GetDataDirNet() / "blocks" / "index",
+            .cache_bytes = 0,
+        },
+    };
+    BlockManager blockman{*Assert(m_node.shutdown_signal), blockman_opts};
+    DataStream expected;
+    expected << TX_WITH_WITNESS(params->GenesisBlock());
+
+    // Fill the first (64 KiB with -fastprune) block file, so that it is finalized.
+    std::vector<FlatFilePos> positions;
+    while (positions.empty() || positions.back().nFile == 0) {
+        positions.push_back(blockman.WriteBlock(params->GenesisBlock(), positions.size()));
+    }
+    BOOST_CHECK_GT(positions.size(), 2U);
+
+    // Blocks are the same whether read through the mapping of the finalized file or not.
+    for (const FlatFilePos& pos : {positions.front(), positions[positions.size() - 2], positions.back()}) {
+        const auto block{blockman.ReadRawBlock(pos)};
+        BOOST_REQUIRE(block);
+        BOOST_CHECK(std::ranges::equal(*block, expected));
+        const auto part{blockman.ReadRawBlock(pos, std::pair{size_t{10}, size_t{20}})};
+        BOOST_REQUIRE(part);
+        BOOST_CHECK(std::ranges::equal(*part, std::span{expected}.subspan(10, 20)));
+    }
+    // A position past the used part of the file is not read from the mapping.
+    BOOST_CHECK(!blockman.ReadRawBlock({0, MAX_BLOCKFILE_SIZE}));
+
+    // A record appended to the file after it was mapped is read from the file.
+    const unsigned int file_size{blockman.GetBlockFileInfo(0)->nSize};
+    {
+        AutoFile file{blockman.OpenBlockFile({0, file_size}, /*fReadOnly=*/false)};
+        file << params->MessageStart() << uint32_t(expected.size()) << TX_WITH_WITNESS(params->GenesisBlock());
+        BOOST_REQUIRE_EQUAL(file.fclose(), 0);
+    }
+    const auto appended{blockman.ReadRawBlock({0, file_size + STORAGE_HEADER_BYTES})};
+    BOOST_REQUIRE(appended);
+    BOOST_CHECK(std::ranges::equal(*appended, expected));
+    BOOST_CHECK(blockman.ReadRawBlock(positions.front()));
+
+    // Pruning the file drops its mapping.
+    blockman.UnlinkPrunedFiles({0});
+    BOOST_CHECK(!blockman.ReadRawBlock(positions.front()));
+    BOOST_CHECK(blockman.ReadRawBlock(positions.back()));
+}
+
+BOOST_FIXTURE_TEST_CASE(blockmanager_read_compressed, TestChain100Setup)
+{
+    fs::create_directories(m_args.GetDataDirBase() / "compressed");
+    KernelNotifications notifications{Assert(m_node.shutdown_request), m_node.exit_status, *Assert(m_node.warnings)};
+    const BlockManager::Options blockman_opts{
+        .chainparams = Params(),
+        .compress_blocks = true,
+        .blocks_dir = m_args.GetDataDirBase() / "compressed",
+        .notifications = notifications,
+        .block_tree_db_params = DBParams{
+            .path = m_args.GetDataDirBase() / "compressed" / "index",
+            .cache_bytes = 0,
+        },
+    };
+    BlockManager blockman{*Assert(m_node.shutdown_signal), blockman_opts};
+
+    // Blocks written compressed read back the same, in full and in parts.
+    const CBlockIndex* tip{WITH_LOCK(::cs_main, return m_node.chainman->ActiveChain().Tip())};
+    CBlock block;
+    BOOST_REQUIRE(m_node.chainman->m_blockman.ReadBlock(block, *tip));
+    DataStream expected;
+    expected << TX_WITH_WITNESS(block);
+    const FlatFilePos pos{blockman.WriteBlock(block, tip->nHeight)};
+    BOOST_CHECK_LT(blockman.CalculateCurrentUsage(), expected.size());
+
+    const auto raw{blockman.ReadRawBlock(pos)};
+    BOOST_REQUIRE(raw);
+    BOOST_CHECK(std::ranges::equal(*raw, expected));
+    const auto part{blockman.ReadRawBlock(pos, std::pair{size_t{10}, expected.size() - 10})};
+    BOOST_REQUIRE(part);
+    BOOST_CHECK(std::ranges::equal(*part, std::span{expected}.subspan(10)));
+    BOOST_CHECK(!blockman.ReadRawBlock(pos, std::pair{size_t{10}, expected.size() - 9}));
+    CBlock read_block;
+    BOOST_CHECK(blockman.ReadBlock(read_block, pos, block.GetHash()));
+    BOOST_CHECK_EQUAL(read_block.GetHash(), block.GetHash());
+
+    // They are found by a block file scan, at the position they were written to.
+    AutoFile file{blockman.OpenBlockFile({pos.nFile, 0}, /*fReadOnly=*/true)};
+    const auto scanned{node::ScanBlockFile(file, pos.nFile, Params().MessageStart(), *Assert(m_node.shutdown_signal))};
+    BOOST_REQUIRE_EQUAL(scanned.size(), 1U);
+    BOOST_CHECK_EQUAL(scanned[0].hash, block.GetHash());
+    BOOST_CHECK(scanned[0].pos == pos);
+    BOOST_CHECK_LT(scanned[0].size, expected.size());
+
+    // Reindexing it accounts for the compressed record, not the block's
+    // serialization, whether the scan's record size is passed or not.
+    const uint64_t usage{blockman.CalculateCurrentUsage()};
+    blockman.UpdateBlockInfo(block, tip->nHeight, pos);
+    BOOST_CHECK_EQUAL(blockman.CalculateCurrentUsage(), usage);
+    blockman.UpdateBlockInfo(block, tip->nHeight, pos, scanned[0].size);
+    BOOST_CHECK_EQUAL(blockman.CalculateCurrentUsage(), usage);
+}
+
+BOOST_FIXTURE_TEST_CASE(blockmanager_block_read_ahead, TestChain100Setup)
+{
+    auto& chainman{m_node.chainman};
+    const auto& blockman{chainman->m_blockman};
+    std::vector<std::pair<uint256, FlatFilePos>> blocks;
+    {
+        LOCK(::cs_main);
+        for (int height{1}; height <= 20; ++height) {
+            const CBlockIndex& index{*chainman->ActiveChain()[height]};
+            blocks.emplace_back(index.GetBlockHash(), index.GetBlockPos());
+        }
+    }
+
+    std::atomic<int> prepared{0};
+    node::BlockReadAhead read_ahead{blockman, [&](CBlock&) { ++prepared; }, /*depth=*/4};
+    // Nothing scheduled
+    BOOST_CHECK(!read_ahead.Take(blocks[0].first));
+
+    // Only the first depth blocks are read ahead.
+    read_ahead.Schedule(blocks);
+    while (prepared < 4) UninterruptibleSleep(1ms);
+    for (size_t i{0}; i < 4; ++i) {
+        const auto block{read_ahead.Take(blocks[i].first)};
+        BOOST_REQUIRE(block);
+        BOOST_CHECK_EQUAL(block->GetHash(), blocks[i].first);
+    }
+    BOOST_CHECK_EQUAL(prepared, 4);
+
+    // A block that is no longer scheduled is dropped.
+    read_ahead.Schedule(std::span{blocks}.first(2));
+    read_ahead.Schedule(std::span{blocks}.subspan(1, 1));
+    BOOST_CHECK(!read_ahead.Take(blocks[0].first));
+
+    // A block at a bad position is not returned, so that the caller reads it and reports the error.
+    read_ahead.Schedule(std::vector{std::pair{blocks[2].first, blocks[3].second}});
+    BOOST_CHECK(!read_ahead.Take(blocks[2].first));
+}
+
+BOOST_FIXTURE_TEST_CASE(blockmanager_scan_block_files, TestChain100Setup)
+{
+    auto& chainman{*m_node.chainman};
+    std::vector<node::ScannedBlock> expected;
+    {
+        LOCK(::cs_main);
+        for (const CBlockIndex* index{chainman.ActiveChain().Genesis()}; index; index = chainman.ActiveChain().Next(index)) {
+            expected.push_back({.hash = index->GetBlockHash(), .prev_hash = index->pprev ? index->pprev->GetBlockHash() : uint256{}, .pos = index->GetBlockPos()});
+        }
+    }
+    BOOST_REQUIRE(std::ranges::all_of(expected, [](const auto& block) { return block.pos.nFile == 0; }));
+
+    // The second file does not exist, which ends the scan.
+    node::BlockFileScanner scanner{chainman.m_blockman, chainman.GetParams().MessageStart(), /*num_files=*/2, /*threads=*/2, chainman.m_interrupt};
+    const auto blocks{scanner.Next()};
+    BOOST_REQUIRE(blocks);
+    BOOST_REQUIRE_EQUAL(blocks->size(), expected.size());
+    for (size_t i{0}; i < blocks->size(); ++i) {
+        BOOST_CHECK_EQUAL((*blocks)[i].hash, expected[i].hash);
+        BOOST_CHECK_EQUAL((*blocks)[i].prev_hash, expected[i].prev_hash);
+        BOOST_CHECK((*blocks)[i].pos == expected[i].pos);
+        BOOST_CHECK_EQUAL((*blocks)[i].size, chainman.m_blockman.ReadRawBlock(expected[i].pos).value().size());
+    }
+    BOOST_CHECK(!scanner.Next());
+    BOOST_CHECK(!scanner.Next());
+}
+
 BOOST_FIXTURE_TEST_CASE(blockmanager_block_data_part_error, TestChain100Setup)
 {
     LOCK(::cs_main);
@@ -0,0 +1,77 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/blockservecache.h>
+#include <test/util/random.h>
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+using node::BlockServeCache;
+
+BOOST_FIXTURE_TEST_SUITE(blockservecache_tests, BasicTestingSetup)
+
+static BlockServeCache::Payload MakePayload(size_t size)
+{
+    return std::make_shared<const std::vector<std::byte>>(size);
+}
+
+BOOST_AUTO_TEST_CASE(get_add)
+{
+    BlockServeCache cache{1000};
+    const uint256 hash{m_rng.rand256()};
+
+    BOOST_CHECK(!cache.Get(hash, BlockServeCache::Format::WITNESS));
+    const auto payload{MakePayload(100)};
+    cache.Add(hash, BlockServeCache::Format::WITNESS, payload);
+    BOOST_CHECK(cache.Get(hash, BlockServeCache::Format::WITNESS) == payload);
+    // Each format is cached separately.
+    BOOST_CHECK(!cache.Get(hash, BlockServeCache::Format::NO_WITNESS));
+    BOOST_CHECK(!cache.Get(hash, BlockServeCache::Format::COMPACT));
+
+    // Adding a block again keeps the first payload.
+    cache.Add(hash, BlockServeCache::Format::WITNESS, MakePayload(200));
+    BOOST_CHECK(cache.Get(hash, BlockServeCache::Format::WITNESS) == payload);
+
+    const auto stats{cache.GetStats()};
+    BOOST_CHECK_EQUAL(stats.hits, 2U);
+    BOOST_CHECK_EQUAL(stats.misses, 3U);
+    BOOST_CHECK_EQUAL(stats.entries, 1U);
+    BOOST_CHECK_EQUAL(stats.bytes, 100U);
+    BOOST_CHECK_EQUAL(stats.max_bytes, 1000U);
+}
+
+BOOST_AUTO_TEST_CASE(evict_least_recently_served)
+{
+    BlockServeCache cache{1000};
+    std::vector<uint256> hashes;
+    for (int i{0}; i < 4; ++i) {
+        hashes.push_back(m_rng.rand256());
+        cache.Add(hashes.back(), BlockServeCache::Format::WITNESS, MakePayload(250));
+    }
+    BOOST_CHECK_EQUAL(cache.GetStats().bytes, 1000U);
+
+    // Serving the first block makes the second the least recently served.
+    BOOST_CHECK(cache.Get(hashes[0], BlockServeCache::Format::WITNESS));
+    const uint256 new_hash{m_rng.rand256()};
+    cache.Add(new_hash, BlockServeCache::Format::WITNESS, MakePayload(250));
+    BOOST_CHECK(!cache.Get(hashes[1], BlockServeCache::Format::WITNESS));
+    for (const auto& hash : {hashes[0], hashes[2], hashes[3], new_hash}) {
+        BOOST_CHECK(cache.Get(hash, BlockServeCache::Format::WITNESS));
+    }
+
+    // A larger payload evicts as many blocks as it needs to.
+    const uint256 big_hash{m_rng.rand256()};
+    const auto big{MakePayload(600)};
+    cache.Add(big_hash, BlockServeCache::Format::COMPACT, big);
+    BOOST_CHECK(cache.Get(big_hash, BlockServeCache::Format::COMPACT) == big);
+    BOOST_CHECK_EQUAL(cache.GetStats().entries, 2U);
+    BOOST_CHECK_EQUAL(cache.GetStats().bytes, 850U);
+
+    // A payload larger than the cache is not kept, and evicts nothing.
+    cache.Add(m_rng.rand256(), BlockServeCache::Format::WITNESS, MakePayload(1001));
+    BOOST_CHECK_EQUAL(cache.GetStats().entries, 2U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
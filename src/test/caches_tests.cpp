@@ -41,4 +41,35 @@ BOOST_AUTO_TEST_CASE(oversized_dbcache_warning)
     }
 }
 
+BOOST_AUTO_TEST_CASE(adaptive_coins_cache_size)
+{
+    // Plenty available: grow into half of what is left above the reserve (512 MiB here).
+    BOOST_CHECK_EQUAL(*AdaptiveCoinsCacheSize(/*budget=*/400_MiB, /*usage=*/390_MiB, /*available_ram=*/2560_MiB, /*total_ram=*/4000_MiB), 1414_MiB);
+    // Small growth is not worth resizing for.
+    BOOST_CHECK(!AdaptiveCoinsCacheSize(/*budget=*/1000_MiB, /*usage=*/1000_MiB, /*available_ram=*/600_MiB, /*total_ram=*/4000_MiB));
+    // Neither is an unused budget while memory is not short.
+    BOOST_CHECK(!AdaptiveCoinsCacheSize(/*budget=*/2000_MiB, /*usage=*/100_MiB, /*available_ram=*/700_MiB, /*total_ram=*/4000_MiB));
+    // Short of the reserve: shrink, but not below the minimum, and never up.
+    BOOST_CHECK_EQUAL(*AdaptiveCoinsCacheSize(/*budget=*/400_MiB, /*usage=*/100_MiB, /*available_ram=*/100_MiB, /*total_ram=*/2048_MiB), MIN_ADAPTIVE_COINS_CACHE);
+    BOOST_CHECK(!AdaptiveCoinsCacheSize(/*budget=*/MIN_ADAPTIVE_COINS_CACHE, /*usage=*/20_MiB, /*available_ram=*/100_MiB, /*total_ram=*/2048_MiB));
+
+    if constexpr (SIZE_MAX == UINT64_MAX) {
+        // Growth is capped at 3/4 of total memory.
+        BOOST_CHECK_EQUAL(*AdaptiveCoinsCacheSize(/*budget=*/5000_MiB, /*usage=*/5000_MiB, /*available_ram=*/6000_MiB, /*total_ram=*/8192_MiB), 6144_MiB);
+        // Short of the reserve (a tenth of 10 GiB here): shrink below usage by the shortfall.
+        BOOST_CHECK_EQUAL(*AdaptiveCoinsCacheSize(/*budget=*/8000_MiB, /*usage=*/6000_MiB, /*available_ram=*/600_MiB, /*total_ram=*/10240_MiB), 5576_MiB);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(reduce_validation_caches)
+{
+    // Reduced when less than the reserve (512 MiB here) is available.
+    BOOST_CHECK(*ReduceValidationCaches(/*reduced=*/false, /*available_ram=*/500_MiB, /*total_ram=*/4000_MiB));
+    BOOST_CHECK(!ReduceValidationCaches(/*reduced=*/false, /*available_ram=*/600_MiB, /*total_ram=*/4000_MiB));
+    // Restored only once twice the reserve is available.
+    BOOST_CHECK(!ReduceValidationCaches(/*reduced=*/true, /*available_ram=*/600_MiB, /*total_ram=*/4000_MiB));
+    BOOST_CHECK(!*ReduceValidationCaches(/*reduced=*/true, /*available_ram=*/1024_MiB, /*total_ram=*/4000_MiB));
+    BOOST_CHECK(!ReduceValidationCaches(/*reduced=*/true, /*available_ram=*/100_MiB, /*total_ram=*/4000_MiB));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -135,6 +135,40 @@ struct FrozenCleanupCheck {
     }
 };
 
+struct BatchedCheck {
+    struct Batch {
+        bool valid{true};
+        bool Verify() const { return valid; }
+    };
+    static std::atomic<size_t> n_batched;
+    static std::atomic<size_t> n_single;
+    std::optional<int> m_result;
+    BatchedCheck(std::optional<int> result) : m_result(result) {}
+    std::optional<int> operator()(Batch& batch)
+    {
+        n_batched.fetch_add(1, std::memory_order_relaxed);
+        batch.valid &= !m_result.has_value();
+        return std::nullopt;
+    }
+    std::optional<int> operator()()
+    {
+        n_single.fetch_add(1, std::memory_order_relaxed);
+        return m_result;
+    }
+};
+
+struct StealCheck {
+    static std::atomic<size_t> n_done;
+    //! Other checks to wait for, if this is the slow one
+    size_t m_wait_for{0};
+    std::optional<int> operator()() const
+    {
+        while (n_done.load() < m_wait_for) std::this_thread::yield();
+        n_done.fetch_add(1);
+        return std::nullopt;
+    }
+};
+
 // Static Allocations
 std::mutex FrozenCleanupCheck::m{};
 std::atomic<uint64_t> FrozenCleanupCheck::nFrozen{0};
@@ -143,6 +177,9 @@ Mutex UniqueCheck::m;
 std::unordered_multiset<size_t> UniqueCheck::results;
 std::atomic<size_t> FakeCheckCheckCompletion::n_calls{0};
 std::atomic<size_t> MemoryCheck::fake_allocated_memory{0};
+std::atomic<size_t> BatchedCheck::n_batched{0};
+std::atomic<size_t> BatchedCheck::n_single{0};
+std::atomic<size_t> StealCheck::n_done{0};
 
 // Queue Typedefs
 typedef CCheckQueue<FakeCheckCheckCompletion> Correct_Queue;
@@ -151,6 +188,8 @@ typedef CCheckQueue<FixedCheck> Fixed_Queue;
 typedef CCheckQueue<UniqueCheck> Unique_Queue;
 typedef CCheckQueue<MemoryCheck> Memory_Queue;
 typedef CCheckQueue<FrozenCleanupCheck> FrozenCleanup_Queue;
+typedef CCheckQueue<BatchedCheck> Batched_Queue;
+typedef CCheckQueue<StealCheck> Steal_Queue;
 
 
 /** This test case checks that the CCheckQueue works properly
@@ -259,6 +298,53 @@ BOOST_AUTO_TEST_CASE(test_CheckQueue_Recovers_From_Failure)
     }
 }
 
+// Test that batchable checks are verified in batches when enabled, and run
+// one by one to find the failure when a batch fails.
+BOOST_AUTO_TEST_CASE(test_CheckQueue_Batch)
+{
+    for (const bool batch_verify : {false, true}) {
+        auto batched_queue = std::make_unique<Batched_Queue>(QUEUE_BATCH_SIZE, SCRIPT_CHECK_THREADS, "Batched checks", "batchch", batch_verify);
+        for (const bool fails : {false, true}) {
+            BatchedCheck::n_batched = 0;
+            BatchedCheck::n_single = 0;
+            CCheckQueueControl<BatchedCheck> control(*batched_queue);
+            std::vector<BatchedCheck> vChecks(1000, BatchedCheck{std::nullopt});
+            if (fails) vChecks[m_rng.randrange(vChecks.size())] = BatchedCheck{3};
+            control.Add(std::move(vChecks));
+            const auto result{control.Complete()};
+            BOOST_CHECK_EQUAL(result.value_or(0), fails ? 3 : 0);
+            if (!batch_verify) {
+                BOOST_CHECK_EQUAL(BatchedCheck::n_batched, 0U);
+            } else if (!fails) {
+                BOOST_CHECK_EQUAL(BatchedCheck::n_batched, 1000U);
+                BOOST_CHECK_EQUAL(BatchedCheck::n_single, 0U);
+            } else {
+                // Only the checks in the failed batch are run again.
+                BOOST_CHECK_GT(BatchedCheck::n_single, 0U);
+                BOOST_CHECK_LE(BatchedCheck::n_single, QUEUE_BATCH_SIZE);
+            }
+        }
+    }
+}
+
+// Test that a thread stuck on a slow check does not hold up the checks queued
+// behind it: the other threads steal them. A thread takes at most half of its
+// queued checks at once, so all but those can complete while it is stuck.
+BOOST_AUTO_TEST_CASE(test_CheckQueue_Steals)
+{
+    auto queue = std::make_unique<Steal_Queue>(QUEUE_BATCH_SIZE, SCRIPT_CHECK_THREADS);
+    const size_t n_checks{size_t{SCRIPT_CHECK_THREADS + 1} * QUEUE_BATCH_SIZE};
+    for (int i = 0; i < 10; ++i) {
+        StealCheck::n_done = 0;
+        CCheckQueueControl<StealCheck> control(*queue);
+        std::vector<StealCheck> vChecks(n_checks);
+        vChecks[m_rng.randrange(n_checks)].m_wait_for = n_checks - QUEUE_BATCH_SIZE / 2;
+        control.Add(std::move(vChecks));
+        BOOST_REQUIRE(!control.Complete().has_value());
+        BOOST_REQUIRE_EQUAL(StealCheck::n_done, n_checks);
+    }
+}
+
 // Test that unique checks are actually all called individually, rather than
 // just one check being called repeatedly. Test that checks are not called
 // more than once as well
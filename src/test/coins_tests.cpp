@@ -1121,4 +1121,167 @@ BOOST_AUTO_TEST_CASE(ccoins_emplace_duplicate_keeps_usage_balanced)
     BOOST_CHECK(cache.AccessCoin(outpoint) == coin1);
 }
 
+
+BOOST_AUTO_TEST_CASE(ccoins_add_fetched_coin)
+{
+    CCoinsView root;
+    CCoinsViewCacheTest cache{&root};
+
+    const COutPoint outpoint{Txid::FromUint256(m_rng.rand256()), m_rng.rand32()};
+    const Coin coin1{CTxOut{m_rng.randrange(10), CScript{} << m_rng.randbytes(CScriptBase::STATIC_SIZE + 1)}, 1, false};
+    cache.AddFetchedCoin(outpoint, Coin{coin1});
+    cache.SelfTest();
+    BOOST_CHECK(cache.AccessCoin(outpoint) == coin1);
+    // A fetched coin is as read from the base, so there is nothing to write back.
+    BOOST_CHECK(!cache.map().at(outpoint).IsDirty());
+    BOOST_CHECK(!cache.map().at(outpoint).IsFresh());
+
+    // A coin spent in the cache is not brought back by a stale read of the base.
+    BOOST_CHECK(cache.SpendCoin(outpoint));
+    cache.AddFetchedCoin(outpoint, Coin{coin1});
+    cache.SelfTest();
+    BOOST_CHECK(!cache.HaveCoinInCache(outpoint));
+    BOOST_CHECK(cache.map().at(outpoint).IsDirty());
+}
+
+BOOST_AUTO_TEST_CASE(ccoins_db_get_coins)
+{
+    CCoinsViewDB db{{.path = "test", .cache_bytes = 1 << 23, .memory_only = true}, {}};
+    CCoinsViewCacheTest cache{&db};
+
+    std::vector<COutPoint> outpoints;
+    std::vector<Coin> expected;
+    for (uint32_t i{0}; i < 50; ++i) {
+        outpoints.emplace_back(Txid::FromUint256(m_rng.rand256()), i);
+        expected.emplace_back(CTxOut{m_rng.randrange(MAX_MONEY), CScript{} << m_rng.randbytes(20)}, i, i % 2 == 0);
+        // Leave out every fifth coin.
+        if (i % 5 != 0) cache.AddCoin(outpoints.back(), Coin{expected.back()}, /*possible_overwrite=*/false);
+    }
+    cache.SetBestBlock(m_rng.rand256());
+    BOOST_CHECK(cache.Flush());
+
+    // Coins read together are the same as read one by one.
+    std::vector<std::optional<Coin>> coins(outpoints.size());
+    db.GetCoins(outpoints, coins);
+    for (size_t i{0}; i < outpoints.size(); ++i) {
+        BOOST_CHECK_EQUAL(coins[i].has_value(), db.GetCoin(outpoints[i]).has_value());
+        BOOST_CHECK_EQUAL(coins[i].has_value(), i % 5 != 0);
+        if (coins[i]) BOOST_CHECK(*coins[i] == expected[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ccoins_background_write)
+{
+    CCoinsViewDB db{{.path = "test", .cache_bytes = 1 << 23, .memory_only = true}, {}};
+    CCoinsViewBackgroundWriter writer{&db, /*background=*/true};
+    CCoinsViewCacheTest cache{&writer};
+
+    const COutPoint outpoint1{Txid::FromUint256(m_rng.rand256()), 0};
+    const COutPoint outpoint2{Txid::FromUint256(m_rng.rand256()), 1};
+    const Coin coin1{CTxOut{m_rng.randrange(10), CScript{} << m_rng.randbytes(CScriptBase::STATIC_SIZE + 1)}, 1, false};
+    const Coin coin2{CTxOut{m_rng.randrange(10), CScript{} << m_rng.randbytes(CScriptBase::STATIC_SIZE + 1)}, 2, false};
+
+    // An erasing flush hands the coins over and leaves the cache empty, whether
+    // or not the database has them yet.
+    const uint256 block1{m_rng.rand256()};
+    cache.AddCoin(outpoint1, Coin{coin1}, /*possible_overwrite=*/false);
+    cache.SetBestBlock(block1);
+    writer.DeferNextWrite();
+    BOOST_CHECK(cache.Flush());
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), 0U);
+    BOOST_CHECK(*Assert(writer.GetCoin(outpoint1)) == coin1);
+    BOOST_CHECK_EQUAL(writer.GetBestBlock(), block1);
+    BOOST_CHECK(writer.Wait());
+    BOOST_CHECK(*Assert(db.GetCoin(outpoint1)) == coin1);
+    BOOST_CHECK_EQUAL(db.GetBestBlock(), block1);
+
+    // A spend written in the background hides the coin at once.
+    const uint256 block2{m_rng.rand256()};
+    BOOST_CHECK(cache.SpendCoin(outpoint1));
+    cache.AddCoin(outpoint2, Coin{coin2}, /*possible_overwrite=*/false);
+    cache.SetBestBlock(block2);
+    writer.DeferNextWrite();
+    BOOST_CHECK(cache.Sync());
+    BOOST_CHECK(!writer.HaveCoin(outpoint1));
+    BOOST_CHECK(!writer.GetCoin(outpoint1));
+    BOOST_CHECK(writer.HaveCoin(outpoint2));
+    {
+        const COutPoint missing{Txid::FromUint256(m_rng.rand256()), 2};
+        const std::vector<COutPoint> outpoints{outpoint2, missing, outpoint1};
+        std::vector<std::optional<Coin>> coins(outpoints.size(), coin1);
+        writer.GetCoins(outpoints, coins);
+        BOOST_CHECK(coins[0] && *coins[0] == coin2);
+        BOOST_CHECK(!coins[1]);
+        BOOST_CHECK(!coins[2]);
+    }
+    BOOST_CHECK_EQUAL(writer.GetBestBlock(), block2);
+    // Synced coins stay in the cache, clean.
+    BOOST_CHECK(cache.HaveCoinInCache(outpoint2));
+    BOOST_CHECK(!cache.map().at(outpoint2).IsDirty());
+
+    // A write that is not deferred waits for the one in progress and is done on return.
+    const uint256 block3{m_rng.rand256()};
+    BOOST_CHECK(cache.SpendCoin(outpoint2));
+    cache.SetBestBlock(block3);
+    BOOST_CHECK(cache.Flush());
+    BOOST_CHECK(!db.HaveCoin(outpoint1));
+    BOOST_CHECK(!db.HaveCoin(outpoint2));
+    BOOST_CHECK_EQUAL(db.GetBestBlock(), block3);
+    BOOST_CHECK(!writer.Failed());
+}
+
+BOOST_AUTO_TEST_CASE(ccoins_evict_clean)
+{
+    CCoinsView root;
+    CCoinsViewCacheTest base{&root};
+    CCoinsViewCacheTest cache{&base};
+
+    constexpr size_t NUM_COINS{200};
+    std::vector<COutPoint> outpoints;
+    for (size_t i{0}; i < NUM_COINS; ++i) {
+        outpoints.emplace_back(Txid::FromUint256(m_rng.rand256()), i);
+        base.AddCoin(outpoints.back(), Coin{CTxOut{m_rng.randrange(10), CScript{} << m_rng.randbytes(CScriptBase::STATIC_SIZE + 1)}, 1, false}, /*possible_overwrite=*/false);
+    }
+    const auto fetch_all{[&] {
+        for (const auto& outpoint : outpoints) BOOST_CHECK(cache.HaveCoin(outpoint));
+    }};
+
+    // Modified entries are never evicted, the others all go if need be.
+    const COutPoint added{Txid::FromUint256(m_rng.rand256()), 0};
+    cache.AddCoin(added, Coin{CTxOut{1, CScript{} << OP_TRUE}, 1, false}, /*possible_overwrite=*/false);
+    fetch_all();
+    BOOST_CHECK(cache.SpendCoin(outpoints[0]));
+    const size_t usage_before{cache.InUseMemoryUsage()};
+    BOOST_CHECK_EQUAL(cache.EvictClean(0), NUM_COINS - 1);
+    cache.SelfTest();
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), 2U);
+    BOOST_CHECK(cache.HaveCoinInCache(added));
+    BOOST_CHECK(cache.map().at(outpoints[0]).IsDirty());
+    BOOST_CHECK_LT(cache.InUseMemoryUsage(), usage_before);
+    // The freed memory is kept for new entries.
+    BOOST_CHECK_GT(cache.DynamicMemoryUsage(), cache.InUseMemoryUsage());
+
+    // Evicting one entry at a time, the coins used since the hand last passed
+    // go after all the others.
+    outpoints.erase(outpoints.begin());
+    fetch_all();
+    BOOST_CHECK_EQUAL(cache.EvictClean(cache.InUseMemoryUsage() - 1), 1U);
+    std::vector<COutPoint> used, unused;
+    for (const auto& outpoint : outpoints) {
+        if (!cache.HaveCoinInCache(outpoint)) continue;
+        if (used.size() < unused.size()) {
+            BOOST_CHECK(cache.HaveCoin(outpoint));
+            used.push_back(outpoint);
+        } else {
+            unused.push_back(outpoint);
+        }
+    }
+    for (size_t i{0}; i < unused.size(); ++i) {
+        BOOST_CHECK_EQUAL(cache.EvictClean(cache.InUseMemoryUsage() - 1), 1U);
+    }
+    cache.SelfTest();
+    for (const auto& outpoint : used) BOOST_CHECK(cache.HaveCoinInCache(outpoint));
+    for (const auto& outpoint : unused) BOOST_CHECK(!cache.HaveCoinInCache(outpoint));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
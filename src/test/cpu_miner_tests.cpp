@@ -0,0 +1,128 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <arith_uint256.h>
+#include <node/cpu_miner.h>
+#include <primitives/block.h>
+#include <test/util/random.h>
+#include <test/util/setup_common.h>
+#include <util/signalinterrupt.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+
+using node::HeaderHasher;
+using node::MAX_GENERATE_THREADS;
+using node::MINER_INLINE_NONCES;
+using node::MinerThreadPool;
+using node::ScanHeaderNonces;
+
+BOOST_FIXTURE_TEST_SUITE(cpu_miner_tests, BasicTestingSetup)
+
+static CBlockHeader RandomHeader(FastRandomContext& rng)
+{
+    CBlockHeader header;
+    header.nVersion = rng.rand32();
+    header.hashPrevBlock = rng.rand256();
+    header.hashMerkleRoot = rng.rand256();
+    header.nTime = rng.rand32();
+    header.nBits = rng.rand32();
+    header.nNonce = 0;
+    return header;
+}
+
+BOOST_AUTO_TEST_CASE(header_hasher)
+{
+    for (int i = 0; i < 100; ++i) {
+        CBlockHeader header{RandomHeader(m_rng)};
+        HeaderHasher hasher{header};
+        header.nNonce = m_rng.rand32();
+        BOOST_CHECK_EQUAL(hasher.GetHash(header.nNonce), header.GetHash());
+
+        // Changing the time does not require a new midstate.
+        header.nTime = m_rng.rand32();
+        hasher.SetTime(header.nTime);
+        BOOST_CHECK_EQUAL(hasher.GetHash(header.nNonce), header.GetHash());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(scan_nonces)
+{
+    // Roughly one in 256 hashes meets this target.
+    const arith_uint256 target{~arith_uint256{} >> 8};
+    for (int i = 0; i < 20; ++i) {
+        CBlockHeader header{RandomHeader(m_rng)};
+        const HeaderHasher hasher{header};
+        const uint32_t first{m_rng.rand32()};
+        const uint32_t count{1 + m_rng.randrange<uint32_t>(2000)};
+
+        std::optional<uint32_t> expected;
+        for (uint32_t n = first; n != first + count; ++n) {
+            header.nNonce = n;
+            if (UintToArith256(header.GetHash()) <= target) {
+                expected = n;
+                break;
+            }
+        }
+        BOOST_CHECK(hasher.ScanNonces(target, first, count) == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(scan_header_nonces)
+{
+    util::SignalInterrupt interrupt;
+    uint64_t hashes_done{0};
+    // The same threads scan all the headers below.
+    MinerThreadPool pool{/*threads=*/3};
+
+    // A target that needs the worker threads most of the time.
+    const arith_uint256 target{~arith_uint256{} >> 18};
+    CBlockHeader header{RandomHeader(m_rng)};
+    const auto nonce{ScanHeaderNonces(header, target, uint64_t{1} << 32, pool, interrupt, hashes_done)};
+    BOOST_REQUIRE(nonce);
+    BOOST_CHECK_GE(hashes_done, 1U);
+    header.nNonce = *nonce;
+    BOOST_CHECK(UintToArith256(header.GetHash()) <= target);
+
+    // An impossible target exhausts the range, across the inline scan and
+    // uneven worker slices, without running past its end.
+    header = RandomHeader(m_rng);
+    header.nNonce = 1000;
+    const uint64_t count{MINER_INLINE_NONCES + 5003};
+    BOOST_CHECK(!ScanHeaderNonces(header, arith_uint256{0}, count, pool, interrupt, hashes_done));
+    BOOST_CHECK_EQUAL(hashes_done, count);
+
+    // Nothing is hashed once interrupted.
+    BOOST_REQUIRE(interrupt());
+    BOOST_CHECK(!ScanHeaderNonces(header, target, count, pool, interrupt, hashes_done));
+    BOOST_CHECK_EQUAL(hashes_done, 0U);
+}
+
+BOOST_AUTO_TEST_CASE(mining_threads)
+{
+    BOOST_CHECK_EQUAL(*node::GetMiningThreads(1), 1);
+    BOOST_CHECK_EQUAL(*node::GetMiningThreads(MAX_GENERATE_THREADS), MAX_GENERATE_THREADS);
+    BOOST_CHECK(!node::GetMiningThreads(MAX_GENERATE_THREADS + 1));
+    BOOST_CHECK(!node::GetMiningThreads(std::numeric_limits<int64_t>::max()));
+    // All cores, within the limit
+    for (const int64_t requested : {int64_t{-1}, int64_t{0}}) {
+        const auto threads{node::GetMiningThreads(requested)};
+        BOOST_REQUIRE(threads);
+        BOOST_CHECK_GE(*threads, 1);
+        BOOST_CHECK_LE(*threads, MAX_GENERATE_THREADS);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hash_rate_meter)
+{
+    node::HashRateMeter meter;
+    BOOST_CHECK_EQUAL(meter.GetHashesPerSecond(), 0);
+    meter.AddHashes(1000);
+    meter.AddHashes(500);
+    BOOST_CHECK_EQUAL(meter.GetTotalHashes(), 1500U);
+    BOOST_CHECK_GE(meter.GetHashesPerSecond(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
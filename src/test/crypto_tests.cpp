@@ -1086,6 +1086,28 @@ BOOST_AUTO_TEST_CASE(sha256d64)
     }
 }
 
+BOOST_AUTO_TEST_CASE(sha256d80midstate)
+{
+    for (int i = 0; i <= 32; ++i) {
+        unsigned char prefix[64];
+        unsigned char in[16 * 32];
+        unsigned char out1[32 * 32], out2[32 * 32];
+        for (int j = 0; j < 64; ++j) {
+            prefix[j] = m_rng.randbits(8);
+        }
+        for (int j = 0; j < 16 * i; ++j) {
+            in[j] = m_rng.randbits(8);
+        }
+        for (int j = 0; j < i; ++j) {
+            CHash256().Write(prefix).Write({in + 16 * j, 16}).Finalize({out1 + 32 * j, 32});
+        }
+        uint32_t midstate[8];
+        SHA256Midstate(midstate, prefix);
+        SHA256D80Midstate(out2, midstate, in, i);
+        BOOST_CHECK(memcmp(out1, out2, 32 * i) == 0);
+    }
+}
+
 void CryptoTest::TestSHA3_256(const std::string& input, const std::string& output)
 {
     const auto in_bytes = ParseHex(input);
@@ -379,4 +379,72 @@ BOOST_FIXTURE_TEST_CASE(cuckoocache_generations, GenerationsTest)
     test_cache_generations<CuckooCache::cache<uint256, SignatureCacheHasher>>();
 }
 
+/* Test that pinned elements outlive several generations of inserts, until
+ * they are looked up with erase set, while unpinned ones age out.
+ */
+BOOST_AUTO_TEST_CASE(cuckoocache_pin)
+{
+    SeedRandomForTest(SeedRand::ZEROS);
+    for (const bool pin : {false, true}) {
+        CuckooCache::cache<uint256, SignatureCacheHasher> cc{};
+        const uint32_t size{cc.setup(1 << 12)};
+        std::vector<uint256> pinned(200);
+        for (auto& hash : pinned) {
+            hash = m_rng.rand256();
+            BOOST_CHECK(cc.insert(hash, pin));
+        }
+        const auto churn{[&] {
+            for (uint32_t i = 0; i < 4 * size; ++i) cc.insert(m_rng.rand256());
+        }};
+        churn();
+        size_t kept{0};
+        for (const auto& hash : pinned) kept += cc.contains(hash, /*erase=*/false);
+        if (!pin) {
+            BOOST_CHECK_LT(kept, pinned.size() / 10);
+            continue;
+        }
+        // Only elements dropped by an insert running out of depth are lost.
+        BOOST_CHECK_GT(kept, pinned.size() * 9 / 10);
+
+        // Looking them up with erase set unpins them.
+        for (const auto& hash : pinned) cc.contains(hash, /*erase=*/true);
+        churn();
+        kept = 0;
+        for (const auto& hash : pinned) kept += cc.contains(hash, /*erase=*/false);
+        BOOST_CHECK_LT(kept, pinned.size() / 10);
+
+        // Pinned elements that are never looked up with erase set expire
+        // after MAX_PINNED_EPOCHS epochs of about size / 2 inserts each.
+        for (const auto& hash : pinned) cc.insert(hash, /*pin=*/true);
+        for (int i = 0; i < 3; ++i) churn();
+        kept = 0;
+        for (const auto& hash : pinned) kept += cc.contains(hash, /*erase=*/false);
+        BOOST_CHECK_LT(kept, pinned.size() / 10);
+    }
+}
+
+/* Test that setup can be called again to resize a cache, dropping its
+ * elements.
+ */
+BOOST_AUTO_TEST_CASE(cuckoocache_resize)
+{
+    SeedRandomForTest(SeedRand::ZEROS);
+    CuckooCache::cache<uint256, SignatureCacheHasher> cc{};
+    std::vector<uint256> hashes(100);
+    for (auto& hash : hashes) hash = m_rng.rand256();
+    cc.setup(1 << 12);
+    for (const auto& hash : hashes) cc.insert(hash);
+    for (const uint32_t new_size : {1u << 8, 1u << 14}) {
+        BOOST_CHECK_EQUAL(cc.setup(new_size), new_size);
+        for (const auto& hash : hashes) BOOST_CHECK(!cc.contains(hash, /*erase=*/false));
+        for (auto& hash : hashes) {
+            hash = m_rng.rand256();
+            cc.insert(hash);
+        }
+        size_t kept{0};
+        for (const auto& hash : hashes) kept += cc.contains(hash, /*erase=*/false);
+        BOOST_CHECK_GT(kept, hashes.size() * 9 / 10);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -185,6 +185,43 @@ BOOST_AUTO_TEST_CASE(dbwrapper_batch)
     }
 }
 
+BOOST_AUTO_TEST_CASE(dbwrapper_multiread)
+{
+    // Perform tests both obfuscated and non-obfuscated.
+    for (const bool obfuscate : {false, true}) {
+        CDBWrapper dbw({.path = "multiread", .cache_bytes = 1 << 20, .memory_only = true, .obfuscate = obfuscate});
+
+        std::vector<uint256> values;
+        CDBBatch batch(dbw);
+        for (uint8_t key{0}; key < 100; ++key) {
+            values.push_back(m_rng.rand256());
+            // Leave out every third key.
+            if (key % 3 != 0) batch.Write(key, values.back());
+        }
+        // A value that does not deserialize as a uint256
+        batch.Write(uint8_t{200}, uint8_t{1});
+        dbw.WriteBatch(batch);
+
+        // Keys are looked up in sorted order, but results come in the order of the keys.
+        std::vector<uint8_t> keys;
+        for (uint8_t key{0}; key < 100; ++key) keys.push_back(key);
+        std::shuffle(keys.begin(), keys.end(), m_rng);
+        keys.push_back(200);
+        keys.push_back(keys.front());
+        const auto results{dbw.MultiRead<uint256>(keys)};
+        BOOST_REQUIRE_EQUAL(results.size(), keys.size());
+        for (size_t i{0}; i < keys.size(); ++i) {
+            if (keys[i] % 3 == 0 || keys[i] == 200) {
+                BOOST_CHECK(!results[i]);
+            } else {
+                BOOST_REQUIRE(results[i]);
+                BOOST_CHECK_EQUAL(*results[i], values[keys[i]]);
+            }
+        }
+        BOOST_CHECK(dbw.MultiRead<uint256>(std::vector<uint8_t>{}).empty());
+    }
+}
+
 BOOST_AUTO_TEST_CASE(dbwrapper_iterator)
 {
     // Perform tests both obfuscated and non-obfuscated.
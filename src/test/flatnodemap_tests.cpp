@@ -0,0 +1,107 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <coins.h>
+#include <memusage.h>
+#include <primitives/transaction.h>
+#include <support/allocators/pool.h>
+#include <test/util/random.h>
+#include <test/util/setup_common.h>
+#include <util/flatnodemap.h>
+#include <util/hasher.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+BOOST_FIXTURE_TEST_SUITE(flatnodemap_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(random_operations)
+{
+    FlatNodeMap<uint32_t, uint64_t> map;
+    std::unordered_map<uint32_t, uint64_t> expected;
+    // Keys from a small range, so that inserts, erases and lookups of the same keys mix.
+    for (int i{0}; i < 100'000; ++i) {
+        const uint32_t key{uint32_t(m_rng.randrange(2000))};
+        switch (m_rng.randrange(4)) {
+        case 0: {
+            const uint64_t value{m_rng.rand64()};
+            const bool inserted{map.try_emplace(key, value).second};
+            BOOST_CHECK_EQUAL(inserted, expected.try_emplace(key, value).second);
+            break;
+        }
+        case 1:
+            BOOST_CHECK_EQUAL(map.erase(key), expected.erase(key));
+            break;
+        case 2: {
+            const auto it{map.find(key)};
+            const auto expected_it{expected.find(key)};
+            BOOST_REQUIRE_EQUAL(it == map.end(), expected_it == expected.end());
+            if (it != map.end()) BOOST_CHECK_EQUAL(it->second, expected_it->second);
+            break;
+        }
+        case 3:
+            if (auto it{map.find(key)}; it != map.end()) {
+                const auto next{map.erase(it)};
+                BOOST_CHECK(next == map.end() || next->first != key);
+                expected.erase(key);
+            }
+            break;
+        }
+        BOOST_REQUIRE_EQUAL(map.size(), expected.size());
+    }
+
+    size_t count{0};
+    for (const auto& [key, value] : map) {
+        BOOST_CHECK_EQUAL(expected.at(key), value);
+        ++count;
+    }
+    BOOST_CHECK_EQUAL(count, expected.size());
+
+    map.clear();
+    BOOST_CHECK(map.empty());
+    BOOST_CHECK(map.begin() == map.end());
+}
+
+BOOST_AUTO_TEST_CASE(stable_references)
+{
+    FlatNodeMap<uint32_t, uint64_t> map;
+    std::vector<const uint64_t*> values;
+    for (uint32_t key{0}; key < 1000; ++key) {
+        values.push_back(&map.try_emplace(key, key * 3).first->second);
+    }
+    // Growing the index and erasing other elements does not move the nodes.
+    for (uint32_t key{1000}; key < 10000; ++key) map.emplace(key, 0);
+    for (uint32_t key{1000}; key < 10000; key += 2) map.erase(key);
+    for (uint32_t key{0}; key < 1000; ++key) {
+        BOOST_CHECK_EQUAL(&map.at(key), values[key]);
+        BOOST_CHECK_EQUAL(*values[key], key * 3);
+    }
+    BOOST_CHECK_THROW(map.at(1000), std::out_of_range);
+    BOOST_CHECK(!map.emplace(0, 1).second);
+    BOOST_CHECK_EQUAL(map.at(0), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(coins_map_memory)
+{
+    using UnorderedCoinsMap = std::unordered_map<COutPoint, CCoinsCacheEntry, SaltedOutpointHasher, std::equal_to<COutPoint>,
+                                                 PoolAllocator<CoinsCachePair, sizeof(CoinsCachePair) + sizeof(void*) * 4>>;
+    UnorderedCoinsMap::allocator_type::ResourceType unordered_resource;
+    UnorderedCoinsMap unordered{0, SaltedOutpointHasher{}, std::equal_to<COutPoint>{}, &unordered_resource};
+    CCoinsMapMemoryResource flat_resource;
+    CCoinsMap flat{0, SaltedOutpointHasher{}, std::equal_to<COutPoint>{}, &flat_resource};
+
+    for (int i{0}; i < 100'000; ++i) {
+        const COutPoint outpoint{Txid::FromUint256(m_rng.rand256()), uint32_t(m_rng.randrange(4))};
+        unordered.try_emplace(outpoint);
+        flat.try_emplace(outpoint);
+    }
+    // Without a chain pointer per node, the same coins take less memory.
+    BOOST_CHECK_LT(memusage::DynamicUsage(flat), memusage::DynamicUsage(unordered));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -85,6 +85,7 @@ const std::vector<std::string> RPC_COMMANDS_NOT_SAFE_FOR_FUZZING{
     "loadwallet",   // avoid reading from disk
     "savemempool",           // disabled as a precautionary measure: may take a file path argument in the future
     "setban",                // avoid DNS lookups
+    "setgenerate",           // avoid starting background mining threads
     "stop",                  // avoid shutdown state
 };
 
@@ -131,6 +132,7 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "getdescriptoractivity",
     "getdescriptorinfo",
     "getdifficulty",
+    "getgenerate",
     "getindexinfo",
     "getmemoryinfo",
     "getmempoolancestors",
@@ -140,11 +142,13 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "getmempoolcluster",
     "getmempoolinfo",
     "getmininginfo",
+    "getminingmetrics",
     "getnettotals",
     "getnetworkhashps",
     "getnetworkinfo",
     "getnodeaddresses",
     "getorphantxs",
+    "getsignaturecacheinfo",
     "getpeerinfo",
     "getprioritisedtransactions",
     "getrawaddrman",
@@ -15,7 +15,9 @@
 #include <util/strencodings.h>
 #include <util/string.h>
 
+#include <array>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
@@ -334,6 +336,42 @@ BOOST_AUTO_TEST_CASE(bip340_test_vectors)
     }
 }
 
+BOOST_AUTO_TEST_CASE(schnorr_batch)
+{
+    SchnorrBatch batch;
+    BOOST_CHECK(batch.Verify());
+
+    std::vector<std::tuple<XOnlyPubKey, uint256, std::array<unsigned char, 64>>> sigs;
+    for (int i = 0; i < 100; ++i) {
+        const CKey key{GenerateRandomKey()};
+        const uint256 msg{m_rng.rand256()};
+        std::array<unsigned char, 64> sig;
+        BOOST_REQUIRE(key.SignSchnorr(msg, sig, nullptr, m_rng.rand256()));
+        sigs.emplace_back(XOnlyPubKey{key.GetPubKey()}, msg, sig);
+        batch.Add(sig, XOnlyPubKey{key.GetPubKey()}, msg);
+    }
+    BOOST_CHECK_EQUAL(batch.size(), 100U);
+    BOOST_CHECK(batch.Verify());
+
+    // Any one bad signature fails the batch.
+    for (int i = 0; i < 10; ++i) {
+        const size_t bad{m_rng.randrange(sigs.size())};
+        batch.clear();
+        for (size_t j{0}; j < sigs.size(); ++j) {
+            auto [pubkey, msg, sig]{sigs[j]};
+            if (j == bad) sig[m_rng.randrange(sig.size())] ^= 1 + m_rng.randrange(255);
+            batch.Add(sig, pubkey, msg);
+        }
+        BOOST_CHECK(!batch.Verify());
+    }
+
+    // So does a public key that is not on the curve.
+    batch.clear();
+    const auto& [pubkey, msg, sig]{sigs[0]};
+    batch.Add(sig, XOnlyPubKey{ParseHex("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC30")}, msg);
+    BOOST_CHECK(!batch.Verify());
+}
+
 BOOST_AUTO_TEST_CASE(key_ellswift)
 {
     for (const auto& secret : {strSecret1, strSecret2, strSecret1C, strSecret2C}) {
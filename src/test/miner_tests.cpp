@@ -864,4 +864,56 @@ BOOST_AUTO_TEST_CASE(CreateNewBlock_validity)
     TestPrioritisedMining(scriptPubKey, txFirst);
 }
 
+BOOST_FIXTURE_TEST_CASE(unchanged_mempool_selection_cache, TestChain100Setup)
+{
+    CTxMemPool& mempool{*Assert(m_node.mempool)};
+    BlockAssembler::Options options;
+    options.coinbase_output_script = CScript() << OP_TRUE;
+    const auto create_block{[&] { return BlockAssembler{m_node.chainman->ActiveChainstate(), &mempool, options}.CreateNewBlock(); }};
+    const CScript script{GetScriptForRawPubKey(coinbaseKey.GetPubKey())};
+    // Make the coinbase of block 2 mature as well.
+    CreateAndProcessBlock({}, script);
+
+    const CTransaction tx1{CreateValidMempoolTransaction(m_coinbase_txns[0], 0, 0, coinbaseKey, script)};
+    const auto first{create_block()};
+    BOOST_REQUIRE_EQUAL(first->block.vtx.size(), 2U);
+
+    // An unchanged mempool gives the same selection
+    const auto second{create_block()};
+    BOOST_REQUIRE_EQUAL(second->block.vtx.size(), 2U);
+    BOOST_CHECK(second->block.vtx[1]->GetHash() == tx1.GetHash());
+    BOOST_CHECK(second->vTxFees == first->vTxFees);
+    BOOST_CHECK(second->vTxSigOpsCost == first->vTxSigOpsCost);
+    BOOST_CHECK(second->m_package_feerates == first->m_package_feerates);
+    BOOST_CHECK_EQUAL(GetBlockWeight(second->block), GetBlockWeight(first->block));
+
+    // Adding a transaction invalidates it
+    const CTransaction tx2{CreateValidMempoolTransaction(m_coinbase_txns[1], 0, 0, coinbaseKey, script)};
+    auto block_template{create_block()};
+    BOOST_REQUIRE_EQUAL(block_template->block.vtx.size(), 3U);
+    BOOST_CHECK_EQUAL(block_template->m_package_feerates.size(), 2U);
+
+    // So does prioritising one
+    mempool.PrioritiseTransaction(tx2.GetHash(), COIN);
+    block_template = create_block();
+    BOOST_REQUIRE_EQUAL(block_template->block.vtx.size(), 3U);
+    BOOST_CHECK(block_template->block.vtx[1]->GetHash() == tx2.GetHash());
+
+    // Different block limits are not served from the cache
+    options.blockMinFeeRate = CFeeRate{MAX_MONEY};
+    BOOST_CHECK_EQUAL(create_block()->block.vtx.size(), 1U);
+    options.blockMinFeeRate = CFeeRate{DEFAULT_BLOCK_MIN_TX_FEE};
+    BOOST_CHECK_EQUAL(create_block()->block.vtx.size(), 3U);
+
+    // Nor is a removed transaction
+    WITH_LOCK(mempool.cs, mempool.removeRecursive(tx2, MemPoolRemovalReason::REPLACED));
+    block_template = create_block();
+    BOOST_REQUIRE_EQUAL(block_template->block.vtx.size(), 2U);
+    BOOST_CHECK(block_template->block.vtx[1]->GetHash() == tx1.GetHash());
+
+    // Nor is a template for a new tip, which confirmed tx1
+    CreateAndProcessBlock({CMutableTransaction{tx1}}, script);
+    BOOST_CHECK_EQUAL(create_block()->block.vtx.size(), 1U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,185 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <arith_uint256.h>
+#include <consensus/merkle.h>
+#include <crypto/sha256.h>
+#include <hash.h>
+#include <node/mining_job.h>
+#include <primitives/block.h>
+#include <primitives/transaction.h>
+#include <script/script.h>
+#include <streams.h>
+#include <test/util/random.h>
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+using node::EXTRANONCE_SIZE;
+using node::MAX_MINING_JOBS;
+using node::MAX_RETIRED_MINING_JOBS;
+using node::MiningJob;
+using node::MiningJobList;
+
+BOOST_FIXTURE_TEST_SUITE(mining_job_tests, BasicTestingSetup)
+
+static CBlock RandomBlock(FastRandomContext& rng, size_t num_txs)
+{
+    CBlock block;
+    block.nVersion = rng.rand32();
+    block.hashPrevBlock = rng.rand256();
+    block.nTime = rng.rand32();
+    block.nBits = rng.rand32();
+
+    CMutableTransaction coinbase;
+    coinbase.vin.resize(1);
+    coinbase.vin[0].prevout.SetNull();
+    coinbase.vin[0].scriptSig = CScript() << rng.randrange(1000000) << OP_0;
+    coinbase.vout.resize(1);
+    coinbase.vout[0].nValue = rng.randrange(50 * COIN);
+    coinbase.vout[0].scriptPubKey = CScript() << OP_TRUE;
+    block.vtx.push_back(MakeTransactionRef(std::move(coinbase)));
+
+    for (size_t i = 1; i < num_txs; ++i) {
+        CMutableTransaction tx;
+        tx.vin.resize(1);
+        tx.vin[0].prevout = COutPoint{Txid::FromUint256(rng.rand256()), 0};
+        tx.vout.resize(1);
+        tx.vout[0].nValue = i;
+        block.vtx.push_back(MakeTransactionRef(std::move(tx)));
+    }
+    return block;
+}
+
+BOOST_AUTO_TEST_CASE(extranonce_rolling)
+{
+    for (size_t num_txs : {1, 2, 3, 7, 16, 33}) {
+        const CBlock block{RandomBlock(m_rng, num_txs)};
+        const MiningJob job{block};
+        BOOST_CHECK_EQUAL(job.GetMerklePath().size(), TransactionMerklePath(block, 0).size());
+
+        for (int i = 0; i < 4; ++i) {
+            const uint64_t extra_nonce{m_rng.rand64()};
+            const uint32_t time{m_rng.rand32()};
+            const uint32_t nonce{m_rng.rand32()};
+            const CBlock solved{job.GetBlock(extra_nonce, time, nonce)};
+
+            // The rolled coinbase is the original one with the extranonce pushed.
+            BOOST_REQUIRE_EQUAL(solved.vtx.size(), block.vtx.size());
+            const CScript& script_sig{solved.vtx[0]->vin[0].scriptSig};
+            BOOST_CHECK_EQUAL(script_sig.size(), block.vtx[0]->vin[0].scriptSig.size() + 1 + EXTRANONCE_SIZE);
+            BOOST_CHECK(std::equal(block.vtx[0]->vin[0].scriptSig.begin(), block.vtx[0]->vin[0].scriptSig.end(), script_sig.begin()));
+
+            // The prefix and suffix around the extranonce serialize the coinbase.
+            std::vector<unsigned char> coinbase{job.GetCoinbasePrefix()};
+            coinbase.insert(coinbase.end(), script_sig.end() - EXTRANONCE_SIZE, script_sig.end());
+            coinbase.insert(coinbase.end(), job.GetCoinbaseSuffix().begin(), job.GetCoinbaseSuffix().end());
+            BOOST_CHECK_EQUAL(Hash(coinbase), solved.vtx[0]->GetHash().ToUint256());
+
+            // The header from the cached merkle path matches a full recomputation.
+            BOOST_CHECK_EQUAL(solved.hashMerkleRoot, BlockMerkleRoot(solved));
+            CBlockHeader header{job.GetHeader(extra_nonce)};
+            BOOST_CHECK_EQUAL(header.hashMerkleRoot, solved.hashMerkleRoot);
+            BOOST_CHECK_EQUAL(header.nNonce, 0U);
+            header.nTime = time;
+            header.nNonce = nonce;
+            BOOST_CHECK_EQUAL(header.GetHash(), solved.GetHash());
+            for (size_t tx = 1; tx < block.vtx.size(); ++tx) {
+                BOOST_CHECK(solved.vtx[tx] == block.vtx[tx]);
+            }
+        }
+        // Different extranonces give different merkle roots.
+        BOOST_CHECK(job.GetHeader(1).hashMerkleRoot != job.GetHeader(2).hashMerkleRoot);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mining_work_serialization)
+{
+    CBlock block{RandomBlock(m_rng, 5)};
+    block.nBits = 0x207fffff;
+    const MiningJob job{block};
+    const uint64_t job_id{m_rng.rand64()};
+    const std::vector<unsigned char> work{node::SerializeMiningWork(job, job_id, /*clean=*/true)};
+
+    SpanReader reader{work};
+    uint64_t read_job_id;
+    uint8_t flags;
+    CBlockHeader header;
+    std::array<uint32_t, 8> midstate;
+    uint256 target;
+    std::vector<unsigned char> prefix, suffix;
+    std::vector<uint256> merkle_path;
+    reader >> read_job_id >> flags >> header;
+    for (uint32_t& word : midstate) reader >> word;
+    reader >> target >> prefix >> suffix >> merkle_path;
+    BOOST_CHECK(reader.empty());
+
+    BOOST_CHECK_EQUAL(read_job_id, job_id);
+    BOOST_CHECK_EQUAL(flags, 1);
+    BOOST_CHECK_EQUAL(header.GetHash(), job.GetHeader(uint64_t{0}).GetHash());
+    BOOST_CHECK_EQUAL(UintToArith256(target), arith_uint256{}.SetCompact(block.nBits));
+    BOOST_CHECK(prefix == job.GetCoinbasePrefix());
+    BOOST_CHECK(suffix == job.GetCoinbaseSuffix());
+    BOOST_CHECK(merkle_path == job.GetMerklePath());
+
+    // Hashing the end of the header from the midstate gives the header hash.
+    DataStream header_bytes{};
+    header_bytes << header;
+    uint256 hash;
+    SHA256D80Midstate(hash.begin(), midstate.data(), UCharCast(header_bytes.data()) + 64, 1);
+    BOOST_CHECK_EQUAL(hash, header.GetHash());
+
+    BOOST_CHECK_EQUAL(node::SerializeMiningWork(job, job_id, /*clean=*/false)[8], 0);
+
+    const node::MiningWorkSubmission submission{m_rng.rand64(), {1, 2, 3, 4, 5, 6, 7, 8}, m_rng.rand32(), m_rng.rand32()};
+    DataStream ss{};
+    ss << submission;
+    BOOST_CHECK_EQUAL(ss.size(), node::MINING_WORK_SUBMISSION_SIZE);
+    node::MiningWorkSubmission read_submission;
+    ss >> read_submission;
+    BOOST_CHECK_EQUAL(read_submission.job_id, submission.job_id);
+    BOOST_CHECK(read_submission.extra_nonce == submission.extra_nonce);
+    BOOST_CHECK_EQUAL(read_submission.time, submission.time);
+    BOOST_CHECK_EQUAL(read_submission.nonce, submission.nonce);
+}
+
+BOOST_AUTO_TEST_CASE(mining_job_list)
+{
+    struct Job {
+        uint64_t id;
+    };
+    MiningJobList<const Job> jobs;
+    bool stale{true};
+    BOOST_CHECK(!jobs.Newest());
+    BOOST_CHECK(!jobs.Find(uint64_t{1}, stale));
+    BOOST_CHECK(!stale);
+
+    uint64_t next_id{1};
+    for (size_t i = 0; i < MAX_MINING_JOBS; ++i) jobs.Add(std::make_shared<const Job>(next_id++), /*clean=*/i == 0);
+    BOOST_CHECK_EQUAL(jobs.Newest()->id, MAX_MINING_JOBS);
+    for (uint64_t id = 1; id < next_id; ++id) {
+        BOOST_CHECK_EQUAL(jobs.Find(id, stale)->id, id);
+        BOOST_CHECK(!stale);
+    }
+
+    // Jobs beyond MAX_MINING_JOBS on the same tip are still found, and not stale.
+    jobs.Add(std::make_shared<const Job>(next_id++), /*clean=*/false);
+    BOOST_CHECK_EQUAL(jobs.Find(uint64_t{1}, stale)->id, 1U);
+    BOOST_CHECK(!stale);
+    BOOST_CHECK(jobs.Find(uint64_t{2}, stale));
+    BOOST_CHECK(!stale);
+
+    // A clean job makes all others stale, and only the last dropped ones are kept.
+    jobs.Add(std::make_shared<const Job>(next_id), /*clean=*/true);
+    BOOST_CHECK_EQUAL(jobs.Newest()->id, next_id);
+    for (uint64_t id = 1; id < next_id; ++id) {
+        const bool known{jobs.Find(id, stale) != nullptr};
+        BOOST_CHECK_EQUAL(known, id >= next_id - MAX_RETIRED_MINING_JOBS);
+        BOOST_CHECK_EQUAL(stale, known);
+    }
+    BOOST_CHECK(jobs.Find(next_id, stale));
+    BOOST_CHECK(!stale);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,82 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/mining_metrics.h>
+#include <test/util/setup_common.h>
+#include <uint256.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std::chrono_literals;
+using node::MiningMetrics;
+using node::TEMPLATE_BUILD_TIME_BUCKETS;
+
+BOOST_FIXTURE_TEST_SUITE(mining_metrics_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(template_build_histogram)
+{
+    MiningMetrics metrics;
+    const uint256 tip{uint256::ONE};
+    metrics.TemplateBuilt(tip, 500us);
+    metrics.TemplateBuilt(tip, 1ms);
+    metrics.TemplateBuilt(tip, 3ms);
+    metrics.TemplateBuilt(tip, 2s);
+
+    const auto snapshot{metrics.GetSnapshot()};
+    BOOST_CHECK_EQUAL(snapshot.template_build.count, 4U);
+    BOOST_CHECK(snapshot.template_build.last == 2s);
+    BOOST_CHECK(snapshot.template_build.max == 2s);
+    BOOST_CHECK(snapshot.template_build.total == 2004500us);
+    BOOST_CHECK(snapshot.template_build.Average() == 501125us);
+    // Bucket bounds are inclusive, and slower builds than the last bound get their own bucket.
+    BOOST_CHECK_EQUAL(snapshot.template_build_histogram[0], 2U);
+    BOOST_CHECK_EQUAL(snapshot.template_build_histogram[1], 0U);
+    BOOST_CHECK_EQUAL(snapshot.template_build_histogram[2], 1U);
+    BOOST_CHECK_EQUAL(snapshot.template_build_histogram[TEMPLATE_BUILD_TIME_BUCKETS.size()], 1U);
+}
+
+BOOST_AUTO_TEST_CASE(tip_to_template)
+{
+    MiningMetrics metrics;
+    const uint256 tip_a{uint256::ONE};
+    const uint256 tip_b{uint256{2}};
+
+    // Nothing is timed before the first tip change.
+    BOOST_CHECK(!metrics.TemplateBuilt(tip_a, 1ms));
+
+    metrics.TipChanged(tip_a);
+    metrics.TipChanged(tip_a); // the same tip again is not a change
+    // A template on another tip does not count.
+    BOOST_CHECK(!metrics.TemplateBuilt(tip_b, 1ms));
+    const auto latency{metrics.TemplateBuilt(tip_a, 1ms)};
+    BOOST_REQUIRE(latency);
+    BOOST_CHECK(*latency >= 0us);
+    // Only the first template on a tip is timed.
+    BOOST_CHECK(!metrics.TemplateBuilt(tip_a, 1ms));
+
+    metrics.TipChanged(tip_b);
+    BOOST_CHECK(metrics.TemplateBuilt(tip_b, 1ms));
+
+    const auto snapshot{metrics.GetSnapshot()};
+    BOOST_CHECK_EQUAL(snapshot.tip_changes, 2U);
+    BOOST_CHECK_EQUAL(snapshot.tip_to_template.count, 2U);
+    BOOST_CHECK_EQUAL(snapshot.template_build.count, 5U);
+}
+
+BOOST_AUTO_TEST_CASE(stale_ratio)
+{
+    MiningMetrics metrics;
+    BOOST_CHECK_EQUAL(metrics.GetSnapshot().StaleRatio(), 0.0);
+    metrics.SolutionFound(/*stale=*/false);
+    metrics.SolutionFound(/*stale=*/true);
+    metrics.SolutionFound(/*stale=*/false);
+    metrics.SolutionFound(/*stale=*/false);
+
+    const auto snapshot{metrics.GetSnapshot()};
+    BOOST_CHECK_EQUAL(snapshot.solutions, 4U);
+    BOOST_CHECK_EQUAL(snapshot.stale_solutions, 1U);
+    BOOST_CHECK_EQUAL(snapshot.StaleRatio(), 0.25);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
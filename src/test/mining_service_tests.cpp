@@ -0,0 +1,60 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/miner.h>
+#include <node/mining_service.h>
+#include <script/script.h>
+#include <sync.h>
+#include <test/util/setup_common.h>
+#include <util/time.h>
+#include <validation.h>
+#include <validationinterface.h>
+
+#include <boost/test/unit_test.hpp>
+
+using node::BlockAssembler;
+using node::MiningService;
+
+BOOST_FIXTURE_TEST_SUITE(mining_service_tests, TestChain100Setup)
+
+BOOST_AUTO_TEST_CASE(mine_in_background)
+{
+    MiningService service{*m_node.chainman, m_node.mempool.get(), BlockAssembler::Options{}};
+    m_node.validation_signals->RegisterValidationInterface(&service);
+    BOOST_CHECK(!service.IsMining());
+
+    const int start_height{WITH_LOCK(::cs_main, return m_node.chainman->ActiveHeight())};
+    const CScript script{CScript() << OP_TRUE};
+    service.Start(script, /*threads=*/2);
+    BOOST_CHECK(service.IsMining());
+    BOOST_CHECK_EQUAL(service.GetThreads(), 2);
+
+    // Regtest blocks are found almost immediately; each one moves the tip and
+    // makes the service build a new template on top of it.
+    const auto deadline{SteadyClock::now() + 60s};
+    while (WITH_LOCK(::cs_main, return m_node.chainman->ActiveHeight()) < start_height + 5 && SteadyClock::now() < deadline) {
+        UninterruptibleSleep(10ms);
+    }
+    service.Stop();
+    BOOST_CHECK(!service.IsMining());
+    BOOST_CHECK_EQUAL(service.GetThreads(), 0);
+
+    const int end_height{WITH_LOCK(::cs_main, return m_node.chainman->ActiveHeight())};
+    BOOST_CHECK_GE(end_height, start_height + 5);
+    const node::MiningStats stats{service.GetStats()};
+    BOOST_CHECK_EQUAL(stats.blocks_accepted, uint64_t(end_height - start_height));
+    BOOST_CHECK_EQUAL(stats.blocks_found, stats.blocks_accepted + stats.blocks_stale);
+    BOOST_CHECK_GE(stats.templates, stats.blocks_found);
+
+    // Restarting and stopping again is safe, as is stopping twice.
+    service.Start(script, /*threads=*/1);
+    service.Stop();
+    service.Stop();
+    BOOST_CHECK(!service.IsMining());
+
+    m_node.validation_signals->SyncWithValidationInterfaceQueue();
+    m_node.validation_signals->UnregisterValidationInterface(&service);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -2,6 +2,7 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <arith_uint256.h>
 #include <chain.h>
 #include <chainparams.h>
 #include <pow.h>
@@ -156,6 +157,54 @@ BOOST_AUTO_TEST_CASE(GetBlockProofEquivalentTime_test)
     }
 }
 
+/* Test the min-difficulty rule on two competing branches, whose walks back to
+ * the last real difficulty block must not be confused with each other */
+BOOST_AUTO_TEST_CASE(get_next_work_min_difficulty_branches)
+{
+    const auto chainParams = CreateChainParams(*m_node.args, ChainType::TESTNET);
+    const auto& consensus = chainParams->GetConsensus();
+    const uint32_t pow_limit_bits = UintToArith256(consensus.powLimit).GetCompact();
+    const uint32_t real_bits = 0x1c00ffff;
+    constexpr int LENGTH{100};
+    constexpr int FORK_HEIGHT{10};
+    constexpr int REAL_HEIGHT{20};
+
+    // Branch a has a single real difficulty block at REAL_HEIGHT, branch b
+    // forks off before it and only has min-difficulty blocks.
+    std::vector<uint256> hashes(2 * LENGTH);
+    std::vector<CBlockIndex> a(LENGTH), b(LENGTH);
+    const auto init{[&](std::vector<CBlockIndex>& branch, int height, CBlockIndex* prev, uint32_t bits, int hash_index) {
+        CBlockIndex& block{branch[height]};
+        hashes[hash_index] = ArithToUint256(arith_uint256{uint64_t(hash_index) + 1});
+        block.phashBlock = &hashes[hash_index];
+        block.pprev = prev;
+        block.nHeight = height;
+        block.nTime = 1269211443 + height * consensus.nPowTargetSpacing;
+        block.nBits = bits;
+        block.BuildSkip();
+    }};
+    for (int height = 0; height < LENGTH; ++height) {
+        init(a, height, height ? &a[height - 1] : nullptr, height == REAL_HEIGHT ? real_bits : pow_limit_bits, height);
+        if (height > FORK_HEIGHT) {
+            init(b, height, height == FORK_HEIGHT + 1 ? &a[FORK_HEIGHT] : &b[height - 1], pow_limit_bits, LENGTH + height);
+        }
+    }
+
+    // Alternate between the branches, and check each more than once
+    for (int round = 0; round < 2; ++round) {
+        for (int height = FORK_HEIGHT + 1; height < LENGTH; ++height) {
+            CBlockHeader header;
+            header.nTime = a[height].nTime + consensus.nPowTargetSpacing;
+            BOOST_CHECK_EQUAL(GetNextWorkRequired(&a[height], &header, consensus), height >= REAL_HEIGHT ? real_bits : pow_limit_bits);
+            header.nTime = b[height].nTime + consensus.nPowTargetSpacing;
+            BOOST_CHECK_EQUAL(GetNextWorkRequired(&b[height], &header, consensus), pow_limit_bits);
+            // A late block may always be min difficulty
+            header.nTime = a[height].nTime + 3 * consensus.nPowTargetSpacing;
+            BOOST_CHECK_EQUAL(GetNextWorkRequired(&a[height], &header, consensus), pow_limit_bits);
+        }
+    }
+}
+
 void sanity_check_chainparams(const ArgsManager& args, ChainType chain_type)
 {
     const auto chainParams = CreateChainParams(args, chain_type);
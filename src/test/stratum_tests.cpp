@@ -0,0 +1,194 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <arith_uint256.h>
+#include <consensus/merkle.h>
+#include <crypto/common.h>
+#include <hash.h>
+#include <interfaces/mining.h>
+#include <node/mining_metrics.h>
+#include <primitives/block.h>
+#include <script/script.h>
+#include <stratum.h>
+#include <sync.h>
+#include <test/util/setup_common.h>
+#include <univalue.h>
+#include <util/strencodings.h>
+#include <util/string.h>
+#include <util/time.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+BOOST_FIXTURE_TEST_SUITE(stratum_tests, TestChain100Setup)
+
+static std::vector<UniValue> ParseLines(const std::string& reply)
+{
+    std::vector<UniValue> messages;
+    for (const auto& line : util::SplitString(reply, '\n')) {
+        if (line.empty()) continue;
+        UniValue message;
+        BOOST_REQUIRE(message.read(line));
+        messages.push_back(std::move(message));
+    }
+    return messages;
+}
+
+static std::string Request(int id, const std::string& method, const std::string& params)
+{
+    return strprintf(R"({"id":%d,"method":"%s","params":%s})", id, method, params);
+}
+
+static uint32_t ParseHexUInt32(const std::string& hex)
+{
+    return ReadBE32(ParseHex(hex).data());
+}
+
+/** Header a miner builds from a mining.notify, as a stratum client would. */
+static CBlockHeader MinerHeader(const UniValue& notify, const std::string& extranonce1, const std::string& extranonce2, uint32_t nonce)
+{
+    const UniValue& params{notify.find_value("params")};
+    const std::vector<unsigned char> coinbase{ParseHex(params[2].get_str() + extranonce1 + extranonce2 + params[3].get_str())};
+    uint256 root{Hash(coinbase)};
+    for (const UniValue& branch : params[4].getValues()) {
+        root = Hash(root, uint256{ParseHex(branch.get_str())});
+    }
+    const std::vector<unsigned char> swapped{ParseHex(params[1].get_str())};
+    std::vector<unsigned char> prev(32);
+    for (size_t i = 0; i < 32; ++i) prev[i] = swapped[(i & ~size_t{3}) + 3 - (i & 3)];
+
+    CBlockHeader header;
+    header.nVersion = ParseHexUInt32(params[5].get_str());
+    header.hashPrevBlock = uint256{prev};
+    header.hashMerkleRoot = root;
+    header.nBits = ParseHexUInt32(params[6].get_str());
+    header.nTime = ParseHexUInt32(params[7].get_str());
+    header.nNonce = nonce;
+    return header;
+}
+
+BOOST_AUTO_TEST_CASE(stratum_protocol)
+{
+    auto mining{interfaces::MakeMining(m_node)};
+    StratumServer server{DEFAULT_STRATUM_DIFFICULTY};
+    StratumSession session{server.NewSession()};
+
+    // Shares are refused before subscribing and authorizing.
+    auto reply{ParseLines(server.HandleRequest(session, Request(1, "mining.submit", R"(["w","1","00000000","00000000","00000000"])")))};
+    BOOST_REQUIRE_EQUAL(reply.size(), 1U);
+    BOOST_CHECK_EQUAL(reply[0].find_value("error")[0].getInt<int>(), 25);
+
+    BOOST_CHECK(ParseLines(server.HandleRequest(session, "not json"))[0].find_value("error").isArray());
+    BOOST_CHECK(server.HandleRequest(session, "").empty());
+
+    // Without a job, subscribing only returns the subscription.
+    reply = ParseLines(server.HandleRequest(session, Request(2, "mining.subscribe", "[]")));
+    BOOST_REQUIRE_EQUAL(reply.size(), 1U);
+    const UniValue& subscribe_result{reply[0].find_value("result")};
+    const std::string extranonce1{subscribe_result[1].get_str()};
+    BOOST_CHECK_EQUAL(extranonce1, HexStr(session.extranonce1));
+    BOOST_CHECK_EQUAL(subscribe_result[2].getInt<int>(), int{STRATUM_EXTRANONCE2_SIZE});
+    BOOST_CHECK(ParseLines(server.HandleRequest(session, Request(3, "mining.authorize", R"(["worker","x"])")))[0].find_value("result").get_bool());
+
+    // Sessions get distinct extranonce1s.
+    BOOST_CHECK(server.NewSession().extranonce1 != session.extranonce1);
+
+    std::shared_ptr<interfaces::BlockTemplate> block_template{mining->createNewBlock({.coinbase_output_script = CScript() << OP_TRUE})};
+    BOOST_REQUIRE(block_template);
+    server.AddJob(block_template, /*clean=*/true);
+    reply = ParseLines(server.GetNotify(/*clean=*/true));
+    BOOST_REQUIRE_EQUAL(reply.size(), 2U);
+    BOOST_CHECK_EQUAL(reply[0].find_value("method").get_str(), "mining.set_difficulty");
+    const UniValue notify{reply[1]};
+    BOOST_CHECK_EQUAL(notify.find_value("method").get_str(), "mining.notify");
+    const std::string job_id{notify.find_value("params")[0].get_str()};
+    BOOST_CHECK(notify.find_value("params")[8].get_bool());
+
+    // The header built from the notification matches the template.
+    const std::string extranonce2{"01020304"};
+    const CBlockHeader header{MinerHeader(notify, extranonce1, extranonce2, 0)};
+    const CBlockHeader tmpl_header{block_template->getBlockHeader()};
+    BOOST_CHECK_EQUAL(header.hashPrevBlock, tmpl_header.hashPrevBlock);
+    BOOST_CHECK_EQUAL(header.nVersion, tmpl_header.nVersion);
+    BOOST_CHECK_EQUAL(header.nBits, tmpl_header.nBits);
+    BOOST_CHECK_EQUAL(header.nTime, tmpl_header.nTime);
+
+    // The regtest target is easier than difficulty 1, so shares are blocks.
+    const arith_uint256 target{arith_uint256{}.SetCompact(header.nBits)};
+    uint32_t good_nonce{0}, bad_nonce{0};
+    while (UintToArith256(MinerHeader(notify, extranonce1, extranonce2, good_nonce).GetHash()) > target) ++good_nonce;
+    while (UintToArith256(MinerHeader(notify, extranonce1, extranonce2, bad_nonce).GetHash()) <= target) ++bad_nonce;
+    const auto submit = [&](const std::string& job, const std::string& en2, uint32_t time, uint32_t nonce) {
+        return ParseLines(server.HandleRequest(session, Request(4, "mining.submit", strprintf(R"(["worker","%s","%s","%08x","%08x"])", job, en2, time, nonce))))[0];
+    };
+
+    const auto metrics_before{node::GetMiningMetrics().GetSnapshot()};
+    BOOST_CHECK_EQUAL(submit(job_id, extranonce2, header.nTime, bad_nonce).find_value("error")[0].getInt<int>(), 23);
+    BOOST_CHECK_EQUAL(submit("ffff", extranonce2, header.nTime, good_nonce).find_value("error")[0].getInt<int>(), 21);
+    BOOST_CHECK_EQUAL(submit(job_id, "0102", header.nTime, good_nonce).find_value("error")[0].getInt<int>(), 20);
+    BOOST_CHECK_EQUAL(submit(job_id, extranonce2, header.nTime - 1, good_nonce).find_value("error")[0].getInt<int>(), 20);
+    // The four above and the one sent before subscribing
+    BOOST_CHECK_EQUAL(server.GetRejectedShares(), 5U);
+
+    const int height{WITH_LOCK(::cs_main, return m_node.chainman->ActiveHeight())};
+    const UniValue accepted{submit(job_id, extranonce2, header.nTime, good_nonce)};
+    BOOST_CHECK(accepted.find_value("error").isNull());
+    BOOST_CHECK(accepted.find_value("result").get_bool());
+    BOOST_CHECK_EQUAL(server.GetAcceptedShares(), 1U);
+    // The block is only queued by the request, and passed to the node on the submission thread.
+    BOOST_CHECK_EQUAL(server.GetBlocksFound(), 0U);
+    BOOST_CHECK_EQUAL(WITH_LOCK(::cs_main, return m_node.chainman->ActiveHeight()), height);
+    // It only counts as a solution once the node accepted it.
+    BOOST_CHECK_EQUAL(node::GetMiningMetrics().GetSnapshot().solutions, metrics_before.solutions);
+    server.SubmitBlocks(/*timeout=*/0ms);
+    BOOST_CHECK_EQUAL(server.GetBlocksFound(), 1U);
+    // Only the block counts as a solution, and an unknown job is not a stale one.
+    BOOST_CHECK_EQUAL(node::GetMiningMetrics().GetSnapshot().solutions, metrics_before.solutions + 1);
+    BOOST_CHECK_EQUAL(node::GetMiningMetrics().GetSnapshot().stale_solutions, metrics_before.stale_solutions);
+    BOOST_CHECK_EQUAL(WITH_LOCK(::cs_main, return m_node.chainman->ActiveHeight()), height + 1);
+    BOOST_CHECK_EQUAL(WITH_LOCK(::cs_main, return m_node.chainman->ActiveTip()->GetBlockHash()),
+                      MinerHeader(notify, extranonce1, extranonce2, good_nonce).GetHash());
+
+    BOOST_CHECK_EQUAL(submit(job_id, extranonce2, header.nTime, good_nonce).find_value("error")[0].getInt<int>(), 22);
+
+    // A clean job drops the old ones.
+    std::shared_ptr<interfaces::BlockTemplate> next{mining->createNewBlock({.coinbase_output_script = CScript() << OP_TRUE})};
+    BOOST_REQUIRE(next);
+    server.AddJob(next, /*clean=*/true);
+    BOOST_CHECK_EQUAL(submit(job_id, extranonce2, header.nTime, good_nonce).find_value("error")[0].getInt<int>(), 21);
+    BOOST_CHECK_EQUAL(node::GetMiningMetrics().GetSnapshot().stale_solutions, metrics_before.stale_solutions);
+
+    // A new block for the dropped job is refused, and counted as stale.
+    const std::string stale_extranonce2{"05060708"};
+    uint32_t stale_nonce{0};
+    while (UintToArith256(MinerHeader(notify, extranonce1, stale_extranonce2, stale_nonce).GetHash()) > target) ++stale_nonce;
+    BOOST_CHECK_EQUAL(submit(job_id, stale_extranonce2, header.nTime, stale_nonce).find_value("error")[0].getInt<int>(), 21);
+    BOOST_CHECK_EQUAL(node::GetMiningMetrics().GetSnapshot().solutions, metrics_before.solutions + 2);
+    BOOST_CHECK_EQUAL(node::GetMiningMetrics().GetSnapshot().stale_solutions, metrics_before.stale_solutions + 1);
+
+    // A job pushed out by newer ones on the same tip still takes a block.
+    const UniValue next_notify{ParseLines(server.GetNotify(/*clean=*/true))[1]};
+    const std::string next_job_id{next_notify.find_value("params")[0].get_str()};
+    for (size_t i = 0; i < node::MAX_MINING_JOBS; ++i) {
+        server.AddJob(mining->createNewBlock({.coinbase_output_script = CScript() << OP_TRUE}), /*clean=*/false);
+    }
+    BOOST_CHECK(ParseLines(server.GetNotify(/*clean=*/false))[1].find_value("params")[0].get_str() != next_job_id);
+    const CBlockHeader next_header{MinerHeader(next_notify, extranonce1, extranonce2, 0)};
+    uint32_t next_nonce{0};
+    while (UintToArith256(MinerHeader(next_notify, extranonce1, extranonce2, next_nonce).GetHash()) > target) ++next_nonce;
+    const UniValue overflowed{submit(next_job_id, extranonce2, next_header.nTime, next_nonce)};
+    BOOST_CHECK(overflowed.find_value("error").isNull());
+    BOOST_CHECK(overflowed.find_value("result").get_bool());
+    server.SubmitBlocks(/*timeout=*/0ms);
+    BOOST_CHECK_EQUAL(server.GetBlocksFound(), 2U);
+    BOOST_CHECK_EQUAL(node::GetMiningMetrics().GetSnapshot().stale_solutions, metrics_before.stale_solutions + 1);
+    BOOST_CHECK_EQUAL(WITH_LOCK(::cs_main, return m_node.chainman->ActiveTip()->GetBlockHash()),
+                      MinerHeader(next_notify, extranonce1, extranonce2, next_nonce).GetHash());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -29,4 +29,17 @@ BOOST_AUTO_TEST_CASE(total_ram)
     }
 }
 
+BOOST_AUTO_TEST_CASE(available_ram)
+{
+    const auto available{GetAvailableRAM()};
+    if (!available) {
+        BOOST_WARN_MESSAGE(false, "skipping available_ram: available RAM unknown");
+        return;
+    }
+
+    BOOST_CHECK_GT(*available, 0U);
+    if (const auto total{GetTotalRAM()}) BOOST_CHECK_LE(*available, *total);
+    if (const auto limit{GetCgroupMemoryLimit()}) BOOST_CHECK_LE(*available, *limit);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
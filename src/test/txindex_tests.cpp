@@ -46,6 +46,25 @@ BOOST_FIXTURE_TEST_CASE(txindex_initial_sync, TestChain100Setup)
         }
     }
 
+    // Check that transactions looked up together are found, in the order asked for.
+    std::vector<Txid> txids;
+    for (auto it{m_coinbase_txns.rbegin()}; it != m_coinbase_txns.rend(); ++it) txids.push_back((*it)->GetHash());
+    txids.insert(txids.begin() + 10, Txid::FromUint256(m_rng.rand256()));
+    std::vector<uint256> block_hashes;
+    std::vector<CTransactionRef> txs;
+    BOOST_CHECK_EQUAL(txindex.FindTxs(txids, block_hashes, txs), m_coinbase_txns.size());
+    BOOST_REQUIRE_EQUAL(txs.size(), txids.size());
+    for (size_t i{0}; i < txids.size(); ++i) {
+        if (i == 10) {
+            BOOST_CHECK(!txs[i]);
+            continue;
+        }
+        BOOST_REQUIRE(txs[i]);
+        BOOST_CHECK_EQUAL(txs[i]->GetHash(), txids[i]);
+        BOOST_CHECK(txindex.FindTx(txids[i], block_hash, tx_disk));
+        BOOST_CHECK_EQUAL(block_hashes[i], block_hash);
+    }
+
     // Check that new transactions in new blocks make it into the index.
     for (int i = 0; i < 10; i++) {
         CScript coinbase_script_pub_key = GetScriptForDestination(PKHash(coinbaseKey.GetPubKey()));
@@ -73,4 +92,43 @@ BOOST_FIXTURE_TEST_CASE(txindex_initial_sync, TestChain100Setup)
     txindex.Stop();
 }
 
+struct CompressedBlocksTestingSetup : public TestChain100Setup {
+    CompressedBlocksTestingSetup() : TestChain100Setup{ChainType::REGTEST, {.extra_args = {"-blockscompress"}}} {}
+};
+
+BOOST_FIXTURE_TEST_CASE(txindex_compressed_blocks, CompressedBlocksTestingSetup)
+{
+    TxIndex txindex(interfaces::MakeChain(m_node), 1 << 20, true);
+    BOOST_REQUIRE(txindex.Init());
+    txindex.Sync();
+
+    // Transactions are found in blocks stored compressed, at their offset in the uncompressed block.
+    const auto txns{m_coinbase_txns};
+    CMutableTransaction spend{CreateValidMempoolTransaction(txns[0], 0, 1, coinbaseKey, GetScriptForDestination(PKHash(coinbaseKey.GetPubKey())), 48 * COIN, /*submit=*/false)};
+    const CBlock& block = CreateAndProcessBlock({spend}, GetScriptForDestination(PKHash(coinbaseKey.GetPubKey())));
+    BOOST_CHECK(txindex.BlockUntilSyncedToCurrentChain());
+
+    CTransactionRef tx_disk;
+    uint256 block_hash;
+    for (const auto& txn : std::vector<CTransactionRef>{txns.front(), txns.back(), block.vtx[0], block.vtx[1]}) {
+        BOOST_REQUIRE(txindex.FindTx(txn->GetHash(), block_hash, tx_disk));
+        BOOST_CHECK_EQUAL(tx_disk->GetWitnessHash(), txn->GetWitnessHash());
+    }
+    BOOST_CHECK_EQUAL(block_hash, block.GetHash());
+
+    // A batch reads both transactions from one decompression of the block.
+    const std::vector<Txid> txids{block.vtx[1]->GetHash(), txns.front()->GetHash(), block.vtx[0]->GetHash()};
+    std::vector<uint256> block_hashes;
+    std::vector<CTransactionRef> txs;
+    BOOST_CHECK_EQUAL(txindex.FindTxs(txids, block_hashes, txs), 3U);
+    BOOST_CHECK_EQUAL(txs[0]->GetWitnessHash(), block.vtx[1]->GetWitnessHash());
+    BOOST_CHECK_EQUAL(txs[1]->GetWitnessHash(), txns.front()->GetWitnessHash());
+    BOOST_CHECK_EQUAL(txs[2]->GetWitnessHash(), block.vtx[0]->GetWitnessHash());
+    BOOST_CHECK_EQUAL(block_hashes[0], block.GetHash());
+    BOOST_CHECK_EQUAL(block_hashes[2], block.GetHash());
+
+    m_node.validation_signals->SyncWithValidationInterfaceQueue();
+    txindex.Stop();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -164,6 +164,55 @@ static void ValidateCheckInputsForAllFlags(const CTransaction &tx, script_verify
     }
 }
 
+// Test that the sighash midstates of a transaction accepted to the mempool are
+// kept, and used up when a block with the transaction is connected.
+BOOST_FIXTURE_TEST_CASE(precomputed_txdata_reuse, TestChain100Setup)
+{
+    const CScript script_pub_key{CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG};
+    CMutableTransaction spend;
+    spend.version = 1;
+    spend.vin.resize(1);
+    spend.vin[0].prevout = COutPoint{m_coinbase_txns[0]->GetHash(), 0};
+    spend.vout.resize(1);
+    spend.vout[0].nValue = 11 * CENT;
+    spend.vout[0].scriptPubKey = script_pub_key;
+    std::vector<unsigned char> sig;
+    BOOST_CHECK(coinbaseKey.Sign(SignatureHash(script_pub_key, spend, 0, SIGHASH_ALL, 0, SigVersion::BASE), sig));
+    sig.push_back((unsigned char)SIGHASH_ALL);
+    spend.vin[0].scriptSig << sig;
+    const CTransaction tx{spend};
+
+    PrecomputedTxDataCache& cache{m_node.chainman->m_validation_cache.m_txdata_cache};
+    {
+        LOCK(cs_main);
+        BOOST_CHECK_EQUAL(cache.size(), 0U);
+        BOOST_CHECK_EQUAL(m_node.chainman->ProcessTransaction(MakeTransactionRef(tx)).m_result_type, MempoolAcceptResult::ResultType::VALID);
+        BOOST_CHECK_EQUAL(cache.size(), 1U);
+        BOOST_CHECK_GT(cache.DynamicMemoryUsage(), 0U);
+
+        PrecomputedTransactionData txdata;
+        BOOST_CHECK(cache.Get(tx, m_node.chainman->ActiveChainstate().CoinsTip(), /*erase=*/false, txdata));
+        BOOST_CHECK(txdata.m_spent_outputs_ready);
+        BOOST_CHECK(txdata.m_spent_outputs == std::vector<CTxOut>{m_coinbase_txns[0]->vout[0]});
+        BOOST_CHECK_EQUAL(cache.size(), 1U);
+
+        // Data computed for other spent outputs is not used, and dropped.
+        CCoinsViewCache view{&m_node.chainman->ActiveChainstate().CoinsTip()};
+        Coin coin{view.AccessCoin(spend.vin[0].prevout)};
+        coin.out.nValue += 1;
+        view.AddCoin(spend.vin[0].prevout, std::move(coin), /*possible_overwrite=*/true);
+        BOOST_CHECK(!cache.Get(tx, view, /*erase=*/false, txdata));
+        BOOST_CHECK_EQUAL(cache.size(), 0U);
+        cache.Add(tx, txdata);
+        BOOST_CHECK_EQUAL(cache.size(), 1U);
+    }
+
+    const CBlock block{CreateAndProcessBlock({spend}, script_pub_key)};
+    LOCK(cs_main);
+    BOOST_CHECK_EQUAL(m_node.chainman->ActiveChain().Tip()->GetBlockHash(), block.GetHash());
+    BOOST_CHECK_EQUAL(cache.size(), 0U);
+}
+
 BOOST_FIXTURE_TEST_CASE(checkinputs_test, Dersig100Setup)
 {
     // Test that passing CheckInputScripts with one set of script flags doesn't imply
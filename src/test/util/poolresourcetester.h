@@ -91,6 +91,11 @@ public:
                 ASAN_POISON_MEMORY_REGION(ptr_, sizeof(typename PoolResource<MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>::ListNode));
             }
         }
+        // the resource keeps a running total of the freelists
+        std::size_t free_list_bytes{0};
+        for (const auto& free_block : free_blocks) free_list_bytes += free_block.size;
+        assert(free_list_bytes == resource.FreeListBytes());
+
         // also add whatever has not yet been used for blocks
         auto num_available_bytes = resource.m_available_memory_end - resource.m_available_memory_it;
         if (num_available_bytes > 0) {
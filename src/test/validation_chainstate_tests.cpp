@@ -58,7 +58,15 @@ BOOST_AUTO_TEST_CASE(validation_chainstate_resize_caches)
             1 << 23  // upsizing the coinsdb cache
         );
 
-        // The view cache should be empty since we had to destruct to downsize.
+        // Downsizing only evicts unmodified coins, so the new coin stays cached.
+        BOOST_CHECK(c1.CoinsTip().HaveCoinInCache(outpoint));
+
+        // Once written out, it is evicted when the cache no longer fits it.
+        BOOST_REQUIRE(c1.CoinsTip().Sync());
+        c1.ResizeCoinsCaches(
+            0,  // downsizing the coinsview cache
+            1 << 23
+        );
         BOOST_CHECK(!c1.CoinsTip().HaveCoinInCache(outpoint));
     }
 }
@@ -5,6 +5,7 @@
 #include <chainparams.h>
 #include <consensus/validation.h>
 #include <kernel/disconnected_transactions.h>
+#include <node/caches.h>
 #include <node/chainstatemanager_args.h>
 #include <node/kernel_notifications.h>
 #include <node/utxo_snapshot.h>
@@ -12,11 +13,13 @@
 #include <rpc/blockchain.h>
 #include <sync.h>
 #include <test/util/chainstate.h>
+#include <test/util/coins.h>
 #include <test/util/logging.h>
 #include <test/util/random.h>
 #include <test/util/setup_common.h>
 #include <test/util/validation.h>
 #include <uint256.h>
+#include <util/byte_units.h>
 #include <util/result.h>
 #include <util/vector.h>
 #include <validation.h>
@@ -163,6 +166,41 @@ BOOST_FIXTURE_TEST_CASE(chainstatemanager_rebalance_caches, TestChain100Setup)
     BOOST_CHECK_CLOSE(double(c2.m_coinsdb_cache_size_bytes), max_cache * 0.95, 1);
 }
 
+//! Test that -dbcacheadaptive gives back the memory of a coins cache it shrinks.
+BOOST_FIXTURE_TEST_CASE(chainstatemanager_adapt_coins_cache, TestChain100Setup)
+{
+    ChainstateManager& manager{*m_node.chainman};
+    Chainstate& chainstate{manager.ActiveChainstate()};
+    // With 4 GiB of memory, 512 MiB are kept free for the rest of the system.
+    const size_t total_ram{4096_MiB};
+    const size_t reserve{512_MiB};
+
+    size_t usage;
+    {
+        LOCK(::cs_main);
+        manager.m_total_coinstip_cache = 256_MiB;
+        manager.MaybeRebalanceCaches();
+        while (chainstate.CoinsTip().DynamicMemoryUsage() < 2 * MIN_ADAPTIVE_COINS_CACHE + 8_MiB) {
+            AddTestCoin(m_rng, chainstate.CoinsTip());
+        }
+        usage = node::GetCoinsCacheUsage(manager);
+    }
+
+    // Half the cache is needed elsewhere: the budget drops by that much, and
+    // the cache releases its memory.
+    size_t available_ram{reserve - usage / 2};
+    node::AdaptCoinsCache(manager, available_ram, total_ram);
+    const size_t budget{WITH_LOCK(::cs_main, return manager.m_total_coinstip_cache)};
+    BOOST_CHECK_EQUAL(budget, usage - usage / 2);
+    const size_t usage_after{WITH_LOCK(::cs_main, return node::GetCoinsCacheUsage(manager))};
+    BOOST_CHECK_LT(usage_after, budget);
+
+    // The next poll sees the memory given back, and leaves the budget alone.
+    available_ram += usage - usage_after;
+    node::AdaptCoinsCache(manager, available_ram, total_ram);
+    BOOST_CHECK_EQUAL(WITH_LOCK(::cs_main, return manager.m_total_coinstip_cache), budget);
+}
+
 struct SnapshotTestSetup : TestChain100Setup {
     // Run with coinsdb on the filesystem to support, e.g., moving invalidated
     // chainstate dirs to "*_invalid".
@@ -8,6 +8,7 @@
 #include <core_io.h>
 #include <hash.h>
 #include <net.h>
+#include <pow.h>
 #include <signet.h>
 #include <uint256.h>
 #include <util/chaintype.h>
@@ -360,4 +361,75 @@ BOOST_AUTO_TEST_CASE(block_malleation)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(headers_pow_check, RegTestingSetup)
+{
+    ChainstateManager& chainman{*m_node.chainman};
+    const auto& params{chainman.GetConsensus()};
+
+    // Enough headers to be spread over the header check queue
+    std::vector<CBlockHeader> headers(5 * HEADER_POW_CHECK_SIZE + 1);
+    uint256 prev_hash{params.hashGenesisBlock};
+    for (auto& header : headers) {
+        header.hashPrevBlock = prev_hash;
+        header.nBits = 0x207fffff;
+        while (!CheckProofOfWork(header.GetHash(), header.nBits, params)) ++header.nNonce;
+        prev_hash = header.GetHash();
+    }
+    BOOST_CHECK(HasValidProofOfWork(headers, params));
+    BOOST_CHECK(chainman.HasValidProofOfWork(headers));
+
+    // A single bad header anywhere fails the whole batch
+    for (const size_t bad : {size_t{0}, HEADER_POW_CHECK_SIZE, headers.size() - 1}) {
+        auto bad_headers{headers};
+        while (CheckProofOfWork(bad_headers[bad].GetHash(), bad_headers[bad].nBits, params)) ++bad_headers[bad].nNonce;
+        BOOST_CHECK(!HasValidProofOfWork(bad_headers, params));
+        BOOST_CHECK(!chainman.HasValidProofOfWork(bad_headers));
+    }
+}
+
+
+BOOST_FIXTURE_TEST_CASE(fetch_inputs, TestChain100Setup)
+{
+    Chainstate& chainstate{m_node.chainman->ActiveChainstate()};
+    const CScript op_true{CScript() << OP_TRUE};
+
+    // Enough outputs in the coins database to be spread over the input fetch queue
+    const size_t num_outputs{3 * INPUT_FETCH_SIZE + 1};
+    const auto [fan_out_tx, _]{CreateValidTransaction(
+        {m_coinbase_txns[0]}, {COutPoint(m_coinbase_txns[0]->GetHash(), 0)}, chainstate.m_chain.Height() + 1,
+        {coinbaseKey}, std::vector<CTxOut>(num_outputs, CTxOut{COIN, op_true}), {}, {})};
+    CreateAndProcessBlock({fan_out_tx}, op_true, &chainstate);
+    chainstate.ForceFlushStateToDisk();
+
+    std::vector<CMutableTransaction> txs(num_outputs);
+    for (size_t i{0}; i < num_outputs; ++i) {
+        txs[i].vin.emplace_back(COutPoint(fan_out_tx.GetHash(), i));
+        txs[i].vout.emplace_back(COIN, op_true);
+    }
+    // A spend of an output created in the same block is not fetched.
+    CMutableTransaction child;
+    child.vin.emplace_back(COutPoint(txs[0].GetHash(), 0));
+    child.vout.emplace_back(COIN, op_true);
+    txs.push_back(child);
+    const CBlock block{CreateBlock(txs, op_true, chainstate)};
+
+    {
+        LOCK(cs_main);
+        for (size_t i{0}; i < num_outputs; ++i) {
+            chainstate.CoinsTip().Uncache(COutPoint(fan_out_tx.GetHash(), i));
+            BOOST_CHECK(!chainstate.CoinsTip().HaveCoinInCache(COutPoint(fan_out_tx.GetHash(), i)));
+        }
+        const size_t cache_size{chainstate.CoinsTip().GetCacheSize()};
+        chainstate.FetchInputs(block);
+        for (size_t i{0}; i < num_outputs; ++i) {
+            BOOST_CHECK(chainstate.CoinsTip().HaveCoinInCache(COutPoint(fan_out_tx.GetHash(), i)));
+        }
+        BOOST_CHECK_EQUAL(chainstate.CoinsTip().GetCacheSize(), cache_size + num_outputs);
+    }
+
+    // The block connects on top of the fetched coins.
+    BOOST_CHECK(m_node.chainman->ProcessNewBlock(std::make_shared<const CBlock>(block), /*force_processing=*/true, /*min_pow_checked=*/true, /*new_block=*/nullptr));
+    BOOST_CHECK_EQUAL(WITH_LOCK(cs_main, return chainstate.m_chain.Tip()->GetBlockHash()), block.GetHash());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -12,8 +12,12 @@
 #include <random.h>
 #include <serialize.h>
 #include <uint256.h>
+#include <util/check.h>
+#include <util/threadnames.h>
+#include <util/time.h>
 #include <util/vector.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <iterator>
@@ -71,6 +75,16 @@ std::optional<Coin> CCoinsViewDB::GetCoin(const COutPoint& outpoint) const
     return std::nullopt;
 }
 
+void CCoinsViewDB::GetCoins(std::span<const COutPoint> outpoints, std::span<std::optional<Coin>> coins) const
+{
+    assert(outpoints.size() == coins.size());
+    std::vector<CoinEntry> entries;
+    entries.reserve(outpoints.size());
+    for (const COutPoint& outpoint : outpoints) entries.emplace_back(&outpoint);
+    auto values{m_db->MultiRead<Coin>(entries)};
+    std::ranges::move(values, coins.begin());
+}
+
 bool CCoinsViewDB::HaveCoin(const COutPoint &outpoint) const {
     return m_db->Exists(CoinEntry(&outpoint));
 }
@@ -231,3 +245,174 @@ void CCoinsViewDBCursor::Next()
         keyTmp.first = entry.key;
     }
 }
+
+CCoinsViewBackgroundWriter::CCoinsViewBackgroundWriter(CCoinsView* base, bool background)
+    : CCoinsViewBacked{base}, m_background{background} {}
+
+CCoinsViewBackgroundWriter::~CCoinsViewBackgroundWriter()
+{
+    std::thread thread;
+    {
+        LOCK(m_mutex);
+        m_stop = true;
+        std::swap(thread, m_thread);
+    }
+    m_cv.notify_all();
+    // The thread finishes the write in progress, if any, before it stops.
+    if (thread.joinable()) thread.join();
+}
+
+std::shared_ptr<const CCoinsViewBackgroundWriter::Snapshot> CCoinsViewBackgroundWriter::GetSnapshot() const
+{
+    return WITH_LOCK(m_mutex, return m_snapshot);
+}
+
+std::optional<Coin> CCoinsViewBackgroundWriter::GetCoin(const COutPoint& outpoint) const
+{
+    if (const auto snapshot{GetSnapshot()}) {
+        if (const auto it{snapshot->coins.find(outpoint)}; it != snapshot->coins.end()) {
+            if (it->second.coin.IsSpent()) return std::nullopt;
+            return it->second.coin;
+        }
+    }
+    return base->GetCoin(outpoint);
+}
+
+void CCoinsViewBackgroundWriter::GetCoins(std::span<const COutPoint> outpoints, std::span<std::optional<Coin>> coins) const
+{
+    assert(outpoints.size() == coins.size());
+    const auto snapshot{GetSnapshot()};
+    if (!snapshot) {
+        base->GetCoins(outpoints, coins);
+        return;
+    }
+
+    // Read the coins the snapshot does not have from the base view together.
+    std::vector<size_t> missing;
+    for (size_t i{0}; i < outpoints.size(); ++i) {
+        if (const auto it{snapshot->coins.find(outpoints[i])}; it != snapshot->coins.end()) {
+            if (it->second.coin.IsSpent()) {
+                coins[i].reset();
+            } else {
+                coins[i] = it->second.coin;
+            }
+        } else {
+            missing.push_back(i);
+        }
+    }
+    if (missing.empty()) return;
+    std::vector<COutPoint> missing_outpoints;
+    missing_outpoints.reserve(missing.size());
+    for (const size_t i : missing) missing_outpoints.push_back(outpoints[i]);
+    std::vector<std::optional<Coin>> missing_coins(missing.size());
+    base->GetCoins(missing_outpoints, missing_coins);
+    for (size_t j{0}; j < missing.size(); ++j) coins[missing[j]] = std::move(missing_coins[j]);
+}
+
+bool CCoinsViewBackgroundWriter::HaveCoin(const COutPoint& outpoint) const
+{
+    if (const auto snapshot{GetSnapshot()}) {
+        if (const auto it{snapshot->coins.find(outpoint)}; it != snapshot->coins.end()) {
+            return !it->second.coin.IsSpent();
+        }
+    }
+    return base->HaveCoin(outpoint);
+}
+
+uint256 CCoinsViewBackgroundWriter::GetBestBlock() const
+{
+    if (const auto snapshot{GetSnapshot()}) return snapshot->best_block;
+    return base->GetBestBlock();
+}
+
+std::unique_ptr<CCoinsViewCursor> CCoinsViewBackgroundWriter::Cursor() const
+{
+    Wait();
+    return base->Cursor();
+}
+
+bool CCoinsViewBackgroundWriter::BatchWrite(CoinsViewCacheCursor& cursor, const uint256& hashBlock)
+{
+    const bool defer{std::exchange(m_defer_next, false)};
+    // Writes reach the base view in order, one snapshot at a time.
+    if (!Wait()) return false;
+    if (!defer) return base->BatchWrite(cursor, hashBlock);
+
+    const auto time_start{SteadyClock::now()};
+    auto snapshot{std::make_shared<Snapshot>()};
+    snapshot->best_block = hashBlock;
+    for (auto it{cursor.Begin()}; it != cursor.End();) {
+        if (it->second.IsDirty()) {
+            // The coins of entries the cache drops anyway can be moved rather than copied.
+            Coin coin{cursor.WillErase(*it) ? std::move(it->second.coin) : it->second.coin};
+            auto [entry, inserted]{snapshot->coins.try_emplace(it->first, std::move(coin))};
+            Assume(inserted);
+            CCoinsCacheEntry::SetDirty(*entry, snapshot->sentinel);
+        }
+        it = cursor.NextAndMaybeErase(*it);
+    }
+    LogDebug(BCLog::COINDB, "Deferred writing %u changed transaction outputs to the coin database (%.2fms)",
+             snapshot->coins.size(), Ticks<MillisecondsDouble>(SteadyClock::now() - time_start));
+
+    {
+        LOCK(m_mutex);
+        m_snapshot = std::move(snapshot);
+        if (!m_thread.joinable()) {
+            m_thread = std::thread{[this] {
+                util::ThreadRename("coinswriter");
+                ThreadWrite();
+            }};
+        }
+    }
+    m_cv.notify_all();
+    return true;
+}
+
+bool CCoinsViewBackgroundWriter::Wait() const
+{
+    WAIT_LOCK(m_mutex, lock);
+    m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return !m_snapshot || m_failed; });
+    return !m_failed;
+}
+
+bool CCoinsViewBackgroundWriter::Failed() const
+{
+    return WITH_LOCK(m_mutex, return m_failed);
+}
+
+void CCoinsViewBackgroundWriter::ThreadWrite()
+{
+    WAIT_LOCK(m_mutex, lock);
+    while (true) {
+        m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return (m_snapshot && !m_failed) || m_stop; });
+        if (!m_snapshot || m_failed) return;
+        auto snapshot{m_snapshot};
+
+        bool ok{false};
+        {
+            REVERSE_LOCK(lock, m_mutex);
+            const auto time_start{SteadyClock::now()};
+            // Nothing else modifies the snapshot, and a cursor that will erase leaves it untouched.
+            CoinsViewCacheCursor cursor{snapshot->sentinel, snapshot->coins, /*will_erase=*/true};
+            try {
+                ok = base->BatchWrite(cursor, snapshot->best_block);
+            } catch (const std::exception& e) {
+                LogError("Failed to write coins to the database in the background: %s", e.what());
+            }
+            LogDebug(BCLog::COINDB, "Wrote %u changed transaction outputs to the coin database in the background (%.2fms)",
+                     snapshot->coins.size(), Ticks<MillisecondsDouble>(SteadyClock::now() - time_start));
+        }
+
+        if (ok) {
+            m_snapshot.reset();
+        } else {
+            m_failed = true;
+        }
+        m_cv.notify_all();
+        {
+            // Free the written coins without holding up readers.
+            REVERSE_LOCK(lock, m_mutex);
+            snapshot.reset();
+        }
+    }
+}
@@ -13,21 +13,29 @@
 #include <sync.h>
 #include <util/fs.h>
 
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <span>
+#include <thread>
 #include <vector>
 
 class COutPoint;
 class uint256;
 
+//! -dbbackgroundflush default
+static constexpr bool DEFAULT_DB_BACKGROUND_FLUSH{false};
+
 //! User-controlled performance and debug options.
 struct CoinsViewOptions {
     //! Maximum database write batch size in bytes.
     size_t batch_write_bytes{DEFAULT_DB_CACHE_BATCH};
     //! If non-zero, randomly exit when the database is flushed with (1/ratio) probability.
     int simulate_crash_ratio{0};
+    //! Write flushed coins to the database on a background thread (see CCoinsViewBackgroundWriter).
+    bool background_flush{DEFAULT_DB_BACKGROUND_FLUSH};
 };
 
 /** CCoinsView backed by the coin database (chainstate/) */
@@ -41,6 +49,8 @@ public:
     explicit CCoinsViewDB(DBParams db_params, CoinsViewOptions options);
 
     std::optional<Coin> GetCoin(const COutPoint& outpoint) const override;
+    //! Read the coins with CDBWrapper::MultiRead(), from one snapshot of the database.
+    void GetCoins(std::span<const COutPoint> outpoints, std::span<std::optional<Coin>> coins) const override;
     bool HaveCoin(const COutPoint &outpoint) const override;
     uint256 GetBestBlock() const override;
     std::vector<uint256> GetHeadBlocks() const override;
@@ -55,4 +65,75 @@ public:
     void ResizeCache(size_t new_cache_size) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 };
 
+/**
+ * CCoinsView that can write the coins flushed into it to its base view on a
+ * background thread, so that flushing a large coins cache does not hold up
+ * the caller for as long as the database write takes.
+ *
+ * A deferred BatchWrite() only moves the dirty entries into a snapshot and
+ * returns. The snapshot is then written to the base view, which CCoinsViewDB
+ * does in batches of -dbbatchsize, marking the database as being between the
+ * old and the new best block until the last one (see GetHeadBlocks()). A
+ * crash during the write is recovered from on startup, as for a foreground
+ * flush. Until the snapshot is written, reads are answered from it first, so
+ * this view always reflects every write made to it.
+ *
+ * Only one snapshot is held at a time: a write waits for the previous one to
+ * complete. The snapshot takes memory on top of the cache it was flushed from.
+ */
+class CCoinsViewBackgroundWriter final : public CCoinsViewBacked
+{
+public:
+    //! If background is false, all writes go straight through to the base view.
+    CCoinsViewBackgroundWriter(CCoinsView* base, bool background);
+    ~CCoinsViewBackgroundWriter();
+
+    CCoinsViewBackgroundWriter(const CCoinsViewBackgroundWriter&) = delete;
+    CCoinsViewBackgroundWriter& operator=(const CCoinsViewBackgroundWriter&) = delete;
+
+    std::optional<Coin> GetCoin(const COutPoint& outpoint) const override;
+    void GetCoins(std::span<const COutPoint> outpoints, std::span<std::optional<Coin>> coins) const override;
+    bool HaveCoin(const COutPoint& outpoint) const override;
+    uint256 GetBestBlock() const override;
+    bool BatchWrite(CoinsViewCacheCursor& cursor, const uint256& hashBlock) override;
+    std::unique_ptr<CCoinsViewCursor> Cursor() const override;
+
+    //! Let the next BatchWrite() return before its coins are written to the base view, if
+    //! background writes are enabled.
+    void DeferNextWrite() { m_defer_next = m_background; }
+
+    //! Wait until no write is in progress.
+    //! @returns false if a background write failed, in which case the base view is not consistent
+    bool Wait() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    //! @returns whether a background write failed
+    bool Failed() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    //! Coins flushed into this view and not yet written to the base view
+    struct Snapshot {
+        CCoinsMapMemoryResource resource;
+        //! Declared before the map: the entries unlink themselves when destroyed.
+        CoinsCachePair sentinel;
+        CCoinsMap coins{0, SaltedOutpointHasher{/*deterministic=*/true}, CCoinsMap::key_equal{}, &resource};
+        uint256 best_block;
+
+        Snapshot() { sentinel.second.SelfRef(sentinel); }
+    };
+
+    std::shared_ptr<const Snapshot> GetSnapshot() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void ThreadWrite() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    const bool m_background;
+    bool m_defer_next{false};
+
+    mutable Mutex m_mutex;
+    mutable std::condition_variable m_cv;
+    //! Being written by the background thread. Kept if that fails, so reads stay correct.
+    std::shared_ptr<Snapshot> m_snapshot GUARDED_BY(m_mutex);
+    bool m_failed GUARDED_BY(m_mutex){false};
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::thread m_thread GUARDED_BY(m_mutex);
+};
+
 #endif // BITCOIN_TXDB_H
@@ -290,6 +290,7 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
     cachedInnerUsage -= it->DynamicMemoryUsage();
     mapTx.erase(it);
     nTransactionsUpdated++;
+    m_unchanged_mempool_selection.reset();
 }
 
 // Calculates descendants of given entry and adds to setDescendants.
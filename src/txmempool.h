@@ -20,6 +20,7 @@
 #include <primitives/transaction_identifier.h>
 #include <sync.h>
 #include <txgraph.h>
+#include <uint256.h>
 #include <util/epochguard.h>
 #include <util/feefrac.h>
 #include <util/hasher.h>
@@ -265,6 +266,22 @@ public:
     mutable std::unique_ptr<TxGraph::BlockBuilder> m_builder GUARDED_BY(cs);
     indexed_transaction_set mapTx GUARDED_BY(cs);
 
+    /**
+     * Transactions picked by a block building pass, see node::BlockAssembler.
+     * This is not maintained as the mempool changes: it is only reused while
+     * the mempool is exactly as it was when the selection was made.
+     */
+    struct UnchangedMempoolSelection {
+        //! Chain tip and block limits the selection was made for, as hashed by the caller
+        uint256 key;
+        //! GetTransactionsUpdated() when the selection was made
+        unsigned int transactions_updated;
+        //! Selected entries, in block order
+        std::vector<CTxMemPoolEntry::CTxMemPoolEntryRef> entries;
+        //! Feerates of the selected chunks, in block order
+        std::vector<FeePerVSize> chunk_feerates;
+    };
+
     using txiter = indexed_transaction_set::nth_index<0>::type::const_iterator;
     std::vector<std::pair<Wtxid, txiter>> txns_randomized GUARDED_BY(cs); //!< All transactions in mapTx with their wtxids, in arbitrary order
 
@@ -763,6 +780,22 @@ public:
     void IncludeBuilderChunk() const EXCLUSIVE_LOCKS_REQUIRED(cs) { m_builder->Include(); }
     void SkipBuilderChunk() const EXCLUSIVE_LOCKS_REQUIRED(cs) { m_builder->Skip(); }
     void StopBlockBuilding() const EXCLUSIVE_LOCKS_REQUIRED(cs) { m_builder.reset(); }
+
+    /**
+     * Return the selection cached for key, as long as no transaction has been
+     * added, removed or prioritised since it was made, so that a new walk over
+     * the block builder chunks would pick the same entries. Otherwise nullptr.
+     */
+    const UnchangedMempoolSelection* GetUnchangedMempoolSelection(const uint256& key) const EXCLUSIVE_LOCKS_REQUIRED(cs)
+    {
+        if (!m_unchanged_mempool_selection || m_unchanged_mempool_selection->key != key || m_unchanged_mempool_selection->transactions_updated != nTransactionsUpdated) return nullptr;
+        return &*m_unchanged_mempool_selection;
+    }
+    void CacheUnchangedMempoolSelection(UnchangedMempoolSelection selection) const EXCLUSIVE_LOCKS_REQUIRED(cs) { m_unchanged_mempool_selection = std::move(selection); }
+
+private:
+    //! Last selection made by a block building pass, reusable only while the mempool is unchanged. Dropped when any entry is removed, as it holds references to entries.
+    mutable std::optional<UnchangedMempoolSelection> m_unchanged_mempool_selection GUARDED_BY(cs);
 };
 
 /**
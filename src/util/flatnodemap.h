@@ -0,0 +1,329 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_UTIL_FLATNODEMAP_H
+#define BITCOIN_UTIL_FLATNODEMAP_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * Hash map with an open-addressing index over individually allocated nodes.
+ *
+ * The index is two flat arrays probed linearly: one control byte per slot,
+ * holding 7 bits of the key's hash (or marking the slot empty or deleted),
+ * and the matching node pointers. A lookup scans the contiguous control
+ * bytes and only dereferences a node whose hash bits match, so a miss
+ * usually touches no node at all, unlike the bucket chains of
+ * std::unordered_map. Nodes carry no chain pointer.
+ *
+ * The elements themselves stay in nodes from the allocator, so references
+ * and pointers to them remain valid until they are erased, as for
+ * std::unordered_map. Iterators are invalidated by an insertion that grows
+ * the index. The interface is the subset of std::unordered_map that its
+ * users need.
+ */
+template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class FlatNodeMap
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Allocator;
+
+private:
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    static constexpr uint8_t EMPTY{0x80};
+    static constexpr uint8_t DELETED{0xFE};
+    static constexpr size_type MIN_CAPACITY{16};
+
+    static constexpr bool IsFull(uint8_t ctrl) { return !(ctrl & 0x80); }
+    static constexpr uint8_t H2(size_t hash) { return hash & 0x7F; }
+    static constexpr size_t H1(size_t hash) { return hash >> 7; }
+    //! Elements plus deleted slots allowed before the index grows, at a load factor of 7/8
+    static constexpr size_type MaxLoad(size_type capacity) { return capacity - capacity / 8; }
+
+    template <bool Const>
+    class Iterator
+    {
+        using Map = std::conditional_t<Const, const FlatNodeMap, FlatNodeMap>;
+        Map* m_map{nullptr};
+        size_type m_index{0};
+
+        void SkipFree()
+        {
+            while (m_index < m_map->m_ctrl.size() && !IsFull(m_map->m_ctrl[m_index])) ++m_index;
+        }
+
+        friend class FlatNodeMap;
+        Iterator(Map* map, size_type index, bool skip) : m_map{map}, m_index{index}
+        {
+            if (skip) SkipFree();
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FlatNodeMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+        Iterator() = default;
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        Iterator(const Iterator<false>& other) : m_map{other.m_map}, m_index{other.m_index} {}
+
+        reference operator*() const { return *m_map->m_slots[m_index]; }
+        pointer operator->() const { return m_map->m_slots[m_index]; }
+        Iterator& operator++()
+        {
+            ++m_index;
+            SkipFree();
+            return *this;
+        }
+        Iterator operator++(int)
+        {
+            Iterator ret{*this};
+            ++*this;
+            return ret;
+        }
+        friend bool operator==(const Iterator& a, const Iterator& b) { return a.m_index == b.m_index; }
+    };
+
+    Hash m_hash;
+    KeyEqual m_equal;
+    Allocator m_alloc;
+    std::vector<uint8_t> m_ctrl;
+    std::vector<value_type*> m_slots;
+    size_type m_size{0};
+    size_type m_deleted{0};
+
+    size_type Mask() const { return m_ctrl.size() - 1; }
+
+    /** Slot holding key, or the index size if there is none. */
+    size_type FindSlot(const Key& key) const
+    {
+        if (m_ctrl.empty()) return 0;
+        const size_t hash{m_hash(key)};
+        const uint8_t h2{H2(hash)};
+        for (size_type i{H1(hash) & Mask()};; i = (i + 1) & Mask()) {
+            const uint8_t ctrl{m_ctrl[i]};
+            if (ctrl == EMPTY) return m_ctrl.size();
+            if (ctrl == h2 && m_equal(m_slots[i]->first, key)) return i;
+        }
+    }
+
+    /** Slot holding key, or else the slot to insert it at, after making room for it. */
+    std::pair<size_type, bool> FindOrPrepareInsert(const Key& key)
+    {
+        if (m_size + m_deleted + 1 > MaxLoad(m_ctrl.size())) {
+            // Grow if the elements themselves need the room, otherwise just drop the deleted slots.
+            Rehash(m_size + 1 > MaxLoad(m_ctrl.size()) / 2 ? std::max(MIN_CAPACITY, m_ctrl.size() * 2) : m_ctrl.size());
+        }
+        const size_t hash{m_hash(key)};
+        const uint8_t h2{H2(hash)};
+        size_type insert_at{m_ctrl.size()};
+        for (size_type i{H1(hash) & Mask()};; i = (i + 1) & Mask()) {
+            const uint8_t ctrl{m_ctrl[i]};
+            if (ctrl == EMPTY) {
+                if (insert_at == m_ctrl.size()) insert_at = i;
+                break;
+            }
+            if (ctrl == DELETED) {
+                if (insert_at == m_ctrl.size()) insert_at = i;
+            } else if (ctrl == h2 && m_equal(m_slots[i]->first, key)) {
+                return {i, false};
+            }
+        }
+        if (m_ctrl[insert_at] == DELETED) --m_deleted;
+        m_ctrl[insert_at] = h2;
+        return {insert_at, true};
+    }
+
+    void Rehash(size_type capacity)
+    {
+        std::vector<uint8_t> ctrl(capacity, EMPTY);
+        std::vector<value_type*> slots(capacity, nullptr);
+        for (size_type j{0}; j < m_ctrl.size(); ++j) {
+            if (!IsFull(m_ctrl[j])) continue;
+            const size_t hash{m_hash(m_slots[j]->first)};
+            size_type i{H1(hash) & (capacity - 1)};
+            while (ctrl[i] != EMPTY) i = (i + 1) & (capacity - 1);
+            ctrl[i] = H2(hash);
+            slots[i] = m_slots[j];
+        }
+        m_ctrl = std::move(ctrl);
+        m_slots = std::move(slots);
+        m_deleted = 0;
+    }
+
+    template <typename... Args>
+    value_type* NewNode(Args&&... args)
+    {
+        value_type* node{AllocTraits::allocate(m_alloc, 1)};
+        try {
+            AllocTraits::construct(m_alloc, node, std::forward<Args>(args)...);
+        } catch (...) {
+            AllocTraits::deallocate(m_alloc, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void DeleteNode(value_type* node)
+    {
+        AllocTraits::destroy(m_alloc, node);
+        AllocTraits::deallocate(m_alloc, node, 1);
+    }
+
+    void EraseSlot(size_type i)
+    {
+        value_type* node{m_slots[i]};
+        // A probe for any other key would have stopped at an empty next slot
+        // anyway, so this slot can be made empty rather than deleted.
+        if (m_ctrl[(i + 1) & Mask()] == EMPTY) {
+            m_ctrl[i] = EMPTY;
+        } else {
+            m_ctrl[i] = DELETED;
+            ++m_deleted;
+        }
+        m_slots[i] = nullptr;
+        --m_size;
+        DeleteNode(node);
+    }
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    explicit FlatNodeMap(size_type bucket_count = 0, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(), const Allocator& alloc = Allocator())
+        : m_hash{hash}, m_equal{equal}, m_alloc{alloc}
+    {
+        reserve(bucket_count);
+    }
+
+    ~FlatNodeMap() { clear(); }
+
+    FlatNodeMap(const FlatNodeMap&) = delete;
+    FlatNodeMap& operator=(const FlatNodeMap&) = delete;
+
+    iterator begin() { return {this, 0, true}; }
+    iterator end() { return {this, m_ctrl.size(), false}; }
+    const_iterator begin() const { return {this, 0, true}; }
+    const_iterator end() const { return {this, m_ctrl.size(), false}; }
+
+    //! First element at or after index slot i, to walk the map starting from a given point
+    iterator begin_at(size_type i) { return {this, std::min(i, m_ctrl.size()), true}; }
+    //! Index slot of an element, stable until the index grows
+    size_type slot(const_iterator it) const { return it.m_index; }
+
+    size_type size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    //! Number of slots in the index
+    size_type bucket_count() const { return m_ctrl.size(); }
+    allocator_type get_allocator() const { return m_alloc; }
+
+    /** Erase all elements. The index keeps its size, as std::unordered_map keeps its buckets. */
+    void clear()
+    {
+        for (size_type i{0}; i < m_ctrl.size(); ++i) {
+            if (IsFull(m_ctrl[i])) DeleteNode(m_slots[i]);
+            m_ctrl[i] = EMPTY;
+            m_slots[i] = nullptr;
+        }
+        m_size = 0;
+        m_deleted = 0;
+    }
+
+    /** Size the index for count elements, so that inserting them does not grow it. */
+    void reserve(size_type count)
+    {
+        if (count == 0) return;
+        const size_type capacity{std::bit_ceil(std::max(MIN_CAPACITY, count + count / 7 + 1))};
+        if (capacity > m_ctrl.size()) Rehash(capacity);
+    }
+
+    iterator find(const Key& key) { return {this, FindSlot(key), false}; }
+    const_iterator find(const Key& key) const { return {this, FindSlot(key), false}; }
+    bool contains(const Key& key) const { return FindSlot(key) != m_ctrl.size(); }
+    size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+    T& at(const Key& key)
+    {
+        const size_type i{FindSlot(key)};
+        if (i == m_ctrl.size()) throw std::out_of_range("FlatNodeMap::at");
+        return m_slots[i]->second;
+    }
+    const T& at(const Key& key) const
+    {
+        const size_type i{FindSlot(key)};
+        if (i == m_ctrl.size()) throw std::out_of_range("FlatNodeMap::at");
+        return m_slots[i]->second;
+    }
+
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+    {
+        const auto [i, inserted]{FindOrPrepareInsert(key)};
+        if (inserted) {
+            try {
+                m_slots[i] = NewNode(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+            } catch (...) {
+                // The slot may be in the middle of another key's probe sequence.
+                m_ctrl[i] = DELETED;
+                ++m_deleted;
+                throw;
+            }
+            ++m_size;
+        }
+        return {iterator{this, i, false}, inserted};
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        value_type* node{NewNode(std::forward<Args>(args)...)};
+        const auto [i, inserted]{FindOrPrepareInsert(node->first)};
+        if (!inserted) {
+            DeleteNode(node);
+            return {iterator{this, i, false}, false};
+        }
+        m_slots[i] = node;
+        ++m_size;
+        return {iterator{this, i, false}, true};
+    }
+
+    T& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+    iterator erase(const_iterator it)
+    {
+        EraseSlot(it.m_index);
+        return {this, it.m_index, true};
+    }
+    iterator erase(iterator it) { return erase(const_iterator{it}); }
+
+    size_type erase(const Key& key)
+    {
+        const size_type i{FindSlot(key)};
+        if (i == m_ctrl.size()) return 0;
+        EraseSlot(i);
+        return 1;
+    }
+};
+
+#endif // BITCOIN_UTIL_FLATNODEMAP_H
@@ -0,0 +1,42 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <util/mappedfile.h>
+
+#include <cstdint>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // WIN32
+
+std::unique_ptr<MappedFile> MappedFile::Open(const fs::path& path, size_t size)
+{
+#ifndef WIN32
+    if (!SUPPORTED || size == 0) return nullptr;
+    const int fd{open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (fd == -1) return nullptr;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<uint64_t>(st.st_size) < size) {
+        close(fd);
+        return nullptr;
+    }
+    void* data{mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0)};
+    // The mapping keeps its own reference to the file.
+    close(fd);
+    if (data == MAP_FAILED) return nullptr;
+    return std::unique_ptr<MappedFile>{new MappedFile{static_cast<const std::byte*>(data), size}};
+#else
+    return nullptr;
+#endif // WIN32
+}
+
+MappedFile::~MappedFile()
+{
+#ifndef WIN32
+    munmap(const_cast<std::byte*>(m_data), m_size);
+#endif // WIN32
+}
@@ -0,0 +1,56 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_UTIL_MAPPEDFILE_H
+#define BITCOIN_UTIL_MAPPEDFILE_H
+
+#include <util/fs.h>
+
+#include <cstddef>
+#include <memory>
+#include <span>
+
+/**
+ * Read-only memory mapping of the start of a file.
+ *
+ * The file must not shrink below the mapped size while it is mapped:
+ * accessing a page past the end of the file faults. The mapping stays valid
+ * when the file is deleted.
+ */
+class MappedFile
+{
+public:
+    /** Whether files can be mapped on this platform. */
+    static constexpr bool SUPPORTED{
+#ifndef WIN32
+        sizeof(void*) >= 8
+#else
+        false
+#endif
+    };
+
+    /**
+     * Map the first size bytes of the file at path.
+     *
+     * @returns the mapping, or nullptr if the file cannot be opened or mapped
+     *          (or mapping is not supported)
+     */
+    static std::unique_ptr<MappedFile> Open(const fs::path& path, size_t size);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::span<const std::byte> data() const { return {m_data, m_size}; }
+    size_t size() const { return m_size; }
+
+private:
+    MappedFile(const std::byte* data, size_t size) : m_data{data}, m_size{size} {}
+
+    const std::byte* const m_data;
+    const size_t m_size;
+};
+
+#endif // BITCOIN_UTIL_MAPPEDFILE_H
@@ -17,6 +17,7 @@
 #include <consensus/tx_check.h>
 #include <consensus/tx_verify.h>
 #include <consensus/validation.h>
+#include <core_memusage.h>
 #include <cuckoocache.h>
 #include <flatfile.h>
 #include <hash.h>
@@ -30,6 +31,9 @@
 #include <kernel/warning.h>
 #include <logging.h>
 #include <logging/timer.h>
+#include <memusage.h>
+#include <node/blockcompression.h>
+#include <node/blockfilescanner.h>
 #include <node/blockstorage.h>
 #include <node/utxo_snapshot.h>
 #include <policy/ephemeral_policy.h>
@@ -68,12 +72,14 @@
 #include <cassert>
 #include <chrono>
 #include <deque>
+#include <iterator>
 #include <numeric>
 #include <optional>
 #include <ranges>
 #include <span>
 #include <string>
 #include <tuple>
+#include <unordered_set>
 #include <utility>
 
 using kernel::CCoinsStats;
@@ -91,6 +97,8 @@ using node::SnapshotMetadata;
 
 /** Size threshold for warning about slow UTXO set flush to disk. */
 static constexpr size_t WARN_FLUSH_COINS_SIZE = 1 << 30; // 1 GiB
+/** Share of the coins cache budget that unused coins are evicted down to when the cache fills up. */
+static constexpr size_t COINS_CACHE_EVICT_TARGET_PERCENT{75};
 /** Time window to wait between writing blocks/block index and chainstate to disk.
  *  Randomize writing time inside the window to prevent a situation where the
  *  network over time settles into a few cohorts of synchronized writers.
@@ -1201,6 +1209,8 @@ bool MemPoolAccept::ConsensusScriptChecks(const ATMPArgs& args, Workspace& ws)
         return Assume(false);
     }
 
+    // Keep the sighash midstates for when the transaction is connected in a block.
+    GetValidationCache().m_txdata_cache.Add(tx, ws.m_precomputed_txdata);
     return true;
 }
 
@@ -1866,8 +1876,9 @@ CAmount GetBlockSubsidy(int nHeight, const Consensus::Params& consensusParams)
 }
 
 CoinsViews::CoinsViews(DBParams db_params, CoinsViewOptions options)
-    : m_dbview{std::move(db_params), std::move(options)},
-      m_catcherview(&m_dbview) {}
+    : m_dbview{std::move(db_params), options},
+      m_writerview{&m_dbview, options.background_flush},
+      m_catcherview(&m_writerview) {}
 
 void CoinsViews::InitCache()
 {
@@ -1884,7 +1895,12 @@ Chainstate::Chainstate(
       m_blockman(blockman),
       m_chainman(chainman),
       m_assumeutxo(from_snapshot_blockhash ? Assumeutxo::UNVALIDATED : Assumeutxo::VALIDATED),
-      m_from_snapshot_blockhash(from_snapshot_blockhash) {}
+      m_from_snapshot_blockhash(from_snapshot_blockhash),
+      m_block_read_ahead{blockman, [&chainman](CBlock& block) {
+          // Context-free checks only: ConnectBlock() skips them for a block that passed.
+          BlockValidationState state;
+          CheckBlock(block, state, chainman.GetConsensus());
+      }} {}
 
 fs::path Chainstate::StoragePath() const
 {
@@ -2053,10 +2069,18 @@ void UpdateCoins(const CTransaction& tx, CCoinsViewCache& inputs, CTxUndo &txund
 }
 
 std::optional<std::pair<ScriptError, std::string>> CScriptCheck::operator()() {
+    return Check(nullptr);
+}
+
+std::optional<std::pair<ScriptError, std::string>> CScriptCheck::operator()(SchnorrBatch& batch) {
+    return Check(&batch);
+}
+
+std::optional<std::pair<ScriptError, std::string>> CScriptCheck::Check(SchnorrBatch* batch) {
     const CScript &scriptSig = ptxTo->vin[nIn].scriptSig;
     const CScriptWitness *witness = &ptxTo->vin[nIn].scriptWitness;
     ScriptError error{SCRIPT_ERR_UNKNOWN_ERROR};
-    if (VerifyScript(scriptSig, m_tx_out.scriptPubKey, witness, m_flags, CachingTransactionSignatureChecker(ptxTo, nIn, m_tx_out.nValue, cacheStore, *m_signature_cache, *txdata), &error)) {
+    if (VerifyScript(scriptSig, m_tx_out.scriptPubKey, witness, m_flags, CachingTransactionSignatureChecker(ptxTo, nIn, m_tx_out.nValue, cacheStore, *m_signature_cache, *txdata, batch), &error)) {
         return std::nullopt;
     } else {
         auto debug_str = strprintf("input %i of %s (wtxid %s), spending %s:%i", nIn, ptxTo->GetHash().ToString(), ptxTo->GetWitnessHash().ToString(), ptxTo->vin[nIn].prevout.hash.ToString(), ptxTo->vin[nIn].prevout.n);
@@ -2064,8 +2088,8 @@ std::optional<std::pair<ScriptError, std::string>> CScriptCheck::operator()() {
     }
 }
 
-ValidationCache::ValidationCache(const size_t script_execution_cache_bytes, const size_t signature_cache_bytes)
-    : m_signature_cache{signature_cache_bytes}
+ValidationCache::ValidationCache(const size_t script_execution_cache_bytes, const size_t signature_cache_bytes, bool signature_cache_pin)
+    : m_signature_cache{signature_cache_bytes, signature_cache_pin}
 {
     // Setup the salted hasher
     uint256 nonce = GetRandHash();
@@ -2075,9 +2099,60 @@ ValidationCache::ValidationCache(const size_t script_execution_cache_bytes, cons
     m_script_execution_cache_hasher.Write(nonce.begin(), 32);
     m_script_execution_cache_hasher.Write(nonce.begin(), 32);
 
-    const auto [num_elems, approx_size_bytes] = m_script_execution_cache.setup_bytes(script_execution_cache_bytes);
+    const auto [num_elems, approx_size_bytes] = m_script_execution_cache.Resize(script_execution_cache_bytes);
+    LogInfo("Using %zu MiB out of %zu MiB requested for script execution cache, able to store %zu elements",
+              approx_size_bytes >> 20, script_execution_cache_bytes >> 20, num_elems);
+}
+
+void ValidationCache::Resize(const size_t script_execution_cache_bytes, const size_t signature_cache_bytes)
+{
+    const auto [num_elems, approx_size_bytes] = m_script_execution_cache.Resize(script_execution_cache_bytes);
     LogInfo("Using %zu MiB out of %zu MiB requested for script execution cache, able to store %zu elements",
               approx_size_bytes >> 20, script_execution_cache_bytes >> 20, num_elems);
+    m_signature_cache.Resize(signature_cache_bytes);
+}
+
+void PrecomputedTxDataCache::Erase(std::unordered_map<Wtxid, Entry, SaltedWtxidHasher>::iterator it)
+{
+    m_usage -= it->second.usage;
+    m_order.erase(it->second.order);
+    m_entries.erase(it);
+}
+
+void PrecomputedTxDataCache::Add(const CTransaction& tx, const PrecomputedTransactionData& txdata)
+{
+    if (!txdata.m_spent_outputs_ready) return;
+    size_t usage{sizeof(Entry) + sizeof(Wtxid) + memusage::DynamicUsage(txdata.m_spent_outputs)};
+    for (const CTxOut& out : txdata.m_spent_outputs) usage += RecursiveDynamicUsage(out);
+    if (usage > m_max_usage) return;
+
+    if (const auto it{m_entries.find(tx.GetWitnessHash())}; it != m_entries.end()) Erase(it);
+    while (m_usage + usage > m_max_usage) Erase(m_entries.find(m_order.front()));
+    m_order.push_back(tx.GetWitnessHash());
+    m_entries.emplace(tx.GetWitnessHash(), Entry{.txdata = txdata, .usage = usage, .order = std::prev(m_order.end())});
+    m_usage += usage;
+}
+
+bool PrecomputedTxDataCache::Get(const CTransaction& tx, const CCoinsViewCache& inputs, bool erase, PrecomputedTransactionData& txdata)
+{
+    const auto it{m_entries.find(tx.GetWitnessHash())};
+    if (it == m_entries.end()) return false;
+    // The wtxid commits to the outpoints spent, not to the outputs there, so check those.
+    const auto& spent_outputs{it->second.txdata.m_spent_outputs};
+    bool match{spent_outputs.size() == tx.vin.size()};
+    for (size_t i{0}; match && i < tx.vin.size(); ++i) {
+        const Coin& coin{inputs.AccessCoin(tx.vin[i].prevout)};
+        match = !coin.IsSpent() && coin.out == spent_outputs[i];
+    }
+    if (match) {
+        if (erase) {
+            txdata = std::move(it->second.txdata);
+        } else {
+            txdata = it->second.txdata;
+        }
+    }
+    if (erase || !match) Erase(it);
+    return match;
 }
 
 /**
@@ -2119,8 +2194,7 @@ bool CheckInputScripts(const CTransaction& tx, TxValidationState& state,
     uint256 hashCacheEntry;
     CSHA256 hasher = validation_cache.ScriptExecutionCacheHasher();
     hasher.Write(UCharCast(tx.GetWitnessHash().begin()), 32).Write((unsigned char*)&flags, sizeof(flags)).Finalize(hashCacheEntry.begin());
-    AssertLockHeld(cs_main); //TODO: Remove this requirement by making CuckooCache not require external locks
-    if (validation_cache.m_script_execution_cache.contains(hashCacheEntry, !cacheFullScriptStore)) {
+    if (validation_cache.m_script_execution_cache.Get(hashCacheEntry, !cacheFullScriptStore)) {
         return true;
     }
 
@@ -2168,7 +2242,7 @@ bool CheckInputScripts(const CTransaction& tx, TxValidationState& state,
     if (cacheFullScriptStore && !pvChecks) {
         // We executed all of the provided scripts, and were told to
         // cache the result. Do so now.
-        validation_cache.m_script_execution_cache.insert(hashCacheEntry);
+        validation_cache.m_script_execution_cache.Set(hashCacheEntry);
     }
 
     return true;
@@ -2615,6 +2689,7 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
         if (!tx.IsCoinBase() && fScriptChecks)
         {
             bool fCacheResults = fJustCheck; /* Don't cache results if we're actually connecting blocks (still consult the cache, though) */
+            m_chainman.m_validation_cache.m_txdata_cache.Get(tx, view, /*erase=*/!fJustCheck, txsdata[i]);
             bool tx_ok;
             TxValidationState tx_state;
             // If CheckInputScripts is called with a pointer to a checks vector, the resulting checks are appended to it. In that case
@@ -2727,7 +2802,7 @@ CoinsCacheSizeState Chainstate::GetCoinsCacheSizeState(
 {
     AssertLockHeld(::cs_main);
     const int64_t nMempoolUsage = m_mempool ? m_mempool->DynamicMemoryUsage() : 0;
-    int64_t cacheSize = CoinsTip().DynamicMemoryUsage();
+    int64_t cacheSize = CoinsTip().InUseMemoryUsage();
     int64_t nTotalSpace =
         max_coins_cache_size_bytes + std::max<int64_t>(int64_t(max_mempool_size_bytes) - nMempoolUsage, 0);
 
@@ -2755,6 +2830,9 @@ bool Chainstate::FlushStateToDisk(
 
     try {
     {
+        if (m_coins_views->m_writerview.Failed()) {
+            return FatalError(m_chainman.GetNotifications(), state, _("Failed to write to coin database."));
+        }
         bool fFlushForPrune = false;
 
         CoinsCacheSizeState cache_state = GetCoinsCacheSizeState();
@@ -2856,10 +2934,20 @@ bool Chainstate::FlushStateToDisk(
                     return FatalError(m_chainman.GetNotifications(), state, _("Disk space is too low!"));
                 }
                 // Flush the chainstate (which may refer to block index entries).
-                const auto empty_cache{(mode == FlushStateMode::ALWAYS) || fCacheLarge || fCacheCritical};
+                const auto empty_cache{mode == FlushStateMode::ALWAYS};
+                // Unless everything has to be on disk when we return, let the database
+                // write finish in the background while blocks keep being connected.
+                if (mode != FlushStateMode::ALWAYS) m_coins_views->m_writerview.DeferNextWrite();
                 if (empty_cache ? !CoinsTip().Flush() : !CoinsTip().Sync()) {
                     return FatalError(m_chainman.GetNotifications(), state, _("Failed to write to coin database."));
                 }
+                if (!empty_cache && (fCacheLarge || fCacheCritical)) {
+                    // Everything is on disk now, so make room by evicting the coins that were
+                    // not used lately, rather than emptying the cache and missing on the coins
+                    // the next blocks spend.
+                    const size_t evicted{CoinsTip().EvictClean(m_coinstip_cache_size_bytes * COINS_CACHE_EVICT_TARGET_PERCENT / 100)};
+                    LogDebug(BCLog::COINDB, "Evicted %u coins from the cache, %.2fKiB in use", evicted, CoinsTip().InUseMemoryUsage() / 1024.0);
+                }
                 full_flush_completed = true;
                 TRACEPOINT(utxocache, flush,
                     int64_t{Ticks<std::chrono::microseconds>(NodeClock::now() - nNow)},
@@ -3077,6 +3165,55 @@ public:
     }
 };
 
+void Chainstate::FetchInputs(const CBlock& block)
+{
+    AssertLockHeld(cs_main);
+    auto& queue{m_chainman.GetInputFetchQueue()};
+    if (!queue.HasThreads()) return;
+
+    const auto time_start{SteadyClock::now()};
+    std::unordered_set<Txid, SaltedTxidHasher> block_txids;
+    block_txids.reserve(block.vtx.size());
+    std::vector<COutPoint> outpoints;
+    for (const auto& tx : block.vtx) {
+        if (!tx->IsCoinBase()) {
+            for (const CTxIn& txin : tx->vin) {
+                // Outputs of earlier transactions in the block are not in the database yet.
+                if (block_txids.contains(txin.prevout.hash) || CoinsTip().HaveCoinInCache(txin.prevout)) continue;
+                outpoints.push_back(txin.prevout);
+            }
+        }
+        block_txids.insert(tx->GetHash());
+    }
+    // A few misses are cheaper to read in place than to hand out.
+    if (outpoints.size() <= INPUT_FETCH_SIZE) return;
+    // Coins are keyed by outpoint in the database, so each run covers a narrow range of keys.
+    std::sort(outpoints.begin(), outpoints.end());
+
+    std::vector<std::optional<Coin>> coins(outpoints.size());
+    std::vector<InputFetch> fetches;
+    fetches.reserve((outpoints.size() + INPUT_FETCH_SIZE - 1) / INPUT_FETCH_SIZE);
+    for (size_t i = 0; i < outpoints.size(); i += INPUT_FETCH_SIZE) {
+        const size_t count{std::min(INPUT_FETCH_SIZE, outpoints.size() - i)};
+        fetches.emplace_back(std::span{outpoints}.subspan(i, count), std::span{coins}.subspan(i, count), m_coins_views->m_writerview);
+    }
+    CCheckQueueControl<InputFetch> control{queue};
+    control.Add(std::move(fetches));
+    if (const auto failed{control.Complete()}) {
+        // Not fatal here: ConnectBlock() reads it again and reports the error.
+        LogDebug(BCLog::VALIDATION, "Failed to fetch input %s ahead of connecting block %s\n", failed->ToString(), block.GetHash().ToString());
+    }
+
+    size_t fetched{0};
+    for (size_t i = 0; i < outpoints.size(); ++i) {
+        if (!coins[i]) continue;
+        CoinsTip().AddFetchedCoin(outpoints[i], std::move(*coins[i]));
+        ++fetched;
+    }
+    LogDebug(BCLog::BENCH, "  - Fetch inputs: %.2fms [%u/%u coins]\n",
+             Ticks<MillisecondsDouble>(SteadyClock::now() - time_start), fetched, outpoints.size());
+}
+
 /**
  * Connect a new block to m_chain. block_to_connect is either nullptr or a pointer to a CBlock
  * corresponding to pindexNew, to bypass loading it again from disk.
@@ -3096,6 +3233,7 @@ bool Chainstate::ConnectTip(
     assert(pindexNew->pprev == m_chain.Tip());
     // Read block from disk.
     const auto time_1{SteadyClock::now()};
+    if (!block_to_connect) block_to_connect = m_block_read_ahead.Take(pindexNew->GetBlockHash());
     if (!block_to_connect) {
         std::shared_ptr<CBlock> pblockNew = std::make_shared<CBlock>();
         if (!m_blockman.ReadBlock(*pblockNew, *pindexNew)) {
@@ -3113,6 +3251,7 @@ bool Chainstate::ConnectTip(
     LogDebug(BCLog::BENCH, "  - Load block from disk: %.2fms\n",
              Ticks<MillisecondsDouble>(time_2 - time_1));
     {
+        FetchInputs(*block_to_connect);
         CCoinsViewCache view(&CoinsTip());
         bool rv = ConnectBlock(*block_to_connect, state, pindexNew, view);
         if (m_chainman.m_options.signals) {
@@ -3311,6 +3450,14 @@ bool Chainstate::ActivateBestChainStep(BlockValidationState& state, CBlockIndex*
         }
         nHeight = nTargetHeight;
 
+        // Read the blocks after the next one while it is being connected.
+        std::vector<std::pair<uint256, FlatFilePos>> read_ahead;
+        for (const CBlockIndex* pindex : vpindexToConnect | std::views::reverse | std::views::drop(1)) {
+            if (pindex == pindexMostWork && pblock) break;
+            read_ahead.emplace_back(pindex->GetBlockHash(), pindex->GetBlockPos());
+        }
+        m_block_read_ahead.Schedule(read_ahead);
+
         // Connect new blocks.
         for (CBlockIndex* pindexConnect : vpindexToConnect | std::views::reverse) {
             if (!ConnectTip(state, pindexConnect, pindexConnect == pindexMostWork ? pblock : std::shared_ptr<const CBlock>(), connectTrace, disconnectpool)) {
@@ -4100,12 +4247,54 @@ std::vector<unsigned char> ChainstateManager::GenerateCoinbaseCommitment(CBlock&
     return commitment;
 }
 
-bool HasValidProofOfWork(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams)
+bool HasValidProofOfWork(std::span<const CBlockHeader> headers, const Consensus::Params& consensusParams)
 {
-    return std::all_of(headers.cbegin(), headers.cend(),
+    return std::all_of(headers.begin(), headers.end(),
             [&](const auto& header) { return CheckProofOfWork(header.GetHash(), header.nBits, consensusParams);});
 }
 
+std::optional<uint256> HeaderPoWCheck::operator()() const
+{
+    for (const CBlockHeader& header : m_headers) {
+        const uint256 hash{header.GetHash()};
+        if (!CheckProofOfWork(hash, header.nBits, *m_params)) return hash;
+    }
+    return std::nullopt;
+}
+
+std::optional<COutPoint> InputFetch::operator()()
+{
+    try {
+        m_db->GetCoins(m_outpoints, m_coins);
+        return std::nullopt;
+    } catch (const std::exception&) {
+    }
+    // Read them one by one to find the one that fails.
+    for (size_t i{0}; i < m_outpoints.size(); ++i) {
+        try {
+            m_coins[i] = m_db->GetCoin(m_outpoints[i]);
+        } catch (const std::exception&) {
+            return m_outpoints[i];
+        }
+    }
+    return std::nullopt;
+}
+
+bool ChainstateManager::HasValidProofOfWork(std::span<const CBlockHeader> headers)
+{
+    if (!m_header_check_queue.HasThreads() || headers.size() <= HEADER_POW_CHECK_SIZE) {
+        return ::HasValidProofOfWork(headers, GetConsensus());
+    }
+    std::vector<HeaderPoWCheck> checks;
+    checks.reserve((headers.size() + HEADER_POW_CHECK_SIZE - 1) / HEADER_POW_CHECK_SIZE);
+    for (size_t i = 0; i < headers.size(); i += HEADER_POW_CHECK_SIZE) {
+        checks.emplace_back(headers.subspan(i, std::min(HEADER_POW_CHECK_SIZE, headers.size() - i)), GetConsensus());
+    }
+    CCheckQueueControl<HeaderPoWCheck> control{m_header_check_queue};
+    control.Add(std::move(checks));
+    return !control.Complete().has_value();
+}
+
 bool IsBlockMutated(const CBlock& block, bool check_witness_root)
 {
     BlockValidationState state;
@@ -4378,7 +4567,7 @@ void ChainstateManager::ReportHeadersPresync(const arith_uint256& work, int64_t
 }
 
 /** Store block on disk. If dbp is non-nullptr, the file is known to already reside on disk */
-bool ChainstateManager::AcceptBlock(const std::shared_ptr<const CBlock>& pblock, BlockValidationState& state, CBlockIndex** ppindex, bool fRequested, const FlatFilePos* dbp, bool* fNewBlock, bool min_pow_checked)
+bool ChainstateManager::AcceptBlock(const std::shared_ptr<const CBlock>& pblock, BlockValidationState& state, CBlockIndex** ppindex, bool fRequested, const FlatFilePos* dbp, bool* fNewBlock, bool min_pow_checked, std::optional<unsigned int> dbp_size)
 {
     const CBlock& block = *pblock;
 
@@ -4451,7 +4640,7 @@ bool ChainstateManager::AcceptBlock(const std::shared_ptr<const CBlock>& pblock,
         FlatFilePos blockPos{};
         if (dbp) {
             blockPos = *dbp;
-            m_blockman.UpdateBlockInfo(block, pindex->nHeight, blockPos);
+            m_blockman.UpdateBlockInfo(block, pindex->nHeight, blockPos, dbp_size);
         } else {
             blockPos = m_blockman.WriteBlock(block, pindex->nHeight);
             if (blockPos.IsNull()) {
@@ -5033,6 +5222,110 @@ bool Chainstate::LoadGenesisBlock()
     return true;
 }
 
+bool ChainstateManager::LoadExternalBlock(
+    const uint256& hash,
+    const uint256& prev_hash,
+    const FlatFilePos* dbp,
+    unsigned int stored_size,
+    const std::function<std::shared_ptr<const CBlock>()>& read_block,
+    std::multimap<uint256, FlatFilePos>* blocks_with_unknown_parent,
+    int& loaded)
+{
+    const CChainParams& params{GetParams()};
+
+    std::shared_ptr<const CBlock> pblock{}; // needs to remain available after the cs_main lock is released to avoid duplicate reads from disk
+
+    {
+        LOCK(cs_main);
+        // detect out of order blocks, and store them for later
+        if (hash != params.GetConsensus().hashGenesisBlock && !m_blockman.LookupBlockIndex(prev_hash)) {
+            LogDebug(BCLog::REINDEX, "%s: Out of order block %s, parent %s not known\n", __func__, hash.ToString(),
+                     prev_hash.ToString());
+            if (dbp && blocks_with_unknown_parent) {
+                blocks_with_unknown_parent->emplace(prev_hash, *dbp);
+            }
+            return true;
+        }
+
+        // process in case the block isn't known yet
+        const CBlockIndex* pindex = m_blockman.LookupBlockIndex(hash);
+        if (!pindex || (pindex->nStatus & BLOCK_HAVE_DATA) == 0) {
+            // This block can be processed immediately.
+            pblock = read_block();
+            if (!pblock) return true;
+
+            BlockValidationState state;
+            if (AcceptBlock(pblock, state, nullptr, true, dbp, nullptr, true, stored_size)) {
+                loaded++;
+            }
+            if (state.IsError()) {
+                return false;
+            }
+        } else if (hash != params.GetConsensus().hashGenesisBlock && pindex->nHeight % 1000 == 0) {
+            LogDebug(BCLog::REINDEX, "Block Import: already had block %s at height %d\n", hash.ToString(), pindex->nHeight);
+        }
+    }
+
+    // Activate the genesis block so normal node progress can continue
+    // During first -reindex, this will only connect Genesis since
+    // ActivateBestChain only connects blocks which are in the block tree db,
+    // which only contains blocks whose parents are in it.
+    // But do this only if genesis isn't activated yet, to avoid connecting many blocks
+    // without assumevalid in the case of a continuation of a reindex that
+    // was interrupted by the user.
+    if (hash == params.GetConsensus().hashGenesisBlock && WITH_LOCK(::cs_main, return ActiveHeight()) == -1) {
+        BlockValidationState state;
+        if (!ActiveChainstate().ActivateBestChain(state, nullptr)) {
+            return false;
+        }
+    }
+
+    if (m_blockman.IsPruneMode() && m_blockman.m_blockfiles_indexed && pblock) {
+        // must update the tip for pruning to work while importing with -loadblock.
+        // this is a tradeoff to conserve disk space at the expense of time
+        // spent updating the tip to be able to prune.
+        // otherwise, ActivateBestChain won't be called by the import process
+        // until after all of the block files are loaded. ActivateBestChain can be
+        // called by concurrent network message processing. but, that is not
+        // reliable for the purpose of pruning while importing.
+        if (auto result{ActivateBestChains()}; !result) {
+            LogDebug(BCLog::REINDEX, "%s\n", util::ErrorString(result).original);
+            return false;
+        }
+    }
+
+    NotifyHeaderTip();
+
+    if (!blocks_with_unknown_parent) return true;
+
+    // Recursively process earlier encountered successors of this block
+    std::deque<uint256> queue;
+    queue.push_back(hash);
+    while (!queue.empty()) {
+        uint256 head = queue.front();
+        queue.pop_front();
+        auto range = blocks_with_unknown_parent->equal_range(head);
+        while (range.first != range.second) {
+            std::multimap<uint256, FlatFilePos>::iterator it = range.first;
+            std::shared_ptr<CBlock> pblockrecursive = std::make_shared<CBlock>();
+            if (m_blockman.ReadBlock(*pblockrecursive, it->second, {})) {
+                const auto& block_hash{pblockrecursive->GetHash()};
+                LogDebug(BCLog::REINDEX, "%s: Processing out of order child %s of %s", __func__, block_hash.ToString(), head.ToString());
+                LOCK(cs_main);
+                BlockValidationState dummy;
+                if (AcceptBlock(pblockrecursive, dummy, nullptr, true, &it->second, nullptr, true)) {
+                    loaded++;
+                    queue.push_back(block_hash);
+                }
+            }
+            range.first++;
+            blocks_with_unknown_parent->erase(it);
+            NotifyHeaderTip();
+        }
+    }
+    return true;
+}
+
 void ChainstateManager::LoadExternalBlockFile(
     AutoFile& file_in,
     FlatFilePos* dbp,
@@ -5057,6 +5350,7 @@ void ChainstateManager::LoadExternalBlockFile(
             nRewind++; // start one byte further next time, in case of failure
             blkdat.SetLimit(); // remove former limit
             unsigned int nSize = 0;
+            bool compressed{false};
             try {
                 // locate a header
                 MessageStartChars buf;
@@ -5068,6 +5362,8 @@ void ChainstateManager::LoadExternalBlockFile(
                 }
                 // read size
                 blkdat >> nSize;
+                compressed = (nSize & node::COMPRESSED_BLOCK_RECORD) != 0;
+                nSize &= ~node::COMPRESSED_BLOCK_RECORD;
                 if (nSize < 80 || nSize > MAX_BLOCK_SERIALIZED_SIZE)
                     continue;
             } catch (const std::exception&) {
@@ -5089,97 +5385,22 @@ void ChainstateManager::LoadExternalBlockFile(
                 nRewind = nBlockPos + nSize;
                 blkdat.SkipTo(nRewind);
 
-                std::shared_ptr<CBlock> pblock{}; // needs to remain available after the cs_main lock is released to avoid duplicate reads from disk
-
-                {
-                    LOCK(cs_main);
-                    // detect out of order blocks, and store them for later
-                    if (hash != params.GetConsensus().hashGenesisBlock && !m_blockman.LookupBlockIndex(header.hashPrevBlock)) {
-                        LogDebug(BCLog::REINDEX, "%s: Out of order block %s, parent %s not known\n", __func__, hash.ToString(),
-                                 header.hashPrevBlock.ToString());
-                        if (dbp && blocks_with_unknown_parent) {
-                            blocks_with_unknown_parent->emplace(header.hashPrevBlock, *dbp);
-                        }
-                        continue;
-                    }
-
-                    // process in case the block isn't known yet
-                    const CBlockIndex* pindex = m_blockman.LookupBlockIndex(hash);
-                    if (!pindex || (pindex->nStatus & BLOCK_HAVE_DATA) == 0) {
-                        // This block can be processed immediately; rewind to its start, read and deserialize it.
-                        blkdat.SetPos(nBlockPos);
-                        pblock = std::make_shared<CBlock>();
+                const auto read_block{[&]() -> std::shared_ptr<const CBlock> {
+                    // Rewind to the start of the block, read and deserialize it.
+                    blkdat.SetPos(nBlockPos);
+                    auto pblock{std::make_shared<CBlock>()};
+                    if (compressed) {
+                        std::vector<std::byte> record(nSize);
+                        blkdat.read(record);
+                        SpanReader{node::DecompressBlock(record)} >> TX_WITH_WITNESS(*pblock);
+                    } else {
                         blkdat >> TX_WITH_WITNESS(*pblock);
-                        nRewind = blkdat.GetPos();
-
-                        BlockValidationState state;
-                        if (AcceptBlock(pblock, state, nullptr, true, dbp, nullptr, true)) {
-                            nLoaded++;
-                        }
-                        if (state.IsError()) {
-                            break;
-                        }
-                    } else if (hash != params.GetConsensus().hashGenesisBlock && pindex->nHeight % 1000 == 0) {
-                        LogDebug(BCLog::REINDEX, "Block Import: already had block %s at height %d\n", hash.ToString(), pindex->nHeight);
-                    }
-                }
-
-                // Activate the genesis block so normal node progress can continue
-                // During first -reindex, this will only connect Genesis since
-                // ActivateBestChain only connects blocks which are in the block tree db,
-                // which only contains blocks whose parents are in it.
-                // But do this only if genesis isn't activated yet, to avoid connecting many blocks
-                // without assumevalid in the case of a continuation of a reindex that
-                // was interrupted by the user.
-                if (hash == params.GetConsensus().hashGenesisBlock && WITH_LOCK(::cs_main, return ActiveHeight()) == -1) {
-                    BlockValidationState state;
-                    if (!ActiveChainstate().ActivateBestChain(state, nullptr)) {
-                        break;
-                    }
-                }
-
-                if (m_blockman.IsPruneMode() && m_blockman.m_blockfiles_indexed && pblock) {
-                    // must update the tip for pruning to work while importing with -loadblock.
-                    // this is a tradeoff to conserve disk space at the expense of time
-                    // spent updating the tip to be able to prune.
-                    // otherwise, ActivateBestChain won't be called by the import process
-                    // until after all of the block files are loaded. ActivateBestChain can be
-                    // called by concurrent network message processing. but, that is not
-                    // reliable for the purpose of pruning while importing.
-                    if (auto result{ActivateBestChains()}; !result) {
-                        LogDebug(BCLog::REINDEX, "%s\n", util::ErrorString(result).original);
-                        break;
-                    }
-                }
-
-                NotifyHeaderTip();
-
-                if (!blocks_with_unknown_parent) continue;
-
-                // Recursively process earlier encountered successors of this block
-                std::deque<uint256> queue;
-                queue.push_back(hash);
-                while (!queue.empty()) {
-                    uint256 head = queue.front();
-                    queue.pop_front();
-                    auto range = blocks_with_unknown_parent->equal_range(head);
-                    while (range.first != range.second) {
-                        std::multimap<uint256, FlatFilePos>::iterator it = range.first;
-                        std::shared_ptr<CBlock> pblockrecursive = std::make_shared<CBlock>();
-                        if (m_blockman.ReadBlock(*pblockrecursive, it->second, {})) {
-                            const auto& block_hash{pblockrecursive->GetHash()};
-                            LogDebug(BCLog::REINDEX, "%s: Processing out of order child %s of %s", __func__, block_hash.ToString(), head.ToString());
-                            LOCK(cs_main);
-                            BlockValidationState dummy;
-                            if (AcceptBlock(pblockrecursive, dummy, nullptr, true, &it->second, nullptr, true)) {
-                                nLoaded++;
-                                queue.push_back(block_hash);
-                            }
-                        }
-                        range.first++;
-                        blocks_with_unknown_parent->erase(it);
-                        NotifyHeaderTip();
                     }
+                    nRewind = blkdat.GetPos();
+                    return pblock;
+                }};
+                if (!LoadExternalBlock(hash, header.hashPrevBlock, dbp, nSize, read_block, blocks_with_unknown_parent, nLoaded)) {
+                    break;
                 }
             } catch (const std::exception& e) {
                 // historical bugs added extra data to the block files that does not deserialize cleanly.
@@ -5202,6 +5423,57 @@ void ChainstateManager::LoadExternalBlockFile(
     LogInfo("Loaded %i blocks from external file in %dms", nLoaded, Ticks<std::chrono::milliseconds>(SteadyClock::now() - start));
 }
 
+void ChainstateManager::LoadScannedBlockFile(
+    std::span<const node::ScannedBlock> blocks,
+    std::multimap<uint256, FlatFilePos>& blocks_with_unknown_parent)
+{
+    const auto start{SteadyClock::now()};
+
+    // Blocks are read and checked ahead on another thread, while the ones
+    // before them are indexed.
+    node::BlockReadAhead read_ahead{m_blockman, [this](CBlock& block) {
+        BlockValidationState state;
+        CheckBlock(block, state, GetConsensus());
+    }};
+    std::vector<std::pair<uint256, FlatFilePos>> next;
+
+    int loaded{0};
+    for (size_t i{0}; i < blocks.size(); ++i) {
+        if (m_interrupt) return;
+
+        const node::ScannedBlock& block{blocks[i]};
+        // Only read ahead the blocks LoadExternalBlock() will read next: those
+        // extending the block index, or the blocks before them in this file.
+        // Blocks it already has, or whose parent is unknown, are not read.
+        next.clear();
+        {
+            LOCK(cs_main);
+            const size_t end{std::min(blocks.size(), i + 4 * node::BLOCK_READ_AHEAD_DEPTH)};
+            for (size_t j{i}; j < end && next.size() < node::BLOCK_READ_AHEAD_DEPTH; ++j) {
+                const CBlockIndex* pindex{m_blockman.LookupBlockIndex(blocks[j].hash)};
+                if (pindex && (pindex->nStatus & BLOCK_HAVE_DATA)) continue;
+                const bool connects{blocks[j].hash == GetConsensus().hashGenesisBlock ||
+                                    m_blockman.LookupBlockIndex(blocks[j].prev_hash) ||
+                                    std::ranges::any_of(next, [&](const auto& entry) { return entry.first == blocks[j].prev_hash; })};
+                if (connects) next.emplace_back(blocks[j].hash, blocks[j].pos);
+            }
+        }
+        read_ahead.Schedule(next);
+
+        const auto read_block{[&]() -> std::shared_ptr<const CBlock> {
+            if (auto pblock{read_ahead.Take(block.hash)}) return pblock;
+            auto pblock{std::make_shared<CBlock>()};
+            // A block that does not deserialize is skipped, as LoadExternalBlockFile() does.
+            if (!m_blockman.ReadBlock(*pblock, block.pos, block.hash)) return nullptr;
+            return pblock;
+        }};
+        if (!LoadExternalBlock(block.hash, block.prev_hash, &block.pos, block.size, read_block, &blocks_with_unknown_parent, loaded)) {
+            break;
+        }
+    }
+    LogInfo("Loaded %i blocks from external file in %dms", loaded, Ticks<std::chrono::milliseconds>(SteadyClock::now() - start));
+}
+
 bool ChainstateManager::ShouldCheckBlockIndex() const
 {
     // Assert to verify Flatten() has been called.
@@ -5546,11 +5818,14 @@ bool Chainstate::ResizeCoinsCaches(size_t coinstip_size, size_t coinsdb_size)
     }
     size_t old_coinstip_size = m_coinstip_cache_size_bytes;
     m_coinstip_cache_size_bytes = coinstip_size;
-    m_coinsdb_cache_size_bytes = coinsdb_size;
-    CoinsDB().ResizeCache(coinsdb_size);
+    if (coinsdb_size != m_coinsdb_cache_size_bytes) {
+        // Reopens the database, so only when its cache size actually changes.
+        m_coinsdb_cache_size_bytes = coinsdb_size;
+        CoinsDB().ResizeCache(coinsdb_size);
 
-    LogInfo("[%s] resized coinsdb cache to %.1f MiB",
-        this->ToString(), coinsdb_size * (1.0 / 1024 / 1024));
+        LogInfo("[%s] resized coinsdb cache to %.1f MiB",
+            this->ToString(), coinsdb_size * (1.0 / 1024 / 1024));
+    }
     LogInfo("[%s] resized coinstip cache to %.1f MiB",
         this->ToString(), coinstip_size * (1.0 / 1024 / 1024));
 
@@ -5561,8 +5836,13 @@ bool Chainstate::ResizeCoinsCaches(size_t coinstip_size, size_t coinsdb_size)
         // Likely no need to flush if cache sizes have grown.
         ret = FlushStateToDisk(state, FlushStateMode::IF_NEEDED);
     } else {
-        // Otherwise, flush state to disk and deallocate the in-memory coins map.
-        ret = FlushStateToDisk(state, FlushStateMode::ALWAYS);
+        // Otherwise make room by evicting the unmodified coins that were not
+        // used lately, which needs no write, rather than flushing and emptying
+        // the whole cache. If the modified coins alone are still over the new
+        // size, the flush writes them out and evicts further.
+        const size_t evicted{CoinsTip().EvictClean(coinstip_size * COINS_CACHE_EVICT_TARGET_PERCENT / 100)};
+        LogDebug(BCLog::COINDB, "[%s] evicted %u coins from the cache, %.2fKiB in use", this->ToString(), evicted, CoinsTip().InUseMemoryUsage() / 1024.0);
+        ret = FlushStateToDisk(state, FlushStateMode::IF_NEEDED);
     }
     return ret;
 }
@@ -6201,11 +6481,13 @@ static ChainstateManager::Options&& Flatten(ChainstateManager::Options&& opts)
 }
 
 ChainstateManager::ChainstateManager(const util::SignalInterrupt& interrupt, Options options, node::BlockManager::Options blockman_options)
-    : m_script_check_queue{/*batch_size=*/128, std::clamp(options.worker_threads_num, 0, MAX_SCRIPTCHECK_THREADS)},
+    : m_script_check_queue{/*batch_size=*/128, std::clamp(options.worker_threads_num, 0, MAX_SCRIPTCHECK_THREADS), "Script verification", "scriptch", options.batch_schnorr_verify},
+      m_header_check_queue{/*batch_size=*/1, std::clamp(options.worker_threads_num, 0, MAX_HEADER_CHECK_THREADS), "Header proof of work checking", "headerch"},
+      m_input_fetch_queue{/*batch_size=*/1, std::clamp(options.worker_threads_num, 0, MAX_SCRIPTCHECK_THREADS), "Input fetching", "inputfetch"},
       m_interrupt{interrupt},
       m_options{Flatten(std::move(options))},
       m_blockman{interrupt, std::move(blockman_options)},
-      m_validation_cache{m_options.script_execution_cache_bytes, m_options.signature_cache_bytes}
+      m_validation_cache{m_options.script_execution_cache_bytes, m_options.signature_cache_bytes, m_options.signature_cache_pin}
 {
 }
 
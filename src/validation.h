@@ -17,10 +17,12 @@
 #include <kernel/chainparams.h>
 #include <kernel/chainstatemanager_opts.h>
 #include <kernel/cs_main.h> // IWYU pragma: export
+#include <node/blockreadahead.h>
 #include <node/blockstorage.h>
 #include <policy/feerate.h>
 #include <policy/packages.h>
 #include <policy/policy.h>
+#include <pubkey.h>
 #include <script/script_error.h>
 #include <script/sigcache.h>
 #include <script/verify_flags.h>
@@ -40,6 +42,8 @@
 #include <algorithm>
 #include <atomic>
 #include <cstdint>
+#include <list>
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
@@ -47,6 +51,7 @@
 #include <span>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -63,6 +68,7 @@ struct ChainstateRole;
 } // namespace kernel
 namespace node {
 class SnapshotMetadata;
+struct ScannedBlock;
 } // namespace node
 namespace Consensus {
 struct Params;
@@ -87,6 +93,12 @@ static const uint64_t MIN_DISK_SPACE_FOR_BLOCK_FILES = 550 * 1024 * 1024;
 
 /** Maximum number of dedicated script-checking threads allowed */
 static constexpr int MAX_SCRIPTCHECK_THREADS{15};
+/** Maximum number of threads checking the proof of work of headers, besides the calling thread */
+static constexpr int MAX_HEADER_CHECK_THREADS{3};
+/** Number of headers hashed by each check on the header check queue */
+static constexpr size_t HEADER_POW_CHECK_SIZE{100};
+/** Number of coins read by each job on the input fetch queue */
+static constexpr size_t INPUT_FETCH_SIZE{16};
 
 /** Current sync state passed to tip changed callbacks. */
 enum class SynchronizationState {
@@ -354,7 +366,15 @@ public:
     CScriptCheck(CScriptCheck&&) = default;
     CScriptCheck& operator=(CScriptCheck&&) = default;
 
+    //! Schnorr signatures that CCheckQueue verifies at once for a batch of checks
+    using Batch = SchnorrBatch;
+
     std::optional<std::pair<ScriptError, std::string>> operator()();
+    //! Check the script, leaving Schnorr signatures it does not find cached to batch
+    std::optional<std::pair<ScriptError, std::string>> operator()(SchnorrBatch& batch);
+
+private:
+    std::optional<std::pair<ScriptError, std::string>> Check(SchnorrBatch* batch);
 };
 
 // CScriptCheck is used a lot in std::vector, make sure that's efficient
@@ -362,6 +382,51 @@ static_assert(std::is_nothrow_move_assignable_v<CScriptCheck>);
 static_assert(std::is_nothrow_move_constructible_v<CScriptCheck>);
 static_assert(std::is_nothrow_destructible_v<CScriptCheck>);
 
+//! Memory for the precomputed transaction data of mempool transactions
+static constexpr size_t PRECOMPUTED_TXDATA_CACHE_BYTES{16_MiB};
+
+/**
+ * Precomputed transaction data (the sighash midstates) of transactions
+ * accepted to the mempool, by wtxid, so that connecting a block with them
+ * does not hash them again. The oldest entries are dropped to stay within
+ * its memory limit. Unlike the signature and script execution caches, it
+ * has no lock of its own: it is only used with cs_main held, when accepting
+ * a transaction to the mempool or connecting a block.
+ */
+class PrecomputedTxDataCache
+{
+private:
+    struct Entry {
+        PrecomputedTransactionData txdata;
+        size_t usage;
+        std::list<Wtxid>::iterator order;
+    };
+    std::unordered_map<Wtxid, Entry, SaltedWtxidHasher> m_entries;
+    //! Wtxids of the entries, oldest first
+    std::list<Wtxid> m_order;
+    size_t m_usage{0};
+    const size_t m_max_usage;
+
+    void Erase(std::unordered_map<Wtxid, Entry, SaltedWtxidHasher>::iterator it);
+
+public:
+    explicit PrecomputedTxDataCache(size_t max_usage_bytes) : m_max_usage{max_usage_bytes} {}
+
+    /** Keep the data of tx, if its spent outputs were loaded. */
+    void Add(const CTransaction& tx, const PrecomputedTransactionData& txdata);
+
+    /**
+     * Copy the data of tx to txdata, if it is cached and was computed for the
+     * outputs that tx spends in inputs.
+     *
+     * @param[in] erase  whether to drop it from the cache once found
+     */
+    bool Get(const CTransaction& tx, const CCoinsViewCache& inputs, bool erase, PrecomputedTransactionData& txdata);
+
+    size_t size() const { return m_entries.size(); }
+    size_t DynamicMemoryUsage() const { return m_usage; }
+};
+
 /**
  * Convenience class for initializing and passing the script execution cache
  * and signature cache.
@@ -373,10 +438,14 @@ private:
     CSHA256 m_script_execution_cache_hasher;
 
 public:
-    CuckooCache::cache<uint256, SignatureCacheHasher> m_script_execution_cache;
+    ShardedValidationCache m_script_execution_cache;
     SignatureCache m_signature_cache;
+    PrecomputedTxDataCache m_txdata_cache{PRECOMPUTED_TXDATA_CACHE_BYTES};
 
-    ValidationCache(size_t script_execution_cache_bytes, size_t signature_cache_bytes);
+    ValidationCache(size_t script_execution_cache_bytes, size_t signature_cache_bytes, bool signature_cache_pin = DEFAULT_SIGNATURE_CACHE_PIN);
+
+    /** Size the script execution and signature caches, dropping their entries. */
+    void Resize(size_t script_execution_cache_bytes, size_t signature_cache_bytes);
 
     ValidationCache(const ValidationCache&) = delete;
     ValidationCache& operator=(const ValidationCache&) = delete;
@@ -414,7 +483,38 @@ BlockValidationState TestBlockValidity(
     bool check_merkle_root) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
 /** Check with the proof of work on each blockheader matches the value in nBits */
-bool HasValidProofOfWork(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams);
+bool HasValidProofOfWork(std::span<const CBlockHeader> headers, const Consensus::Params& consensusParams);
+
+/** Proof of work check of a run of headers, for spreading a headers message over the header check queue. */
+class HeaderPoWCheck
+{
+private:
+    std::span<const CBlockHeader> m_headers;
+    const Consensus::Params* m_params;
+
+public:
+    HeaderPoWCheck(std::span<const CBlockHeader> headers, const Consensus::Params& params)
+        : m_headers{headers}, m_params{&params} {}
+
+    /** Returns the hash of a header whose proof of work does not match its nBits, if any. */
+    std::optional<uint256> operator()() const;
+};
+
+/** Read of a run of coins from the coins database, for spreading the inputs of a block over the input fetch queue. */
+class InputFetch
+{
+private:
+    std::span<const COutPoint> m_outpoints;
+    std::span<std::optional<Coin>> m_coins;
+    const CCoinsView* m_db;
+
+public:
+    InputFetch(std::span<const COutPoint> outpoints, std::span<std::optional<Coin>> coins, const CCoinsView& db)
+        : m_outpoints{outpoints}, m_coins{coins}, m_db{&db} {}
+
+    /** Read the coins of the outpoints together into the matching slots. Returns an outpoint that could not be read, if any. */
+    std::optional<COutPoint> operator()();
+};
 
 /** Check if a block has been mutated (with respect to its merkle root and witness commitments). */
 bool IsBlockMutated(const CBlock& block, bool check_witness_root);
@@ -481,6 +581,10 @@ public:
     //! All unspent coins reside in this store.
     CCoinsViewDB m_dbview GUARDED_BY(cs_main);
 
+    //! This view writes flushed coins to m_dbview, in the background if -dbbackgroundflush is set,
+    //! and serves the coins not yet written from memory.
+    CCoinsViewBackgroundWriter m_writerview GUARDED_BY(cs_main);
+
     //! This view wraps access to the leveldb instance and handles read errors gracefully.
     CCoinsViewErrorCatcher m_catcherview GUARDED_BY(cs_main);
 
@@ -488,7 +592,7 @@ public:
     //! can fit per the dbcache setting.
     std::unique_ptr<CCoinsViewCache> m_cacheview GUARDED_BY(cs_main);
 
-    //! This constructor initializes CCoinsViewDB and CCoinsViewErrorCatcher instances, but it
+    //! This constructor initializes the CCoinsViewDB, CCoinsViewBackgroundWriter and CCoinsViewErrorCatcher instances, but it
     //! *does not* create a CCoinsViewCache instance by default. This is done separately because the
     //! presence of the cache has implications on whether or not we're allowed to flush the cache's
     //! state to disk, which should not be done until the health of the database is verified.
@@ -684,11 +788,13 @@ public:
         return *Assert(m_coins_views->m_cacheview);
     }
 
-    //! @returns A reference to the on-disk UTXO set database.
+    //! @returns A reference to the on-disk UTXO set database, once all coins flushed
+    //!     to it are written.
     CCoinsViewDB& CoinsDB() EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
     {
         AssertLockHeld(::cs_main);
-        return Assert(m_coins_views)->m_dbview;
+        Assert(m_coins_views)->m_writerview.Wait();
+        return m_coins_views->m_dbview;
     }
 
     //! @returns A pointer to the mempool.
@@ -775,6 +881,14 @@ public:
     bool ConnectBlock(const CBlock& block, BlockValidationState& state, CBlockIndex* pindex,
                       CCoinsViewCache& view, bool fJustCheck = false) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
+    /**
+     * Warm the coins cache for connecting block: the coins it spends that are
+     * neither cached nor created by the block itself are read from the coins
+     * database on the input fetch queue workers, instead of one after another
+     * by ConnectBlock().
+     */
+    void FetchInputs(const CBlock& block) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+
     // Apply the effects of a block disconnection on the UTXO set.
     bool DisconnectTip(BlockValidationState& state, DisconnectedBlockTransactions* disconnectpool) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
 
@@ -880,6 +994,9 @@ protected:
 
     NodeClock::time_point m_next_write{NodeClock::time_point::max()};
 
+    //! The next blocks to connect, read and checked ahead of ConnectTip()
+    node::BlockReadAhead m_block_read_ahead;
+
     /**
      * In case of an invalid snapshot, rename the coins leveldb directory so
      * that it can be examined for issue diagnosis.
@@ -961,11 +1078,35 @@ private:
         bool min_pow_checked) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     friend Chainstate;
 
+    /**
+     * Index a block found in a block file, then the blocks found earlier
+     * that were waiting for it as their parent. Shared by
+     * LoadExternalBlockFile() and LoadScannedBlockFile().
+     *
+     * @param[in]     stored_size   Size of the block's record at dbp, compressed or not
+     * @param[in]     read_block    Reads the whole block, only if it needs indexing. A block
+     *                              it fails to read (returning nullptr) is skipped.
+     * @param[in,out] loaded        Number of blocks indexed
+     * @returns false if loading the file should stop
+     */
+    bool LoadExternalBlock(
+        const uint256& hash,
+        const uint256& prev_hash,
+        const FlatFilePos* dbp,
+        unsigned int stored_size,
+        const std::function<std::shared_ptr<const CBlock>()>& read_block,
+        std::multimap<uint256, FlatFilePos>* blocks_with_unknown_parent,
+        int& loaded) LOCKS_EXCLUDED(cs_main);
+
     /** Most recent headers presync progress update, for rate-limiting. */
     MockableSteadyClock::time_point m_last_presync_update GUARDED_BY(GetMutex()){};
 
     //! A queue for script verifications that have to be performed by worker threads.
     CCheckQueue<CScriptCheck> m_script_check_queue;
+    //! A queue for checking the proof of work of headers messages on worker threads.
+    CCheckQueue<HeaderPoWCheck> m_header_check_queue;
+    //! A queue for reading the inputs of a block from the coins database on worker threads.
+    CCheckQueue<InputFetch> m_input_fetch_queue;
 
     //! Timers and counters used for benchmarking validation in both background
     //! and active chainstates.
@@ -1205,6 +1346,21 @@ public:
         FlatFilePos* dbp = nullptr,
         std::multimap<uint256, FlatFilePos>* blocks_with_unknown_parent = nullptr);
 
+    /**
+     * Index the blocks of a block file found by node::ScanBlockFile(), in
+     * file order, for -reindex. Does what LoadExternalBlockFile() does, but
+     * the file was scanned beforehand (on another thread), so only the
+     * blocks that need indexing are read, and those are read and checked
+     * ahead of indexing.
+     *
+     * @param[in]     blocks                        Blocks of the file, in file order
+     * @param[in,out] blocks_with_unknown_parent    Map of disk positions for blocks with
+     *                                              unknown parent, key is parent block hash
+     */
+    void LoadScannedBlockFile(
+        std::span<const node::ScannedBlock> blocks,
+        std::multimap<uint256, FlatFilePos>& blocks_with_unknown_parent);
+
     /**
      * Process an incoming block. This only returns after the best known valid
      * block is made active. Note that it does not, however, guarantee that the
@@ -1253,6 +1409,8 @@ public:
      *                              peer.
      * @param[in]   dbp             The location on disk, if we are importing
      *                              this block from prior storage.
+     * @param[in]   dbp_size        The size of the block's record at dbp,
+     *                              if known (read from disk otherwise).
      * @param[in]   min_pow_checked True if proof-of-work anti-DoS checks have
      *                              been done by caller for headers chain
      *
@@ -1264,7 +1422,7 @@ public:
      *
      * @returns   False if the block or header is invalid, or if saving to disk fails (likely a fatal error); true otherwise.
      */
-    bool AcceptBlock(const std::shared_ptr<const CBlock>& pblock, BlockValidationState& state, CBlockIndex** ppindex, bool fRequested, const FlatFilePos* dbp, bool* fNewBlock, bool min_pow_checked) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    bool AcceptBlock(const std::shared_ptr<const CBlock>& pblock, BlockValidationState& state, CBlockIndex** ppindex, bool fRequested, const FlatFilePos* dbp, bool* fNewBlock, bool min_pow_checked, std::optional<unsigned int> dbp_size = std::nullopt) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     void ReceivedBlockTransactions(const CBlock& block, CBlockIndex* pindexNew, const FlatFilePos& pos) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
@@ -1337,6 +1495,14 @@ public:
     void RecalculateBestHeader() EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
     CCheckQueue<CScriptCheck>& GetCheckQueue() { return m_script_check_queue; }
+    CCheckQueue<InputFetch>& GetInputFetchQueue() { return m_input_fetch_queue; }
+
+    /**
+     * Check the proof of work of each header, as HasValidProofOfWork(). Large
+     * batches, such as a full headers message, are hashed on the header check
+     * queue workers as well as on the calling thread.
+     */
+    bool HasValidProofOfWork(std::span<const CBlockHeader> headers);
 
     ~ChainstateManager();
 
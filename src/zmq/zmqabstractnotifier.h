@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <span>
 #include <string>
 
 class CBlockIndex;
@@ -55,6 +56,8 @@ public:
     virtual bool NotifyTransactionRemoval(const CTransaction &transaction, uint64_t mempool_sequence);
     // Notifies of transactions added to mempool or appearing in blocks
     virtual bool NotifyTransaction(const CTransaction &transaction);
+    // Notifies of every new mining job, see CZMQMiningJobs
+    virtual bool NotifyMiningJob(std::span<const unsigned char> work);
 
 protected:
     void* psocket{nullptr};
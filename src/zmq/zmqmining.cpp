@@ -0,0 +1,186 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <zmq/zmqmining.h>
+
+#include <chain.h>
+#include <interfaces/mining.h>
+#include <logging.h>
+#include <node/mining_metrics.h>
+#include <primitives/block.h>
+#include <streams.h>
+#include <util/thread.h>
+#include <util/time.h>
+#include <zmq/zmqabstractnotifier.h>
+#include <zmq/zmqutil.h>
+
+#include <zmq.h>
+
+#include <cerrno>
+#include <utility>
+
+namespace {
+/** How often the submission thread checks for an interrupt */
+constexpr auto ZMQ_MINING_POLL_INTERVAL{100ms};
+} // namespace
+
+CZMQMiningJobs::Job::Job(uint64_t id_in, std::shared_ptr<interfaces::BlockTemplate> block_template_in)
+    : id{id_in},
+      block_template{std::move(block_template_in)},
+      work{block_template->getBlock()}
+{
+    target.SetCompact(work.GetTemplate().nBits);
+}
+
+CZMQMiningJobs::CZMQMiningJobs(interfaces::Mining& mining, const CScript& coinbase_output_script, std::vector<CZMQAbstractNotifier*> publishers)
+    : m_feed{mining, coinbase_output_script, ZMQ_MINING_TEMPLATE_REFRESH}, m_publishers{std::move(publishers)} {}
+
+CZMQMiningJobs::~CZMQMiningJobs()
+{
+    Interrupt();
+    Stop();
+}
+
+bool CZMQMiningJobs::Start(void* pcontext, const std::vector<std::string>& submit_addresses)
+{
+    for (const std::string& address : submit_addresses) {
+        void* socket{zmq_socket(pcontext, ZMQ_REP)};
+        if (!socket) {
+            zmqError("Failed to create socket");
+            return false;
+        }
+        const int linger{0};
+        zmq_setsockopt(socket, ZMQ_LINGER, &linger, sizeof(linger));
+        if (zmq_bind(socket, address.c_str()) != 0) {
+            zmqError("Failed to bind address");
+            zmq_close(socket);
+            return false;
+        }
+        LogDebug(BCLog::ZMQ, "Accepting mining job solutions at %s", address);
+        m_submit_sockets.push_back(socket);
+    }
+
+    m_template_thread = std::thread(&util::TraceThread, "zmqminejob", [this] { ThreadTemplates(); });
+    if (!m_submit_sockets.empty()) {
+        m_submit_thread = std::thread(&util::TraceThread, "zmqminesub", [this] { ThreadSubmissions(); });
+    }
+    return true;
+}
+
+void CZMQMiningJobs::Interrupt()
+{
+    m_feed.Interrupt();
+}
+
+void CZMQMiningJobs::Stop()
+{
+    if (m_template_thread.joinable()) m_template_thread.join();
+    if (m_submit_thread.joinable()) m_submit_thread.join();
+    for (void* socket : m_submit_sockets) zmq_close(socket);
+    m_submit_sockets.clear();
+}
+
+ZMQSubmitResult CZMQMiningJobs::Submit(std::span<const std::byte> request)
+{
+    if (request.size() != node::MINING_WORK_SUBMISSION_SIZE) return ZMQSubmitResult::MALFORMED;
+    node::MiningWorkSubmission submission;
+    SpanReader{request} >> submission;
+
+    bool stale;
+    const std::shared_ptr<const Job> job{WITH_LOCK(m_mutex, return m_jobs.Find(submission.job_id, stale))};
+    if (!job) return ZMQSubmitResult::STALE;
+
+    CBlockHeader header{job->work.GetHeader(submission.extra_nonce)};
+    if (submission.time < header.nTime || int64_t{submission.time} > int64_t{header.nTime} + MAX_FUTURE_BLOCK_TIME) {
+        return ZMQSubmitResult::TIME_OUT_OF_RANGE;
+    }
+    header.nTime = submission.time;
+    header.nNonce = submission.nonce;
+    const uint256 hash{header.GetHash()};
+    if (UintToArith256(hash) > job->target) return ZMQSubmitResult::HIGH_HASH;
+    if (stale) {
+        node::GetMiningMetrics().SolutionFound(/*stale=*/true);
+        return ZMQSubmitResult::STALE;
+    }
+
+    const CBlock block{job->work.GetBlock(submission.extra_nonce, submission.time, submission.nonce)};
+    const bool accepted{job->block_template->submitSolution(header.nVersion, submission.time, submission.nonce, block.vtx[0])};
+    node::GetMiningMetrics().SolutionFound(/*stale=*/!accepted);
+    if (!accepted) {
+        LogWarning("zmq: Block %s was not processed", hash.ToString());
+        return ZMQSubmitResult::REJECTED;
+    }
+    LogInfo("zmq: Found block %s", hash.ToString());
+    return ZMQSubmitResult::ACCEPTED;
+}
+
+void CZMQMiningJobs::ThreadTemplates()
+{
+    bool clean;
+    while (auto block_template{m_feed.Next(clean)}) {
+        std::shared_ptr<const Job> job;
+        {
+            LOCK(m_mutex);
+            job = std::make_shared<const Job>(++m_job_counter, std::move(block_template));
+            // Store the job before publishing it, so that even the fastest
+            // solution finds it.
+            m_jobs.Add(job, clean);
+        }
+
+        const std::vector<unsigned char> work{node::SerializeMiningWork(job->work, job->id, clean)};
+        for (CZMQAbstractNotifier* publisher : m_publishers) {
+            if (!publisher->NotifyMiningJob(work)) {
+                LogDebug(BCLog::ZMQ, "Failed to publish mining job %d to %s", job->id, publisher->GetAddress());
+            }
+        }
+    }
+}
+
+void CZMQMiningJobs::ThreadSubmissions()
+{
+    std::vector<zmq_pollitem_t> items;
+    for (void* socket : m_submit_sockets) items.push_back({socket, 0, ZMQ_POLLIN, 0});
+
+    while (!m_feed.Interrupted()) {
+        if (zmq_poll(items.data(), items.size(), count_milliseconds(ZMQ_MINING_POLL_INTERVAL)) < 0) {
+            if (zmq_errno() == EINTR) continue;
+            zmqError("Failed to poll mining job submission sockets");
+            break;
+        }
+        for (const zmq_pollitem_t& item : items) {
+            if (item.revents & ZMQ_POLLIN) HandleSubmission(item.socket);
+        }
+    }
+}
+
+void CZMQMiningJobs::HandleSubmission(void* socket)
+{
+    std::vector<std::byte> request;
+    size_t parts{0};
+    bool received{true};
+    bool more{true};
+    while (more) {
+        zmq_msg_t msg;
+        zmq_msg_init(&msg);
+        if (zmq_msg_recv(&msg, socket, 0) < 0) {
+            zmqError("Unable to receive ZMQ msg");
+            zmq_msg_close(&msg);
+            received = false;
+            break;
+        }
+        if (parts++ == 0) {
+            const auto* data{static_cast<const std::byte*>(zmq_msg_data(&msg))};
+            request.assign(data, data + zmq_msg_size(&msg));
+        }
+        more = zmq_msg_more(&msg);
+        zmq_msg_close(&msg);
+    }
+
+    // A REP socket takes no further request until this one is answered, so
+    // reply even if it could not be read.
+    const ZMQSubmitResult result{received && parts == 1 ? Submit(request) : ZMQSubmitResult::MALFORMED};
+    LogDebug(BCLog::ZMQ, "Mining job submission result %d", static_cast<int>(result));
+    const uint8_t reply{static_cast<uint8_t>(result)};
+    if (zmq_send(socket, &reply, sizeof(reply), 0) < 0) zmqError("Unable to send ZMQ msg");
+}
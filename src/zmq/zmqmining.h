@@ -0,0 +1,95 @@
+// Copyright (c) 2025-present The DRIP developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_ZMQ_ZMQMINING_H
+#define BITCOIN_ZMQ_ZMQMINING_H
+
+#include <arith_uint256.h>
+#include <node/mining_job.h>
+#include <script/script.h>
+#include <sync.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+class CZMQAbstractNotifier;
+namespace interfaces {
+class BlockTemplate;
+class Mining;
+} // namespace interfaces
+
+/** Without a new tip, how often a new template is built to pick up mempool transactions */
+static constexpr std::chrono::seconds ZMQ_MINING_TEMPLATE_REFRESH{30};
+
+/** Reply to a -zmqminingsubmit request, sent back as a single byte */
+enum class ZMQSubmitResult : uint8_t {
+    ACCEPTED = 0,          //!< the block was accepted
+    REJECTED = 1,          //!< the header solves the job, but the block was not accepted
+    STALE = 2,             //!< the job is unknown, or was replaced after a new tip
+    HIGH_HASH = 3,         //!< the header does not meet the block target
+    TIME_OUT_OF_RANGE = 4, //!< nTime is before the template's or too far in the future
+    MALFORMED = 5,         //!< the request is not a single node::MiningWorkSubmission
+};
+
+/**
+ * Mining work export over ZMQ.
+ *
+ * Every new block template from the Mining interface is published to the
+ * -zmqpubminingjob notifiers as a node::SerializeMiningWork unit, as soon as
+ * it is available. Solutions come back on -zmqminingsubmit REP sockets as
+ * fixed-size node::MiningWorkSubmission messages and are answered with a
+ * ZMQSubmitResult byte, so neither direction goes through JSON.
+ *
+ * When the tip changes the new job is flagged clean and solutions for older
+ * jobs are refused as stale.
+ */
+class CZMQMiningJobs
+{
+public:
+    CZMQMiningJobs(interfaces::Mining& mining, const CScript& coinbase_output_script, std::vector<CZMQAbstractNotifier*> publishers);
+    ~CZMQMiningJobs();
+
+    /** Bind the submission sockets and start building templates. */
+    bool Start(void* pcontext, const std::vector<std::string>& submit_addresses) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void Interrupt() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Stop the threads and close the submission sockets. Must be called before the context is terminated. */
+    void Stop();
+
+    /** Handle one submission request. */
+    ZMQSubmitResult Submit(std::span<const std::byte> request) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    struct Job {
+        Job(uint64_t id_in, std::shared_ptr<interfaces::BlockTemplate> block_template_in);
+
+        const uint64_t id;
+        const std::shared_ptr<interfaces::BlockTemplate> block_template;
+        const node::MiningJob work;
+        arith_uint256 target;
+    };
+
+    void ThreadTemplates() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void ThreadSubmissions() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void HandleSubmission(void* socket) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    node::BlockTemplateFeed m_feed;
+    //! Only used from the template thread
+    const std::vector<CZMQAbstractNotifier*> m_publishers;
+    //! Only used from the submission thread once started
+    std::vector<void*> m_submit_sockets;
+    std::thread m_template_thread;
+    std::thread m_submit_thread;
+
+    Mutex m_mutex;
+    uint64_t m_job_counter GUARDED_BY(m_mutex){0};
+    node::MiningJobList<const Job> m_jobs GUARDED_BY(m_mutex);
+};
+
+#endif // BITCOIN_ZMQ_ZMQMINING_H
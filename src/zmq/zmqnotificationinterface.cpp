@@ -11,8 +11,10 @@
 #include <netbase.h>
 #include <primitives/block.h>
 #include <primitives/transaction.h>
+#include <script/script.h>
 #include <validationinterface.h>
 #include <zmq/zmqabstractnotifier.h>
+#include <zmq/zmqmining.h>
 #include <zmq/zmqpublishnotifier.h>
 #include <zmq/zmqutil.h>
 
@@ -39,6 +41,9 @@ std::list<const CZMQAbstractNotifier*> CZMQNotificationInterface::GetActiveNotif
     for (const auto& n : notifiers) {
         result.push_back(n.get());
     }
+    for (const auto& n : m_mining_notifiers) {
+        result.push_back(n.get());
+    }
     return result;
 }
 
@@ -53,11 +58,8 @@ std::unique_ptr<CZMQNotificationInterface> CZMQNotificationInterface::Create(std
     factories["pubrawtx"] = CZMQAbstractNotifier::Create<CZMQPublishRawTransactionNotifier>;
     factories["pubsequence"] = CZMQAbstractNotifier::Create<CZMQPublishSequenceNotifier>;
 
-    std::list<std::unique_ptr<CZMQAbstractNotifier>> notifiers;
-    for (const auto& entry : factories)
-    {
-        std::string arg("-zmq" + entry.first);
-        const auto& factory = entry.second;
+    const auto add_notifiers{[](std::list<std::unique_ptr<CZMQAbstractNotifier>>& notifiers, const std::string& type, const CZMQNotifierFactory& factory) {
+        std::string arg("-zmq" + type);
         for (std::string& address : gArgs.GetArgs(arg)) {
             // libzmq uses prefix "ipc://" for UNIX domain sockets
             if (address.starts_with(ADDR_PREFIX_UNIX)) {
@@ -65,17 +67,26 @@ std::unique_ptr<CZMQNotificationInterface> CZMQNotificationInterface::Create(std
             }
 
             std::unique_ptr<CZMQAbstractNotifier> notifier = factory();
-            notifier->SetType(entry.first);
+            notifier->SetType(type);
             notifier->SetAddress(address);
             notifier->SetOutboundMessageHighWaterMark(static_cast<int>(gArgs.GetIntArg(arg + "hwm", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM)));
             notifiers.push_back(std::move(notifier));
         }
+    }};
+
+    std::list<std::unique_ptr<CZMQAbstractNotifier>> notifiers;
+    for (const auto& entry : factories)
+    {
+        add_notifiers(notifiers, entry.first, entry.second);
     }
+    std::list<std::unique_ptr<CZMQAbstractNotifier>> mining_notifiers;
+    add_notifiers(mining_notifiers, "pubminingjob", CZMQAbstractNotifier::Create<CZMQPublishMiningJobNotifier>);
 
-    if (!notifiers.empty())
+    if (!notifiers.empty() || !mining_notifiers.empty())
     {
         std::unique_ptr<CZMQNotificationInterface> notificationInterface(new CZMQNotificationInterface());
         notificationInterface->notifiers = std::move(notifiers);
+        notificationInterface->m_mining_notifiers = std::move(mining_notifiers);
 
         if (notificationInterface->Initialize()) {
             return notificationInterface;
@@ -103,12 +114,14 @@ bool CZMQNotificationInterface::Initialize()
         return false;
     }
 
-    for (auto& notifier : notifiers) {
-        if (notifier->Initialize(pcontext)) {
-            LogDebug(BCLog::ZMQ, "Notifier %s ready (address = %s)\n", notifier->GetType(), notifier->GetAddress());
-        } else {
-            LogDebug(BCLog::ZMQ, "Notifier %s failed (address = %s)\n", notifier->GetType(), notifier->GetAddress());
-            return false;
+    for (auto* notifier_list : {&notifiers, &m_mining_notifiers}) {
+        for (auto& notifier : *notifier_list) {
+            if (notifier->Initialize(pcontext)) {
+                LogDebug(BCLog::ZMQ, "Notifier %s ready (address = %s)\n", notifier->GetType(), notifier->GetAddress());
+            } else {
+                LogDebug(BCLog::ZMQ, "Notifier %s failed (address = %s)\n", notifier->GetType(), notifier->GetAddress());
+                return false;
+            }
         }
     }
 
@@ -121,9 +134,13 @@ void CZMQNotificationInterface::Shutdown()
     LogDebug(BCLog::ZMQ, "Shutdown notification interface\n");
     if (pcontext)
     {
-        for (auto& notifier : notifiers) {
-            LogDebug(BCLog::ZMQ, "Shutdown notifier %s at %s\n", notifier->GetType(), notifier->GetAddress());
-            notifier->Shutdown();
+        // Stop the mining job threads before closing the sockets they use.
+        m_mining_jobs.reset();
+        for (auto* notifier_list : {&notifiers, &m_mining_notifiers}) {
+            for (auto& notifier : *notifier_list) {
+                LogDebug(BCLog::ZMQ, "Shutdown notifier %s at %s\n", notifier->GetType(), notifier->GetAddress());
+                notifier->Shutdown();
+            }
         }
         zmq_ctx_term(pcontext);
 
@@ -131,6 +148,32 @@ void CZMQNotificationInterface::Shutdown()
     }
 }
 
+bool CZMQNotificationInterface::StartMiningJobs(interfaces::Mining& mining, const CScript& coinbase_output_script, std::vector<std::string> submit_addresses)
+{
+    assert(pcontext && !m_mining_jobs);
+    std::vector<CZMQAbstractNotifier*> publishers;
+    for (const auto& notifier : m_mining_notifiers) {
+        publishers.push_back(notifier.get());
+    }
+    for (std::string& address : submit_addresses) {
+        if (address.starts_with(ADDR_PREFIX_UNIX)) {
+            address.replace(0, ADDR_PREFIX_UNIX.length(), ADDR_PREFIX_IPC);
+        }
+    }
+    m_mining_jobs = std::make_unique<CZMQMiningJobs>(mining, coinbase_output_script, std::move(publishers));
+    return m_mining_jobs->Start(pcontext, submit_addresses);
+}
+
+void CZMQNotificationInterface::InterruptMiningJobs()
+{
+    if (m_mining_jobs) m_mining_jobs->Interrupt();
+}
+
+void CZMQNotificationInterface::StopMiningJobs()
+{
+    if (m_mining_jobs) m_mining_jobs->Stop();
+}
+
 namespace {
 
 template <typename Function>
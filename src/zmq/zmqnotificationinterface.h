@@ -12,12 +12,18 @@
 #include <functional>
 #include <list>
 #include <memory>
+#include <string>
 #include <vector>
 
 class CBlock;
 class CBlockIndex;
+class CScript;
 class CZMQAbstractNotifier;
+class CZMQMiningJobs;
 struct NewMempoolTransactionInfo;
+namespace interfaces {
+class Mining;
+} // namespace interfaces
 
 class CZMQNotificationInterface final : public CValidationInterface
 {
@@ -26,6 +32,14 @@ public:
 
     std::list<const CZMQAbstractNotifier*> GetActiveNotifiers() const;
 
+    /** Whether -zmqpubminingjob is set, so that StartMiningJobs should be called. */
+    bool HasMiningJobNotifiers() const { return !m_mining_notifiers.empty(); }
+    /** Publish mining jobs paying to coinbase_output_script, and accept their solutions on submit_addresses. */
+    bool StartMiningJobs(interfaces::Mining& mining, const CScript& coinbase_output_script, std::vector<std::string> submit_addresses);
+    void InterruptMiningJobs();
+    /** Join the mining job threads, which use the chainstate through the Mining interface. */
+    void StopMiningJobs();
+
     static std::unique_ptr<CZMQNotificationInterface> Create(std::function<bool(std::vector<std::byte>&, const CBlockIndex&)> get_block_by_index);
 
 protected:
@@ -44,6 +58,9 @@ private:
 
     void* pcontext{nullptr};
     std::list<std::unique_ptr<CZMQAbstractNotifier>> notifiers;
+    //! -zmqpubminingjob notifiers, driven by m_mining_jobs rather than by validation events
+    std::list<std::unique_ptr<CZMQAbstractNotifier>> m_mining_notifiers;
+    std::unique_ptr<CZMQMiningJobs> m_mining_jobs;
 };
 
 extern std::unique_ptr<CZMQNotificationInterface> g_zmq_notification_interface;
@@ -45,6 +45,11 @@ static const char *MSG_HASHTX    = "hashtx";
 static const char *MSG_RAWBLOCK  = "rawblock";
 static const char *MSG_RAWTX     = "rawtx";
 static const char *MSG_SEQUENCE  = "sequence";
+static const char *MSG_MININGJOB = "miningjob";
+
+// Mining jobs are published from their own thread, which may share a socket
+// with the notifiers driven by validation events.
+static GlobalMutex g_publish_mutex;
 
 // Internal function to send multipart message
 static int zmq_send_multipart(void *sock, const void* data, size_t size, ...)
@@ -207,6 +212,7 @@ bool CZMQAbstractPublishNotifier::SendZmqMessage(const char *command, const void
     /* send three parts, command & data & a LE 4byte sequence number */
     unsigned char msgseq[sizeof(uint32_t)];
     WriteLE32(msgseq, nSequence);
+    LOCK(g_publish_mutex);
     int rc = zmq_send_multipart(psocket, command, strlen(command), data, size, msgseq, (size_t)sizeof(uint32_t), nullptr);
     if (rc == -1)
         return false;
@@ -301,3 +307,9 @@ bool CZMQPublishSequenceNotifier::NotifyTransactionRemoval(const CTransaction &t
     LogDebug(BCLog::ZMQ, "Publish hashtx mempool removal %s to %s\n", hash.GetHex(), this->address);
     return SendSequenceMsg(*this, hash, /* Mempool (R)emoval */ 'R', mempool_sequence);
 }
+
+bool CZMQPublishMiningJobNotifier::NotifyMiningJob(std::span<const unsigned char> work)
+{
+    LogDebug(BCLog::ZMQ, "Publish miningjob to %s\n", this->address);
+    return SendZmqMessage(MSG_MININGJOB, work.data(), work.size());
+}
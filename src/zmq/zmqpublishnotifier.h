@@ -10,6 +10,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <span>
 #include <vector>
 
 class CBlockIndex;
@@ -72,4 +73,10 @@ public:
     bool NotifyTransactionRemoval(const CTransaction &transaction, uint64_t mempool_sequence) override;
 };
 
+class CZMQPublishMiningJobNotifier : public CZMQAbstractPublishNotifier
+{
+public:
+    bool NotifyMiningJob(std::span<const unsigned char> work) override;
+};
+
 #endif // BITCOIN_ZMQ_ZMQPUBLISHNOTIFIER_H
@@ -62,6 +62,8 @@ class ChainstateWriteCrashTest(BitcoinTestFramework):
         self.node0_args = ["-dbcrashratio=8", "-dbcache=4"] + self.base_args
         self.node1_args = ["-dbcrashratio=16", "-dbcache=8"] + self.base_args
         self.node2_args = ["-dbcrashratio=24", "-dbcache=16"] + self.base_args
+        # Node1 also crashes while writing the coins cache in the background.
+        self.node1_args.append("-dbbackgroundflush")
 
         # Node3 is a normal node with default args, except will mine full blocks
         # and txs with "dust" outputs
@@ -20,6 +20,7 @@ from test_framework.blocktools import (
 from test_framework.test_framework import BitcoinTestFramework
 from test_framework.messages import (
     CBlock,
+    deser_compact_size,
     hash256,
     tx_from_hex,
 )
@@ -130,6 +131,7 @@ class ZMQTest (BitcoinTestFramework):
             self.test_reorg()
             self.test_multiple_interfaces()
             self.test_ipv6()
+            self.test_mining_job()
         finally:
             # Destroy the ZMQ context.
             self.log.debug("Destroying ZMQ context")
@@ -588,6 +590,96 @@ class ZMQTest (BitcoinTestFramework):
         # Should receive the same block hash
         assert_equal(self.nodes[0].getbestblockhash(), subscribers[0].receive().hex())
 
+    def test_mining_job(self):
+        self.log.info("Testing mining jobs and binary submissions")
+        node = self.nodes[0]
+        job_address = f"tcp://127.0.0.1:{self.zmq_port_base + 3}"
+        submit_address = f"tcp://127.0.0.1:{self.zmq_port_base + 4}"
+        socket = self.ctx.socket(zmq.SUB)
+        sub = ZMQSubscriber(socket, b"miningjob")
+        self.restart_node(0, [
+            f"-zmqpubminingjob={job_address}",
+            f"-zmqminingsubmit={submit_address}",
+            f"-genaddress={ADDRESS_BCRT1_UNSPENDABLE}",
+        ])
+        socket.connect(job_address)
+        submit = self.ctx.socket(zmq.REQ)
+        submit.set(zmq.RCVTIMEO, 60000)
+        submit.connect(submit_address)
+
+        def parse_job(body):
+            stream = BytesIO(body)
+            job_id, flags = struct.unpack("<QB", stream.read(9))
+            header = stream.read(80)
+            midstate = stream.read(32)
+            target = int.from_bytes(stream.read(32), "little")
+            coinbase1 = stream.read(deser_compact_size(stream))
+            coinbase2 = stream.read(deser_compact_size(stream))
+            branch = [stream.read(32) for _ in range(deser_compact_size(stream))]
+            assert_equal(stream.read(), b"")
+            return {"id": job_id, "clean": bool(flags & 1), "header": header, "midstate": midstate,
+                    "target": target, "coinbase1": coinbase1, "coinbase2": coinbase2, "branch": branch}
+
+        def next_job(prev_hash):
+            # Skip jobs for older tips, such as those published before subscribing.
+            while True:
+                job = parse_job(sub.receive())
+                if job["header"][4:36] == bytes.fromhex(prev_hash)[::-1]:
+                    return job
+
+        def send(request):
+            submit.send(request)
+            return submit.recv()[0]
+
+        # As in setup_zmq_test, generate blocks until the subscription is live.
+        socket.set(zmq.RCVTIMEO, 1000)
+        while True:
+            tip = self.generatetoaddress(node, 1, ADDRESS_BCRT1_UNSPENDABLE, sync_fun=self.no_op)[0]
+            try:
+                job = next_job(tip)
+                break
+            except zmq.error.Again:
+                self.log.debug("Didn't receive sync-up mining job, trying again.")
+        socket.set(zmq.RCVTIMEO, 60000)
+        assert job["clean"]
+        assert_equal(job["target"], int(node.getblockheader(tip)["target"], 16))
+
+        # Roll the extranonce: the merkle root comes from the coinbase parts.
+        extranonce = bytes(range(1, 9))
+        root = hash256(job["coinbase1"] + extranonce + job["coinbase2"])
+        for node_hash in job["branch"]:
+            root = hash256(root + node_hash)
+        header = bytearray(job["header"][:36] + root + job["header"][68:])
+        time = struct.unpack("<I", header[68:72])[0]
+        solved, unsolved = None, None
+        for nonce in range(1 << 16):
+            header[76:80] = struct.pack("<I", nonce)
+            if int.from_bytes(hash256(bytes(header)), "little") <= job["target"]:
+                solved = solved if solved is not None else nonce
+            else:
+                unsolved = unsolved if unsolved is not None else nonce
+            if solved is not None and unsolved is not None:
+                break
+        header[76:80] = struct.pack("<I", solved)
+
+        def submission(job_id, nonce):
+            return struct.pack("<Q", job_id) + extranonce + struct.pack("<II", time, nonce)
+
+        assert_equal(send(b"\x00" * 23), 5)
+        assert_equal(send(submission(job["id"] + 1000, solved)), 2)
+        assert_equal(send(submission(job["id"], unsolved)), 3)
+        assert_equal(send(struct.pack("<Q", job["id"]) + extranonce + struct.pack("<II", time - 1, solved)), 4)
+        assert_equal(send(submission(job["id"], solved)), 0)
+        block_hash = hash256(bytes(header))[::-1].hex()
+        assert_equal(node.getbestblockhash(), block_hash)
+
+        # The new tip makes the next job clean, and the old one stale.
+        new_job = next_job(block_hash)
+        assert new_job["clean"]
+        assert_equal(send(submission(job["id"], solved)), 2)
+        submit.close()
+        socket.close()
+
 
 if __name__ == '__main__':
     ZMQTest(__file__).main()
@@ -376,6 +376,25 @@ class MiningTest(BitcoinTestFramework):
         assert_equal(block["tx"][0]["locktime"], block["height"] - 1)
         assert_equal(block["tx"][0]["vin"][0]["sequence"], MAX_SEQUENCE_NONFINAL)
 
+    def test_mining_metrics(self):
+        self.log.info("getminingmetrics: templates and solutions are counted")
+        node = self.nodes[0]
+        before = node.getminingmetrics()
+        node.getblocktemplate(NORMAL_GBT_REQUEST_PARAMS)
+        self.generate(node, 1, sync_fun=self.no_op)
+        after = node.getminingmetrics()
+        # One template for getblocktemplate and one for the generated block
+        assert_equal(after['template_build']['count'], before['template_build']['count'] + 2)
+        assert_equal(sum(b['count'] for b in after['template_build_histogram']), after['template_build']['count'])
+        assert 'max_ms' not in after['template_build_histogram'][-1]
+        assert_equal(after['tip_changes'], before['tip_changes'] + 1)
+        assert_equal(after['solutions'], before['solutions'] + 1)
+        assert_equal(after['stale_solutions'], before['stale_solutions'])
+        assert_equal(after['network_hashps'], node.getnetworkhashps(120))
+        # The next template is the first one on the new tip
+        node.getblocktemplate(NORMAL_GBT_REQUEST_PARAMS)
+        assert_equal(node.getminingmetrics()['tip_to_template']['count'], after['tip_to_template']['count'] + 1)
+
     def run_test(self):
         node = self.nodes[0]
         self.wallet = MiniWallet(node)
@@ -515,6 +534,7 @@ class MiningTest(BitcoinTestFramework):
         self.test_timewarp()
         self.test_pruning()
         self.test_height_in_locktime()
+        self.test_mining_metrics()
 
 
 if __name__ == '__main__':
@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025-present The Bitcoin Core developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test the Stratum v1 server (-stratumbind) with a minimal stratum client."""
+
+import json
+import socket
+import struct
+
+from test_framework.address import ADDRESS_BCRT1_P2WSH_OP_TRUE
+from test_framework.messages import (
+    hash256,
+    uint256_from_compact,
+)
+from test_framework.test_framework import BitcoinTestFramework
+from test_framework.util import (
+    assert_equal,
+    p2p_port,
+)
+
+
+class StratumClient:
+    def __init__(self, port):
+        self.sock = socket.create_connection(("127.0.0.1", port), timeout=60)
+        self.buf = b""
+        self.next_id = 1
+        self.notifications = []
+
+    def read_message(self):
+        while b"\n" not in self.buf:
+            data = self.sock.recv(4096)
+            assert data, "connection closed"
+            self.buf += data
+        line, self.buf = self.buf.split(b"\n", 1)
+        return json.loads(line)
+
+    def call(self, method, params):
+        """Send a request and return its response, queueing notifications received meanwhile."""
+        request_id = self.next_id
+        self.next_id += 1
+        self.sock.sendall(json.dumps({"id": request_id, "method": method, "params": params}).encode() + b"\n")
+        while True:
+            message = self.read_message()
+            if message["id"] == request_id:
+                return message
+            self.notifications.append(message)
+
+    def wait_for_notify(self):
+        while True:
+            message = self.notifications.pop(0) if self.notifications else self.read_message()
+            if message.get("method") == "mining.notify":
+                return message["params"]
+
+
+def prev_block_hash(notify):
+    """Block hash in RPC form from the word-swapped mining.notify prevhash."""
+    prevhash = bytes.fromhex(notify[1])
+    return b"".join(prevhash[i:i + 4][::-1] for i in range(0, 32, 4))[::-1].hex()
+
+
+def miner_header(notify, extranonce1, extranonce2, ntime, nonce):
+    _, _, coinb1, coinb2, branches, version, nbits, _, _ = notify
+    coinbase = bytes.fromhex(coinb1 + extranonce1 + extranonce2 + coinb2)
+    root = hash256(coinbase)
+    for branch in branches:
+        root = hash256(root + bytes.fromhex(branch))
+    prev = bytes.fromhex(prev_block_hash(notify))[::-1]
+    return (struct.pack("<I", int(version, 16)) + prev + root +
+            struct.pack("<III", ntime, int(nbits, 16), nonce))
+
+
+def solve(notify, extranonce1, extranonce2):
+    target = uint256_from_compact(int(notify[6], 16))
+    ntime = int(notify[7], 16)
+    nonce = 0
+    while int.from_bytes(hash256(miner_header(notify, extranonce1, extranonce2, ntime, nonce)), "little") > target:
+        nonce += 1
+    return ntime, nonce
+
+
+class MiningStratumTest(BitcoinTestFramework):
+    def set_test_params(self):
+        self.num_nodes = 1
+        self.setup_clean_chain = True
+
+    def submit(self, client, job_id, extranonce2, ntime, nonce):
+        return client.call("mining.submit", ["worker", job_id, extranonce2, f"{ntime:08x}", f"{nonce:08x}"])
+
+    def run_test(self):
+        node = self.nodes[0]
+        self.generate(node, 10)
+        stratum_port = p2p_port(self.num_nodes)
+        self.restart_node(0, extra_args=[
+            f"-stratumbind=127.0.0.1:{stratum_port}",
+            f"-genaddress={ADDRESS_BCRT1_P2WSH_OP_TRUE}",
+        ])
+
+        self.log.info("Subscribe and authorize")
+        client = StratumClient(stratum_port)
+        response = client.call("mining.subscribe", ["test/1.0"])
+        assert_equal(response["error"], None)
+        _, extranonce1, extranonce2_size = response["result"]
+        assert_equal(extranonce2_size, 4)
+        assert_equal(client.call("mining.authorize", ["worker", "x"])["result"], True)
+        notify = client.wait_for_notify()
+        assert_equal(prev_block_hash(notify), node.getbestblockhash())
+        assert_equal(notify[8], True)
+
+        self.log.info("Submit a share that is a block")
+        extranonce2 = "00000001"
+        ntime, nonce = solve(notify, extranonce1, extranonce2)
+        header = miner_header(notify, extranonce1, extranonce2, ntime, nonce)
+        response = self.submit(client, notify[0], extranonce2, ntime, nonce)
+        assert_equal(response["error"], None)
+        assert_equal(response["result"], True)
+        assert_equal(node.getblockcount(), 11)
+        assert_equal(node.getbestblockhash(), hash256(header)[::-1].hex())
+        coinbase = node.getblock(node.getbestblockhash(), 2)["tx"][0]
+        assert_equal(coinbase["vout"][0]["scriptPubKey"]["address"], ADDRESS_BCRT1_P2WSH_OP_TRUE)
+
+        self.log.info("A duplicate share is rejected")
+        assert_equal(self.submit(client, notify[0], extranonce2, ntime, nonce)["error"][0], 22)
+
+        self.log.info("A new tip pushes a clean job")
+        self.generate(node, 1, sync_fun=self.no_op)
+        while prev_block_hash(notify) != node.getbestblockhash():
+            notify = client.wait_for_notify()
+        assert_equal(notify[8], True)
+        assert_equal(self.submit(client, "0", extranonce2, ntime, nonce)["error"][0], 21)
+        ntime, nonce = solve(notify, extranonce1, extranonce2)
+        assert_equal(self.submit(client, notify[0], extranonce2, ntime, nonce)["result"], True)
+        assert_equal(node.getblockcount(), 13)
+
+
+if __name__ == '__main__':
+    MiningStratumTest(__file__).main()
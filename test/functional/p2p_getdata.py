@@ -7,10 +7,13 @@ from collections import defaultdict
 
 from test_framework.messages import (
     CInv,
+    MSG_BLOCK,
+    MSG_WITNESS_FLAG,
     msg_getdata,
 )
 from test_framework.p2p import P2PInterface
 from test_framework.test_framework import BitcoinTestFramework
+from test_framework.util import assert_equal
 
 
 class P2PStoreBlock(P2PInterface):
@@ -43,6 +46,26 @@ class GetdataTest(BitcoinTestFramework):
         p2p_block_store.send_and_ping(good_getdata)
         p2p_block_store.wait_until(lambda: p2p_block_store.blocks[best_block] == 1)
 
+        self.log.info("test that blocks served to several peers are read from disk once")
+        old_block = int(self.nodes[0].getblockhash(1), 16)
+        other_store = self.nodes[0].add_p2p_connection(P2PStoreBlock())
+        before = self.nodes[0].getnetworkinfo()["blockservecache"]
+        for peer in (p2p_block_store, other_store):
+            peer.send_and_ping(msg_getdata([CInv(t=MSG_BLOCK | MSG_WITNESS_FLAG, h=old_block)]))
+            peer.wait_until(lambda: peer.blocks[old_block] == 1)
+        after = self.nodes[0].getnetworkinfo()["blockservecache"]
+        assert_equal(after["misses"], before["misses"] + 1)
+        assert_equal(after["hits"], before["hits"] + 1)
+        assert_equal(after["entries"], before["entries"] + 1)
+
+        # A block without witness data is serialized differently, so it is cached separately.
+        p2p_block_store.send_and_ping(msg_getdata([CInv(t=MSG_BLOCK, h=old_block)]))
+        p2p_block_store.wait_until(lambda: p2p_block_store.blocks[old_block] == 2)
+        final = self.nodes[0].getnetworkinfo()["blockservecache"]
+        assert_equal(final["misses"], after["misses"] + 1)
+        assert_equal(final["entries"], after["entries"] + 1)
+        assert final["bytes"] <= final["maxbytes"]
+
 
 if __name__ == '__main__':
     GetdataTest(__file__).main()
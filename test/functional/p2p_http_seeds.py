@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025-present The Bitcoin Core developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test querying HTTP seeds (-httpseed) and the HTTP seed cache."""
+
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+import json
+import os
+import shutil
+import ssl
+import subprocess
+import threading
+
+from test_framework.test_framework import BitcoinTestFramework
+from test_framework.util import assert_equal
+
+SEED_ADDRESSES = ["1.2.3.4:8333", "5.6.7.8:8333"]
+
+
+class SeedHandler(BaseHTTPRequestHandler):
+    def do_GET(self):
+        if self.path != "/seeds.json":
+            self.send_error(404)
+            return
+        body = json.dumps({"nodes": [{"address": address} for address in SEED_ADDRESSES]}).encode()
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def log_message(self, *args):
+        pass
+
+
+class P2PHTTPSeedsTest(BitcoinTestFramework):
+    def set_test_params(self):
+        self.setup_clean_chain = True
+        self.num_nodes = 1
+
+    def node_addresses(self):
+        return sorted(f"{a['address']}:{a['port']}" for a in self.nodes[0].getnodeaddresses(0))
+
+    def run_test(self):
+        node = self.nodes[0]
+        server = ThreadingHTTPServer(("127.0.0.1", 0), SeedHandler)
+        threading.Thread(target=server.serve_forever, daemon=True).start()
+        base_url = f"http://127.0.0.1:{server.server_port}"
+        seed_args = ["-dnsseed=1", f"-httpseed={base_url}/seeds.json", f"-httpseed={base_url}/missing.json"]
+
+        self.log.info("Query a working and a failing seed concurrently")
+        with node.assert_debug_log(expected_msgs=[
+            f"Added 2 addresses from HTTP seed {base_url}/seeds.json",
+            f"Failed to fetch HTTP seed {base_url}/missing.json",
+        ], timeout=30):
+            self.restart_node(0, extra_args=seed_args)
+        assert_equal(self.node_addresses(), sorted(SEED_ADDRESSES))
+        assert (node.chain_path / "httpseeds.json").exists()
+
+        self.log.info("Start from the cached response while the seeds are unreachable")
+        self.stop_node(0)
+        server.shutdown()
+        server.server_close()
+        (node.chain_path / "peers.dat").unlink()
+        with node.assert_debug_log(expected_msgs=["Loaded 2 addresses from the HTTP seed cache"], timeout=30):
+            self.start_node(0, extra_args=seed_args)
+        assert_equal(self.node_addresses(), sorted(SEED_ADDRESSES))
+
+        self.test_https_seed()
+
+    def test_https_seed(self):
+        if not self.is_httpseed_tls_compiled():
+            self.log.info("Skipping https:// seed test: not supported by this build")
+            return
+        if shutil.which("openssl") is None:
+            self.log.info("Skipping https:// seed test: openssl command not found")
+            return
+        node = self.nodes[0]
+
+        self.log.info("Query an https:// seed, verifying its certificate")
+        cert = os.path.join(self.options.tmpdir, "seed.crt")
+        key = os.path.join(self.options.tmpdir, "seed.key")
+        subprocess.run(["openssl", "req", "-x509", "-newkey", "rsa:2048", "-nodes", "-days", "1",
+                        "-subj", "/CN=localhost", "-addext", "subjectAltName=DNS:localhost",
+                        "-keyout", key, "-out", cert], check=True, capture_output=True)
+        server = ThreadingHTTPServer(("127.0.0.1", 0), SeedHandler)
+        context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+        context.load_cert_chain(cert, key)
+        server.socket = context.wrap_socket(server.socket, server_side=True)
+        threading.Thread(target=server.serve_forever, daemon=True).start()
+        url = f"https://localhost:{server.server_port}/seeds.json"
+
+        self.stop_node(0)
+        (node.chain_path / "peers.dat").unlink()
+        (node.chain_path / "httpseeds.json").unlink()
+        with node.assert_debug_log(expected_msgs=[f"Added 2 addresses from HTTP seed {url}"], timeout=30):
+            self.start_node(0, extra_args=["-dnsseed=1", f"-httpseed={url}"], env={"SSL_CERT_FILE": cert})
+        assert_equal(self.node_addresses(), sorted(SEED_ADDRESSES))
+
+        self.log.info("Reject an https:// seed whose certificate is not trusted")
+        self.stop_node(0)
+        (node.chain_path / "peers.dat").unlink()
+        (node.chain_path / "httpseeds.json").unlink()
+        with node.assert_debug_log(expected_msgs=[f"Failed to fetch HTTP seed {url}"], timeout=30):
+            self.start_node(0, extra_args=["-dnsseed=1", f"-httpseed={url}"])
+        assert_equal(self.node_addresses(), [])
+        server.shutdown()
+        server.server_close()
+
+
+if __name__ == '__main__':
+    P2PHTTPSeedsTest(__file__).main()
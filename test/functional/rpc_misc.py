@@ -62,6 +62,17 @@ class RpcMiscTest(BitcoinTestFramework):
         assert_greater_than(memory['chunks_free'], 0)
         assert_equal(memory['used'] + memory['free'], memory['total'])
 
+        dbcache = node.getmemoryinfo()['dbcache']
+        assert_equal(dbcache['adaptive'], False)
+        assert_greater_than(dbcache['coins_cache_limit'], 0)
+        assert_greater_than(dbcache['coins_cache_usage'], 0)
+        assert_greater_than(dbcache['coins_db_cache'], 0)
+
+        self.log.info("test getmemoryinfo with -dbcacheadaptive")
+        self.restart_node(0, extra_args=["-dbcacheadaptive"])
+        assert_equal(node.getmemoryinfo()['dbcache']['adaptive'], True)
+        self.restart_node(0)
+
         self.log.info("test mallocinfo")
         try:
             mallocinfo = node.getmemoryinfo(mode="mallocinfo")
@@ -1008,6 +1008,10 @@ class BitcoinTestFramework(metaclass=BitcoinTestMetaClass):
         """Checks whether the zmq module was compiled."""
         return self.config["components"].getboolean("ENABLE_ZMQ")
 
+    def is_httpseed_tls_compiled(self):
+        """Checks whether https:// HTTP seeds are supported."""
+        return self.config["components"].getboolean("ENABLE_HTTPSEED_TLS")
+
     def is_usdt_compiled(self):
         """Checks whether the USDT tracepoints were compiled."""
         return self.config["components"].getboolean("ENABLE_USDT_TRACEPOINTS")
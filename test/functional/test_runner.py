@@ -124,6 +124,7 @@ BASE_SCRIPTS = [
     'wallet_multiwallet.py',
     'wallet_multiwallet.py --usecli',
     'p2p_dns_seeds.py',
+    'p2p_http_seeds.py',
     'wallet_groups.py',
     'p2p_blockfilters.py',
     'feature_assumevalid.py',
@@ -282,6 +283,7 @@ BASE_SCRIPTS = [
     'wallet_crosschain.py',
     'mining_basic.py',
     'mining_mainnet.py',
+    'mining_stratum.py',
     'feature_signet.py',
     'p2p_mutated_blocks.py',
     'rpc_named_arguments.py',